@@ -0,0 +1,371 @@
+#include "AvatarQuestCharacterIO.h"
+#include "AvatarQuestGameWeapon.h"
+#include "AvatarQuestGameArmor.h"
+
+namespace AvatarQuest {
+
+using namespace CharacterIO;
+
+namespace {
+    constexpr std::uint32_t kMaxDenseCount = 256;
+    constexpr std::uint32_t kMaxItems = 64;
+    constexpr std::uint32_t kMaxListCount = 64; // damage types / bonuses per item
+
+    enum class ItemKind : std::uint8_t { Weapon = 1, Armor = 2 };
+
+    // Equipment slot order in the Equipment section; append only
+    enum EquipSlot { Primary, Secondary, Head, Chest, Feet, Hands, Shoulders, SlotCount };
+
+    using Bits = std::array<Util::Byte, kMaxDenseCount / 8>;
+    inline bool TestBit(const Bits& b, std::uint32_t i) { return (b[i >> 3] >> (i & 7)) & 1; }
+
+    // [varU32 count][ceil(count/8) presence bytes][value per present key, ascending]
+    template<class Map, class WriteValue>
+    void WriteDense(Util::BinStream& w, const Map& map, std::uint32_t count, WriteValue writeValue)
+    {
+        Bits bits{};
+        for (const auto& kv : map) {
+            if (kv.first >= 0 && (std::uint32_t)kv.first < count) bits[kv.first >> 3] |= (Util::Byte)(1u << (kv.first & 7));
+        }
+        w.writeVarU32(count);
+        w.writeBytes(bits.data(), (count + 7) / 8);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            if (TestBit(bits, i)) writeValue(map.at((int)i));
+        }
+    }
+
+    // readValue(key) reads one value and stores it; no allocation beyond the map node
+    template<class ReadValue>
+    bool ReadDense(Util::BinView& r, ReadValue readValue)
+    {
+        std::uint32_t count = 0;
+        Bits bits{};
+        if (!r.readVarU32(count) || count > kMaxDenseCount) return false;
+        if (!r.readBytes(bits.data(), (count + 7) / 8)) return false;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            if (TestBit(bits, i) && !readValue((int)i)) return false;
+        }
+        return true;
+    }
+
+    void WriteDamageList(Util::BinStream& w, const Vector<DamageInstanceType>& list)
+    {
+        w.writeVarU32((std::uint32_t)list.size());
+        for (const DamageInstanceType& d : list) {
+            w.writeVarI32(d.tileID);
+            w.writeU8((std::uint8_t)d.damageType);
+            w.writeF32(d.damageRange.x);
+            w.writeF32(d.damageRange.y);
+        }
+    }
+
+    bool ReadDamageList(Util::BinView& r, Vector<DamageInstanceType>& out)
+    {
+        std::uint32_t n = 0;
+        if (!r.readVarU32(n) || n > kMaxListCount) return false;
+        out.resize(n);
+        for (DamageInstanceType& d : out) {
+            std::uint8_t type = 0;
+            if (!r.readVarI32(d.tileID) || !r.readU8(type)
+                || !r.readF32(d.damageRange.x) || !r.readF32(d.damageRange.y)) return false;
+            d.damageType = (DamageType)type;
+        }
+        return true;
+    }
+
+    void WriteBonuses(Util::BinStream& w, const Vector<AttributeBonus>& list)
+    {
+        w.writeVarU32((std::uint32_t)list.size());
+        for (const AttributeBonus& b : list) {
+            w.writeU8((std::uint8_t)b.type);
+            w.writeVarI32(b.amount);
+        }
+    }
+
+    bool ReadBonuses(Util::BinView& r, Vector<AttributeBonus>& out)
+    {
+        std::uint32_t n = 0;
+        if (!r.readVarU32(n) || n > kMaxListCount) return false;
+        out.resize(n);
+        for (AttributeBonus& b : out) {
+            std::uint8_t type = 0;
+            if (!r.readU8(type) || !r.readVarI32(b.amount)) return false;
+            b.type = (AttributeType)type;
+        }
+        return true;
+    }
+
+    void WriteWeapon(Util::BinStream& w, const AvatarQuestWeapon& wp)
+    {
+        w.writeVarI32(wp.tileID);
+        w.writeU8((std::uint8_t)wp.primarySkillType);
+        w.writeU8((std::uint8_t)wp.secondarySkillType);
+        w.writeU8((std::uint8_t)wp.governingAttribute);
+        WriteDamageList(w, wp.damageTypes);
+        w.writeF32(wp.attackSpeed);
+        w.writeVarI32(wp.attackReach);
+        w.writeF32(wp.criticalChance);
+        w.writeF32(wp.durability);
+        w.writeStr(wp.weaponName);
+        w.writeStr(wp.description);
+        w.writeVarI32(wp.levelRequirement);
+        WriteBonuses(w, wp.attributeBonuses);
+    }
+
+    bool ReadWeapon(Util::BinView& r, AvatarQuestWeapon& wp)
+    {
+        std::uint8_t primary = 0, secondary = 0, governing = 0;
+        if (!r.readVarI32(wp.tileID) || !r.readU8(primary) || !r.readU8(secondary) || !r.readU8(governing)) return false;
+        wp.primarySkillType = (SkillType)primary;
+        wp.secondarySkillType = (SkillType)secondary;
+        wp.governingAttribute = (AttributeType)governing;
+        return ReadDamageList(r, wp.damageTypes)
+            && r.readF32(wp.attackSpeed) && r.readVarI32(wp.attackReach)
+            && r.readF32(wp.criticalChance) && r.readF32(wp.durability)
+            && r.readStr(wp.weaponName) && r.readStr(wp.description)
+            && r.readVarI32(wp.levelRequirement)
+            && ReadBonuses(r, wp.attributeBonuses);
+    }
+
+    void WriteArmor(Util::BinStream& w, const AvatarQuestArmor& a)
+    {
+        w.writeU8((std::uint8_t)a.armorSkillType);
+        WriteDamageList(w, a.resistances);
+        w.writeU8((std::uint8_t)a.armorType);
+        w.writeU8((std::uint8_t)a.slot);
+        w.writeVarI32(a.armorClass);
+        w.writeF32(a.dodgeChance);
+        w.writeF32(a.durability);
+        w.writeStr(a.armorName);
+        w.writeStr(a.description);
+        w.writeVarI32(a.levelRequirement);
+        WriteBonuses(w, a.attributeBonuses);
+    }
+
+    bool ReadArmor(Util::BinView& r, AvatarQuestArmor& a)
+    {
+        std::uint8_t skill = 0, type = 0, slot = 0;
+        if (!r.readU8(skill) || !ReadDamageList(r, a.resistances) || !r.readU8(type) || !r.readU8(slot)) return false;
+        a.armorSkillType = (SkillType)skill;
+        a.armorType = (ArmorType)type;
+        a.slot = (ArmorSlot)slot;
+        return r.readVarI32(a.armorClass) && r.readF32(a.dodgeChance) && r.readF32(a.durability)
+            && r.readStr(a.armorName) && r.readStr(a.description)
+            && r.readVarI32(a.levelRequirement)
+            && ReadBonuses(r, a.attributeBonuses);
+    }
+
+    // Equipped items in table order; each distinct object appears once
+    struct ItemTable {
+        Vector<const void*> keys;
+        Vector<std::pair<ItemKind, const void*>> items;
+        int indexOf(const void* p)
+        {
+            if (!p) return -1;
+            for (size_t i = 0; i < keys.size(); ++i) if (keys[i] == p) return (int)i;
+            return -1;
+        }
+        void add(ItemKind kind, const void* p)
+        {
+            if (!p || indexOf(p) >= 0) return;
+            keys.push_back(p);
+            items.emplace_back(kind, p);
+        }
+    };
+
+    // Equipment slots as (kind, object) in EquipSlot order
+    std::array<std::pair<ItemKind, const void*>, SlotCount> EquippedItems(const CharacterSheet::Equipment& e)
+    {
+        return { {
+            { ItemKind::Weapon, e.primaryWeapon.get() },
+            { ItemKind::Weapon, e.secondaryWeapon.get() },
+            { ItemKind::Armor, e.head.get() },
+            { ItemKind::Armor, e.chest.get() },
+            { ItemKind::Armor, e.feet.get() },
+            { ItemKind::Armor, e.hands.get() },
+            { ItemKind::Armor, e.shoulders.get() },
+        } };
+    }
+
+    // Section payloads are built in a scratch stream so the length prefix is known
+    void WriteSectionTo(Util::BinStream& w, Tag tag, const Util::BinStream& payload)
+    {
+        w.writeU16((std::uint16_t)tag);
+        w.writeU32((std::uint32_t)payload.size());
+        w.writeBytes(payload.buffer().data(), payload.size());
+    }
+
+    bool ReadIdentity(Util::BinView& r, CharacterSheet& cs)
+    {
+        std::uint8_t male = 1;
+        if (!r.readStr(cs.name) || !r.readU8(male) || !r.readVarI32(cs.portraitIndex)) return false;
+        cs.isMale = male != 0;
+        return true;
+    }
+
+    bool ReadWallet(Util::BinView& r, CurrencyBundle& wallet)
+    {
+        return ReadDense(r, [&](int key) {
+            std::int64_t v = 0;
+            if (!r.readVarI64(v)) return false;
+            wallet.amounts[key] = v;
+            return true;
+        }) && r.readVarI32(wallet.tileID);
+    }
+
+    bool ReadItems(Util::BinView& r, Vector<Ref<AvatarQuestWeapon>>& weapons, Vector<Ref<AvatarQuestArmor>>& armor)
+    {
+        std::uint32_t count = 0;
+        if (!r.readVarU32(count) || count > kMaxItems) return false;
+        weapons.assign(count, nullptr);
+        armor.assign(count, nullptr);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            std::uint8_t kind = 0;
+            std::uint32_t len = 0;
+            Util::BinView rec;
+            if (!r.readU8(kind) || !r.readVarU32(len) || !r.readView(len, rec)) return false;
+            if (kind == (std::uint8_t)ItemKind::Weapon) {
+                weapons[i] = std::make_shared<AvatarQuestWeapon>();
+                if (!ReadWeapon(rec, *weapons[i])) return false;
+            }
+            else if (kind == (std::uint8_t)ItemKind::Armor) {
+                armor[i] = std::make_shared<AvatarQuestArmor>();
+                if (!ReadArmor(rec, *armor[i])) return false;
+            }
+            // Unknown kinds stay empty; slots referring to them load unequipped
+        }
+        return true;
+    }
+
+    bool ReadEquipment(Util::BinView& r, const Vector<Ref<AvatarQuestWeapon>>& weapons,
+                       const Vector<Ref<AvatarQuestArmor>>& armor, CharacterSheet::Equipment& e)
+    {
+        std::uint32_t slots = 0;
+        if (!r.readVarU32(slots) || slots > kMaxDenseCount) return false;
+        Ref<AvatarQuestWeapon>* weaponSlots[] = { &e.primaryWeapon, &e.secondaryWeapon };
+        Ref<AvatarQuestArmor>* armorSlots[] = { &e.head, &e.chest, &e.feet, &e.hands, &e.shoulders };
+        for (std::uint32_t s = 0; s < slots; ++s) {
+            std::int32_t idx = -1;
+            if (!r.readVarI32(idx)) return false;
+            if (idx < -1 || idx >= (std::int32_t)weapons.size()) return false;
+            if (idx < 0) continue;
+            if (s < Head) *weaponSlots[s] = weapons[idx];
+            else if (s < SlotCount) *armorSlots[s - Head] = armor[idx];
+        }
+        return true;
+    }
+}
+
+void writeCharacterSheet(Util::BinStream& w, const CharacterSheet& cs)
+{
+    Util::BinStream s;
+    std::uint16_t sections = 0;
+    Util::BinStream body;
+
+    s.writeStr(cs.name);
+    s.writeU8(cs.isMale ? 1 : 0);
+    s.writeVarI32(cs.portraitIndex);
+    WriteSectionTo(body, Tag::Identity, s); ++sections;
+
+    s.clear();
+    WriteDense(s, cs.attributes.values, (std::uint32_t)AttributeType::COUNT, [&](int v) { s.writeVarI32(v); });
+    WriteSectionTo(body, Tag::Attributes, s); ++sections;
+
+    s.clear();
+    WriteDense(s, cs.skillRatings, (std::uint32_t)SkillType::COUNT, [&](float v) { s.writeF32(v); });
+    WriteSectionTo(body, Tag::Skills, s); ++sections;
+
+    s.clear();
+    WriteDense(s, cs.wallet.amounts, (std::uint32_t)CurrencyType::COUNT, [&](std::int64_t v) { s.writeVarI64(v); });
+    s.writeVarI32(cs.wallet.tileID);
+    WriteSectionTo(body, Tag::Wallet, s); ++sections;
+
+    const auto equipped = EquippedItems(cs.equipment);
+    ItemTable table;
+    for (const auto& [kind, item] : equipped) table.add(kind, item);
+    s.clear();
+    s.writeVarU32((std::uint32_t)table.items.size());
+    Util::BinStream rec;
+    for (const auto& [kind, item] : table.items) {
+        rec.clear();
+        if (kind == ItemKind::Weapon) WriteWeapon(rec, *static_cast<const AvatarQuestWeapon*>(item));
+        else WriteArmor(rec, *static_cast<const AvatarQuestArmor*>(item));
+        s.writeU8((std::uint8_t)kind);
+        s.writeVarU32((std::uint32_t)rec.size());
+        s.writeBytes(rec.buffer().data(), rec.size());
+    }
+    WriteSectionTo(body, Tag::Items, s); ++sections;
+
+    s.clear();
+    s.writeVarU32(SlotCount);
+    for (const auto& slot : equipped) s.writeVarI32(table.indexOf(slot.second));
+    WriteSectionTo(body, Tag::Equipment, s); ++sections;
+
+    w.writeU32(kMagic);
+    w.writeU16(kVersion);
+    w.writeU16(sections);
+    w.writeBytes(body.buffer().data(), body.size());
+}
+
+bool readCharacterSheet(Util::BinView& r, CharacterSheet& out)
+{
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0, sections = 0;
+    if (!r.readU32(magic) || magic != kMagic || !r.readU16(version) || !r.readU16(sections)) return false;
+    // Additions don't bump the version; a bump means this build can't read the layout
+    if (version == 0 || version > kVersion) return false;
+
+    CharacterSheet cs;
+    cs.attributes.values.reserve((size_t)AttributeType::COUNT);
+    cs.skillRatings.reserve((size_t)SkillType::COUNT);
+    Vector<Ref<AvatarQuestWeapon>> weapons;
+    Vector<Ref<AvatarQuestArmor>> armor;
+    for (std::uint16_t i = 0; i < sections; ++i) {
+        std::uint16_t tag = 0;
+        std::uint32_t len = 0;
+        Util::BinView sec;
+        if (!r.readU16(tag) || !r.readU32(len) || !r.readView(len, sec)) return false;
+
+        bool ok = true;
+        switch ((Tag)tag) {
+        case Tag::Identity:
+            ok = ReadIdentity(sec, cs);
+            break;
+        case Tag::Attributes:
+            ok = ReadDense(sec, [&](int key) {
+                std::int32_t v = 0;
+                if (!sec.readVarI32(v)) return false;
+                cs.attributes.values[key] = v;
+                return true;
+            });
+            break;
+        case Tag::Skills:
+            ok = ReadDense(sec, [&](int key) {
+                float v = 0.0f;
+                if (!sec.readF32(v)) return false;
+                cs.skillRatings[key] = v;
+                return true;
+            });
+            break;
+        case Tag::Wallet:
+            ok = ReadWallet(sec, cs.wallet);
+            break;
+        case Tag::Items:
+            ok = ReadItems(sec, weapons, armor);
+            break;
+        case Tag::Equipment:
+            ok = ReadEquipment(sec, weapons, armor, cs.equipment);
+            break;
+        default:
+            break; // written by a newer build; skip
+        }
+        if (!ok) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Bad character section %u", (unsigned)tag);
+            return false;
+        }
+    }
+    out = std::move(cs);
+    return true;
+}
+
+}
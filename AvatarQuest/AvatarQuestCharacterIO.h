@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Common.h"
+#include "AvatarQuestRP.h"
+
+namespace AvatarQuest {
+
+// Binary schema for CharacterSheet (save games).
+//
+//   [u32 'SHET'][u16 version][u16 sectionCount]
+//   sectionCount x [u16 tag][u32 length][payload]
+//
+// Readers skip sections with unknown tags, and they ignore bytes past the fields
+// they know at the end of a section or item record. So new data is added as a
+// new tag or as trailing fields, and older saves and older builds keep loading.
+// Keyed values (attributes, skills, currencies) are written as dense arrays
+// indexed by enum value with a presence bitmask, not as map dumps.
+//
+// Items have no global catalogue, so equipped items are written once each into
+// an item table. The equipment section refers to them by table index, and an
+// item in two slots is stored once.
+namespace CharacterIO {
+    constexpr std::uint32_t kMagic = 0x54454853; // 'SHET'
+    constexpr std::uint16_t kVersion = 1;
+
+    enum class Tag : std::uint16_t {
+        Identity = 1,   // name, isMale, portraitIndex
+        Attributes = 2, // dense AttributeType -> int
+        Skills = 3,     // dense SkillType -> float rating
+        Wallet = 4,     // dense CurrencyType -> int64, tileID
+        Items = 5,      // item table
+        Equipment = 6,  // slot -> item table index (-1 = empty)
+    };
+}
+
+void writeCharacterSheet(Util::BinStream& w, const CharacterSheet& cs);
+// Replaces `out` on success; leaves it untouched on failure
+bool readCharacterSheet(Util::BinView& r, CharacterSheet& out);
+
+}
@@ -1,8 +1,13 @@
 #include "AvatarQuest/Fonts.h"
 
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <sstream>
+
 namespace AvatarQuest { namespace Fonts {
 
-static UMap<int, Text::Font*> s_fonts; // pointSize -> font*
+static UMap<int, Text::FontHandle> s_fonts; // pointSize -> font handle
 
 static const char* kFontCandidates[] = {
     "assets/fonts/DroidSerifBold-aMPE.ttf",
@@ -10,36 +15,150 @@ static const char* kFontCandidates[] = {
     "../../assets/fonts/DroidSerifBold-aMPE.ttf"
 };
 
+static const char* kManifestCandidates[] = {
+    "assets/fonts/preload.txt",
+    "../assets/fonts/preload.txt",
+    "../../assets/fonts/preload.txt"
+};
+
+// Sizes used by the convenience wrappers; preloaded when no manifest is found
+static const int kDefaultPreloadSizes[] = { 27, 31, 54 };
+
+// Background preload: the worker reads the font file once and opens every manifest
+// size from the shared bytes; the main thread adopts finished fonts in get().
+struct PreloadState {
+    std::thread worker;
+    std::mutex mutex;
+    Vector<std::pair<int, TTF_Font*>> ready; // guarded by mutex
+    Text::FontBytes bytes;                   // written by worker, read after join
+    Vector<int> sizes;                       // manifest sizes, fixed before the worker starts
+    std::atomic<bool> done{ false };
+};
+static PreloadState s_preload;
+
+static Vector<int> ReadManifest()
+{
+    Vector<int> sizes;
+    for (const char* p : kManifestCandidates) {
+        size_t len = 0;
+        void* data = SDL_LoadFile(p, &len);
+        if (!data) continue;
+        // One point size per line; '#' starts a comment
+        std::istringstream in(std::string(static_cast<const char*>(data), len));
+        SDL_free(data);
+        std::string line;
+        while (std::getline(in, line)) {
+            const size_t hash = line.find('#');
+            if (hash != std::string::npos) line.resize(hash);
+            int size = 0;
+            std::istringstream ls(line);
+            if (ls >> size && size > 0) sizes.push_back(size);
+        }
+        SDL_Log("[Fonts] Preload manifest %s: %d sizes", p, (int)sizes.size());
+        return sizes;
+    }
+    sizes.assign(std::begin(kDefaultPreloadSizes), std::end(kDefaultPreloadSizes));
+    return sizes;
+}
+
+static void PreloadWorker()
+{
+    Text::FontBytes bytes;
+    for (const char* p : kFontCandidates) {
+        bytes = Text::loadFontBytes(p);
+        if (bytes) break;
+    }
+    if (bytes) {
+        for (int size : s_preload.sizes) {
+            TTF_Font* f = Text::openFontFromMemory(bytes, size);
+            if (!f) continue;
+            std::scoped_lock<std::mutex> lock(s_preload.mutex);
+            s_preload.ready.emplace_back(size, f);
+        }
+    }
+    s_preload.bytes = std::move(bytes);
+    s_preload.done.store(true, std::memory_order_release);
+}
+
+// Hand fonts finished by the worker to Text (main thread, after the worker is joined
+// so its shared bytes are published)
+static void AdoptPreloaded()
+{
+    Vector<std::pair<int, TTF_Font*>> ready;
+    {
+        std::scoped_lock<std::mutex> lock(s_preload.mutex);
+        ready.swap(s_preload.ready);
+    }
+    for (auto& [size, font] : ready) {
+        Text::FontHandle h = Text::adoptFont(font, size, s_preload.bytes);
+        if (h) s_fonts[size] = h;
+    }
+}
+
+static void JoinPreload()
+{
+    if (s_preload.worker.joinable()) s_preload.worker.join();
+}
+
 void init() {
-    // No-op: lazy load on demand
+    if (s_preload.worker.joinable()) return;
+    s_preload.sizes = ReadManifest();
+    s_preload.done = false;
+    s_preload.worker = std::thread(PreloadWorker);
 }
 
-Text::Font* get(int pointSize) {
+Text::FontHandle get(int pointSize) {
     auto it = s_fonts.find(pointSize);
-    if (it != s_fonts.end()) return it->second;
+    // A null entry records a failed load; a stale one (Text was shut down) is reloaded
+    if (it != s_fonts.end() && (!it->second || Text::getFont(it->second))) return it->second;
+
+    const uint64_t start = SDL_GetPerformanceCounter();
 
-    Text::Font* f = nullptr;
+    // Wait for the preload if this size is still in flight, then adopt its results
+    if (s_preload.worker.joinable()) {
+        const bool inManifest = std::find(s_preload.sizes.begin(), s_preload.sizes.end(), pointSize) != s_preload.sizes.end();
+        if (inManifest || s_preload.done.load(std::memory_order_acquire)) JoinPreload();
+    }
+    if (!s_preload.worker.joinable()) {
+        AdoptPreloaded();
+        it = s_fonts.find(pointSize);
+        if (it != s_fonts.end() && Text::getFont(it->second)) {
+            const float ms = (float)((SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+            if (ms > 0.5f) Game::recordStall("font preload wait", ms);
+            return it->second;
+        }
+    }
+
+    // Not preloaded: open synchronously, reusing the shared bytes when we have them
+    Text::FontHandle f;
+    if (!s_preload.worker.joinable() && s_preload.bytes) {
+        f = Text::loadFontFromMemory(s_preload.bytes, pointSize);
+    }
     for (const char* p : kFontCandidates) {
+        if (f) break;
         f = Text::loadFont(p, pointSize);
-        if (f) {
-            SDL_Log("[Fonts] Loaded font size %d from %s", pointSize, p);
-            break;
-        }
+        if (f) SDL_Log("[Fonts] Loaded font size %d from %s", pointSize, p);
     }
     if (!f) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Fonts] Failed to load font size %d from candidates", pointSize);
     }
-    s_fonts[pointSize] = f; // cache nullptr to avoid repeated attempts
+    s_fonts[pointSize] = f; // cache null handle to avoid repeated attempts
+
+    const float ms = (float)((SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    Game::recordStall("font first use", ms);
     return f;
 }
 
 void shutdown() {
+    // Finish the preload so every TTF_Font it opened is owned by Text before teardown
+    JoinPreload();
+    AdoptPreloaded();
     // Let the Text subsystem unload/close all fonts safely and handle TTF_Quit ordering.
-    // Our cache only stores raw pointers into Text's internal list; after Text::shutdown()
-    // those become invalid, so just clear without individually unloading to avoid double free
-    // or calling into SDL_ttf after it has been torn down.
+    // Our cached handles go stale after Text::shutdown(), so just clear without
+    // individually unloading.
     Text::shutdown();
     s_fonts.clear();
+    s_preload.bytes.reset();
 }
 
 } } // namespace AvatarQuest::Fonts
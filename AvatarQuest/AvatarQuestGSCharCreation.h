@@ -26,7 +26,7 @@ public:
     const char* name() const override { return "CharacterCreation"; }
 
 private:
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     // UI demo: window + prompt + name input
     UI::UIWindow _window;
     UI::UILabel _prompt;
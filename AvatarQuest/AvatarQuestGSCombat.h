@@ -18,7 +18,7 @@ public:
     const char* name() const override { return "Combat"; }
 
 private:
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     Menu _menu;
 };
 
@@ -17,7 +17,7 @@ public:
     const char* name() const override { return "MainMenu"; }
 
 private:
-    Text::Font* _titleFont = nullptr;
+    Text::FontHandle _titleFont;
     Menu _menu;
 };
 
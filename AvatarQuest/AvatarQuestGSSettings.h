@@ -22,7 +22,7 @@ public:
     static AQStateId GetBackTarget();
 
 private:
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     UI::UIWindow _window;
     UI::UILabel _title;
 
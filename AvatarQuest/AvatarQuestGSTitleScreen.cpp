@@ -8,7 +8,7 @@ GSTitleScreen::~GSTitleScreen() { }
 
 void GSTitleScreen::onEnter() {
     // Title text is hidden; make the prompt large so it's readable
-    _titleFont = nullptr;
+    _titleFont = {};
     _promptFont = Fonts::menu();
 }
 
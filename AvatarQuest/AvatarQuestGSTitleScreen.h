@@ -17,8 +17,8 @@ public:
     const char* name() const override { return "Title"; }
 
 private:
-    Text::Font* _titleFont = nullptr;
-    Text::Font* _promptFont = nullptr;
+    Text::FontHandle _titleFont;
+    Text::FontHandle _promptFont;
 };
 
 }
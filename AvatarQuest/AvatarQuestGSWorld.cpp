@@ -2,9 +2,22 @@
 #include "AvatarQuest/Fonts.h"
 #include "AvatarQuestGSSettings.h"
 #include "BinaryIO.h"
+#include "AvatarQuestProfile.h"
+#include "AvatarQuestCharacterIO.h"
+#include "AvatarQuestGameWeapon.h"
+#include "AvatarQuestGameArmor.h"
 
 using namespace AvatarQuest;
 
+// One in-game day every 24 minutes (delta is in 60 fps frames)
+static constexpr float kGameHoursPerFrame = 1.0f / 3600.0f;
+
+GSWorld::~GSWorld() {
+    // A save still in flight completes, but must not call back into this state
+    if (_saveJob) AsyncSave::detach(_saveJob);
+    TileLighting::removeLight(_torch);
+}
+
 void GSWorld::onEnter() {
     _window = Window::getWindowSize();
     // Initialize map and player
@@ -18,6 +31,10 @@ void GSWorld::onEnter() {
     createPlayer(_window, startingTile, pc);
     _playerCamera = pc;
 
+    // Start at dusk so the torch shows
+    TileLighting::setTimeOfDay(18.0f);
+    _torch = TileLighting::addLight(TileLighting::LightDesc{}, startingTile);
+
     // Initialize pause menu
     _pauseFont = Fonts::menu();
     _pauseMenu.setFont(_pauseFont);
@@ -203,6 +220,10 @@ void GSWorld::update(float delta) {
     if (!_paused && _playerCamera && movePlayer(_playerCamera->currentMovement, delta)) {
         _playerCamera->currentMovement = PlayerMovement::Move_None;
     }
+#ifdef AVATARQUEST_ENABLE_AUDIO
+    // Positional SFX are heard from the player; emitters refresh in the next Sound::update()
+    if (_playerCamera) Sound::setListenerPosition(_playerCamera->playerWorldPosition);
+#endif
     _window = Window::getWindowSize();
     // Keep quest window anchored to bottom center and fit to window
     {
@@ -218,6 +239,12 @@ void GSWorld::update(float delta) {
     }
     if (!_paused) {
         _questText.update(delta);
+        TileLighting::advanceTimeOfDay(delta * kGameHoursPerFrame);
+        if (_playerCamera) TileLighting::moveLight(_torch, _playerCamera->playerTilePosition);
+    }
+    if (!_saveJob && _saveStatusTime > 0.0f) {
+        _saveStatusTime -= delta;
+        if (_saveStatusTime <= 0.0f) _saveStatus.clear();
     }
     if (_playerCamera) {
         SDL_FRect wf{ (float)_window.x, (float)_window.y, (float)_window.w, (float)_window.h };
@@ -234,6 +261,11 @@ void GSWorld::render(float /*delta*/) {
                _playerCamera->playerCenterScreen.y,
                w, h, Renderer::Color{0,255,0,255});
     }
+    // Sprites queued this frame, back to front, then the next frame starts empty
+    SpriteLayer::renderSprites();
+    SpriteLayer::clearSprites();
+    // Effects draw over the map and under the UI
+    Particles::renderParticles();
     // Quest window and animated text
     _questWindow.render();
     _questText.render();
@@ -264,35 +296,124 @@ void GSWorld::render(float /*delta*/) {
         const float cx = cr.x + cr.w * 0.5f;
         const float cy = cr.y + cr.h * 0.5f;
         _pauseMenu.render(cx, cy);
+        if (!_saveStatus.empty()) {
+            SDL_FRect m = Text::measure(_pauseFont, _saveStatus);
+            Text::draw(_pauseFont, _saveStatus, cr.x + (cr.w - m.w) * 0.5f, cr.y + cr.h - m.h - 8.0f, SDL_Color{ 220,220,160,255 });
+        }
     }
 }
 
 // ---------------- persistence ----------------
 static constexpr std::uint32_t kSaveMagic = 0x41565131; // 'AVQ1'
-static constexpr std::uint32_t kSaveVersion = 1;
+static constexpr std::uint32_t kSaveVersion = 3;        // 1: player tile; 2: + terrain section; 3: + character sheet
 static const char* kSavePath = "savegame.bin";
+static constexpr float kSaveStatusFrames = 180.0f;
+
+namespace {
+    // Everything a save needs, captured on the main thread. The terrain is a
+    // shared copy-on-write reference, so taking it costs nothing.
+    struct SaveSnapshot {
+        TileVector playerTile;
+        TileVector mapSize;
+        Ref<const Vector<int>> terrain;
+        CharacterSheet character;
+    };
+
+    // The sheet is small; copy it, including the equipped items, which the game
+    // may keep mutating (durability) while the worker serialises
+    template<class T>
+    Ref<T> CloneItem(const Ref<T>& item) { return item ? std::make_shared<T>(*item) : nullptr; }
+
+    CharacterSheet SnapshotCharacter(const CharacterSheet& cs)
+    {
+        CharacterSheet copy = cs;
+        auto& e = copy.equipment;
+        const bool sameWeapon = e.primaryWeapon == e.secondaryWeapon;
+        e.primaryWeapon = CloneItem(e.primaryWeapon);
+        e.secondaryWeapon = sameWeapon ? e.primaryWeapon : CloneItem(e.secondaryWeapon);
+        for (Ref<AvatarQuestArmor>* a : { &e.head, &e.chest, &e.feet, &e.hands, &e.shoulders }) *a = CloneItem(*a);
+        return copy;
+    }
+
+    bool WriteSave(const SaveSnapshot& snap, Util::BinStream& bs, const std::function<void(float)>& report)
+    {
+        bs.writeU32(kSaveMagic);
+        bs.writeU32(kSaveVersion);
+        bs.writeI32(snap.playerTile.x);
+        bs.writeI32(snap.playerTile.y);
+        bs.writeI32(snap.mapSize.x);
+        bs.writeI32(snap.mapSize.y);
+        report(0.1f);
+        const Vector<int>& terrain = *snap.terrain;
+        if (!Util::Compress::writeSection(bs, { reinterpret_cast<const Util::Byte*>(terrain.data()), terrain.size() * sizeof(int) },
+                Util::Codec::RleLZ, sizeof(int)))
+            return false;
+        report(0.8f);
+        writeCharacterSheet(bs, snap.character);
+        return true;
+    }
+}
 
 bool GSWorld::saveGame() {
     if (!_playerCamera) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] No player camera"); return false; }
-    Util::BinStream bs;
-    bs.writeU32(kSaveMagic);
-    bs.writeU32(kSaveVersion);
-    bs.writeI32(_playerCamera->playerTilePosition.x);
-    bs.writeI32(_playerCamera->playerTilePosition.y);
-    const bool ok = bs.saveFile(kSavePath);
-    SDL_Log(ok ? "[Save] Saved game to %s" : "[Save] Failed to save game to %s", kSavePath);
-    return ok;
+    if (_saveJob) { SDL_Log("[Save] Save already in progress"); return false; }
+
+    auto snap = std::make_shared<SaveSnapshot>();
+    snap->playerTile = _playerCamera->playerTilePosition;
+    snap->mapSize = _map.mapSize();
+    snap->terrain = _map.terrainSnapshot();
+    snap->character = SnapshotCharacter(GetCurrentCharacter());
+
+    _saveStatus = "Saving...";
+    _saveStatusTime = 0.0f;
+    _saveJob = AsyncSave::submit(kSavePath,
+        [snap](Util::BinStream& out, const std::function<void(float)>& report) { return WriteSave(*snap, out, report); },
+        [this](AsyncSave::JobId, float fraction) {
+            _saveStatus = "Saving... " + std::to_string((int)(fraction * 100.0f)) + "%";
+        },
+        [this](AsyncSave::JobId, bool ok) {
+            _saveJob = 0;
+            _saveStatus = ok ? "Game saved" : "Save failed";
+            _saveStatusTime = kSaveStatusFrames;
+            SDL_Log(ok ? "[Save] Saved game to %s" : "[Save] Failed to save game to %s", kSavePath);
+        });
+    return true;
 }
 
 bool GSWorld::loadGame() {
-    Util::BinStream bs;
-    if (!bs.loadFile(kSavePath)) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Could not open %s", kSavePath); return false; }
+    // Never read a file the worker is about to replace
+    if (_saveJob) AsyncSave::flush();
+    Util::BinView bs;
+    if (!bs.mapFile(kSavePath)) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Could not open %s", kSavePath); return false; }
     std::uint32_t magic = 0, ver = 0;
     if (!bs.readU32(magic) || magic != kSaveMagic) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Bad magic in %s", kSavePath); return false; }
-    if (!bs.readU32(ver) || ver != kSaveVersion) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Bad version in %s", kSavePath); return false; }
+    if (!bs.readU32(ver) || ver < 1 || ver > kSaveVersion) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Bad version in %s", kSavePath); return false; }
     std::int32_t tx = 0, ty = 0;
     if (!bs.readI32(tx) || !bs.readI32(ty)) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Truncated file %s", kSavePath); return false; }
     if (!_playerCamera) { SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] No player camera"); return false; }
+    // Parse everything before applying anything, so a bad file changes nothing
+    Vector<int> terrain;
+    if (ver >= 2) {
+        std::int32_t mw = 0, mh = 0;
+        Vector<Util::Byte> raw;
+        if (!bs.readI32(mw) || !bs.readI32(mh) || !Util::Compress::readSection(bs, raw)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Bad terrain section in %s", kSavePath); return false;
+        }
+        terrain.resize(raw.size() / sizeof(int));
+        if (!raw.empty()) std::memcpy(terrain.data(), raw.data(), terrain.size() * sizeof(int));
+        if (mw != _map.mapSize().x || mh != _map.mapSize().y || terrain.size() != (size_t)mw * mh) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Terrain in %s does not match the map", kSavePath); return false;
+        }
+    }
+    CharacterSheet cs;
+    if (ver >= 3 && !readCharacterSheet(bs, cs)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Bad character sheet in %s", kSavePath); return false;
+    }
+    // restoreTerrain is the only step that can fail and changes nothing when it does
+    if (ver >= 2 && !_map.restoreTerrain(std::move(terrain))) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Load] Could not apply the terrain from %s", kSavePath); return false;
+    }
+    if (ver >= 3) SetCurrentCharacter(cs);
     _playerCamera->playerTilePosition = { (int)tx, (int)ty };
     _playerCamera->playerWorldPosition = _map.worldPosFromTileLoc(_playerCamera->playerTilePosition);
     SDL_Log("[Load] Loaded player tile (%d,%d) from %s", (int)tx, (int)ty, kSavePath);
@@ -12,7 +12,7 @@ namespace AvatarQuest {
 class GSWorld : public IGameState {
 public:
     GSWorld() = default;
-    ~GSWorld() override = default;
+    ~GSWorld() override;
 
     void onEnter() override;
     AQStateId handleEvents(float delta, Game::GameEvents& events) override;
@@ -25,22 +25,27 @@ private:
 
     WorldMap _map;
     Ref<PlayerCamera> _playerCamera;
+    TileLighting::LightHandle _torch;   // carried by the player
     SDL_Rect _window{};
 
     // Pause menu state
     bool _paused = false;
     Menu _pauseMenu;
-    Text::Font* _pauseFont = nullptr;
+    Text::FontHandle _pauseFont;
     UI::UIWindow _pauseWindow;
 
     // Quest text panel (animated word-by-word with wrapping)
     UI::UIWindow _questWindow;
     UI::UIAnimatedTextBox _questText;
-    Text::Font* _questFont = nullptr;
+    Text::FontHandle _questFont;
 
-    // Simple persistence for player position
+    // Persistence: saveGame() snapshots state and hands it to AsyncSave;
+    // progress/completion land in the status line of the pause window
     bool saveGame();
     bool loadGame();
+    AsyncSave::JobId _saveJob = 0;
+    String _saveStatus;
+    float _saveStatusTime = 0.0f; // frames left to show a finished status
 };
 
 }
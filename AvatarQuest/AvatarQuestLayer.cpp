@@ -48,15 +48,14 @@ void AvatarQuestLayer::setState(AQStateId id)
     };
 
     if (isMenuState(id)) {
-        // Lazy-load theme if needed
-        if (!_menuMusic) {
-            _menuMusic = Sound::loadMusic("assets/mp3/AvatarQuestTheme.mp3");
-        }
-        if (_menuMusic && !_menuMusicPlaying) {
-            // Loop indefinitely at current music volume with a short fade-in
-            if (Sound::playMusicFadeIn(_menuMusic, -1, 96, 400)) {
-                _menuMusicPlaying = true;
-            }
+        if (!_menuMusicPlaying) {
+            // Streamed and opened in the background; crossfades in over whatever played before
+            Sound::MusicPlaylistOptions opts;
+            opts.loop = true;
+            opts.volume = 96;
+            opts.switchFadeMs = 400;
+            Sound::playMusicPlaylist({ "assets/mp3/AvatarQuestTheme.mp3" }, opts);
+            _menuMusicPlaying = true;
         }
     } else {
         if (_menuMusicPlaying) {
@@ -76,6 +75,9 @@ void AvatarQuestLayer::init()
 {
 	Renderer::setClearColor({ 0, 0, 0, 255 }); // Black clear color
 
+    // Kick off font preloading so menus don't stall on first use
+    Fonts::init();
+
     // Load shared background image (used on all screens except World)
     Renderer::loadImageFromFile("assets/backgrounds/titleScreen.png", _bgImage);
 
@@ -86,12 +88,13 @@ void AvatarQuestLayer::init()
 void AvatarQuestLayer::render(float deltaTime)
 {
     // Draw background for all non-World states
-    if (_stateId != AQStateId::World && _bgImage && _bgImage->texture) {
+    const Renderer::Image* bg = Renderer::getImage(_bgImage);
+    if (_stateId != AQStateId::World && bg && bg->texture) {
         SDL_Rect ws = Window::getWindowSize();
         const float cx = (float)ws.x + (float)ws.w * 0.5f;
         const float cy = (float)ws.y + (float)ws.h * 0.5f;
-        const float iw = (_bgImage->imageRect.w > 0.0f ? _bgImage->imageRect.w : 1.0f);
-        const float ih = (_bgImage->imageRect.h > 0.0f ? _bgImage->imageRect.h : 1.0f);
+        const float iw = (bg->imageRect.w > 0.0f ? bg->imageRect.w : 1.0f);
+        const float ih = (bg->imageRect.h > 0.0f ? bg->imageRect.h : 1.0f);
         // Stretch to exactly fill the window (no letterboxing)
         const float sx = (float)ws.w / iw;
         const float sy = (float)ws.h / ih;
@@ -109,7 +112,6 @@ void AvatarQuestLayer::shutDown()
     Fonts::shutdown();
 #ifdef AVATARQUEST_ENABLE_AUDIO
     if (_menuMusicPlaying) { Sound::stopMusic(200); _menuMusicPlaying = false; }
-    if (_menuMusic) { Sound::unloadMusic(_menuMusic); _menuMusic = nullptr; }
 #endif
 }
 
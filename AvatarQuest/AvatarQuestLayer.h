@@ -31,11 +31,10 @@ private:
 	std::shared_ptr<AvatarQuest::IGameState> _state;
 
     // Shared background image for non-World screens
-    Ref<Renderer::Image> _bgImage;
+    Renderer::ImageHandle _bgImage;
 
 #ifdef AVATARQUEST_ENABLE_AUDIO
     // Menu background music (played on Title/MainMenu/CharCreation/Settings)
-    Sound::Music* _menuMusic = nullptr;
     bool _menuMusicPlaying = false;
 #endif
 
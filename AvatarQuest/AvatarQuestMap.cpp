@@ -27,6 +27,7 @@ void WorldMap::init(const TileVector& mapSize, const TileVector& tileSize)
 
 	TileMap::initMap(_mapSize, _tileSize, tileModels.data(), (int)tileModels.size(), _mapIndex);
 	TileMap::getMapTiles(_mapIndex, _tiles);
+	TileLighting::initLighting(_mapSize);
 }
 
 void WorldMap::buildGeneratedTerrain()
@@ -49,6 +50,31 @@ void WorldMap::buildGeneratedTerrain()
 	(void)dummy;
 	// Upload to engine TileMap
 	TileMap::setMapData(_mapIndex, dummy, tileMap);
+	TileLighting::setOccludersFromMap(tileMap, _tiles);
+	_terrain.reset(std::move(tileMap));
+}
+
+void WorldMap::setTile(const TileVector& tileLoc, int tileIndex)
+{
+	if (tileLoc.x < 0 || tileLoc.y < 0 || tileLoc.x >= _mapSize.x || tileLoc.y >= _mapSize.y) return;
+	Vector<int>& terrain = _terrain.edit();
+	if (terrain.size() != (size_t)_mapSize.x * _mapSize.y) return;
+	terrain[(size_t)tileLoc.y * _mapSize.x + tileLoc.x] = tileIndex;
+	TileVector loc = tileLoc;
+	TileMap::setMapIndex(_mapIndex, loc, tileIndex);
+	const bool blocking = tileIndex >= 0 && tileIndex < (int)_tiles.size() &&
+		_tiles[tileIndex]->isPropertySet(TileMap::TileProperties::Blocking);
+	TileLighting::setOccluder(tileLoc, blocking);
+}
+
+bool WorldMap::restoreTerrain(Vector<int> tiles)
+{
+	if (tiles.size() != (size_t)_mapSize.x * _mapSize.y) return false;
+	SDL_FRect dummy{};
+	if (!TileMap::setMapData(_mapIndex, dummy, tiles)) return false;
+	TileLighting::setOccludersFromMap(tiles, _tiles);
+	_terrain.reset(std::move(tiles));
+	return true;
 }
 
 void WorldMap::updateVisible(const SDL_FRect& windowSize, const PlayerCamera& camera)
@@ -58,7 +84,23 @@ void WorldMap::updateVisible(const SDL_FRect& windowSize, const PlayerCamera& ca
 
 void WorldMap::render()
 {
-	TileMap::renderTiles(_visibleTiles, _tiles);
+	// Only dirty light chunks in view are rebuilt; corner light becomes vertex colour
+	TileLighting::updateLighting(_visibleRegion);
+	TileLighting::buildCornerLight(_visibleRegion, _regionLight);
+	const int cols = _visibleRegion.w + 1;
+	_tileLight.resize(_visibleTiles.size() * 4);
+	for (size_t i = 0; i < _visibleCells.size(); ++i) {
+		const int lx = _visibleCells[i].x - _visibleRegion.x;
+		const int ly = _visibleCells[i].y - _visibleRegion.y;
+		const SDL_FColor* top = _regionLight.data() + (size_t)ly * cols + lx;
+		const SDL_FColor* bottom = top + cols;
+		SDL_FColor* out = _tileLight.data() + i * 4;
+		out[0] = top[0];
+		out[1] = top[1];
+		out[2] = bottom[1];
+		out[3] = bottom[0];
+	}
+	TileMap::renderTilesLit(_visibleTiles, _tiles, _tileLight);
 }
 
 TileVector WorldMap::tileLocFromWorldPos(const Vector2& worldPos) const
@@ -85,6 +127,8 @@ void WorldMap::buildVisibleTilesRect(const SDL_FRect& windowSize,
 {
 	outVisible.clear();
 	vMap.clear();
+	_visibleCells.clear();
+	_visibleRegion = {};
 
 	const float tw = (float)_tileSize.x;
 	const float th = (float)_tileSize.y;
@@ -107,6 +151,7 @@ void WorldMap::buildVisibleTilesRect(const SDL_FRect& windowSize,
 
 	if (tilesX > 0 && tilesY > 0) {
 		outVisible.reserve(tilesX * tilesY);
+		_visibleRegion = { startX, startY, tilesX, tilesY };
 	}
 
 	const float anchorX = camera.playerCenterScreen.x;
@@ -144,6 +189,7 @@ void WorldMap::buildVisibleTilesRect(const SDL_FRect& windowSize,
 
 			vMap[tv] = (int)outVisible.size();
 			outVisible.push_back(tt);
+			_visibleCells.push_back(tv);
 		}
 	}
 }
@@ -14,6 +14,7 @@ public:
     void buildGeneratedTerrain();
 
     void updateVisible(const SDL_FRect& windowSize, const PlayerCamera& camera);
+    // Tiles in one geometry batch per image, lit by TileLighting
     void render();
 
     // Helpers
@@ -24,6 +25,12 @@ public:
     const TileVector& mapSize() const { return _mapSize; }
     const TileVector& tileSize() const { return _tileSize; }
 
+    // Terrain indices (row-major). The snapshot is O(1) and stays unchanged while
+    // a background save reads it; setTile() copies the grid only if one is alive.
+    Ref<const Vector<int>> terrainSnapshot() const { return _terrain.share(); }
+    void setTile(const TileVector& tileLoc, int tileIndex);
+    bool restoreTerrain(Vector<int> tiles);
+
 private:
     void buildVisibleTilesRect(const SDL_FRect& windowSize,
                                const TileVector& playerTilePosition,
@@ -35,9 +42,14 @@ private:
     TileVector _tileSize{128,128};
     int _mapIndex = -1;
 
+    Cow<Vector<int>> _terrain;
     VectorRef<TileMap::Tile> _tiles;
     Vector<TileMap::TileTransform> _visibleTiles;
+    Vector<TileVector> _visibleCells;   // map cell of each visible tile
+    SDL_Rect _visibleRegion{};          // tile range the visible tiles come from
     UMap<TileVector, int> _visIndex;
+    Vector<SDL_FColor> _regionLight;    // corner light over _visibleRegion
+    Vector<SDL_FColor> _tileLight;      // 4 corner colours per visible tile
 };
 
 }
\ No newline at end of file
@@ -4,8 +4,8 @@ namespace AvatarQuest {
 
 #ifdef AVATARQUEST_ENABLE_AUDIO
 #include "Sound.h"
-static Sound::Sfx* GetUiBeep() {
-    static Sound::Sfx* s_beep = nullptr;
+static Sound::SfxHandle GetUiBeep() {
+    static Sound::SfxHandle s_beep;
     if (!s_beep) {
         // Try canonical path first, then a common typo fallback
         s_beep = Sound::loadSfx("assets/wav/menu-beep.wav");
@@ -14,7 +14,7 @@ static Sound::Sfx* GetUiBeep() {
     return s_beep;
 }
 static inline void PlayBeep() {
-    if (auto* s = GetUiBeep()) { Sound::playSfx(s, 0, -1, 96); }
+    if (auto s = GetUiBeep()) { Sound::playSfx(s, 0, -1, 96); }
 }
 #endif
 
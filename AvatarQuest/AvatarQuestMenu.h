@@ -13,7 +13,7 @@ struct MenuItem {
 
 class Menu {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
     void setItems(const Vector<MenuItem>& items) { _items = items; _selected = 0; }
 
     // Returns next state if an item is activated; otherwise AQStateId::None.
@@ -39,7 +39,7 @@ public:
     void clearActivation() { _lastActivatedIndex = -1; }
 
 private:
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     Vector<MenuItem> _items;
     int _selected = 0;
     int _pressedIndex = -1;
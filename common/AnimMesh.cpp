@@ -0,0 +1,265 @@
+#include "Common.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define AQ_MESH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define AQ_MESH_NEON 1
+#include <arm_neon.h>
+#endif
+
+using namespace Renderer;
+
+namespace {
+    constexpr float kDegToRad = 0.01745329251994329577f;
+    constexpr float kMinLineLength = 0.0001f;
+
+    void Rot(float deg, float out[4])
+    {
+        const float s = std::sin(deg * kDegToRad), c = std::cos(deg * kDegToRad);
+        out[0] = c; out[1] = -s;
+        out[2] = s; out[3] = c;
+    }
+
+    void Mul(const float a[4], const float b[4], float out[4])
+    {
+        const float r0 = a[0] * b[0] + a[1] * b[2];
+        const float r1 = a[0] * b[1] + a[1] * b[3];
+        const float r2 = a[2] * b[0] + a[3] * b[2];
+        const float r3 = a[2] * b[1] + a[3] * b[3];
+        out[0] = r0; out[1] = r1; out[2] = r2; out[3] = r3;
+    }
+
+    SDL_FColor ToFColor(const Color& c)
+    {
+        return SDL_FColor{ c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f };
+    }
+
+    // Rigid vertex indices are stored as -(k + 1) until the shaped count is known
+    struct MeshBuilder {
+        AnimFrameMesh& mesh;
+        Vector<SDL_FColor> shapedColors;
+        Vector<SDL_FColor> rigidColors;
+
+        // Same quad as Renderer::drawThickLine; the width is applied after transforming
+        void line(const Vector2& s, const Vector2& e, const Vector2& pivot, float thickness, const SDL_FColor& color)
+        {
+            float dx = e.x - s.x, dy = e.y - s.y;
+            const float len = std::sqrt(dx * dx + dy * dy);
+            if (len <= kMinLineLength) return;
+            dx /= len; dy /= len;
+
+            const int base = (int)mesh.offsetX.size();
+            const Vector2 ends[4] = { s, e, e, s };
+            const float side[4] = { 1.0f, 1.0f, -1.0f, -1.0f };
+            for (int k = 0; k < 4; ++k) {
+                mesh.offsetX.push_back(ends[k].x - pivot.x);
+                mesh.offsetY.push_back(ends[k].y - pivot.y);
+                mesh.pivotX.push_back(pivot.x);
+                mesh.pivotY.push_back(pivot.y);
+                mesh.dirX.push_back(dx);
+                mesh.dirY.push_back(dy);
+                mesh.half.push_back(thickness * 0.5f * side[k]);
+                shapedColors.push_back(color);
+            }
+            for (int i : { 0, 1, 2, 2, 3, 0 }) mesh.indices.push_back(base + i);
+        }
+
+        void filledRect(const Vector2& p, const Vector2& size, const SDL_FColor& color)
+        {
+            const int base = (int)mesh.rigidX.size();
+            const Vector2 corners[4] = { p, { p.x + size.x, p.y }, { p.x + size.x, p.y + size.y }, { p.x, p.y + size.y } };
+            for (const Vector2& c : corners) {
+                mesh.rigidX.push_back(c.x);
+                mesh.rigidY.push_back(c.y);
+                rigidColors.push_back(color);
+            }
+            for (int i : { 0, 1, 2, 2, 3, 0 }) mesh.indices.push_back(-(base + i + 1));
+        }
+
+        void primitive(const AnimPrimitive& p)
+        {
+            const Vector2 P = p.aabb.getPosition();
+            const Vector2 S = p.aabb.getSize();
+            const SDL_FColor color = ToFColor(p.color);
+
+            if (p.type == AnimPrimitiveType::Line) {
+                line(P, { P.x + S.x, P.y + S.y }, p.center, p.thickness, color);
+            }
+            else if (p.type == AnimPrimitiveType::RectFilled) {
+                filledRect(P, S, color);
+            }
+            else {
+                const Vector2 a{ P.x, P.y }, b{ P.x + S.x, P.y }, c{ P.x + S.x, P.y + S.y }, d{ P.x, P.y + S.y };
+                const float th = (p.thickness > 0.f) ? p.thickness : 1.0f;
+                line(a, b, p.center, th, color);
+                line(b, c, p.center, th, color);
+                line(c, d, p.center, th, color);
+                line(d, a, p.center, th, color);
+            }
+        }
+
+        void finish()
+        {
+            const int shaped = (int)mesh.offsetX.size();
+            for (int& i : mesh.indices) {
+                if (i < 0) i = shaped + (-i - 1);
+            }
+            mesh.vertices.resize(shapedColors.size() + rigidColors.size());
+            std::size_t v = 0;
+            for (const SDL_FColor& c : shapedColors) mesh.vertices[v++] = SDL_Vertex{ { 0.0f, 0.0f }, c, { 0.0f, 0.0f } };
+            for (const SDL_FColor& c : rigidColors) mesh.vertices[v++] = SDL_Vertex{ { 0.0f, 0.0f }, c, { 0.0f, 0.0f } };
+        }
+    };
+
+    inline void TransformShaped(const AnimFrameMesh& mesh, const AnimMeshXform& x, SDL_Vertex* out, uint32_t begin, uint32_t end)
+    {
+        for (uint32_t i = begin; i < end; ++i) {
+            const float ox = mesh.offsetX[i], oy = mesh.offsetY[i];
+            const float cx = mesh.pivotX[i], cy = mesh.pivotY[i];
+            const float dx = x.m[0] * mesh.dirX[i] + x.m[1] * mesh.dirY[i];
+            const float dy = x.m[2] * mesh.dirX[i] + x.m[3] * mesh.dirY[i];
+            const float len2 = dx * dx + dy * dy;
+            const float k = len2 > kMinLineLength * kMinLineLength ? mesh.half[i] / std::sqrt(len2) : 0.0f;
+            out[i].position.x = x.m[0] * ox + x.m[1] * oy + x.w[0] * cx + x.w[1] * cy - dy * k + x.tx;
+            out[i].position.y = x.m[2] * ox + x.m[3] * oy + x.w[2] * cx + x.w[3] * cy + dx * k + x.ty;
+        }
+    }
+
+    inline void TransformRigid(const AnimFrameMesh& mesh, const AnimMeshXform& x, SDL_Vertex* out)
+    {
+        const uint32_t n = mesh.rigidCount();
+        for (uint32_t i = 0; i < n; ++i) {
+            out[i].position.x = mesh.rigidX[i] + x.tx;
+            out[i].position.y = mesh.rigidY[i] + x.ty;
+        }
+    }
+}
+
+AnimMeshXform Renderer::makeAnimMeshXform(const Vector2& tPos, const Vector2& tScl, float tRot,
+                                          const Vector2& worldPos, const Vector2& worldScale, float worldRotDeg)
+{
+    AnimMeshXform x{};
+    const float totalRot = worldRotDeg + tRot;
+
+    // W = Rot(totalRot) * Scale(worldScale * tScl), the old applyAll
+    float rotW[4];
+    Rot(totalRot, rotW);
+    const float sclW[4] = { worldScale.x * tScl.x, 0.0f, 0.0f, worldScale.y * tScl.y };
+    Mul(rotW, sclW, x.w);
+
+    // Frame-level scale/rotate about each primitive's pivot, then W
+    float rotF[4];
+    Rot(tRot, rotF);
+    const float sclF[4] = { tScl.x, 0.0f, 0.0f, tScl.y };
+    float local[4];
+    Mul(rotF, sclF, local);
+    Mul(x.w, local, x.m);
+
+    x.tx = worldPos.x + tPos.x;
+    x.ty = worldPos.y + tPos.y;
+    return x;
+}
+
+void Renderer::bakeAnimFrameMesh(const AnimPrimitive* prims, std::size_t count, AnimFrameMesh& out)
+{
+    out = AnimFrameMesh{};
+    out.primCount = (uint32_t)count;
+    MeshBuilder b{ out, {}, {} };
+    for (std::size_t i = 0; i < count; ++i) b.primitive(prims[i]);
+    b.finish();
+}
+
+void Renderer::bakeAnimFrameMesh(const Vector<AnimPrimitiveRef>& prims, AnimFrameMesh& out)
+{
+    out = AnimFrameMesh{};
+    out.primCount = (uint32_t)prims.size();
+    MeshBuilder b{ out, {}, {} };
+    for (const AnimPrimitiveRef& p : prims) {
+        if (p) b.primitive(*p);
+    }
+    b.finish();
+}
+
+void Renderer::bakeAnimationFrame(AnimationFrame& frame)
+{
+    Ref<AnimFrameMesh> mesh = CreateRef<AnimFrameMesh>();
+    bakeAnimFrameMesh(frame.primitives, *mesh);
+    frame.mesh = std::move(mesh);
+}
+
+void Renderer::bakeAnimationBank(AnimationBank& bank)
+{
+    for (const AnimationFrameRef& f : bank.frames) {
+        if (f) bakeAnimationFrame(*f);
+    }
+}
+
+void Renderer::transformAnimFrameMeshScalar(const AnimFrameMesh& mesh, const AnimMeshXform& x, SDL_Vertex* out)
+{
+    TransformShaped(mesh, x, out, 0, mesh.shapedCount());
+    TransformRigid(mesh, x, out + mesh.shapedCount());
+}
+
+void Renderer::transformAnimFrameMesh(const AnimFrameMesh& mesh, const AnimMeshXform& x, SDL_Vertex* out)
+{
+    const uint32_t n = mesh.shapedCount();
+    uint32_t i = 0;
+#if defined(AQ_MESH_SSE2)
+    const __m128 m0 = _mm_set1_ps(x.m[0]), m1 = _mm_set1_ps(x.m[1]), m2 = _mm_set1_ps(x.m[2]), m3 = _mm_set1_ps(x.m[3]);
+    const __m128 w0 = _mm_set1_ps(x.w[0]), w1 = _mm_set1_ps(x.w[1]), w2 = _mm_set1_ps(x.w[2]), w3 = _mm_set1_ps(x.w[3]);
+    const __m128 tx = _mm_set1_ps(x.tx), ty = _mm_set1_ps(x.ty);
+    const __m128 minLen2 = _mm_set1_ps(kMinLineLength * kMinLineLength);
+    for (; i + 4 <= n; i += 4) {
+        const __m128 ox = _mm_loadu_ps(&mesh.offsetX[i]), oy = _mm_loadu_ps(&mesh.offsetY[i]);
+        const __m128 cx = _mm_loadu_ps(&mesh.pivotX[i]), cy = _mm_loadu_ps(&mesh.pivotY[i]);
+        const __m128 ux = _mm_loadu_ps(&mesh.dirX[i]), uy = _mm_loadu_ps(&mesh.dirY[i]);
+        const __m128 dx = _mm_add_ps(_mm_mul_ps(m0, ux), _mm_mul_ps(m1, uy));
+        const __m128 dy = _mm_add_ps(_mm_mul_ps(m2, ux), _mm_mul_ps(m3, uy));
+        const __m128 len2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        // Lanes below the minimum length divide by ~0; the mask zeroes them
+        const __m128 k = _mm_and_ps(_mm_cmpgt_ps(len2, minLen2), _mm_div_ps(_mm_loadu_ps(&mesh.half[i]), _mm_sqrt_ps(len2)));
+        __m128 px = _mm_add_ps(tx, _mm_add_ps(_mm_mul_ps(m0, ox), _mm_mul_ps(m1, oy)));
+        px = _mm_add_ps(px, _mm_add_ps(_mm_mul_ps(w0, cx), _mm_mul_ps(w1, cy)));
+        px = _mm_sub_ps(px, _mm_mul_ps(dy, k));
+        __m128 py = _mm_add_ps(ty, _mm_add_ps(_mm_mul_ps(m2, ox), _mm_mul_ps(m3, oy)));
+        py = _mm_add_ps(py, _mm_add_ps(_mm_mul_ps(w2, cx), _mm_mul_ps(w3, cy)));
+        py = _mm_add_ps(py, _mm_mul_ps(dx, k));
+        // SDL_Vertex is interleaved: zip x/y and store one position pair per vertex
+        const __m128 lo = _mm_unpacklo_ps(px, py);
+        const __m128 hi = _mm_unpackhi_ps(px, py);
+        _mm_storel_pi(reinterpret_cast<__m64*>(&out[i].position), lo);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(&out[i + 1].position), lo);
+        _mm_storel_pi(reinterpret_cast<__m64*>(&out[i + 2].position), hi);
+        _mm_storeh_pi(reinterpret_cast<__m64*>(&out[i + 3].position), hi);
+    }
+#elif defined(AQ_MESH_NEON)
+    const float32x4_t tx = vdupq_n_f32(x.tx), ty = vdupq_n_f32(x.ty);
+    const float32x4_t minLen2 = vdupq_n_f32(kMinLineLength * kMinLineLength);
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t ox = vld1q_f32(&mesh.offsetX[i]), oy = vld1q_f32(&mesh.offsetY[i]);
+        const float32x4_t cx = vld1q_f32(&mesh.pivotX[i]), cy = vld1q_f32(&mesh.pivotY[i]);
+        const float32x4_t ux = vld1q_f32(&mesh.dirX[i]), uy = vld1q_f32(&mesh.dirY[i]);
+        const float32x4_t dx = vmlaq_n_f32(vmulq_n_f32(ux, x.m[0]), uy, x.m[1]);
+        const float32x4_t dy = vmlaq_n_f32(vmulq_n_f32(ux, x.m[2]), uy, x.m[3]);
+        const float32x4_t len2 = vmlaq_f32(vmulq_f32(dx, dx), dy, dy);
+        const float32x4_t kRaw = vdivq_f32(vld1q_f32(&mesh.half[i]), vsqrtq_f32(len2));
+        const float32x4_t k = vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(len2, minLen2), vreinterpretq_u32_f32(kRaw)));
+        float32x4_t px = vmlaq_n_f32(vmlaq_n_f32(tx, ox, x.m[0]), oy, x.m[1]);
+        px = vmlaq_n_f32(vmlaq_n_f32(px, cx, x.w[0]), cy, x.w[1]);
+        px = vmlsq_f32(px, dy, k);
+        float32x4_t py = vmlaq_n_f32(vmlaq_n_f32(ty, ox, x.m[2]), oy, x.m[3]);
+        py = vmlaq_n_f32(vmlaq_n_f32(py, cx, x.w[2]), cy, x.w[3]);
+        py = vmlaq_f32(py, dx, k);
+        const float32x4x2_t xy = vzipq_f32(px, py);
+        vst1_f32(&out[i].position.x, vget_low_f32(xy.val[0]));
+        vst1_f32(&out[i + 1].position.x, vget_high_f32(xy.val[0]));
+        vst1_f32(&out[i + 2].position.x, vget_low_f32(xy.val[1]));
+        vst1_f32(&out[i + 3].position.x, vget_high_f32(xy.val[1]));
+    }
+#endif
+    TransformShaped(mesh, x, out, i, n);
+    TransformRigid(mesh, x, out + n);
+}
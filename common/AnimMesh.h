@@ -0,0 +1,58 @@
+#pragma once
+
+// Pre-tessellated animation frames.
+// bakeAnimFrameMesh turns a frame's primitives into one triangle mesh once, at
+// load time. Drawing a frame then means one affine transform over the vertex
+// streams (SIMD) and one SDL_RenderGeometry call, instead of recomputing
+// scaleAround/rotateAround per corner and issuing a draw per edge.
+//
+// Lines and rect outlines are "shaped" vertices. They keep the offset from their
+// primitive's pivot, the pivot itself, and the line's local direction plus a
+// signed half-thickness as separate streams. The per-primitive pivot
+// scale/rotate of the old path is preserved exactly, and the edge is rebuilt
+// perpendicular to the transformed segment, so lines stay the same width on
+// screen under any scale, including flips. Filled rects are only translated (as
+// before) and live in a second, "rigid" range.
+namespace Renderer {
+
+    struct AnimFrameMesh {
+        // Shaped: d = M * dir, pos = M * offset + W * pivot + perp(d) * half / |d| + T
+        // with perp(x, y) = (-y, x); a segment M collapses to a point gets no width
+        Vector<float> offsetX, offsetY;
+        Vector<float> pivotX, pivotY;
+        Vector<float> dirX, dirY;       // unit segment direction, local space
+        Vector<float> half;             // +/- half thickness for the two sides
+        // Rigid: pos = rigid + T
+        Vector<float> rigidX, rigidY;
+        // Shaped vertices first, then rigid. Colours are baked, positions are
+        // written by transformAnimFrameMesh.
+        Vector<SDL_Vertex> vertices;
+        Vector<int> indices;
+        uint32_t primCount = 0;     // source primitive count, to spot stale meshes
+
+        uint32_t shapedCount() const { return (uint32_t)offsetX.size(); }
+        uint32_t rigidCount() const { return (uint32_t)rigidX.size(); }
+    };
+
+    // 2x2 matrices are row-major {m00, m01, m10, m11}
+    struct AnimMeshXform {
+        float m[4];     // world * frame scale/rotate (applied to offsets and directions)
+        float w[4];     // world scale/rotate (applied to pivots)
+        float tx, ty;
+    };
+
+    // Frame lerp values (tPos/tScl/tRot) combined with the world placement
+    AnimMeshXform makeAnimMeshXform(const Vector2& tPos, const Vector2& tScl, float tRot,
+                                    const Vector2& worldPos, const Vector2& worldScale, float worldRotDeg);
+
+    void bakeAnimFrameMesh(const AnimPrimitive* prims, std::size_t count, AnimFrameMesh& out);
+    void bakeAnimFrameMesh(const Vector<AnimPrimitiveRef>& prims, AnimFrameMesh& out);
+    // (Re)bake frame->mesh; call again after editing a frame's primitives
+    void bakeAnimationFrame(AnimationFrame& frame);
+    void bakeAnimationBank(AnimationBank& bank);
+
+    // Write mesh vertex positions into out[0 .. shapedCount + rigidCount).
+    // SSE2 on x86-64, NEON on AArch64, scalar elsewhere.
+    void transformAnimFrameMesh(const AnimFrameMesh& mesh, const AnimMeshXform& x, SDL_Vertex* out);
+    void transformAnimFrameMeshScalar(const AnimFrameMesh& mesh, const AnimMeshXform& x, SDL_Vertex* out);
+}
@@ -0,0 +1,245 @@
+#include "Common.h"
+
+#include <memory>
+
+using namespace Renderer;
+
+namespace {
+    // Copy records in place when the view is aligned (mapped files are), else copy out
+    template<class T>
+    bool ReadRecords(Util::BinView& r, std::uint32_t count, std::span<const T>& out, Vector<T>& fallback)
+    {
+        if (r.readSpan(count, out)) return true;
+        if constexpr (std::endian::native != std::endian::little) return false;
+        if (count > r.remaining() / sizeof(T)) return false;
+        fallback.resize(count);
+        r.readBytes(fallback.data(), fallback.size() * sizeof(T));
+        out = fallback;
+        return true;
+    }
+
+    struct StringTable {
+        std::string_view bytes;
+        bool get(std::uint32_t offset, std::string_view& out) const
+        {
+            if (offset >= bytes.size()) return false;
+            const std::size_t end = bytes.find('\0', offset);
+            if (end == std::string_view::npos) return false;
+            out = bytes.substr(offset, end - offset);
+            return true;
+        }
+    };
+
+    struct StringTableWriter {
+        Vector<Util::Byte> bytes;
+        UMap<String, std::uint32_t> offsets;
+        std::uint32_t add(const String& s)
+        {
+            auto it = offsets.find(s);
+            if (it != offsets.end()) return it->second;
+            const std::uint32_t off = (std::uint32_t)bytes.size();
+            bytes.insert(bytes.end(), s.begin(), s.end());
+            bytes.push_back(0);
+            offsets.emplace(s, off);
+            return off;
+        }
+    };
+
+    void Put(float (&dst)[2], const Vector2& v) { dst[0] = v.x; dst[1] = v.y; }
+    Vector2 Get(const float (&src)[2]) { return { src[0], src[1] }; }
+}
+
+namespace Util {
+
+    void WriteAnimPack(Util::BinStream& w, const Vector<AnimationBankRef>& banks)
+    {
+        Vector<AnimPackBank> bankRecs;
+        Vector<AnimPackFrame> frameRecs;
+        Vector<AnimPackPrim> primRecs;
+        StringTableWriter strings;
+        strings.add("");
+
+        bankRecs.reserve(banks.size());
+        for (const AnimationBankRef& bank : banks) {
+            if (!bank) continue;
+            AnimPackBank b{};
+            b.nameOffset = strings.add(bank->name);
+            b.flags = (std::uint32_t)bank->flags;
+            b.firstFrame = (std::uint32_t)frameRecs.size();
+            b.currentFrame = bank->currentFrame;
+            b.currentTime = bank->currentTime;
+            for (const AnimationFrameRef& frame : bank->frames) {
+                if (!frame) continue;
+                AnimPackFrame f{};
+                f.nameOffset = strings.add(frame->name);
+                f.duration = frame->duration;
+                Put(f.positionStart, frame->positionStart);
+                Put(f.positionEnd, frame->positionEnd);
+                Put(f.rotationStartEnd, frame->rotationStartEnd);
+                Put(f.scaleStart, frame->scaleStart);
+                Put(f.scaleEnd, frame->scaleEnd);
+                f.flags = (std::uint32_t)frame->flags;
+                f.firstPrim = (std::uint32_t)primRecs.size();
+                for (const AnimPrimitiveRef& prim : frame->primitives) {
+                    if (!prim) continue;
+                    AnimPackPrim p{};
+                    p.type = (std::uint32_t)prim->type;
+                    p.aabb[0] = prim->aabb.position.x;
+                    p.aabb[1] = prim->aabb.position.y;
+                    p.aabb[2] = prim->aabb.size.x;
+                    p.aabb[3] = prim->aabb.size.y;
+                    Put(p.center, prim->center);
+                    p.color[0] = prim->color.r;
+                    p.color[1] = prim->color.g;
+                    p.color[2] = prim->color.b;
+                    p.color[3] = prim->color.a;
+                    p.thickness = prim->thickness;
+                    p.layer = prim->layer;
+                    primRecs.push_back(p);
+                }
+                f.primCount = (std::uint32_t)primRecs.size() - f.firstPrim;
+                frameRecs.push_back(f);
+            }
+            b.frameCount = (std::uint32_t)frameRecs.size() - b.firstFrame;
+            bankRecs.push_back(b);
+        }
+        while (strings.bytes.size() % 4) strings.bytes.push_back(0);
+
+        AnimPackHeader h{};
+        h.magic = kAnimPackMagic;
+        h.version = kAnimPackVersion;
+        h.headerSize = sizeof(AnimPackHeader);
+        h.bankCount = (std::uint32_t)bankRecs.size();
+        h.frameCount = (std::uint32_t)frameRecs.size();
+        h.primCount = (std::uint32_t)primRecs.size();
+        h.stringBytes = (std::uint32_t)strings.bytes.size();
+
+        // Records are written as raw little-endian structs (the only layout the
+        // engine targets); the static_asserts in AnimPack.h pin their size
+        w.reserve(w.size() + sizeof(h) + bankRecs.size() * sizeof(AnimPackBank)
+            + frameRecs.size() * sizeof(AnimPackFrame) + primRecs.size() * sizeof(AnimPackPrim) + strings.bytes.size());
+        w.writeBytes(&h, sizeof(h));
+        w.writeBytes(bankRecs.data(), bankRecs.size() * sizeof(AnimPackBank));
+        w.writeBytes(frameRecs.data(), frameRecs.size() * sizeof(AnimPackFrame));
+        w.writeBytes(primRecs.data(), primRecs.size() * sizeof(AnimPackPrim));
+        w.writeBytes(strings.bytes.data(), strings.bytes.size());
+    }
+
+    bool ReadAnimPack(Util::BinView& r, Vector<AnimationBankRef>& out)
+    {
+        const std::size_t start = r.tell();
+        AnimPackHeader h{};
+        if (!r.readBytes(&h, sizeof(h)) || h.magic != kAnimPackMagic || h.version != kAnimPackVersion
+            || h.headerSize < sizeof(h) || !r.skip(h.headerSize - sizeof(h))) {
+            r.seek(start);
+            return false;
+        }
+
+        std::span<const AnimPackBank> banks;
+        std::span<const AnimPackFrame> frames;
+        std::span<const AnimPackPrim> prims;
+        Vector<AnimPackBank> bankCopy;
+        Vector<AnimPackFrame> frameCopy;
+        Vector<AnimPackPrim> primCopy;
+        BinView stringView;
+        if (!ReadRecords(r, h.bankCount, banks, bankCopy) || !ReadRecords(r, h.frameCount, frames, frameCopy)
+            || !ReadRecords(r, h.primCount, prims, primCopy) || !r.readView(h.stringBytes, stringView)) {
+            r.seek(start);
+            return false;
+        }
+        const StringTable strings{ { reinterpret_cast<const char*>(stringView.bytes().data()), stringView.size() } };
+
+        Vector<AnimationBankRef> loaded;
+        loaded.reserve(banks.size());
+        for (const AnimPackBank& b : banks) {
+            // Validate the bank's frame run and the primitive runs it spans before building anything
+            std::string_view name;
+            if (b.firstFrame > frames.size() || b.frameCount > frames.size() - b.firstFrame || !strings.get(b.nameOffset, name)) {
+                r.seek(start);
+                return false;
+            }
+            const std::span<const AnimPackFrame> bankFrames = frames.subspan(b.firstFrame, b.frameCount);
+            std::uint32_t primBase = bankFrames.empty() ? 0 : bankFrames.front().firstPrim;
+            std::uint32_t primEnd = primBase;
+            for (const AnimPackFrame& f : bankFrames) {
+                std::string_view frameName;
+                if (f.firstPrim > prims.size() || f.primCount > prims.size() - f.firstPrim || !strings.get(f.nameOffset, frameName)) {
+                    r.seek(start);
+                    return false;
+                }
+                primBase = std::min(primBase, f.firstPrim);
+                primEnd = std::max(primEnd, f.firstPrim + f.primCount);
+            }
+
+            // Frames and primitives each live in one array. Every frame/primitive Ref
+            // shares ownership of its array, so copies of a frame outlive the bank.
+            // They are separate arrays because a frame's primitive Refs would
+            // otherwise own the block that holds the frame itself and it would never
+            // be freed.
+            const Ref<AnimPrimitive[]> primBlock = std::make_shared<AnimPrimitive[]>(primEnd - primBase);
+            const Ref<AnimationFrame[]> frameBlock = std::make_shared<AnimationFrame[]>(b.frameCount);
+            AnimationBankRef bankRef = CreateRef<AnimationBank>();
+            AnimationBank& bank = *bankRef;
+            bank.name = String(name);
+            bank.flags = (AnimBankFlags)b.flags;
+            bank.currentFrame = b.frameCount ? std::min(b.currentFrame, b.frameCount - 1) : 0;
+            bank.currentTime = b.currentTime;
+            bank.frames.reserve(b.frameCount);
+
+            for (std::uint32_t i = primBase; i < primEnd; ++i) {
+                const AnimPackPrim& src = prims[i];
+                AnimPrimitive& p = primBlock[i - primBase];
+                p.type = (AnimPrimitiveType)src.type;
+                p.aabb = AABB({ src.aabb[0], src.aabb[1] }, { src.aabb[2], src.aabb[3] });
+                p.center = Get(src.center);
+                p.color = Color{ src.color[0], src.color[1], src.color[2], src.color[3] };
+                p.thickness = src.thickness;
+                p.layer = src.layer;
+            }
+
+            for (std::uint32_t i = 0; i < b.frameCount; ++i) {
+                const AnimPackFrame& src = bankFrames[i];
+                AnimationFrame& f = frameBlock[i];
+                std::string_view frameName;
+                strings.get(src.nameOffset, frameName);
+                f.name = String(frameName);
+                f.duration = src.duration;
+                f.positionStart = Get(src.positionStart);
+                f.positionEnd = Get(src.positionEnd);
+                f.rotationStartEnd = Get(src.rotationStartEnd);
+                f.scaleStart = Get(src.scaleStart);
+                f.scaleEnd = Get(src.scaleEnd);
+                f.flags = (AnimFrameFlags)src.flags;
+                f.primitives.reserve(src.primCount);
+                for (std::uint32_t k = 0; k < src.primCount; ++k) {
+                    f.primitives.push_back(AnimPrimitiveRef(primBlock, &primBlock[src.firstPrim - primBase + k]));
+                }
+                bakeAnimationFrame(f);
+                bank.frames.push_back(AnimationFrameRef(frameBlock, &f));
+            }
+            loaded.push_back(std::move(bankRef));
+        }
+
+        out.insert(out.end(), std::make_move_iterator(loaded.begin()), std::make_move_iterator(loaded.end()));
+        return true;
+    }
+
+    bool LoadAnimPack(const char* path, Vector<AnimationBankRef>& out)
+    {
+        const uint64_t t0 = SDL_GetPerformanceCounter();
+        BinView view;
+        if (!view.mapFile(path)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimPack] Could not open %s", path);
+            return false;
+        }
+        const std::size_t before = out.size();
+        if (!ReadAnimPack(view, out)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimPack] Malformed pack %s", path);
+            return false;
+        }
+        const double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+        SDL_Log("[AnimPack] Loaded %d banks from %s in %.2f ms", (int)(out.size() - before), path, ms);
+        return true;
+    }
+
+}
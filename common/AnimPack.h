@@ -0,0 +1,73 @@
+#pragma once
+
+// Animation packs: many AnimationBanks in one file, loaded in a single pass.
+//
+//   [AnimPackHeader]
+//   [AnimPackBank  x bankCount ]  banks, each a run of frames
+//   [AnimPackFrame x frameCount]  frames, each a run of primitives
+//   [AnimPackPrim  x primCount ]
+//   [string table: NUL-terminated names, referenced by byte offset]
+//
+// Every record is fixed size and 4-byte aligned, so a mapped pack is read in
+// place with no per-record parsing. A loaded bank keeps its frames in one array
+// and its primitives in another rather than one allocation each. Frame and
+// primitive Refs share ownership of their array, so a copied bank or frame list
+// stays valid after the original bank is released.
+namespace Util {
+
+    constexpr std::uint32_t kAnimPackMagic = 0x50415141; // 'AQAP'
+    constexpr std::uint16_t kAnimPackVersion = 1;
+
+    struct AnimPackHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t headerSize;   // sizeof(AnimPackHeader); lets later versions grow it
+        std::uint32_t bankCount;
+        std::uint32_t frameCount;
+        std::uint32_t primCount;
+        std::uint32_t stringBytes;
+        std::uint32_t reserved[2];
+    };
+
+    struct AnimPackBank {
+        std::uint32_t nameOffset;
+        std::uint32_t flags;        // AnimBankFlags
+        std::uint32_t firstFrame;
+        std::uint32_t frameCount;
+        std::uint32_t currentFrame;
+        float currentTime;
+    };
+
+    struct AnimPackFrame {
+        std::uint32_t nameOffset;
+        float duration;
+        float positionStart[2];
+        float positionEnd[2];
+        float rotationStartEnd[2];
+        float scaleStart[2];
+        float scaleEnd[2];
+        std::uint32_t flags;        // AnimFrameFlags
+        std::uint32_t firstPrim;
+        std::uint32_t primCount;
+    };
+
+    struct AnimPackPrim {
+        std::uint32_t type;         // AnimPrimitiveType
+        float aabb[4];              // x, y, w, h
+        float center[2];
+        std::uint8_t color[4];
+        float thickness;
+        std::int32_t layer;
+    };
+
+    static_assert(sizeof(AnimPackHeader) == 32 && sizeof(AnimPackBank) == 24
+        && sizeof(AnimPackFrame) == 60 && sizeof(AnimPackPrim) == 40, "AnimPack records are part of the file format");
+
+    // Tool side: write banks as one pack (see ConvertBanksToPack for bank files)
+    void WriteAnimPack(Util::BinStream& w, const Vector<Renderer::AnimationBankRef>& banks);
+
+    // Runtime: build every bank in the pack (appended to `out`). Fails without
+    // touching `out` on a malformed pack.
+    bool ReadAnimPack(Util::BinView& r, Vector<Renderer::AnimationBankRef>& out);
+    bool LoadAnimPack(const char* path, Vector<Renderer::AnimationBankRef>& out);
+}
@@ -139,6 +139,7 @@ namespace Util {
 
             AnimationFrameRef ref =
                 makeFrameRef ? makeFrameRef(temp) : CreateRef<AnimationFrame>(temp);
+            if (ref) bakeAnimationFrame(*ref);
             frames.push_back(ref);
         }
 
@@ -165,4 +166,28 @@ namespace Util {
         return (outRef != nullptr);
     }
 
+    bool ConvertBanksToPack(const Vector<String>& bankFiles, const char* packPath)
+    {
+        Vector<AnimationBankRef> banks;
+        banks.reserve(bankFiles.size());
+        const auto makePrim = [](const AnimPrimitive& p) { return CreateRef<AnimPrimitive>(p); };
+        for (const String& file : bankFiles) {
+            Util::BinStream r;
+            AnimationBank bank{};
+            if (!r.loadFile(file.c_str()) || !ReadBank(r, bank, makePrim)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimPack] Could not read bank %s", file.c_str());
+                return false;
+            }
+            banks.push_back(CreateRef<AnimationBank>(std::move(bank)));
+        }
+        Util::BinStream w;
+        WriteAnimPack(w, banks);
+        if (!w.saveFile(packPath)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimPack] Could not write %s", packPath);
+            return false;
+        }
+        SDL_Log("[AnimPack] Wrote %d banks to %s (%zu bytes)", (int)banks.size(), packPath, w.size());
+        return true;
+    }
+
 }
\ No newline at end of file
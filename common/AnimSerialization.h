@@ -28,4 +28,8 @@ namespace Util {
         const std::function<Renderer::AnimationFrameRef(const Renderer::AnimationFrame&)>& makeFrameRef = {}
     );
 
+    // Tool side: convert bank files written by WriteBank into one animation pack
+    // (AnimPack.h), so the game loads them all in one pass
+    bool ConvertBanksToPack(const Vector<String>& bankFiles, const char* packPath);
+
 }
\ No newline at end of file
@@ -27,16 +27,6 @@ static inline float lerpf(float a, float b, float t) { return a + (b - a) * t; }
 static inline Vector2 vlerp(const Vector2& a, const Vector2& b, float t) {
 	return { lerpf(a.x,b.x,t), lerpf(a.y,b.y,t) };
 }
-static inline Vector2 rotateAround(const Vector2& p, const Vector2& pivot, float deg) {
-	const float r = deg * 0.01745329251994329577f;
-	const float s = std::sin(r), c = std::cos(r);
-	const float x = p.x - pivot.x, y = p.y - pivot.y;
-	return { pivot.x + x * c - y * s, pivot.y + x * s + y * c };
-}
-static inline Vector2 scaleAround(const Vector2& p, const Vector2& pivot, const Vector2& s) {
-	return { pivot.x + (p.x - pivot.x) * s.x,
-			 pivot.y + (p.y - pivot.y) * s.y };
-}
 
 inline void SetFlag(Renderer::AnimBankFlags& m, Renderer::AnimBankFlags f) { m |= f; }
 inline void ClearFlag(Renderer::AnimBankFlags& m, Renderer::AnimBankFlags f) { m &= ~f; }
@@ -98,6 +88,7 @@ Renderer::AnimationFrameRef Renderer::createAnimationFrame(const String& name, A
 		});
 
 	frame->primitives = anims;
+	bakeAnimationFrame(*frame);
 
 	return frame;
 }
@@ -178,83 +169,85 @@ Renderer::AnimationUpdateState Renderer::updateAnimationBank(AnimationBankRef& b
     return AnimationUpdateState::Playing;
 }
 
+namespace {
+    // Frame lerp (Move/Rotate/Scale) combined with the world placement
+    Renderer::AnimMeshXform MakeFrameXform(float time, float duration, Renderer::AnimFrameFlags flags,
+        const Vector2& posStart, const Vector2& posEnd, const Vector2& rotStartEnd,
+        const Vector2& sclStart, const Vector2& sclEnd,
+        const Vector2& worldPos, const Vector2& worldScale, float worldRotDeg)
+    {
+        using Renderer::AnimFrameFlags;
+        const float dur = duration > 0.f ? duration : 0.0001f;
+        const float t = clamp01(time / dur);
+
+        const bool doMove = Renderer::HasFrameFlag(flags, AnimFrameFlags::Move);
+        const bool doRot = Renderer::HasFrameFlag(flags, AnimFrameFlags::Rotate);
+        const bool doScl = Renderer::HasFrameFlag(flags, AnimFrameFlags::Scale);
+
+        const Vector2 tPos = doMove ? vlerp(posStart, posEnd, t) : posStart;
+        const float   tRot = doRot ? lerpf(rotStartEnd.x, rotStartEnd.y, t) : rotStartEnd.x;
+        const Vector2 tScl = doScl ? vlerp(sclStart, sclEnd, t) : sclStart;
+        return Renderer::makeAnimMeshXform(tPos, tScl, tRot, worldPos, worldScale, worldRotDeg);
+    }
+
+    // Positions are rewritten every draw; colours come from the baked template
+    Vector<SDL_Vertex> s_meshVerts;
+
+    void DrawFrameMesh(const Renderer::AnimFrameMesh& mesh, const Renderer::AnimMeshXform& x, float alpha = 1.0f)
+    {
+        if (mesh.indices.empty() || alpha <= 0.0f) return;
+        s_meshVerts.assign(mesh.vertices.begin(), mesh.vertices.end());
+        if (alpha < 1.0f) {
+            for (SDL_Vertex& v : s_meshVerts) v.color.a *= alpha;
+        }
+        Renderer::transformAnimFrameMesh(mesh, x, s_meshVerts.data());
+        Renderer::drawGeometry(s_meshVerts, mesh.indices);
+    }
+}
+
 void Renderer::RenderAnimationBank(AnimationBankRef& bank, const Vector2& worldPos, const Vector2& worldScale, float worldRotDeg)
 {
 
     if (!bank || bank->frames.empty()) return;
     auto fr = bank->frames[bank->currentFrame]; if (!fr) return;
 
-    const float dur = fr->duration > 0.f ? fr->duration : 0.0001f;
-    const float t = clamp01(bank->currentTime / dur);
-
-    const bool doMove = HasFrameFlag(fr->flags, AnimFrameFlags::Move);
-    const bool doRot = HasFrameFlag(fr->flags, AnimFrameFlags::Rotate);
-    const bool doScl = HasFrameFlag(fr->flags, AnimFrameFlags::Scale);
-
-    const Vector2 tPos = doMove ? vlerp(fr->positionStart, fr->positionEnd, t)
-        : fr->positionStart;
-    const float   tRot = doRot ? lerpf(fr->rotationStartEnd.x, fr->rotationStartEnd.y, t)
-        : fr->rotationStartEnd.x;
-    const Vector2 tScl = doScl ? vlerp(fr->scaleStart, fr->scaleEnd, t)
-        : fr->scaleStart;
-
-    const float totalRot = worldRotDeg + tRot;
-    const Vector2 totalScl{ worldScale.x * tScl.x, worldScale.y * tScl.y };
-
-    auto applyAll = [&](const Vector2& p)->Vector2 {
-        Vector2 s{ p.x * totalScl.x, p.y * totalScl.y };
-        Vector2 r = rotateAround(s, { 0,0 }, totalRot);
-        return { r.x + worldPos.x + tPos.x, r.y + worldPos.y + tPos.y };
-        };
+    // Frames built by hand (or edited) after load are baked on first use
+    if (!fr->mesh || fr->mesh->primCount != fr->primitives.size()) bakeAnimationFrame(*fr);
 
-   
+    const AnimMeshXform x = MakeFrameXform(bank->currentTime, fr->duration, fr->flags,
+        fr->positionStart, fr->positionEnd, fr->rotationStartEnd, fr->scaleStart, fr->scaleEnd,
+        worldPos, worldScale, worldRotDeg);
+    DrawFrameMesh(*fr->mesh, x);
 
-    for (const auto& pRef : fr->primitives) {
-		if (!pRef) continue; // Skip null references
-        const AnimPrimitive& p = *pRef;
-        const Vector2 P = p.aabb.getPosition();
-        const Vector2 S = p.aabb.getSize();
-
-        if (p.type == AnimPrimitiveType::Line) {
-            Vector2 s{ P.x,       P.y };
-            Vector2 e{ P.x + S.x,   P.y + S.y };
+}
 
-            s = scaleAround(s, p.center, tScl);
-            e = scaleAround(e, p.center, tScl);
-            s = rotateAround(s, p.center, tRot);
-            e = rotateAround(e, p.center, tRot);
+void Renderer::renderAnimationClip(const AnimationClip& clip, uint32_t frame, float time,
+    const Vector2& worldPos, const Vector2& worldScale, float worldRotDeg, float alpha)
+{
+    if (frame >= clip.frames.size() || frame >= clip.meshes.size()) return;
+    const AnimClipFrame& fr = clip.frames[frame];
 
-            s = applyAll(s);
-            e = applyAll(e);
+    const AnimMeshXform x = MakeFrameXform(time, fr.duration, fr.flags,
+        fr.positionStart, fr.positionEnd, fr.rotationStartEnd, fr.scaleStart, fr.scaleEnd,
+        worldPos, worldScale, worldRotDeg);
+    DrawFrameMesh(clip.meshes[frame], x, alpha);
+}
 
-            Renderer::drawThickLine(s.x, s.y, e.x, e.y, p.thickness, p.color);
-        }
-        else { // Rect
-            Vector2 a{ P.x,       P.y };
-            Vector2 b{ P.x + S.x,   P.y };
-            Vector2 c{ P.x + S.x,   P.y + S.y };
-            Vector2 d{ P.x,       P.y + S.y };
-
-            if (p.type == AnimPrimitiveType::RectFilled) {
-                Vector2 tl = { a.x + worldPos.x + tPos.x, a.y + worldPos.y + tPos.y };
-                Renderer::drawFilledRect(tl.x, tl.y, S.x, S.y, p.color);
-            }
-            else {
-                a = scaleAround(a, p.center, tScl); b = scaleAround(b, p.center, tScl);
-                c = scaleAround(c, p.center, tScl); d = scaleAround(d, p.center, tScl);
-                a = rotateAround(a, p.center, tRot); b = rotateAround(b, p.center, tRot);
-                c = rotateAround(c, p.center, tRot); d = rotateAround(d, p.center, tRot);
-                a = applyAll(a); b = applyAll(b); c = applyAll(c); d = applyAll(d);
-
-                const float th = (p.thickness > 0.f) ? p.thickness : 1.0f;
-                Renderer::drawThickLine(a.x, a.y, b.x, b.y, th, p.color);
-                Renderer::drawThickLine(b.x, b.y, c.x, c.y, th, p.color);
-                Renderer::drawThickLine(c.x, c.y, d.x, d.y, th, p.color);
-                Renderer::drawThickLine(d.x, d.y, a.x, a.y, th, p.color);
-            }
-        }
+void Renderer::renderPlayhead(PlayheadHandle h, const Vector2& position, const Vector2& scale, float rotation, float alpha)
+{
+    PlayheadState st;
+    if (!getPlayhead(h, st)) return;
+    if (const AnimationClip* clip = getAnimationClip(st.clip)) {
+        renderAnimationClip(*clip, st.frame, st.time, position, scale, rotation, alpha);
     }
+}
 
+void Renderer::renderAnimationController(AnimControllerHandle h, const Vector2& position, const Vector2& scale, float rotation)
+{
+    AnimControllerPose pose;
+    if (!getAnimControllerPose(h, pose)) return;
+    if (pose.previous) renderPlayhead(pose.previous, position, scale, rotation, 1.0f - pose.blend);
+    renderPlayhead(pose.current, position, scale, rotation, pose.blend);
 }
 
 void Renderer::ResetAnimationBank(AnimationBankRef& bank, Uint32 toFrame, float startTime)
@@ -71,6 +71,7 @@ namespace Renderer {
 	};
 
 	struct AnimationFrame;
+	struct AnimFrameMesh;
 	using AnimPrimitiveRef = Ref<Renderer::AnimPrimitive>;
 	
 	struct AnimationFrame {
@@ -84,6 +85,7 @@ namespace Renderer {
 		Vector2 scaleEnd;
 		AnimFrameFlags flags = AnimFrameFlags::None;   // <-- per-frame controls
 		Vector<AnimPrimitiveRef> primitives; // List of primitives for this frame
+		Ref<const AnimFrameMesh> mesh; // Baked primitives (see AnimMesh.h), rebuilt if primitives change
 	
 	};
 
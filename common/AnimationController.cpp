@@ -0,0 +1,347 @@
+#include "Common.h"
+
+using namespace Renderer;
+
+namespace {
+    constexpr uint16_t kNoState = 0xFFFFu;
+
+    struct GraphParam {
+        String name;
+        AnimParamType type = AnimParamType::Float;
+    };
+
+    struct GraphState {
+        String name;
+        AnimClipId clip = kInvalidAnimClip;
+        float speed = 1.0f;
+        float clipDuration = 0.0f;
+        uint32_t firstTransition = 0;
+        uint32_t transitionCount = 0;
+    };
+
+    struct GraphCondition {
+        uint8_t param = 0;
+        AnimCondOp op = AnimCondOp::IsTrue;
+        float threshold = 0.0f;
+    };
+
+    struct GraphTransition {
+        uint16_t to = 0;
+        bool atClipEnd = false;
+        float fadeTime = 0.0f;
+        uint32_t firstCondition = 0;
+        uint32_t conditionCount = 0;
+    };
+
+    // Flattened graph: each state's transitions are one contiguous run, followed
+    // by the any-state run
+    struct AnimGraph {
+        String name;
+        Vector<GraphParam> params;
+        Vector<GraphState> states;
+        Vector<GraphTransition> transitions;
+        Vector<GraphCondition> conditions;
+        uint32_t anyFirst = 0;
+        uint32_t anyCount = 0;
+        std::array<float, kMaxAnimParams> defaults{};
+    };
+
+    struct Controller {
+        const AnimGraph* graph = nullptr;
+        PlayheadHandle current;
+        PlayheadHandle previous;
+        uint16_t state = kNoState;
+        float stateTime = 0.0f;     // clip time spent in the current state
+        float fadeTime = 0.0f;
+        float fadeDuration = 0.0f;
+        uint32_t triggers = 0;      // bit per trigger parameter, cleared every update
+        std::array<float, kMaxAnimParams> params{};
+    };
+
+    Vector<Ref<const AnimGraph>> s_graphs;
+    HandlePool<Controller, AnimControllerTag> s_controllers;
+
+    const AnimGraph* GetGraph(AnimGraphId id)
+    {
+        return id < s_graphs.size() ? s_graphs[id].get() : nullptr;
+    }
+
+    int FindByName(const Vector<GraphParam>& v, std::string_view name)
+    {
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            if (v[i].name == name) return (int)i;
+        }
+        return -1;
+    }
+
+    int FindByName(const Vector<GraphState>& v, std::string_view name)
+    {
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            if (v[i].name == name) return (int)i;
+        }
+        return -1;
+    }
+
+    bool ValidParam(const Controller* c, int param)
+    {
+        return c && param >= 0 && param < (int)c->graph->params.size();
+    }
+
+    bool Passes(const AnimGraph& g, const Controller& c, const GraphTransition& t)
+    {
+        if (t.atClipEnd && c.stateTime < g.states[c.state].clipDuration) return false;
+        const GraphCondition* cond = g.conditions.data() + t.firstCondition;
+        for (uint32_t i = 0; i < t.conditionCount; ++i, ++cond) {
+            const float v = c.params[cond->param];
+            bool ok = false;
+            switch (cond->op) {
+            case AnimCondOp::Greater:   ok = v > cond->threshold; break;
+            case AnimCondOp::Less:      ok = v < cond->threshold; break;
+            case AnimCondOp::IsTrue:    ok = v != 0.0f; break;
+            case AnimCondOp::IsFalse:   ok = v == 0.0f; break;
+            case AnimCondOp::Triggered: ok = (c.triggers & (1u << cond->param)) != 0; break;
+            }
+            if (!ok) return false;
+        }
+        return true;
+    }
+
+    // Playheads are recycled through the runtime's free lists, so switching
+    // states does not allocate once the pool has warmed up
+    void EnterState(Controller& c, uint16_t to, float fadeTime)
+    {
+        const GraphState& s = c.graph->states[to];
+        if (c.previous) {
+            destroyPlayhead(c.previous);
+            c.previous = PlayheadHandle{};
+        }
+        if (fadeTime > 0.0f && c.current) {
+            c.previous = c.current;
+            c.current = createPlayhead(s.clip, s.speed);
+            c.fadeTime = 0.0f;
+            c.fadeDuration = fadeTime;
+        }
+        else if (!c.current || !setPlayheadClip(c.current, s.clip)) {
+            c.current = createPlayhead(s.clip, s.speed);
+        }
+        setPlayheadSpeed(c.current, s.speed);
+        c.state = to;
+        c.stateTime = 0.0f;
+    }
+
+    void UpdateController(Controller& c, float dt)
+    {
+        const AnimGraph& g = *c.graph;
+        c.stateTime += dt * g.states[c.state].speed;
+        if (c.previous) {
+            c.fadeTime += dt;
+            if (c.fadeTime >= c.fadeDuration) {
+                destroyPlayhead(c.previous);
+                c.previous = PlayheadHandle{};
+            }
+        }
+
+        const GraphState& s = g.states[c.state];
+        const GraphTransition* fire = nullptr;
+        for (uint32_t i = 0; i < s.transitionCount && !fire; ++i) {
+            const GraphTransition& t = g.transitions[s.firstTransition + i];
+            if (Passes(g, c, t)) fire = &t;
+        }
+        for (uint32_t i = 0; i < g.anyCount && !fire; ++i) {
+            const GraphTransition& t = g.transitions[g.anyFirst + i];
+            if (t.to != c.state && Passes(g, c, t)) fire = &t;
+        }
+        if (fire) EnterState(c, fire->to, fire->fadeTime);
+        c.triggers = 0;
+    }
+
+    void ReleasePlayheads(Controller& c)
+    {
+        destroyPlayhead(c.current);
+        destroyPlayhead(c.previous);
+    }
+}
+
+AnimGraphId Renderer::createAnimGraph(const AnimGraphDesc& desc)
+{
+    if (desc.states.empty() || desc.states.size() >= kNoState || desc.params.size() > (std::size_t)kMaxAnimParams) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimGraph] %s: needs 1..%d states and at most %d params",
+            desc.name.c_str(), (int)kNoState - 1, kMaxAnimParams);
+        return kInvalidAnimGraph;
+    }
+
+    Ref<AnimGraph> g = CreateRef<AnimGraph>();
+    g->name = desc.name;
+    for (std::size_t i = 0; i < desc.params.size(); ++i) {
+        const AnimParamDesc& p = desc.params[i];
+        g->params.push_back({ p.name, p.type });
+        g->defaults[i] = p.type == AnimParamType::Trigger ? 0.0f : p.defaultValue;
+    }
+    for (const AnimStateDesc& sd : desc.states) {
+        const AnimationClip* clip = getAnimationClip(sd.clip);
+        if (!clip) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimGraph] %s: state %s has no registered clip", desc.name.c_str(), sd.name.c_str());
+            return kInvalidAnimGraph;
+        }
+        GraphState s;
+        s.name = sd.name;
+        s.clip = sd.clip;
+        s.speed = sd.speed;
+        s.clipDuration = clip->duration;
+        g->states.push_back(s);
+    }
+
+    // Resolve names once; runs are emitted per source state (any-state last)
+    auto addRun = [&](int from) -> bool {
+        for (const AnimTransitionDesc& td : desc.transitions) {
+            const int src = td.from.empty() ? -1 : FindByName(g->states, td.from);
+            if (src != from) continue;
+            const int dst = FindByName(g->states, td.to);
+            if (dst < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimGraph] %s: unknown target state %s", desc.name.c_str(), td.to.c_str());
+                return false;
+            }
+            GraphTransition t;
+            t.to = (uint16_t)dst;
+            t.atClipEnd = td.atClipEnd;
+            t.fadeTime = std::max(td.fadeTime, 0.0f);
+            t.firstCondition = (uint32_t)g->conditions.size();
+            for (const AnimConditionDesc& cd : td.conditions) {
+                const int param = FindByName(g->params, cd.param);
+                if (param < 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimGraph] %s: unknown parameter %s", desc.name.c_str(), cd.param.c_str());
+                    return false;
+                }
+                g->conditions.push_back({ (uint8_t)param, cd.op, cd.threshold });
+            }
+            t.conditionCount = (uint32_t)g->conditions.size() - t.firstCondition;
+            g->transitions.push_back(t);
+        }
+        return true;
+    };
+
+    for (const AnimTransitionDesc& td : desc.transitions) {
+        if (!td.from.empty() && FindByName(g->states, td.from) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[AnimGraph] %s: unknown source state %s", desc.name.c_str(), td.from.c_str());
+            return kInvalidAnimGraph;
+        }
+    }
+    for (std::size_t s = 0; s < g->states.size(); ++s) {
+        g->states[s].firstTransition = (uint32_t)g->transitions.size();
+        if (!addRun((int)s)) return kInvalidAnimGraph;
+        g->states[s].transitionCount = (uint32_t)g->transitions.size() - g->states[s].firstTransition;
+    }
+    g->anyFirst = (uint32_t)g->transitions.size();
+    if (!addRun(-1)) return kInvalidAnimGraph;
+    g->anyCount = (uint32_t)g->transitions.size() - g->anyFirst;
+
+    s_graphs.push_back(std::move(g));
+    return (AnimGraphId)(s_graphs.size() - 1);
+}
+
+int Renderer::findAnimGraphParam(AnimGraphId graph, std::string_view name)
+{
+    const AnimGraph* g = GetGraph(graph);
+    return g ? FindByName(g->params, name) : -1;
+}
+
+int Renderer::findAnimGraphState(AnimGraphId graph, std::string_view name)
+{
+    const AnimGraph* g = GetGraph(graph);
+    return g ? FindByName(g->states, name) : -1;
+}
+
+AnimControllerHandle Renderer::createAnimationController(AnimGraphId graph)
+{
+    const AnimGraph* g = GetGraph(graph);
+    if (!g) return AnimControllerHandle{};
+    Controller c;
+    c.graph = g;
+    c.params = g->defaults;
+    EnterState(c, 0, 0.0f);
+    if (!c.current) return AnimControllerHandle{};
+    return s_controllers.create(c);
+}
+
+bool Renderer::destroyAnimationController(AnimControllerHandle h)
+{
+    Controller* c = s_controllers.get(h);
+    if (!c) return false;
+    ReleasePlayheads(*c);
+    return s_controllers.release(h);
+}
+
+bool Renderer::setAnimFloat(AnimControllerHandle h, int param, float value)
+{
+    Controller* c = s_controllers.get(h);
+    if (!ValidParam(c, param)) return false;
+    c->params[param] = value;
+    return true;
+}
+
+bool Renderer::setAnimBool(AnimControllerHandle h, int param, bool value)
+{
+    return setAnimFloat(h, param, value ? 1.0f : 0.0f);
+}
+
+bool Renderer::setAnimTrigger(AnimControllerHandle h, int param)
+{
+    Controller* c = s_controllers.get(h);
+    if (!ValidParam(c, param) || c->graph->params[param].type != AnimParamType::Trigger) return false;
+    c->triggers |= 1u << param;
+    return true;
+}
+
+float Renderer::getAnimParam(AnimControllerHandle h, int param)
+{
+    const Controller* c = s_controllers.get(h);
+    if (!ValidParam(c, param)) return 0.0f;
+    if (c->graph->params[param].type == AnimParamType::Trigger) return (c->triggers & (1u << param)) ? 1.0f : 0.0f;
+    return c->params[param];
+}
+
+bool Renderer::playAnimState(AnimControllerHandle h, int state, float fadeTime)
+{
+    Controller* c = s_controllers.get(h);
+    if (!c || state < 0 || state >= (int)c->graph->states.size()) return false;
+    EnterState(*c, (uint16_t)state, fadeTime);
+    return true;
+}
+
+int Renderer::getAnimState(AnimControllerHandle h)
+{
+    const Controller* c = s_controllers.get(h);
+    return c ? (int)c->state : -1;
+}
+
+bool Renderer::getAnimControllerPose(AnimControllerHandle h, AnimControllerPose& out)
+{
+    const Controller* c = s_controllers.get(h);
+    if (!c) return false;
+    out.current = c->current;
+    out.previous = c->previous;
+    out.blend = c->previous ? std::clamp(c->fadeTime / c->fadeDuration, 0.0f, 1.0f) : 1.0f;
+    return true;
+}
+
+void Renderer::updateAnimationControllers(float dt)
+{
+    s_controllers.forEach([dt](Controller& c) { UpdateController(c, dt); });
+}
+
+std::size_t Renderer::getAnimationControllerCount()
+{
+    return s_controllers.size();
+}
+
+void Renderer::clearAnimationControllers()
+{
+    s_controllers.forEach([](Controller& c) { ReleasePlayheads(c); });
+    s_controllers.clear();
+}
+
+void Renderer::shutdownAnimationControllers()
+{
+    clearAnimationControllers();
+    s_graphs.clear();
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// Animation state machines on top of the clip runtime (AnimationRuntime.h).
+// An AnimGraph is the shared, immutable part: states (a clip each), parameters,
+// and transitions guarded by parameter conditions and/or the end of the current
+// clip. A controller is one character's instance of a graph: its parameter values,
+// current state and up to two playheads while a cross-fade runs.
+//
+// Controllers live in a pool and are evaluated together by
+// updateAnimationControllers(dt). Graphs are flattened when created, so
+// evaluating transitions only reads flat arrays and never allocates.
+namespace Renderer {
+
+    constexpr int kMaxAnimParams = 16;
+
+    enum struct AnimParamType : uint8_t { Float, Bool, Trigger };
+
+    enum struct AnimCondOp : uint8_t {
+        Greater,    // value > threshold
+        Less,       // value < threshold
+        IsTrue,     // bool set
+        IsFalse,    // bool clear
+        Triggered,  // trigger fired since the last controller update
+    };
+
+    struct AnimParamDesc {
+        String name;
+        AnimParamType type = AnimParamType::Float;
+        float defaultValue = 0.0f;
+    };
+
+    struct AnimStateDesc {
+        String name;
+        AnimClipId clip = kInvalidAnimClip;
+        float speed = 1.0f;
+    };
+
+    struct AnimConditionDesc {
+        String param;
+        AnimCondOp op = AnimCondOp::IsTrue;
+        float threshold = 0.0f;
+    };
+
+    struct AnimTransitionDesc {
+        String from;                // state name, or empty for any state
+        String to;
+        float fadeTime = 0.15f;     // cross-fade length, 0 = cut
+        bool atClipEnd = false;     // also require one full pass of the current clip
+        Vector<AnimConditionDesc> conditions;   // all must hold (may be empty)
+    };
+
+    struct AnimGraphDesc {
+        String name;
+        Vector<AnimParamDesc> params;
+        Vector<AnimStateDesc> states;   // the first state is the entry state
+        Vector<AnimTransitionDesc> transitions;
+    };
+
+    using AnimGraphId = uint32_t;
+    constexpr AnimGraphId kInvalidAnimGraph = 0xFFFFFFFFu;
+
+    // Validates and flattens the description. Transitions are tried in the order
+    // given: those leaving the current state first, then the any-state ones.
+    AnimGraphId createAnimGraph(const AnimGraphDesc& desc);
+    // -1 when the name is unknown. Resolve once and keep the index.
+    int findAnimGraphParam(AnimGraphId graph, std::string_view name);
+    int findAnimGraphState(AnimGraphId graph, std::string_view name);
+
+    struct AnimControllerTag;
+    using AnimControllerHandle = Handle<AnimControllerTag>;
+
+    AnimControllerHandle createAnimationController(AnimGraphId graph);
+    bool destroyAnimationController(AnimControllerHandle h);
+
+    bool setAnimFloat(AnimControllerHandle h, int param, float value);
+    bool setAnimBool(AnimControllerHandle h, int param, bool value);
+    // Triggers last for one updateAnimationControllers call
+    bool setAnimTrigger(AnimControllerHandle h, int param);
+    float getAnimParam(AnimControllerHandle h, int param);
+
+    // Jump to a state regardless of transitions (fadeTime 0 = cut)
+    bool playAnimState(AnimControllerHandle h, int state, float fadeTime = 0.0f);
+    int getAnimState(AnimControllerHandle h);
+
+    struct AnimControllerPose {
+        PlayheadHandle current;
+        PlayheadHandle previous;    // fading out; null when no fade is running
+        float blend = 1.0f;         // weight of current, 1 - blend for previous
+    };
+    bool getAnimControllerPose(AnimControllerHandle h, AnimControllerPose& out);
+
+    // Evaluate transitions and advance fades for every controller. Call before
+    // updateAnimations so new playheads advance in the same frame.
+    void updateAnimationControllers(float dt);
+    // Draws the fading-out clip under the current one (implemented with the bank renderer)
+    void renderAnimationController(AnimControllerHandle h, const Vector2& position, const Vector2& scale, float rotation);
+
+    std::size_t getAnimationControllerCount();
+    // Destroys all controllers and their playheads (graphs stay registered)
+    void clearAnimationControllers();
+    void shutdownAnimationControllers();
+}
@@ -0,0 +1,323 @@
+#include "Common.h"
+
+using namespace Renderer;
+
+namespace {
+    constexpr float kMinFrameDuration = 0.0001f;
+    constexpr uint32_t kNoDense = 0xFFFFFFFFu;
+
+    constexpr uint8_t Bit(PlayheadFlags f) { return (uint8_t)f; }
+
+    // Clip registry: Refs own the clips; the raw pointer and duration arrays are
+    // what the update loop touches.
+    struct ClipRegistry {
+        Vector<AnimClipRef> clips;
+        Vector<const AnimationClip*> ptrs;
+        UMap<String, AnimClipId> byName;
+    };
+
+    // Playheads as structure-of-arrays, swap-removed like HandlePool. Slot
+    // generations make stale handles fail instead of aliasing a new actor.
+    struct PlayheadStore {
+        Vector<AnimClipId> clip;
+        Vector<uint32_t> frame;
+        Vector<float> time;
+        Vector<float> speed;
+        Vector<uint8_t> flags;
+        Vector<uint32_t> denseToSlot;
+
+        struct Slot {
+            uint32_t dense = kNoDense;
+            uint32_t generation = 1;
+        };
+        Vector<Slot> slots;
+        Vector<uint32_t> freeSlots;
+
+        std::size_t size() const { return clip.size(); }
+
+        uint32_t find(PlayheadHandle h) const
+        {
+            if (!h || h.index() >= slots.size()) return kNoDense;
+            const Slot& s = slots[h.index()];
+            return (s.dense != kNoDense && s.generation == h.generation()) ? s.dense : kNoDense;
+        }
+
+        PlayheadHandle add(AnimClipId c, float spd, uint8_t fl)
+        {
+            uint32_t index;
+            if (!freeSlots.empty()) {
+                index = freeSlots.back();
+                freeSlots.pop_back();
+            }
+            else {
+                index = (uint32_t)slots.size();
+                if (index > PlayheadHandle::kIndexMask) return PlayheadHandle{};
+                slots.push_back(Slot{});
+            }
+            slots[index].dense = (uint32_t)clip.size();
+            clip.push_back(c);
+            frame.push_back(0);
+            time.push_back(0.0f);
+            speed.push_back(spd);
+            flags.push_back(fl);
+            denseToSlot.push_back(index);
+            return PlayheadHandle::make(index, slots[index].generation);
+        }
+
+        bool remove(PlayheadHandle h)
+        {
+            const uint32_t d = find(h);
+            if (d == kNoDense) return false;
+            const uint32_t last = (uint32_t)clip.size() - 1;
+            if (d != last) {
+                clip[d] = clip[last];
+                frame[d] = frame[last];
+                time[d] = time[last];
+                speed[d] = speed[last];
+                flags[d] = flags[last];
+                denseToSlot[d] = denseToSlot[last];
+                slots[denseToSlot[d]].dense = d;
+            }
+            clip.pop_back();
+            frame.pop_back();
+            time.pop_back();
+            speed.pop_back();
+            flags.pop_back();
+            denseToSlot.pop_back();
+
+            Slot& s = slots[h.index()];
+            s.dense = kNoDense;
+            s.generation = (s.generation + 1) & PlayheadHandle::kGenerationMask;
+            if (s.generation == 0) s.generation = 1;
+            freeSlots.push_back(h.index());
+            return true;
+        }
+
+        void clear()
+        {
+            for (uint32_t i = 0; i < (uint32_t)slots.size(); ++i) {
+                if (slots[i].dense != kNoDense) remove(PlayheadHandle::make(i, slots[i].generation));
+            }
+        }
+    };
+
+    struct AnimRuntimeState {
+        ClipRegistry clips;
+        PlayheadStore heads;
+        Vector<AnimEvent> events;
+    };
+    AnimRuntimeState s_anim;
+
+    uint8_t RunFlags(const AnimationClip* clip)
+    {
+        return Bit(PlayheadFlags::Playing) | ((clip && clip->loop) ? Bit(PlayheadFlags::Loop) : 0);
+    }
+
+    void PushEvent(uint32_t dense, AnimEventType type)
+    {
+        const uint32_t slot = s_anim.heads.denseToSlot[dense];
+        s_anim.events.push_back({ PlayheadHandle::make(slot, s_anim.heads.slots[slot].generation), s_anim.heads.clip[dense], type });
+    }
+}
+
+AnimClipRef Renderer::createAnimationClip(const AnimationBank& bank)
+{
+    Ref<AnimationClip> clip = CreateRef<AnimationClip>();
+    clip->name = bank.name;
+    clip->loop = (bank.flags & AnimBankFlags::Repeat) != AnimBankFlags::None;
+    clip->frames.reserve(bank.frames.size());
+    std::size_t primTotal = 0;
+    for (const AnimationFrameRef& fr : bank.frames) primTotal += fr ? fr->primitives.size() : 0;
+    clip->primitives.reserve(primTotal);
+
+    for (const AnimationFrameRef& fr : bank.frames) {
+        if (!fr) continue;
+        AnimClipFrame f;
+        f.duration = std::max(fr->duration, kMinFrameDuration);
+        f.flags = fr->flags;
+        f.positionStart = fr->positionStart;
+        f.positionEnd = fr->positionEnd;
+        f.rotationStartEnd = fr->rotationStartEnd;
+        f.scaleStart = fr->scaleStart;
+        f.scaleEnd = fr->scaleEnd;
+        f.firstPrim = (uint32_t)clip->primitives.size();
+        for (const AnimPrimitiveRef& p : fr->primitives) {
+            if (p) clip->primitives.push_back(*p);
+        }
+        f.primCount = (uint32_t)clip->primitives.size() - f.firstPrim;
+        clip->duration += f.duration;
+        clip->frames.push_back(f);
+    }
+    clip->meshes.resize(clip->frames.size());
+    for (std::size_t i = 0; i < clip->frames.size(); ++i) {
+        const AnimClipFrame& f = clip->frames[i];
+        bakeAnimFrameMesh(clip->primitives.data() + f.firstPrim, f.primCount, clip->meshes[i]);
+    }
+    return clip;
+}
+
+AnimClipId Renderer::registerAnimationClip(AnimClipRef clip)
+{
+    if (!clip || clip->frames.empty()) return kInvalidAnimClip;
+    const AnimClipId id = (AnimClipId)s_anim.clips.clips.size();
+    s_anim.clips.ptrs.push_back(clip.get());
+    if (!clip->name.empty()) s_anim.clips.byName[clip->name] = id;
+    s_anim.clips.clips.push_back(std::move(clip));
+    return id;
+}
+
+const AnimationClip* Renderer::getAnimationClip(AnimClipId id)
+{
+    return id < s_anim.clips.ptrs.size() ? s_anim.clips.ptrs[id] : nullptr;
+}
+
+AnimClipId Renderer::findAnimationClip(const String& name)
+{
+    auto it = s_anim.clips.byName.find(name);
+    return it != s_anim.clips.byName.end() ? it->second : kInvalidAnimClip;
+}
+
+PlayheadHandle Renderer::createPlayhead(AnimClipId clip, float speed)
+{
+    const AnimationClip* c = getAnimationClip(clip);
+    if (!c) return PlayheadHandle{};
+    return s_anim.heads.add(clip, speed, RunFlags(c));
+}
+
+bool Renderer::destroyPlayhead(PlayheadHandle h)
+{
+    return s_anim.heads.remove(h);
+}
+
+bool Renderer::setPlayheadClip(PlayheadHandle h, AnimClipId clip)
+{
+    const uint32_t d = s_anim.heads.find(h);
+    const AnimationClip* c = getAnimationClip(clip);
+    if (d == kNoDense || !c) return false;
+    s_anim.heads.clip[d] = clip;
+    s_anim.heads.frame[d] = 0;
+    s_anim.heads.time[d] = 0.0f;
+    s_anim.heads.flags[d] = RunFlags(c);
+    return true;
+}
+
+bool Renderer::setPlayheadSpeed(PlayheadHandle h, float speed)
+{
+    const uint32_t d = s_anim.heads.find(h);
+    if (d == kNoDense) return false;
+    s_anim.heads.speed[d] = speed;
+    return true;
+}
+
+bool Renderer::setPlayheadLooping(PlayheadHandle h, bool loop)
+{
+    const uint32_t d = s_anim.heads.find(h);
+    if (d == kNoDense) return false;
+    uint8_t& f = s_anim.heads.flags[d];
+    f = loop ? (f | Bit(PlayheadFlags::Loop)) : (f & ~Bit(PlayheadFlags::Loop));
+    return true;
+}
+
+bool Renderer::setPlayheadPlaying(PlayheadHandle h, bool playing)
+{
+    const uint32_t d = s_anim.heads.find(h);
+    if (d == kNoDense) return false;
+    uint8_t& f = s_anim.heads.flags[d];
+    if (playing && (f & Bit(PlayheadFlags::Finished))) return false; // restart it instead
+    f = playing ? (f | Bit(PlayheadFlags::Playing)) : (f & ~Bit(PlayheadFlags::Playing));
+    return true;
+}
+
+bool Renderer::restartPlayhead(PlayheadHandle h)
+{
+    const uint32_t d = s_anim.heads.find(h);
+    if (d == kNoDense) return false;
+    s_anim.heads.frame[d] = 0;
+    s_anim.heads.time[d] = 0.0f;
+    uint8_t& f = s_anim.heads.flags[d];
+    f = (f & Bit(PlayheadFlags::Loop)) | Bit(PlayheadFlags::Playing);
+    return true;
+}
+
+bool Renderer::getPlayhead(PlayheadHandle h, PlayheadState& out)
+{
+    const uint32_t d = s_anim.heads.find(h);
+    if (d == kNoDense) return false;
+    out.clip = s_anim.heads.clip[d];
+    out.frame = s_anim.heads.frame[d];
+    out.time = s_anim.heads.time[d];
+    out.speed = s_anim.heads.speed[d];
+    out.flags = (PlayheadFlags)s_anim.heads.flags[d];
+    return true;
+}
+
+std::size_t Renderer::getPlayheadCount()
+{
+    return s_anim.heads.size();
+}
+
+void Renderer::updateAnimations(float dt)
+{
+    s_anim.events.clear();
+    PlayheadStore& heads = s_anim.heads;
+    const AnimationClip* const* clips = s_anim.clips.ptrs.data();
+    const uint32_t n = (uint32_t)heads.size();
+    AnimClipId* clipIds = heads.clip.data();
+    uint32_t* frames = heads.frame.data();
+    float* times = heads.time.data();
+    const float* speeds = heads.speed.data();
+    uint8_t* flags = heads.flags.data();
+
+    for (uint32_t i = 0; i < n; ++i) {
+        uint8_t fl = flags[i];
+        if (!(fl & Bit(PlayheadFlags::Playing))) continue;
+        if (!(fl & Bit(PlayheadFlags::Started))) {
+            fl |= Bit(PlayheadFlags::Started);
+            PushEvent(i, AnimEventType::Started);
+        }
+
+        const AnimationClip& clip = *clips[clipIds[i]];
+        const AnimClipFrame* cf = clip.frames.data();
+        const uint32_t frameCount = (uint32_t)clip.frames.size();
+        uint32_t f = frames[i];
+        float t = times[i] + dt * speeds[i];
+
+        // Most playheads stay inside their frame; only the crossing ones take the loop
+        while (t >= cf[f].duration) {
+            t -= cf[f].duration;
+            if (++f < frameCount) continue;
+            if (fl & Bit(PlayheadFlags::Loop)) {
+                f = 0;
+                PushEvent(i, AnimEventType::Looped);
+                // A huge dt (hitch, fast-forward) skips whole cycles instead of walking them
+                if (t >= clip.duration) t = std::fmod(t, clip.duration);
+                continue;
+            }
+            f = frameCount - 1;
+            t = cf[f].duration;
+            fl = (fl & ~Bit(PlayheadFlags::Playing)) | Bit(PlayheadFlags::Finished);
+            PushEvent(i, AnimEventType::Ended);
+            break;
+        }
+        frames[i] = f;
+        times[i] = t;
+        flags[i] = fl;
+    }
+}
+
+const Vector<AnimEvent>& Renderer::getAnimationEvents()
+{
+    return s_anim.events;
+}
+
+void Renderer::clearPlayheads()
+{
+    s_anim.heads.clear();
+    s_anim.events.clear();
+}
+
+void Renderer::shutdownAnimations()
+{
+    clearPlayheads();
+    s_anim.clips = ClipRegistry{};
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+// Data-oriented animation runtime.
+// An AnimationClip is the immutable, shareable half of an AnimationBank: flattened
+// frames plus one contiguous primitive array. Clips are registered once and
+// referenced by id. Per-actor playback state is a playhead, kept as
+// structure-of-arrays (clip, frame, time, speed, flags), so thousands of actors
+// share one clip without copying it. updateAnimations(dt) advances every playhead
+// in a single pass. Start/loop/end notifications land in an event list that the
+// game reads after the update, instead of per-bank std::function callbacks.
+namespace Renderer {
+
+    struct AnimClipFrame {
+        float duration = 0.1f;      // always > 0
+        AnimFrameFlags flags = AnimFrameFlags::None;
+        Vector2 positionStart;
+        Vector2 positionEnd;
+        Vector2 rotationStartEnd;
+        Vector2 scaleStart{ 1.0f, 1.0f };
+        Vector2 scaleEnd{ 1.0f, 1.0f };
+        uint32_t firstPrim = 0;
+        uint32_t primCount = 0;
+    };
+
+    struct AnimationClip {
+        String name;
+        bool loop = false;                  // default for playheads created on this clip
+        Vector<AnimClipFrame> frames;
+        Vector<AnimPrimitive> primitives;   // frames index runs of this array
+        Vector<AnimFrameMesh> meshes;       // one baked mesh per frame
+        float duration = 0.0f;              // sum of frame durations
+    };
+    using AnimClipRef = Ref<const AnimationClip>;
+    using AnimClipId = uint32_t;
+    constexpr AnimClipId kInvalidAnimClip = 0xFFFFFFFFu;
+
+    // Flatten a bank (frames and primitives are copied; the bank is not kept) and
+    // bake one mesh per frame.
+    // loop defaults to the bank's Repeat flag.
+    AnimClipRef createAnimationClip(const AnimationBank& bank);
+    // Clips live until shutdownAnimations(); ids are dense and never reused
+    AnimClipId registerAnimationClip(AnimClipRef clip);
+    const AnimationClip* getAnimationClip(AnimClipId id);
+    AnimClipId findAnimationClip(const String& name);
+
+    struct PlayheadTag;
+    using PlayheadHandle = Handle<PlayheadTag>;
+
+    enum struct PlayheadFlags : uint8_t {
+        None = 0,
+        Playing = 1u << 0,
+        Loop = 1u << 1,
+        Started = 1u << 2,  // Started event already sent for this run
+        Finished = 1u << 3, // non-looping clip reached its end
+    };
+    inline bool HasPlayheadFlag(PlayheadFlags m, PlayheadFlags f) {
+        return (static_cast<uint8_t>(m) & static_cast<uint8_t>(f)) != 0u;
+    }
+
+    enum struct AnimEventType : uint8_t { Started, Looped, Ended };
+
+    struct AnimEvent {
+        PlayheadHandle playhead;
+        AnimClipId clip = kInvalidAnimClip;
+        AnimEventType type = AnimEventType::Started;
+    };
+
+    struct PlayheadState {
+        AnimClipId clip = kInvalidAnimClip;
+        uint32_t frame = 0;
+        float time = 0.0f;      // time into the current frame
+        float speed = 1.0f;
+        PlayheadFlags flags = PlayheadFlags::None;
+    };
+
+    PlayheadHandle createPlayhead(AnimClipId clip, float speed = 1.0f);
+    bool destroyPlayhead(PlayheadHandle h);
+    // Switch clip and restart from its first frame (loop follows the new clip)
+    bool setPlayheadClip(PlayheadHandle h, AnimClipId clip);
+    bool setPlayheadSpeed(PlayheadHandle h, float speed);
+    bool setPlayheadLooping(PlayheadHandle h, bool loop);
+    bool setPlayheadPlaying(PlayheadHandle h, bool playing);
+    bool restartPlayhead(PlayheadHandle h);
+    bool getPlayhead(PlayheadHandle h, PlayheadState& out);
+    std::size_t getPlayheadCount();
+
+    // Advance every playing playhead by dt (same units as frame durations).
+    // Clears and refills the event list.
+    void updateAnimations(float dt);
+    const Vector<AnimEvent>& getAnimationEvents();
+
+    // Draw a playhead's current frame (implemented with the bank renderer).
+    // alpha scales the baked vertex alpha, e.g. for cross-fades.
+    void renderPlayhead(PlayheadHandle h, const Vector2& position, const Vector2& scale, float rotation, float alpha = 1.0f);
+    // Draw frame `frame` of a clip, `time` into it
+    void renderAnimationClip(const AnimationClip& clip, uint32_t frame, float time,
+                             const Vector2& position, const Vector2& scale, float rotation, float alpha = 1.0f);
+
+    // Destroys all playheads (clips stay registered)
+    void clearPlayheads();
+    void shutdownAnimations();
+}
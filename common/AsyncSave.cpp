@@ -0,0 +1,312 @@
+#include "Common.h"
+#include "AsyncSave.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define AQ_HAS_FSYNC 1
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr float kSerializeShare = 0.6f;       // progress covered by the serializer
+    constexpr std::size_t kWriteChunk = 256 * 1024;
+    constexpr float kMinProgressStep = 0.01f;     // coalesce finer progress updates
+
+    struct Job {
+        AsyncSave::JobId id = 0;
+        String path;
+        AsyncSave::Serializer serialize;
+    };
+
+    struct Event {
+        AsyncSave::JobId id = 0;
+        bool done = false;
+        bool ok = false;
+        float fraction = 0.0f;
+    };
+
+    struct Callbacks {
+        AsyncSave::ProgressCallback onProgress;
+        AsyncSave::CompletionCallback onComplete;
+    };
+
+    // Worker state, guarded by mutex. Callbacks are main-thread only.
+    struct SaveState {
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable wake;   // worker: new job or stop
+        std::condition_variable idle;   // flush(): a job finished
+        std::deque<Job> queue;
+        Vector<Event> events;
+        bool running = false;           // worker is inside a job
+        bool stop = false;
+
+        UMap<AsyncSave::JobId, Callbacks> callbacks;
+        AsyncSave::JobId nextId = 1;
+    };
+    SaveState s_save;
+
+    void PostEvent(const Event& e)
+    {
+        std::scoped_lock<std::mutex> lock(s_save.mutex);
+        // Only the newest progress per job matters to the UI
+        if (!e.done && !s_save.events.empty()) {
+            Event& last = s_save.events.back();
+            if (last.id == e.id && !last.done) { last.fraction = e.fraction; return; }
+        }
+        s_save.events.push_back(e);
+    }
+
+    // Throttled progress reporter mapping a stage's 0..1 onto [base, base + span]
+    struct Reporter {
+        AsyncSave::JobId id;
+        float base, span;
+        float last = -1.0f;
+        void operator()(float t)
+        {
+            const float f = base + span * std::clamp(t, 0.0f, 1.0f);
+            if (f - last < kMinProgressStep && t < 1.0f) return;
+            last = f;
+            PostEvent({ id, false, false, f });
+        }
+    };
+
+    bool RunJob(Job& job)
+    {
+        const uint64_t start = SDL_GetTicks();
+        Util::BinStream out;
+        Reporter serializeReport{ job.id, 0.0f, kSerializeShare };
+        const std::function<void(float)> report = std::ref(serializeReport);
+        if (!job.serialize || !job.serialize(out, report)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Serializing %s failed", job.path.c_str());
+            return false;
+        }
+        report(1.0f);
+
+        Reporter writeReport{ job.id, kSerializeShare, 1.0f - kSerializeShare };
+        if (!AsyncSave::writeFileAtomic(job.path, out.buffer(), std::ref(writeReport))) return false;
+        SDL_Log("[Save] Wrote %s (%zu bytes) in %llu ms", job.path.c_str(), out.size(),
+            (unsigned long long)(SDL_GetTicks() - start));
+        return true;
+    }
+
+    void Worker()
+    {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(s_save.mutex);
+                s_save.wake.wait(lock, [] { return s_save.stop || !s_save.queue.empty(); });
+                if (s_save.queue.empty()) return; // stop requested and drained
+                job = std::move(s_save.queue.front());
+                s_save.queue.pop_front();
+                s_save.running = true;
+            }
+            const bool ok = RunJob(job);
+            job.serialize = nullptr; // drop the snapshot before reporting completion
+            {
+                std::scoped_lock<std::mutex> lock(s_save.mutex);
+                s_save.events.push_back({ job.id, true, ok, ok ? 1.0f : 0.0f });
+                s_save.running = false;
+            }
+            s_save.idle.notify_all();
+        }
+    }
+
+    bool WorkerBusy()
+    {
+        std::scoped_lock<std::mutex> lock(s_save.mutex);
+        return s_save.running || !s_save.queue.empty();
+    }
+
+    // Writes `bytes` to a new file and forces them to disk before closing it, so a
+    // rename that follows can't reach the disk ahead of the data
+    bool WriteSynced(const String& tmp, std::span<const Util::Byte> bytes, const std::function<void(float)>& report)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(tmp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Cannot open %s", tmp.c_str());
+            return false;
+        }
+        bool ok = true;
+        for (std::size_t off = 0; ok && off < bytes.size(); off += kWriteChunk) {
+            const DWORD n = static_cast<DWORD>(std::min(kWriteChunk, bytes.size() - off));
+            DWORD written = 0;
+            ok = WriteFile(file, bytes.data() + off, n, &written, nullptr) && written == n;
+            if (ok && report) report((float)(off + n) / (float)bytes.size());
+        }
+        ok = ok && FlushFileBuffers(file);
+        ok = CloseHandle(file) && ok;
+        return ok;
+#elif defined(AQ_HAS_FSYNC)
+        const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Cannot open %s", tmp.c_str());
+            return false;
+        }
+        bool ok = true;
+        std::size_t off = 0;
+        while (ok && off < bytes.size()) {
+            const std::size_t n = std::min(kWriteChunk, bytes.size() - off);
+            const ssize_t written = ::write(fd, bytes.data() + off, n);
+            if (written < 0 && errno == EINTR) continue;
+            ok = written > 0;
+            if (!ok) break;
+            off += static_cast<std::size_t>(written);
+            if (report) report((float)off / (float)bytes.size());
+        }
+        ok = ok && ::fsync(fd) == 0;
+        ok = ::close(fd) == 0 && ok;
+        return ok;
+#else
+        // No way to sync a stream here; only a process crash is covered
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Cannot open %s", tmp.c_str());
+            return false;
+        }
+        for (std::size_t off = 0; off < bytes.size(); off += kWriteChunk) {
+            const std::size_t n = std::min(kWriteChunk, bytes.size() - off);
+            f.write(reinterpret_cast<const char*>(bytes.data() + off), static_cast<std::streamsize>(n));
+            if (!f.good()) break;
+            if (report) report((float)(off + n) / (float)bytes.size());
+        }
+        f.flush();
+        return f.good();
+#endif
+    }
+
+    // Makes a rename inside `dir` durable; POSIX only, Windows renames write through
+    void SyncDirectory(const std::filesystem::path& dir)
+    {
+#ifdef AQ_HAS_FSYNC
+        const String name = dir.empty() ? String(".") : dir.string();
+        const int fd = ::open(name.c_str(), O_RDONLY);
+        if (fd < 0 || ::fsync(fd) != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Cannot sync directory %s", name.c_str());
+        }
+        if (fd >= 0) ::close(fd);
+#else
+        (void)dir;
+#endif
+    }
+}
+
+bool AsyncSave::writeFileAtomic(const String& path, std::span<const Util::Byte> bytes,
+                                const std::function<void(float)>& report)
+{
+    const String tmp = path + ".tmp";
+    std::error_code ec;
+    if (!WriteSynced(tmp, bytes, report)) {
+        std::filesystem::remove(tmp, ec);
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Writing %s failed", tmp.c_str());
+        return false;
+    }
+    // The data is on disk, so the rename can only expose a complete file. It replaces
+    // the destination in one step, so readers see the old or the new file, never half
+    // of one; write-through on Windows, a directory sync on POSIX make it durable.
+#ifdef _WIN32
+    if (!MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Renaming %s -> %s failed: error %lu",
+            tmp.c_str(), path.c_str(), (unsigned long)GetLastError());
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+#else
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[Save] Renaming %s -> %s failed: %s",
+            tmp.c_str(), path.c_str(), ec.message().c_str());
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    SyncDirectory(std::filesystem::path(path).parent_path());
+#endif
+    if (report) report(1.0f);
+    return true;
+}
+
+AsyncSave::JobId AsyncSave::submit(const String& path, Serializer serialize,
+                                   ProgressCallback onProgress, CompletionCallback onComplete)
+{
+    const JobId id = s_save.nextId++;
+    if (s_save.nextId == 0) s_save.nextId = 1;
+    s_save.callbacks[id] = { std::move(onProgress), std::move(onComplete) };
+    {
+        std::scoped_lock<std::mutex> lock(s_save.mutex);
+        s_save.stop = false;
+        s_save.queue.push_back({ id, path, std::move(serialize) });
+    }
+    if (!s_save.worker.joinable()) s_save.worker = std::thread(Worker);
+    s_save.wake.notify_one();
+    return id;
+}
+
+void AsyncSave::detach(JobId job)
+{
+    auto it = s_save.callbacks.find(job);
+    if (it != s_save.callbacks.end()) it->second = {};
+}
+
+void AsyncSave::update()
+{
+    Vector<Event> events;
+    {
+        std::scoped_lock<std::mutex> lock(s_save.mutex);
+        if (s_save.events.empty()) return;
+        events.swap(s_save.events);
+    }
+    for (const Event& e : events) {
+        auto it = s_save.callbacks.find(e.id);
+        if (it == s_save.callbacks.end()) continue;
+        if (!e.done) {
+            if (it->second.onProgress) it->second.onProgress(e.id, e.fraction);
+            continue;
+        }
+        // Erase first so a completion callback may submit the next save
+        Callbacks cb = std::move(it->second);
+        s_save.callbacks.erase(it);
+        if (e.ok && cb.onProgress) cb.onProgress(e.id, 1.0f);
+        if (cb.onComplete) cb.onComplete(e.id, e.ok);
+    }
+}
+
+bool AsyncSave::isBusy()
+{
+    return !s_save.callbacks.empty() || WorkerBusy();
+}
+
+void AsyncSave::flush()
+{
+    {
+        std::unique_lock<std::mutex> lock(s_save.mutex);
+        s_save.idle.wait(lock, [] { return !s_save.running && s_save.queue.empty(); });
+    }
+    update();
+}
+
+void AsyncSave::shutdown()
+{
+    {
+        std::scoped_lock<std::mutex> lock(s_save.mutex);
+        s_save.stop = true;
+    }
+    s_save.wake.notify_one();
+    // Queued saves are finished, not dropped: losing the player's save on quit is worse than waiting
+    if (s_save.worker.joinable()) s_save.worker.join();
+    update();
+    s_save.callbacks.clear();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <functional>
+
+// Background save pipeline. The caller snapshots its state on the main thread
+// (cheaply, e.g. via Cow::share) and submits a serializer that captures the
+// snapshot. A single worker runs the serializer, writes the bytes to
+// "<path>.tmp", syncs them to disk and renames it over <path> (then syncs the
+// directory on POSIX). A crash or power loss mid-save leaves either the previous
+// file or the complete new one. Jobs run in submission order. Callbacks are delivered on the main
+// thread from update(), so the UI never waits on disk.
+namespace AsyncSave {
+
+    using JobId = uint32_t; // 0 = invalid
+
+    // Runs on the worker. Fill `out` from the captured snapshot, calling
+    // report(0..1) as it goes. Must not touch live game state.
+    using Serializer = std::function<bool(Util::BinStream& out, const std::function<void(float)>& report)>;
+    // Overall progress in [0, 1]: serialising covers the first part, the file write the rest
+    using ProgressCallback = std::function<void(JobId job, float fraction)>;
+    using CompletionCallback = std::function<void(JobId job, bool ok)>;
+
+    JobId submit(const String& path, Serializer serialize,
+                 ProgressCallback onProgress = {}, CompletionCallback onComplete = {});
+
+    // Drop a job's callbacks (e.g. its owner is going away); the save still completes
+    void detach(JobId job);
+
+    // Main thread, once per frame: delivers progress/completion callbacks
+    void update();
+
+    // Jobs queued or running, or callbacks not yet delivered
+    bool isBusy();
+    // Block until every submitted job has finished and its callbacks ran. For
+    // shutdown and tests, not for frames.
+    void flush();
+    void shutdown();
+
+    // Write bytes to "<path>.tmp", sync and rename over path; report(0..1) per chunk.
+    // Exposed for tools and tests; the worker uses it for every job.
+    bool writeFileAtomic(const String& path, std::span<const Util::Byte> bytes,
+                         const std::function<void(float)>& report = {});
+}
@@ -0,0 +1,269 @@
+#include "Common.h"
+#include "BinCompress.h"
+
+namespace Util { namespace Compress {
+
+    namespace {
+        constexpr int kMinMatch = 4;
+        constexpr int kHashBits = 14;
+        constexpr std::size_t kMaxOffset = 65535;
+        // Inputs shorter than this aren't worth searching
+        constexpr std::size_t kMinCompressInput = 12;
+
+        inline std::uint32_t load32(const Byte* p) {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        inline std::uint32_t hash4(std::uint32_t v) {
+            return (v * 2654435761u) >> (32 - kHashBits);
+        }
+
+        inline void putLength(std::vector<Byte>& out, std::size_t len) {
+            while (len >= 255) { out.push_back(255); len -= 255; }
+            out.push_back(static_cast<Byte>(len));
+        }
+
+        inline bool getLength(const Byte*& ip, const Byte* end, std::size_t& len) {
+            Byte b;
+            do {
+                if (ip >= end) return false;
+                b = *ip++;
+                len += b;
+            } while (b == 255);
+            return true;
+        }
+
+        // [token][literal length ext][literals][u16 offset][match length ext]
+        void emitSequence(std::vector<Byte>& out, const Byte* lit, std::size_t litLen, std::size_t offset, std::size_t matchLen) {
+            const std::size_t m = matchLen - kMinMatch;
+            out.push_back(static_cast<Byte>((farmMin(litLen, std::size_t(15)) << 4) | farmMin(m, std::size_t(15))));
+            if (litLen >= 15) putLength(out, litLen - 15);
+            out.insert(out.end(), lit, lit + litLen);
+            out.push_back(static_cast<Byte>(offset & 0xFF));
+            out.push_back(static_cast<Byte>(offset >> 8));
+            if (m >= 15) putLength(out, m - 15);
+        }
+
+        // Final sequence: literals only, no offset
+        void emitLastLiterals(std::vector<Byte>& out, const Byte* lit, std::size_t litLen) {
+            out.push_back(static_cast<Byte>(farmMin(litLen, std::size_t(15)) << 4));
+            if (litLen >= 15) putLength(out, litLen - 15);
+            out.insert(out.end(), lit, lit + litLen);
+        }
+    }
+
+    void lzCompress(std::span<const Byte> in, std::vector<Byte>& out) {
+        const Byte* base = in.data();
+        const std::size_t n = in.size();
+        out.reserve(out.size() + n + n / 255 + 16);
+        if (n < kMinCompressInput) { emitLastLiterals(out, base, n); return; }
+
+        // Most recent position (+1, so 0 means empty) of each 4-byte hash
+        std::vector<std::uint32_t> table(std::size_t(1) << kHashBits, 0);
+        std::size_t anchor = 0;
+        std::size_t i = 0;
+        const std::size_t searchEnd = n - kMinMatch;
+        while (i <= searchEnd) {
+            const std::uint32_t seq = load32(base + i);
+            std::uint32_t& slot = table[hash4(seq)];
+            const std::size_t cand = slot;
+            slot = static_cast<std::uint32_t>(i + 1);
+            if (cand == 0 || i - (cand - 1) > kMaxOffset || load32(base + cand - 1) != seq) {
+                // Step faster through incompressible stretches
+                i += 1 + ((i - anchor) >> 6);
+                continue;
+            }
+            const std::size_t match = cand - 1;
+            std::size_t len = kMinMatch;
+            while (i + len < n && base[match + len] == base[i + len]) ++len;
+
+            emitSequence(out, base + anchor, i - anchor, i - match, len);
+            i += len;
+            anchor = i;
+            // Seed the table inside the match so the next search has recent history
+            if (i - 2 <= searchEnd) table[hash4(load32(base + i - 2))] = static_cast<std::uint32_t>(i - 2 + 1);
+        }
+        emitLastLiterals(out, base + anchor, n - anchor);
+    }
+
+    bool lzDecompress(std::span<const Byte> in, std::span<Byte> out) {
+        const Byte* ip = in.data();
+        const Byte* const iend = ip + in.size();
+        Byte* op = out.data();
+        Byte* const ostart = op;
+        Byte* const oend = op + out.size();
+
+        while (ip < iend) {
+            const Byte token = *ip++;
+            std::size_t litLen = token >> 4;
+            if (litLen == 15 && !getLength(ip, iend, litLen)) return false;
+            if (litLen > static_cast<std::size_t>(iend - ip) || litLen > static_cast<std::size_t>(oend - op)) return false;
+            std::memcpy(op, ip, litLen);
+            ip += litLen;
+            op += litLen;
+            if (ip == iend) break; // last sequence carries literals only
+
+            if (iend - ip < 2) return false;
+            const std::size_t offset = ip[0] | (std::size_t(ip[1]) << 8);
+            ip += 2;
+            std::size_t matchLen = token & 15;
+            if (matchLen == 15 && !getLength(ip, iend, matchLen)) return false;
+            matchLen += kMinMatch;
+            if (offset == 0 || offset > static_cast<std::size_t>(op - ostart)) return false;
+            if (matchLen > static_cast<std::size_t>(oend - op)) return false;
+
+            const Byte* src = op - offset;
+            if (offset >= matchLen) {
+                std::memcpy(op, src, matchLen);
+                op += matchLen;
+            }
+            else {
+                // Overlapping copy repeats the last `offset` bytes (runs)
+                for (std::size_t k = 0; k < matchLen; ++k) *op++ = src[k];
+            }
+        }
+        return op == oend;
+    }
+
+    void rleEncode(std::span<const Byte> in, std::size_t elementSize, std::vector<Byte>& out) {
+        if (elementSize == 0) return;
+        const std::size_t count = in.size() / elementSize;
+        const Byte* base = in.data();
+        auto same = [&](std::size_t a, std::size_t b) {
+            return std::memcmp(base + a * elementSize, base + b * elementSize, elementSize) == 0;
+        };
+
+        std::size_t i = 0;
+        while (i < count) {
+            // Run of at least two equal elements
+            std::size_t run = 1;
+            while (i + run < count && run < 129 && same(i, i + run)) ++run;
+            if (run >= 2) {
+                out.push_back(static_cast<Byte>(126 + run));
+                out.insert(out.end(), base + i * elementSize, base + (i + 1) * elementSize);
+                i += run;
+                continue;
+            }
+            // Literals up to the next run (or 128 elements)
+            std::size_t lit = 1;
+            while (i + lit < count && lit < 128 && !(i + lit + 1 < count && same(i + lit, i + lit + 1))) ++lit;
+            out.push_back(static_cast<Byte>(lit - 1));
+            out.insert(out.end(), base + i * elementSize, base + (i + lit) * elementSize);
+            i += lit;
+        }
+    }
+
+    bool rleDecode(std::span<const Byte> in, std::size_t elementSize, std::size_t rawSize, std::vector<Byte>& out) {
+        if (elementSize == 0 || rawSize % elementSize != 0) return false;
+        const std::size_t start = out.size();
+        out.resize(start + rawSize);
+        Byte* op = out.data() + start;
+        Byte* const oend = op + rawSize;
+        const Byte* ip = in.data();
+        const Byte* const iend = ip + in.size();
+
+        while (ip < iend) {
+            const Byte c = *ip++;
+            if (c < 128) {
+                const std::size_t bytes = (std::size_t(c) + 1) * elementSize;
+                if (bytes > static_cast<std::size_t>(iend - ip) || bytes > static_cast<std::size_t>(oend - op)) break;
+                std::memcpy(op, ip, bytes);
+                ip += bytes;
+                op += bytes;
+            }
+            else {
+                const std::size_t run = std::size_t(c) - 126;
+                if (elementSize > static_cast<std::size_t>(iend - ip) || run * elementSize > static_cast<std::size_t>(oend - op)) break;
+                for (std::size_t k = 0; k < run; ++k, op += elementSize) std::memcpy(op, ip, elementSize);
+                ip += elementSize;
+            }
+        }
+        if (ip != iend || op != oend) { out.resize(start); return false; }
+        return true;
+    }
+
+    bool writeSection(BinStream& w, std::span<const Byte> payload, Codec codec, std::uint8_t elementSize) {
+        // readSection refuses anything larger, so writing it would make an unloadable file
+        if (payload.size() > kMaxSectionSize) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "writeSection: %zu byte payload exceeds the %zu byte section limit",
+                payload.size(), kMaxSectionSize);
+            return false;
+        }
+        if (elementSize == 0 || payload.size() % elementSize != 0) elementSize = 1;
+
+        std::vector<Byte> packed;
+        std::size_t stageSize = payload.size();
+        if (codec == Codec::LZ) {
+            lzCompress(payload, packed);
+        }
+        else if (codec == Codec::RleLZ) {
+            std::vector<Byte> rle;
+            rleEncode(payload, elementSize, rle);
+            stageSize = rle.size();
+            lzCompress(rle, packed);
+        }
+        // An RLE stream can come out slightly longer than its input; keep it in bounds too
+        if (codec == Codec::None || packed.size() >= payload.size() || stageSize > kMaxSectionSize) {
+            codec = Codec::None;
+            stageSize = payload.size();
+            packed.assign(payload.begin(), payload.end());
+        }
+
+        w.reserve(w.size() + kSectionHeaderSize + packed.size());
+        w.writeU32(kSectionMagic);
+        w.writeU8(static_cast<std::uint8_t>(codec));
+        w.writeU8(elementSize);
+        w.writeU16(0);
+        w.writeU32(static_cast<std::uint32_t>(payload.size()));
+        w.writeU32(static_cast<std::uint32_t>(stageSize));
+        w.writeU32(static_cast<std::uint32_t>(packed.size()));
+        w.writeBytes(packed.data(), packed.size());
+        return true;
+    }
+
+    bool readSection(BinView& r, std::vector<Byte>& out) {
+        const std::size_t start = r.tell();
+        std::uint32_t magic = 0, rawSize = 0, stageSize = 0, packedSize = 0;
+        std::uint8_t codec = 0, elementSize = 0;
+        std::uint16_t reserved = 0;
+        BinView packedView;
+        const bool header = r.readU32(magic) && magic == kSectionMagic
+            && r.readU8(codec) && r.readU8(elementSize) && r.readU16(reserved)
+            && r.readU32(rawSize) && r.readU32(stageSize) && r.readU32(packedSize)
+            && r.readView(packedSize, packedView);
+        if (!header) { r.seek(start); return false; }
+        const std::span<const Byte> packed = packedView.bytes();
+
+        // Sizes the payload could not possibly decode to are rejected up front
+        const std::size_t maxStage = farmMin(std::size_t(packedSize) * kMaxLzRatio, kMaxSectionSize);
+        const std::size_t maxRaw = static_cast<Codec>(codec) == Codec::RleLZ
+            ? farmMin(std::size_t(stageSize) * kMaxRleRatio, kMaxSectionSize) : maxStage;
+        if (stageSize > maxStage || rawSize > maxRaw) { r.seek(start); return false; }
+
+        out.clear();
+        bool ok = false;
+        switch (static_cast<Codec>(codec)) {
+        case Codec::None:
+            ok = packedSize == rawSize;
+            if (ok) out.assign(packed.begin(), packed.end());
+            break;
+        case Codec::LZ:
+            ok = stageSize == rawSize;
+            if (ok) {
+                out.resize(rawSize);
+                ok = lzDecompress(packed, out);
+            }
+            break;
+        case Codec::RleLZ: {
+            std::vector<Byte> rle(stageSize);
+            ok = lzDecompress(packed, rle) && rleDecode(rle, elementSize, rawSize, out);
+            break;
+        }
+        }
+        if (!ok) { out.clear(); r.seek(start); }
+        return ok;
+    }
+
+} }
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <span>
+
+// Block compression for BinStream sections. Everything is in-tree and
+// dependency-free: an LZ77 block codec in the LZ4 style (byte-aligned tokens, no
+// entropy stage) so decoding stays memcpy-bound, plus an element-wise RLE pre-pass
+// for tile index arrays, which are mostly long runs of the same cell.
+namespace Util {
+
+    enum class Codec : std::uint8_t {
+        None = 0,  // stored
+        LZ = 1,    // LZ block
+        RleLZ = 2, // element RLE, then LZ
+    };
+
+    namespace Compress {
+        // Append the compressed form of `in` to `out`. Worst case grows by ~0.4%.
+        void lzCompress(std::span<const Byte> in, std::vector<Byte>& out);
+        // Decode into exactly out.size() bytes; false on malformed or short input.
+        bool lzDecompress(std::span<const Byte> in, std::span<Byte> out);
+
+        // Runs of equal elementSize-byte elements. in.size() must be a multiple of
+        // elementSize. Control byte c < 128: c + 1 literal elements follow;
+        // c >= 128: one element repeated c - 126 times.
+        void rleEncode(std::span<const Byte> in, std::size_t elementSize, std::vector<Byte>& out);
+        // Appends exactly rawSize bytes to out or fails.
+        bool rleDecode(std::span<const Byte> in, std::size_t elementSize, std::size_t rawSize, std::vector<Byte>& out);
+
+        // Section frame: [u32 'SECT'][u8 codec][u8 elementSize][u16 0]
+        //                [u32 rawSize][u32 stageSize][u32 packedSize][payload]
+        // stageSize is the size of the LZ stage's output (the RLE stream for RleLZ).
+        constexpr std::uint32_t kSectionMagic = 0x54434553; // 'SECT'
+        constexpr std::size_t kSectionHeaderSize = 20;
+        // Most each stage can expand: an LZ length byte adds at most 255 output
+        // bytes, an RLE control byte plus one element at most 129 elements
+        constexpr std::size_t kMaxLzRatio = 255;
+        constexpr std::size_t kMaxRleRatio = 129;
+        // Largest rawSize/stageSize readSection will allocate for, and so the largest
+        // payload writeSection accepts
+        constexpr std::size_t kMaxSectionSize = std::size_t(256) << 20;
+
+        // Encode a framed section. Falls back to Codec::None when the codec doesn't shrink
+        // the data. A payload over kMaxSectionSize is logged and nothing is written.
+        bool writeSection(BinStream& w, std::span<const Byte> payload, Codec codec, std::uint8_t elementSize);
+        // Decode the section at r's cursor into `out` (replaced). Sizes in the header
+        // are checked against the payload before anything is allocated, so a
+        // corrupt frame fails instead of asking for gigabytes.
+        bool readSection(BinView& r, std::vector<Byte>& out);
+    }
+}
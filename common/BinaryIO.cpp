@@ -1,13 +1,81 @@
 #include "Common.h"
 #include <fstream>
+#include <limits>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define AQ_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace Util{
 
     // ---------------- helpers (LE encode/decode) ----------------
     static inline void append(std::vector<Byte>& b, const void* p, std::size_t n) {
         const Byte* s = static_cast<const Byte*>(p);
+        // Grow geometrically ourselves: insert() alone may grow only to fit
+        if (b.capacity() - b.size() < n) b.reserve(std::max({ b.capacity() * 2, b.size() + n, std::size_t(64) }));
         b.insert(b.end(), s, s + n);
     }
+
+    static inline std::uint64_t zigzag(std::int64_t v) {
+        return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+    static inline std::int64_t unzigzag(std::uint64_t v) {
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    static inline void write_var(std::vector<Byte>& b, std::uint64_t v) {
+        Byte tmp[10];
+        std::size_t n = 0;
+        while (v >= 0x80) {
+            tmp[n++] = static_cast<Byte>(v | 0x80);
+            v >>= 7;
+        }
+        tmp[n++] = static_cast<Byte>(v);
+        append(b, tmp, n);
+    }
+
+    // Rejects encodings longer than maxBytes (10 for 64-bit, 5 for 32-bit); the
+    // cursor only moves on success
+    static inline bool read_var(const Byte* data, std::size_t size, std::size_t& rd, std::uint64_t& v, int maxBytes) {
+        std::uint64_t out = 0;
+        std::size_t p = rd;
+        for (int i = 0; i < maxBytes; ++i) {
+            if (p >= size) return false;
+            const Byte byte = data[p++];
+            out |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+            if (!(byte & 0x80)) {
+                v = out;
+                rd = p;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <class T>
+    static inline bool read_var_as(const Byte* data, std::size_t size, std::size_t& rd, T& v) {
+        std::uint64_t raw = 0;
+        const std::size_t start = rd;
+        if (!read_var(data, size, rd, raw, sizeof(T) == 8 ? 10 : 5)) return false;
+        if constexpr (std::is_signed_v<T>) {
+            const std::int64_t s = unzigzag(raw);
+            if (s < std::numeric_limits<T>::min() || s > std::numeric_limits<T>::max()) { rd = start; return false; }
+            v = static_cast<T>(s);
+        }
+        else {
+            if (raw > std::numeric_limits<T>::max()) { rd = start; return false; }
+            v = static_cast<T>(raw);
+        }
+        return true;
+    }
     template <class T>
     static inline void write_le(std::vector<Byte>& b, T v) {
         static_assert(std::is_trivially_copyable_v<T>, "write_le requires POD");
@@ -43,6 +111,16 @@ namespace Util{
         writeU32(static_cast<std::uint32_t>(s.size()));
         if (!s.empty()) writeBytes(s.data(), s.size());
     }
+    void BinStream::writeVarU32(std::uint32_t v) { write_var(buf_, v); }
+    void BinStream::writeVarU64(std::uint64_t v) { write_var(buf_, v); }
+    void BinStream::writeVarI32(std::int32_t v) { write_var(buf_, zigzag(v)); }
+    void BinStream::writeVarI64(std::int64_t v) { write_var(buf_, zigzag(v)); }
+    void BinStream::writeSwapped(const void* v, std::size_t n) {
+        Byte tmp[16];
+        std::memcpy(tmp, v, n);
+        std::reverse(tmp, tmp + n);
+        append(buf_, tmp, n);
+    }
 
     // read
     bool BinStream::readBytes(void* out, std::size_t n) {
@@ -71,6 +149,11 @@ namespace Util{
     bool BinStream::readF32(float& v) { return read_le(buf_, rd_, v); }
     bool BinStream::readF64(double& v) { return read_le(buf_, rd_, v); }
 
+    bool BinStream::readVarU32(std::uint32_t& v) { return read_var_as(buf_.data(), buf_.size(), rd_, v); }
+    bool BinStream::readVarU64(std::uint64_t& v) { return read_var_as(buf_.data(), buf_.size(), rd_, v); }
+    bool BinStream::readVarI32(std::int32_t& v) { return read_var_as(buf_.data(), buf_.size(), rd_, v); }
+    bool BinStream::readVarI64(std::int64_t& v) { return read_var_as(buf_.data(), buf_.size(), rd_, v); }
+
     bool BinStream::readStr(std::string& s) {
         std::uint32_t n = 0;
         if (!readU32(n)) return false;
@@ -145,4 +228,133 @@ namespace Util{
     }
 
 
+    // ---------------- MappedFile ----------------
+    Ref<const MappedFile> MappedFile::open(const char* path) {
+        Ref<MappedFile> m(new MappedFile());
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return nullptr;
+        m->file_ = file;
+        LARGE_INTEGER len{};
+        if (!GetFileSizeEx(file, &len)) return nullptr;
+        m->size_ = static_cast<std::size_t>(len.QuadPart);
+        if (m->size_ == 0) return m; // empty files can't be mapped
+        m->mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!m->mapping_) return nullptr;
+        m->data_ = static_cast<const Byte*>(MapViewOfFile(m->mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!m->data_) return nullptr;
+#elif defined(AQ_HAS_MMAP)
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return nullptr;
+        struct stat st {};
+        if (fstat(fd, &st) != 0) { ::close(fd); return nullptr; }
+        m->size_ = static_cast<std::size_t>(st.st_size);
+        if (m->size_ > 0) {
+            void* p = mmap(nullptr, m->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) { ::close(fd); return nullptr; }
+            m->data_ = static_cast<const Byte*>(p);
+        }
+        ::close(fd); // the mapping keeps its own reference to the file
+#else
+        BinStream tmp;
+        if (!tmp.loadFile(path)) return nullptr;
+        m->fallback_ = tmp.release();
+        m->data_ = m->fallback_.data();
+        m->size_ = m->fallback_.size();
+#endif
+        return m;
+    }
+
+    MappedFile::~MappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(static_cast<HANDLE>(mapping_));
+        if (file_) CloseHandle(static_cast<HANDLE>(file_));
+#elif defined(AQ_HAS_MMAP)
+        if (data_) munmap(const_cast<Byte*>(data_), size_);
+#endif
+    }
+
+    // ---------------- BinView ----------------
+    BinView::BinView(std::span<const Byte> data, Ref<const void> keepAlive)
+        : data_(data), rd_(0), keep_(std::move(keepAlive)) {}
+
+    bool BinView::mapFile(const char* path) {
+        Ref<const MappedFile> m = MappedFile::open(path);
+        if (!m) return false;
+        data_ = m->bytes();
+        keep_ = std::move(m);
+        rd_ = 0;
+        return true;
+    }
+
+    template <class T>
+    bool BinView::readLE(T& v) {
+        static_assert(std::is_trivially_copyable_v<T>, "readLE requires POD");
+        if (sizeof(T) > remaining()) return false;
+        std::memcpy(&v, data_.data() + rd_, sizeof(T));
+        rd_ += sizeof(T);
+        return true;
+    }
+
+    bool BinView::readBytes(void* out, std::size_t n) {
+        if (n > remaining()) return false;
+        if (n) std::memcpy(out, data_.data() + rd_, n);
+        rd_ += n;
+        return true;
+    }
+    bool BinView::skip(std::size_t n) {
+        if (n > remaining()) return false;
+        rd_ += n;
+        return true;
+    }
+    std::size_t BinView::remaining() const { return data_.size() - rd_; }
+    bool BinView::eof() const { return rd_ == data_.size(); }
+
+    bool BinView::readU8(std::uint8_t& v) { return readLE(v); }
+    bool BinView::readI8(std::int8_t& v) { return readLE(v); }
+    bool BinView::readU16(std::uint16_t& v) { return readLE(v); }
+    bool BinView::readI16(std::int16_t& v) { return readLE(v); }
+    bool BinView::readU32(std::uint32_t& v) { return readLE(v); }
+    bool BinView::readI32(std::int32_t& v) { return readLE(v); }
+    bool BinView::readU64(std::uint64_t& v) { return readLE(v); }
+    bool BinView::readI64(std::int64_t& v) { return readLE(v); }
+    bool BinView::readF32(float& v) { return readLE(v); }
+    bool BinView::readF64(double& v) { return readLE(v); }
+
+    bool BinView::readVarU32(std::uint32_t& v) { return read_var_as(data_.data(), data_.size(), rd_, v); }
+    bool BinView::readVarU64(std::uint64_t& v) { return read_var_as(data_.data(), data_.size(), rd_, v); }
+    bool BinView::readVarI32(std::int32_t& v) { return read_var_as(data_.data(), data_.size(), rd_, v); }
+    bool BinView::readVarI64(std::int64_t& v) { return read_var_as(data_.data(), data_.size(), rd_, v); }
+
+    bool BinView::readStr(std::string& s) {
+        std::string_view sv;
+        if (!readStrView(sv)) return false;
+        s.assign(sv);
+        return true;
+    }
+
+    bool BinView::readStrView(std::string_view& s) {
+        const std::size_t start = rd_;
+        std::uint32_t n = 0;
+        if (!readU32(n)) return false;
+        if (n > remaining()) { rd_ = start; return false; }
+        s = std::string_view(reinterpret_cast<const char*>(data_.data() + rd_), n);
+        rd_ += n;
+        return true;
+    }
+
+    bool BinView::readView(std::size_t n, BinView& out) {
+        if (n > remaining()) return false;
+        out = BinView(data_.subspan(rd_, n), keep_);
+        rd_ += n;
+        return true;
+    }
+
+    bool BinView::seek(std::size_t pos) {
+        if (pos > data_.size()) return false;
+        rd_ = pos;
+        return true;
+    }
+
 }
\ No newline at end of file
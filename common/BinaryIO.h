@@ -1,10 +1,54 @@
 #pragma once
 
+#include <span>
+#include <string_view>
+#include <bit>
 
 namespace Util {
 
     using Byte = std::uint8_t;
 
+    // Bulk readers shared by BinStream and BinView. Reader needs remaining(),
+    // readBytes(), readVarI64(), tell() and seek().
+    namespace detail {
+        template<class T>
+        void swapElements(std::span<T> values)
+        {
+            for (T& v : values) {
+                Byte* b = reinterpret_cast<Byte*>(&v);
+                std::reverse(b, b + sizeof(T));
+            }
+        }
+
+        template<class Reader, class T>
+        bool readArray(Reader& r, std::span<T> out)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "readArray requires POD");
+            if (out.size() > r.remaining() / sizeof(T)) return false;
+            r.readBytes(out.data(), out.size_bytes());
+            if constexpr (std::endian::native != std::endian::little && sizeof(T) > 1) swapElements(out);
+            return true;
+        }
+
+        template<class Reader, class T>
+        bool readDelta(Reader& r, std::span<T> out)
+        {
+            static_assert(std::is_integral_v<T>, "readDelta requires integers");
+            const std::size_t start = r.tell();
+            std::uint64_t prev = 0;
+            for (T& v : out) {
+                std::int64_t d = 0;
+                if (!r.readVarI64(d)) {
+                    r.seek(start);
+                    return false;
+                }
+                prev += static_cast<std::uint64_t>(d);
+                v = static_cast<T>(prev);
+            }
+            return true;
+        }
+    }
+
     class BinStream {
     public:
         BinStream();
@@ -29,6 +73,43 @@ namespace Util {
         // Writes: [u32 length][bytes], no null terminator
         void writeStr(const std::string& s);
 
+        // ---------------- bulk / variable-length write ----------------
+        // Raw little-endian elements, one memcpy on little-endian hosts. No count is
+        // written; store it first if the reader can't know it.
+        template<class T>
+        void writeArray(std::span<const T> values)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "writeArray requires POD");
+            if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1) {
+                writeBytes(values.data(), values.size_bytes());
+            }
+            else {
+                static_assert(std::is_arithmetic_v<T>, "writeArray of structs needs a little-endian host");
+                for (const T& v : values) writeSwapped(&v, sizeof(T));
+            }
+        }
+
+        // LEB128: 7 bits per byte, high bit set on all but the last
+        void writeVarU32(std::uint32_t v);
+        void writeVarU64(std::uint64_t v);
+        // Zigzag-mapped so small negative values stay short
+        void writeVarI32(std::int32_t v);
+        void writeVarI64(std::int64_t v);
+
+        // Each element as the zigzag varint of its difference from the previous one
+        // (the first from 0): sorted ids, offsets and timestamps shrink to ~1 byte each.
+        template<class T>
+        void writeDelta(std::span<const T> values)
+        {
+            static_assert(std::is_integral_v<T>, "writeDelta requires integers");
+            std::uint64_t prev = 0;
+            for (const T v : values) {
+                const std::uint64_t cur = static_cast<std::uint64_t>(static_cast<std::int64_t>(v));
+                writeVarI64(static_cast<std::int64_t>(cur - prev)); // wraps consistently
+                prev = cur;
+            }
+        }
+
         // ---------------- read (from cursor) ----------------
         bool readBytes(void* out, std::size_t n);
         bool skip(std::size_t n);
@@ -50,8 +131,25 @@ namespace Util {
 
         bool readStr(std::string& s); // expects [u32 length][bytes]
 
+        // ---------------- bulk / variable-length read ----------------
+        // Fills `out` entirely or fails with the cursor and `out` unchanged
+        template<class T>
+        bool readArray(std::span<T> out) { return detail::readArray(*this, out); }
+
+        bool readVarU32(std::uint32_t& v);
+        bool readVarU64(std::uint64_t& v);
+        bool readVarI32(std::int32_t& v);
+        bool readVarI64(std::int64_t& v);
+
+        // Decodes in place, so on failure the cursor is restored but `out` may
+        // already hold the elements before the bad one
+        template<class T>
+        bool readDelta(std::span<T> out) { return detail::readDelta(*this, out); }
+
         // ---------------- buffer management ----------------
         void clear();                     // clears buffer, rd_ = 0
+        // Writes grow capacity geometrically on their own; reserve up front when the
+        // final size is known to avoid even those reallocations.
         void reserve(std::size_t cap);
         std::size_t size() const;         // bytes in buffer
         const std::vector<Byte>& buffer() const;
@@ -74,9 +172,112 @@ namespace Util {
         std::vector<Byte> release();             // move out, rd_=0
 
     private:
+        void writeSwapped(const void* v, std::size_t n); // big-endian hosts only
+
         std::vector<Byte> buf_;
         std::size_t rd_ = 0; // read cursor
     };
 
+    // Read-only memory mapping of a whole file. Unmapped when the last reference is
+    // dropped, so views into it stay valid for as long as someone holds the Ref.
+    class MappedFile {
+    public:
+        static Ref<const MappedFile> open(const char* path); // null on failure
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::span<const Byte> bytes() const { return { data_, size_ }; }
+
+    private:
+        MappedFile() = default;
+        const Byte* data_ = nullptr;
+        std::size_t size_ = 0;
+        std::vector<Byte> fallback_; // platforms without mmap read the file instead
+#ifdef _WIN32
+        void* file_ = nullptr;
+        void* mapping_ = nullptr;
+#endif
+    };
+
+    // Read-only cursor over bytes it does not own: a mapped file or any span. Same
+    // read API as BinStream, plus zero-copy access to arrays and strings. Views made
+    // by readView()/mapFile() share the owner handle, keeping the bytes alive.
+    class BinView {
+    public:
+        BinView() = default;
+        // keepAlive (optional) owns the bytes behind `data`
+        explicit BinView(std::span<const Byte> data, Ref<const void> keepAlive = nullptr);
+
+        // Map a whole file; replaces the view, rd_ = 0
+        bool mapFile(const char* path);
+
+        bool readBytes(void* out, std::size_t n);
+        bool skip(std::size_t n);
+        std::size_t remaining() const;
+        bool eof() const;
+
+        bool readU8(std::uint8_t& v);
+        bool readI8(std::int8_t& v);
+        bool readU16(std::uint16_t& v);
+        bool readI16(std::int16_t& v);
+        bool readU32(std::uint32_t& v);
+        bool readI32(std::int32_t& v);
+        bool readU64(std::uint64_t& v);
+        bool readI64(std::int64_t& v);
+
+        bool readF32(float& v);
+        bool readF64(double& v);
+
+        bool readStr(std::string& s);            // [u32 length][bytes], copied
+        bool readStrView(std::string_view& s);   // [u32 length][bytes], points into the view
+
+        // `count` elements of T in place, no copy. Fails (cursor unchanged) when out of
+        // bounds, when the data isn't aligned for T, or on big-endian hosts.
+        template<class T>
+        bool readSpan(std::size_t count, std::span<const T>& out)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "readSpan requires POD");
+            if constexpr (std::endian::native != std::endian::little) return false;
+            if (count > remaining() / sizeof(T)) return false;
+            const Byte* p = data_.data() + rd_;
+            if (reinterpret_cast<std::uintptr_t>(p) % alignof(T) != 0) return false;
+            out = { reinterpret_cast<const T*>(p), count };
+            rd_ += count * sizeof(T);
+            return true;
+        }
+
+        // Next n bytes as a sub-view sharing this view's owner
+        bool readView(std::size_t n, BinView& out);
+
+        // Copying counterparts of the BinStream bulk/varint readers
+        template<class T>
+        bool readArray(std::span<T> out) { return detail::readArray(*this, out); }
+
+        bool readVarU32(std::uint32_t& v);
+        bool readVarU64(std::uint64_t& v);
+        bool readVarI32(std::int32_t& v);
+        bool readVarI64(std::int64_t& v);
+
+        template<class T>
+        bool readDelta(std::span<T> out) { return detail::readDelta(*this, out); }
+
+        std::size_t size() const { return data_.size(); }
+        std::span<const Byte> bytes() const { return data_; }
+        const Ref<const void>& owner() const { return keep_; }
+
+        std::size_t tell() const { return rd_; }
+        bool seek(std::size_t pos);
+        void rewind() { rd_ = 0; }
+
+    private:
+        template<class T> bool readLE(T& v);
+
+        std::span<const Byte> data_;
+        std::size_t rd_ = 0;
+        Ref<const void> keep_;
+    };
+
 
 }
\ No newline at end of file
@@ -87,17 +87,30 @@ inline auto farmMax(auto a, auto b) {
 }
 
 
+#include "HandlePool.h"
+#include "SpscRing.h"
+#include "Cow.h"
 #include "Vector2.h"
 #include "TileVector.h"
+#include "Vector2Stream.h"
 #include "BinaryIO.h"
+#include "BinCompress.h"
+#include "AsyncSave.h"
 #include "Random.h"
 #include "Window.h"
 #include "RendererImage.h"
 #include "Renderer.h"
+#include "Palette.h"
 #include "Primitives.h"
 #include "Animation.h"
+#include "AnimMesh.h"
 #include "Helper.h"
 #include "AnimSerialization.h"
+#include "AnimPack.h"
+#include "AnimationRuntime.h"
+#include "AnimationController.h"
+#include "Particles.h"
+#include "SpriteLayer.h"
 #include "RenderGlyphs.h"
 #include "Text.h"
 #ifdef AVATARQUEST_ENABLE_AUDIO
@@ -109,6 +122,7 @@ inline auto farmMax(auto a, auto b) {
 #include "TileBank.h"
 #include "MapCamera.h"
 #include "TileMap.h"
+#include "TileLighting.h"
 #include "imgui.h"
 #include "imgui_impl_sdl3.h"
 #include "imgui_impl_sdlrenderer3.h"
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+// Copy-on-write value. share() hands out a read-only reference in O(1) (e.g. for a
+// save snapshot); edit() clones the value first if anyone else still holds one, so
+// readers on other threads keep seeing the state as it was when they took it.
+// The owner is single-threaded: only shared readers may live on other threads.
+template<typename T>
+class Cow {
+public:
+    Cow() : _value(std::make_shared<T>()) {}
+    explicit Cow(T value) : _value(std::make_shared<T>(std::move(value))) {}
+
+    const T& get() const { return *_value; }
+    const T* operator->() const { return _value.get(); }
+    const T& operator*() const { return *_value; }
+
+    std::shared_ptr<const T> share() const { return _value; }
+
+    T& edit()
+    {
+        if (_value.use_count() > 1) _value = std::make_shared<T>(std::as_const(*_value));
+        return *_value;
+    }
+
+    void reset(T value) { _value = std::make_shared<T>(std::move(value)); }
+
+    // True while a snapshot taken with share() is still alive
+    bool isShared() const { return _value.use_count() > 1; }
+
+private:
+    std::shared_ptr<T> _value;
+};
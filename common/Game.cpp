@@ -7,6 +7,7 @@ struct GameState {
 	bool gameRunning = true;
 	VectorRef<Game::UILayer> _layers;
 	Game::GameEvents _gameEvents;
+	Game::FrameStats _frameStats;
 };
 
 static GameState g_GameState{};
@@ -40,6 +41,21 @@ bool Game::shutDownGame()
 	}
 	g_GameState._layers.clear();
 
+	const auto& stats = g_GameState._frameStats;
+	if (stats.totalStalls > 0) {
+		SDL_Log("[FrameStats] %llu stalls over %llu frames, %.2f ms total, worst %.2f ms on %s",
+			(unsigned long long)stats.totalStalls, (unsigned long long)stats.frameIndex, stats.totalStallMs,
+			stats.worstStallMs, stats.worstStall ? stats.worstStall : "?");
+	}
+
+	// Finish any save still in flight before the rest of the engine goes away
+	AsyncSave::shutdown();
+	Renderer::shutdownAnimationControllers();
+	Renderer::shutdownAnimations();
+	Particles::shutdownParticles();
+	SpriteLayer::shutdownSprites();
+	TileLighting::shutdownLighting();
+
 	#ifdef AVATARQUEST_ENABLE_AUDIO
 	Sound::shutdown();
 	#endif
@@ -71,9 +87,20 @@ bool Game::runGameLoop()
 
 void Game::update(float deltaTime)
 {
+	auto& stats = g_GameState._frameStats;
+	stats.frameIndex++;
+	stats.frameMs = deltaTime * (1000.0f / 60.0f); // deltaTime is in 60fps frame units
+	stats.stallCount = 0;
+	stats.stallMs = 0.0f;
+
 	#ifdef AVATARQUEST_ENABLE_AUDIO
 	Sound::update();
 	#endif
+	AsyncSave::update();
+	// Advance every playhead before the layers so they see this frame's events
+	Renderer::updateAnimationControllers(deltaTime);
+	Renderer::updateAnimations(deltaTime);
+	Particles::updateParticles(deltaTime);
 	for (auto& layer : g_GameState._layers) {
 		layer->update(deltaTime);
 	}
@@ -81,11 +108,31 @@ void Game::update(float deltaTime)
 
 void Game::render(float deltaTime)
 {
+	// Palette swaps made during update reach their textures before drawing
+	Palette::updateIndexedImages();
 	for (auto& layer : g_GameState._layers) {
 		layer->render(deltaTime);
 	}
 }
 
+const Game::FrameStats& Game::getFrameStats()
+{
+	return g_GameState._frameStats;
+}
+
+void Game::recordStall(const char* what, float ms)
+{
+	auto& stats = g_GameState._frameStats;
+	stats.stallCount++;
+	stats.stallMs += ms;
+	stats.totalStalls++;
+	stats.totalStallMs += ms;
+	if (ms > stats.worstStallMs) {
+		stats.worstStallMs = ms;
+		stats.worstStall = what;
+	}
+}
+
 void Game::addlayer(Ref<UILayer>& layer) {
 	g_GameState._layers.push_back(layer);
 }
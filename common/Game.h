@@ -56,6 +56,21 @@ namespace Game
 		}
 	};
 
+	// Per-frame counters. Stall fields cover work that blocked the main thread
+	// (e.g. a font opened on first use) and reset at the start of each update;
+	// the totals and the worst stall are kept for the whole run and summarised
+	// in one log line at shutdown.
+	struct FrameStats {
+		uint64_t frameIndex = 0;
+		float frameMs = 0.0f;
+		int stallCount = 0;
+		float stallMs = 0.0f;
+		uint64_t totalStalls = 0;
+		float totalStallMs = 0.0f;
+		float worstStallMs = 0.0f;
+		const char* worstStall = nullptr;   // static label passed to recordStall
+	};
+
 	bool initGame(const char* settings);
 	bool shutDownGame();
 	bool runGameLoop();
@@ -64,6 +79,9 @@ namespace Game
 	void addlayer(Ref<UILayer>&);
 	void handleEvent(SDL_Event* event);
 	GameEvents& getGameEvents();
+	const FrameStats& getFrameStats();
+	// Record a main-thread stall of the given duration against the current frame
+	void recordStall(const char* what, float ms);
 	void endGameLoop();
 };
 
@@ -0,0 +1,141 @@
+#pragma once
+
+// Generational handles.
+// A handle packs a slot index (low bits) and the slot's generation (high bits)
+// into 32 bits. Releasing a slot bumps its generation, so any handle still
+// pointing at it is detected as stale instead of aliasing the next occupant.
+// Value 0 is never issued and means "no resource".
+template<typename Tag>
+struct Handle {
+    static constexpr uint32_t kIndexBits = 20;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1u;
+    static constexpr uint32_t kGenerationMask = (1u << (32 - kIndexBits)) - 1u;
+
+    uint32_t value = 0;
+
+    static constexpr Handle make(uint32_t index, uint32_t generation) {
+        return Handle{ (generation << kIndexBits) | (index & kIndexMask) };
+    }
+
+    constexpr uint32_t index() const { return value & kIndexMask; }
+    constexpr uint32_t generation() const { return value >> kIndexBits; }
+
+    constexpr bool isValid() const { return value != 0; }
+    constexpr explicit operator bool() const { return value != 0; }
+    constexpr bool operator==(const Handle& o) const { return value == o.value; }
+    constexpr bool operator!=(const Handle& o) const { return value != o.value; }
+};
+
+// Dense handle pool: values live contiguously in _dense (swap-removed on release),
+// a sparse slot table maps handle index -> dense position, and released slots are
+// recycled through a free list. create/get/release are O(1).
+// Pointers returned by get() are only valid until the next create/release.
+template<typename T, typename Tag = T>
+class HandlePool {
+public:
+    using HandleType = Handle<Tag>;
+
+    HandleType create(T value)
+    {
+        uint32_t index;
+        if (!_freeSlots.empty()) {
+            index = _freeSlots.back();
+            _freeSlots.pop_back();
+        }
+        else {
+            index = (uint32_t)_slots.size();
+            if (index > HandleType::kIndexMask) return HandleType{};
+            _slots.push_back(Slot{});
+        }
+
+        Slot& slot = _slots[index];
+        slot.dense = (uint32_t)_dense.size();
+        _dense.push_back(std::move(value));
+        _denseToSlot.push_back(index);
+        return HandleType::make(index, slot.generation);
+    }
+
+    T* get(HandleType h)
+    {
+        const Slot* slot = find(h);
+        return slot ? &_dense[slot->dense] : nullptr;
+    }
+
+    const T* get(HandleType h) const
+    {
+        const Slot* slot = find(h);
+        return slot ? &_dense[slot->dense] : nullptr;
+    }
+
+    bool contains(HandleType h) const { return find(h) != nullptr; }
+
+    // Returns false for null or stale handles.
+    bool release(HandleType h)
+    {
+        if (!find(h)) return false;
+        Slot& slot = _slots[h.index()];
+
+        const uint32_t last = (uint32_t)_dense.size() - 1;
+        if (slot.dense != last) {
+            _dense[slot.dense] = std::move(_dense[last]);
+            _denseToSlot[slot.dense] = _denseToSlot[last];
+            _slots[_denseToSlot[slot.dense]].dense = slot.dense;
+        }
+        _dense.pop_back();
+        _denseToSlot.pop_back();
+
+        slot.dense = kNoDense;
+        // Skip generation 0 so a recycled slot 0 never produces the null handle
+        slot.generation = (slot.generation + 1) & HandleType::kGenerationMask;
+        if (slot.generation == 0) slot.generation = 1;
+        _freeSlots.push_back(h.index());
+        return true;
+    }
+
+    // Visit every live value (dense order, not creation order)
+    template<typename Fn>
+    void forEach(Fn&& fn)
+    {
+        for (T& v : _dense) fn(v);
+    }
+
+    void clear()
+    {
+        for (uint32_t i = 0; i < (uint32_t)_slots.size(); ++i) {
+            Slot& slot = _slots[i];
+            if (slot.dense == kNoDense) continue;
+            slot.dense = kNoDense;
+            slot.generation = (slot.generation + 1) & HandleType::kGenerationMask;
+            if (slot.generation == 0) slot.generation = 1;
+            _freeSlots.push_back(i);
+        }
+        _dense.clear();
+        _denseToSlot.clear();
+    }
+
+    std::size_t size() const { return _dense.size(); }
+    bool empty() const { return _dense.empty(); }
+
+private:
+    static constexpr uint32_t kNoDense = 0xFFFFFFFFu;
+
+    struct Slot {
+        uint32_t dense = kNoDense;
+        uint32_t generation = 1;
+    };
+
+    const Slot* find(HandleType h) const
+    {
+        if (!h) return nullptr;
+        const uint32_t index = h.index();
+        if (index >= _slots.size()) return nullptr;
+        const Slot& slot = _slots[index];
+        if (slot.dense == kNoDense || slot.generation != h.generation()) return nullptr;
+        return &slot;
+    }
+
+    Vector<T> _dense;
+    Vector<uint32_t> _denseToSlot;
+    Vector<Slot> _slots;
+    Vector<uint32_t> _freeSlots;
+};
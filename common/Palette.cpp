@@ -0,0 +1,186 @@
+#include "Common.h"
+
+#include <cstring>
+
+namespace {
+    using namespace Palette;
+
+    const char* SkipSpace(const char* p, const char* end)
+    {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        return p;
+    }
+
+    // Non-negative integer; false if there is none
+    bool ParseInt(const char*& p, const char* end, int& out)
+    {
+        p = SkipSpace(p, end);
+        if (p >= end || *p < '0' || *p > '9') return false;
+        int v = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            v = v * 10 + (*p - '0');
+            if (v > 65535) return false;
+            ++p;
+        }
+        out = v;
+        return true;
+    }
+
+    bool StartsWith(const char* p, const char* end, const char* prefix)
+    {
+        const std::size_t n = std::strlen(prefix);
+        return (std::size_t)(end - p) >= n && std::memcmp(p, prefix, n) == 0;
+    }
+}
+
+bool Palette::parseGpl(const char* text, std::size_t length, ColorPalette& out)
+{
+    out = {};
+    if (!text) return false;
+    const char* p = text;
+    const char* end = text + length;
+    if (length >= 3 && (uint8_t)p[0] == 0xEF && (uint8_t)p[1] == 0xBB && (uint8_t)p[2] == 0xBF) p += 3;
+    if (!StartsWith(p, end, "GIMP Palette")) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "parseGpl: missing 'GIMP Palette' header");
+        return false;
+    }
+
+    int lineNo = 0;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', (std::size_t)(end - p)));
+        if (!eol) eol = end;
+        const char* line = SkipSpace(p, eol);
+        p = eol + 1;
+        if (lineNo++ == 0 || line == eol || *line == '#' || *line == '\r') continue;
+        if (StartsWith(line, eol, "Name:")) {
+            const char* name = SkipSpace(line + 5, eol);
+            const char* nameEnd = eol;
+            while (nameEnd > name && (nameEnd[-1] == '\r' || nameEnd[-1] == ' ')) --nameEnd;
+            out.name.assign(name, nameEnd);
+            continue;
+        }
+        if (StartsWith(line, eol, "Columns:")) continue;
+
+        int rgb[3];
+        const char* q = line;
+        if (!ParseInt(q, eol, rgb[0]) || !ParseInt(q, eol, rgb[1]) || !ParseInt(q, eol, rgb[2]) ||
+            rgb[0] > 255 || rgb[1] > 255 || rgb[2] > 255) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "parseGpl: bad colour on line %d", lineNo);
+            return false;
+        }
+        if (out.colors.size() == kMaxColors) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "parseGpl: more than %d colours", (int)kMaxColors);
+            return false;
+        }
+        out.colors.push_back({ (uint8_t)rgb[0], (uint8_t)rgb[1], (uint8_t)rgb[2], 255 });
+    }
+    return !out.colors.empty();
+}
+
+bool Palette::loadGpl(const char* filename, ColorPalette& out)
+{
+    std::size_t size = 0;
+    void* data = filename ? SDL_LoadFile(filename, &size) : nullptr;
+    if (!data) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "loadGpl: cannot read '%s'", filename ? filename : "(null)");
+        return false;
+    }
+    const bool ok = parseGpl(static_cast<const char*>(data), size, out);
+    SDL_free(data);
+    return ok;
+}
+
+bool Palette::quantize(const uint8_t* rgba, int width, int height, const ColorPalette& palette, IndexedPixels& out)
+{
+    if (!rgba || width <= 0 || height <= 0 || palette.colors.empty() || palette.colors.size() > kMaxColors) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "quantize: invalid image or palette");
+        return false;
+    }
+    out.width = width;
+    out.height = height;
+    const std::size_t count = (std::size_t)width * height;
+    out.indices.resize(count);
+
+    // Art tends to reuse few colours; remember each one's nearest entry
+    UMap<uint32_t, uint8_t> nearest;
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint8_t* px = rgba + i * 4;
+        if (px[3] < 128) {
+            out.indices[i] = kTransparentIndex;
+            continue;
+        }
+        const uint32_t key = (uint32_t)px[0] | ((uint32_t)px[1] << 8) | ((uint32_t)px[2] << 16);
+        auto it = nearest.find(key);
+        if (it == nearest.end()) {
+            int best = 0, bestDist = 3 * 255 * 255 + 1;
+            for (std::size_t c = 0; c < palette.colors.size(); ++c) {
+                const Renderer::Color& pc = palette.colors[c];
+                const int dr = (int)px[0] - pc.r, dg = (int)px[1] - pc.g, db = (int)px[2] - pc.b;
+                const int d = dr * dr + dg * dg + db * db;
+                if (d < bestDist) {
+                    bestDist = d;
+                    best = (int)c;
+                }
+            }
+            it = nearest.emplace(key, (uint8_t)best).first;
+        }
+        out.indices[i] = it->second;
+    }
+    return true;
+}
+
+uint32_t Palette::packRGBA(Renderer::Color c)
+{
+    const uint8_t bytes[4] = { c.r, c.g, c.b, c.a };
+    uint32_t packed;
+    std::memcpy(&packed, bytes, 4);
+    return packed;
+}
+
+Renderer::Color Palette::unpackRGBA(uint32_t packed)
+{
+    uint8_t bytes[4];
+    std::memcpy(bytes, &packed, 4);
+    return { bytes[0], bytes[1], bytes[2], bytes[3] };
+}
+
+void Palette::buildLut(const ColorPalette& palette, Lut& out)
+{
+    const std::size_t n = std::min(palette.colors.size(), kMaxColors);
+    for (std::size_t i = 0; i < 256; ++i) {
+        out.entries[i] = i < n ? packRGBA(palette.colors[i]) : packRGBA({ 0, 0, 0, 0 });
+    }
+}
+
+void Palette::remapLut(const Lut& base, const uint8_t* remap, Lut& out)
+{
+    // Through a copy so base and out may be the same table
+    Lut result;
+    for (int i = 0; i < 256; ++i) result.entries[i] = base.entries[remap[i]];
+    out = result;
+}
+
+void Palette::tintLut(const Lut& base, Renderer::Color multiply, Lut& out)
+{
+    for (int i = 0; i < 256; ++i) {
+        const Renderer::Color c = unpackRGBA(base.entries[i]);
+        out.entries[i] = packRGBA({ (uint8_t)(c.r * multiply.r / 255), (uint8_t)(c.g * multiply.g / 255),
+            (uint8_t)(c.b * multiply.b / 255), c.a });
+    }
+}
+
+void Palette::expand(const uint8_t* indices, std::size_t count, const Lut& lut, uint32_t* out)
+{
+    // A 1 KB table stays in L1; unrolling keeps four independent loads in flight
+    const uint32_t* table = lut.entries;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const uint32_t a = table[indices[i]], b = table[indices[i + 1]];
+        const uint32_t c = table[indices[i + 2]], d = table[indices[i + 3]];
+        out[i] = a;
+        out[i + 1] = b;
+        out[i + 2] = c;
+        out[i + 3] = d;
+    }
+    for (; i < count; ++i) out[i] = table[indices[i]];
+}
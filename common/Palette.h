@@ -0,0 +1,79 @@
+#pragma once
+
+// Palette-indexed art.
+// Indexed images keep a CPU copy of their pixels at 1 byte each, as indices into
+// a palette of up to 255 colours (index 255 is reserved for transparent pixels),
+// and expand them to RGBA through a 256-entry lookup table on upload. A palette
+// swap (night, poison, team colours) is just another table: the textures that
+// use it are re-expanded from the same indices instead of shipping recoloured
+// art. Textures bind to a palette slot; changing a slot's table marks those
+// textures dirty and updateIndexedImages() re-uploads only them.
+//
+// The RGBA8 texture stays resident, so an indexed image costs 5 bytes per pixel
+// against 4 for plain RGBA. It pays off once it replaces two or more recoloured
+// copies of the same art, not for art that only ever uses one palette.
+namespace Palette {
+
+    constexpr uint8_t kTransparentIndex = 255;
+    constexpr std::size_t kMaxColors = 255;
+
+    struct ColorPalette {
+        String name;
+        Vector<Renderer::Color> colors;     // alpha is always 255
+    };
+
+    // GIMP palette text: "GIMP Palette" header, optional Name:/Columns: lines,
+    // '#' comments, then "r g b [label]" per colour
+    bool parseGpl(const char* text, std::size_t length, ColorPalette& out);
+    bool loadGpl(const char* filename, ColorPalette& out);
+
+    struct IndexedPixels {
+        int width = 0;
+        int height = 0;
+        Vector<uint8_t> indices;            // row-major, width * height
+    };
+
+    // Nearest palette colour by squared RGB distance; alpha below 128 becomes
+    // kTransparentIndex. Art already drawn in the palette converts losslessly.
+    bool quantize(const uint8_t* rgba, int width, int height, const ColorPalette& palette, IndexedPixels& out);
+
+    // One packed RGBA8 value per index, bytes R, G, B, A in memory (the order
+    // of the renderer's RGBA32 textures)
+    struct Lut {
+        uint32_t entries[256] = {};
+    };
+    uint32_t packRGBA(Renderer::Color c);
+    Renderer::Color unpackRGBA(uint32_t packed);
+
+    // Palette colours, then transparent entries up to and including 255
+    void buildLut(const ColorPalette& palette, Lut& out);
+    // out[i] = base[remap[i]] (team colours, swapped ramps); remap has 256 entries
+    void remapLut(const Lut& base, const uint8_t* remap, Lut& out);
+    // Multiplies every colour (night, poison); alpha is kept
+    void tintLut(const Lut& base, Renderer::Color multiply, Lut& out);
+
+    // out[i] = lut[indices[i]]
+    void expand(const uint8_t* indices, std::size_t count, const Lut& lut, uint32_t* out);
+
+    // Renderer side (implemented with the renderer images). A slot that has no
+    // table yet takes the import palette of the first image loaded into it, and
+    // remembers that palette: loading into the slot with a different one logs an
+    // error and fails, since its indices would expand through the wrong table.
+    bool loadIndexedImageFromFile(const char* filename, const ColorPalette& palette, Renderer::ImageHandle& outImage, uint8_t slot = 0);
+    bool setSlotLut(uint8_t slot, const Lut& lut);
+    // Fails, with a logged error, when the slot has no table yet or was built from a
+    // different palette than the image
+    bool setImageSlot(Renderer::ImageHandle image, uint8_t slot);
+    // Re-expands and uploads dirty indexed textures; returns how many. Textures
+    // whose upload fails stay dirty for the next call.
+    int updateIndexedImages();
+
+    struct MemoryStats {
+        std::size_t images = 0;
+        std::size_t textureBytes = 0;       // resident RGBA8 textures, 4 bytes per pixel
+        std::size_t indexBytes = 0;         // CPU indices kept for re-expansion, 1 byte per pixel
+        std::size_t lutBytes = 0;           // slot tables in use
+        std::size_t totalBytes() const { return textureBytes + indexBytes + lutBytes; }
+    };
+    MemoryStats getIndexedMemoryStats();
+}
@@ -0,0 +1,434 @@
+#include "Common.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define AQ_PART_SSE2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define AQ_PART_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+    using namespace Particles;
+
+    // Particles per job on the parallel path
+    constexpr std::size_t kJobParticles = 4096;
+    constexpr float kMinLife = 1e-4f;
+
+    struct ParticleStore {
+        Vector<float> posX, posY, velX, velY, life, invLife, size;
+        uint32_t count = 0;
+
+        uint32_t capacity() const { return (uint32_t)life.size(); }
+
+        void allocate(uint32_t cap)
+        {
+            for (Vector<float>* v : { &posX, &posY, &velX, &velY, &life, &invLife, &size }) v->assign(cap, 0.0f);
+            count = 0;
+        }
+
+        ParticleArrays arrays()
+        {
+            return { posX.data(), posY.data(), velX.data(), velY.data(), life.data(), invLife.data(), size.data() };
+        }
+
+        // Order is not kept: the last live particle takes the slot
+        void swapRemove(uint32_t i)
+        {
+            const uint32_t last = --count;
+            if (i == last) return;
+            posX[i] = posX[last]; posY[i] = posY[last];
+            velX[i] = velX[last]; velY[i] = velY[last];
+            life[i] = life[last]; invLife[i] = invLife[last];
+            size[i] = size[last];
+        }
+    };
+
+    struct Emitter {
+        EmitterHandle self;
+        EmitterDesc desc;
+        Vector2 position;
+        float spawnCarry = 0.0f;    // fractional spawns left over from the last update
+        bool active = true;
+        bool finishing = false;
+        ParticleStore p;
+    };
+
+    HandlePool<Emitter, EmitterTag> s_emitters;
+    uint32_t s_rng = 0x9E3779B9u;
+
+    // xorshift32; effects only need cheap, well spread numbers
+    inline float Rand01()
+    {
+        s_rng ^= s_rng << 13;
+        s_rng ^= s_rng >> 17;
+        s_rng ^= s_rng << 5;
+        return (float)(s_rng >> 8) * (1.0f / 16777216.0f);
+    }
+
+    inline float RandRange(float a, float b) { return a + (b - a) * Rand01(); }
+
+    uint32_t Spawn(Emitter& e, uint32_t n)
+    {
+        ParticleStore& p = e.p;
+        n = std::min(n, p.capacity() - p.count);
+        const EmitterDesc& d = e.desc;
+        for (uint32_t k = 0; k < n; ++k) {
+            const uint32_t i = p.count++;
+            const float a = (d.angleDeg + (Rand01() - 0.5f) * d.spreadDeg) * 0.01745329251994329577f;
+            const float speed = RandRange(d.speedMin, d.speedMax);
+            const float life = std::max(kMinLife, RandRange(d.lifeMin, d.lifeMax));
+            p.posX[i] = e.position.x + RandRange(-d.spawnExtent.x, d.spawnExtent.x);
+            p.posY[i] = e.position.y + RandRange(-d.spawnExtent.y, d.spawnExtent.y);
+            p.velX[i] = std::cos(a) * speed;
+            p.velY[i] = std::sin(a) * speed;
+            p.life[i] = life;
+            p.invLife[i] = 1.0f / life;
+            p.size[i] = d.sizeStart;
+        }
+        return n;
+    }
+
+    inline ParticleMotion MotionFor(const EmitterDesc& d, float dt)
+    {
+        ParticleMotion m;
+        m.gravity = d.gravity;
+        m.damping = std::max(0.0f, 1.0f - d.drag * dt);
+        m.sizeStart = d.sizeStart;
+        m.sizeEnd = d.sizeEnd;
+        return m;
+    }
+
+    inline void IntegrateRange(const ParticleArrays& p, std::size_t i, std::size_t end, const ParticleMotion& m, float dt)
+    {
+        const float gx = m.gravity.x * dt, gy = m.gravity.y * dt;
+        const float sizeRange = m.sizeStart - m.sizeEnd;
+        for (; i < end; ++i) {
+            const float vx = (p.velX[i] + gx) * m.damping;
+            const float vy = (p.velY[i] + gy) * m.damping;
+            p.velX[i] = vx;
+            p.velY[i] = vy;
+            p.posX[i] += vx * dt;
+            p.posY[i] += vy * dt;
+            const float life = p.life[i] - dt;
+            p.life[i] = life;
+            p.size[i] = m.sizeEnd + sizeRange * life * p.invLife[i];
+        }
+    }
+
+    // Jobs for the parallel path. Worker w runs jobs w, w + n, w + 2n ... where
+    // n is workers + 1 (the caller takes slot 0).
+    struct Job {
+        ParticleArrays arrays;
+        ParticleMotion motion;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    struct WorkerPool {
+        Vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable wake;   // workers: new batch or stop
+        std::condition_variable done;   // caller: a worker finished its share
+        Vector<Job> jobs;
+        float dt = 0.0f;
+        uint64_t batch = 0;
+        int pending = 0;
+        bool stop = false;
+    };
+    WorkerPool s_pool;
+
+    void RunShare(std::size_t slot, std::size_t stride)
+    {
+        for (std::size_t j = slot; j < s_pool.jobs.size(); j += stride) {
+            const Job& job = s_pool.jobs[j];
+            integrateParticles(job.arrays, job.begin, job.end, job.motion, s_pool.dt);
+        }
+    }
+
+    // seen = the batch already done when the thread was started
+    void Worker(std::size_t slot, uint64_t seen)
+    {
+        for (;;) {
+            std::size_t stride;
+            {
+                std::unique_lock<std::mutex> lock(s_pool.mutex);
+                s_pool.wake.wait(lock, [&] { return s_pool.stop || s_pool.batch != seen; });
+                if (s_pool.stop) return;
+                seen = s_pool.batch;
+                stride = s_pool.threads.size() + 1;
+            }
+            // jobs and dt are not touched by the caller until pending is back to 0
+            RunShare(slot, stride);
+            std::scoped_lock<std::mutex> lock(s_pool.mutex);
+            if (--s_pool.pending == 0) s_pool.done.notify_one();
+        }
+    }
+
+    void StopWorkers()
+    {
+        {
+            std::scoped_lock<std::mutex> lock(s_pool.mutex);
+            s_pool.stop = true;
+        }
+        s_pool.wake.notify_all();
+        for (std::thread& t : s_pool.threads) t.join();
+        s_pool.threads.clear();
+        s_pool.stop = false;
+    }
+
+    void IntegrateParallel(float dt)
+    {
+        s_pool.jobs.clear();
+        s_emitters.forEach([&](Emitter& e) {
+            const ParticleMotion m = MotionFor(e.desc, dt);
+            for (std::size_t b = 0; b < e.p.count; b += kJobParticles) {
+                s_pool.jobs.push_back({ e.p.arrays(), m, b, std::min<std::size_t>(b + kJobParticles, e.p.count) });
+            }
+        });
+        if (s_pool.jobs.size() <= 1) {
+            for (const Job& job : s_pool.jobs) integrateParticles(job.arrays, job.begin, job.end, job.motion, dt);
+            return;
+        }
+
+        const std::size_t stride = s_pool.threads.size() + 1;
+        {
+            std::scoped_lock<std::mutex> lock(s_pool.mutex);
+            s_pool.dt = dt;
+            s_pool.pending = (int)s_pool.threads.size();
+            ++s_pool.batch;
+        }
+        s_pool.wake.notify_all();
+        RunShare(0, stride);
+        std::unique_lock<std::mutex> lock(s_pool.mutex);
+        s_pool.done.wait(lock, [] { return s_pool.pending == 0; });
+    }
+
+    Vector<ParticleBatch> s_batches;
+}
+
+void Particles::integrateParticlesScalar(const ParticleArrays& p, std::size_t begin, std::size_t end, const ParticleMotion& m, float dt)
+{
+    IntegrateRange(p, begin, end, m, dt);
+}
+
+#if defined(AQ_PART_SSE2)
+void Particles::integrateParticles(const ParticleArrays& p, std::size_t begin, std::size_t end, const ParticleMotion& m, float dt)
+{
+    const __m128 gx = _mm_set1_ps(m.gravity.x * dt), gy = _mm_set1_ps(m.gravity.y * dt);
+    const __m128 damp = _mm_set1_ps(m.damping), vdt = _mm_set1_ps(dt);
+    const __m128 s0 = _mm_set1_ps(m.sizeEnd), sr = _mm_set1_ps(m.sizeStart - m.sizeEnd);
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(p.velX + i), gx), damp);
+        const __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(p.velY + i), gy), damp);
+        _mm_storeu_ps(p.velX + i, vx);
+        _mm_storeu_ps(p.velY + i, vy);
+        _mm_storeu_ps(p.posX + i, _mm_add_ps(_mm_loadu_ps(p.posX + i), _mm_mul_ps(vx, vdt)));
+        _mm_storeu_ps(p.posY + i, _mm_add_ps(_mm_loadu_ps(p.posY + i), _mm_mul_ps(vy, vdt)));
+        const __m128 life = _mm_sub_ps(_mm_loadu_ps(p.life + i), vdt);
+        _mm_storeu_ps(p.life + i, life);
+        _mm_storeu_ps(p.size + i, _mm_add_ps(s0, _mm_mul_ps(_mm_mul_ps(sr, life), _mm_loadu_ps(p.invLife + i))));
+    }
+    IntegrateRange(p, i, end, m, dt);
+}
+#elif defined(AQ_PART_NEON)
+void Particles::integrateParticles(const ParticleArrays& p, std::size_t begin, std::size_t end, const ParticleMotion& m, float dt)
+{
+    const float32x4_t gx = vdupq_n_f32(m.gravity.x * dt), gy = vdupq_n_f32(m.gravity.y * dt);
+    const float32x4_t s0 = vdupq_n_f32(m.sizeEnd), vdt = vdupq_n_f32(dt);
+    const float sr = m.sizeStart - m.sizeEnd;
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const float32x4_t vx = vmulq_n_f32(vaddq_f32(vld1q_f32(p.velX + i), gx), m.damping);
+        const float32x4_t vy = vmulq_n_f32(vaddq_f32(vld1q_f32(p.velY + i), gy), m.damping);
+        vst1q_f32(p.velX + i, vx);
+        vst1q_f32(p.velY + i, vy);
+        vst1q_f32(p.posX + i, vaddq_f32(vld1q_f32(p.posX + i), vmulq_n_f32(vx, dt)));
+        vst1q_f32(p.posY + i, vaddq_f32(vld1q_f32(p.posY + i), vmulq_n_f32(vy, dt)));
+        const float32x4_t life = vsubq_f32(vld1q_f32(p.life + i), vdt);
+        vst1q_f32(p.life + i, life);
+        vst1q_f32(p.size + i, vaddq_f32(s0, vmulq_f32(vmulq_n_f32(life, sr), vld1q_f32(p.invLife + i))));
+    }
+    IntegrateRange(p, i, end, m, dt);
+}
+#else
+void Particles::integrateParticles(const ParticleArrays& p, std::size_t begin, std::size_t end, const ParticleMotion& m, float dt)
+{
+    IntegrateRange(p, begin, end, m, dt);
+}
+#endif
+
+Particles::EmitterHandle Particles::createEmitter(const EmitterDesc& desc, const Vector2& position)
+{
+    if (desc.maxParticles == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "createEmitter: maxParticles must be > 0");
+        return {};
+    }
+    Emitter e;
+    e.desc = desc;
+    e.position = position;
+    e.p.allocate(desc.maxParticles);
+    const EmitterHandle h = s_emitters.create(std::move(e));
+    if (Emitter* created = s_emitters.get(h)) created->self = h;
+    return h;
+}
+
+bool Particles::destroyEmitter(EmitterHandle h, bool finish)
+{
+    if (!finish) return s_emitters.release(h);
+    Emitter* e = s_emitters.get(h);
+    if (!e) return false;
+    e->active = false;
+    e->finishing = true;
+    return true;
+}
+
+bool Particles::setEmitterPosition(EmitterHandle h, const Vector2& position)
+{
+    Emitter* e = s_emitters.get(h);
+    if (!e) return false;
+    e->position = position;
+    return true;
+}
+
+bool Particles::setEmitterActive(EmitterHandle h, bool active)
+{
+    Emitter* e = s_emitters.get(h);
+    if (!e || e->finishing) return false;
+    e->active = active;
+    if (!active) e->spawnCarry = 0.0f;
+    return true;
+}
+
+uint32_t Particles::emitBurst(EmitterHandle h, uint32_t count)
+{
+    Emitter* e = s_emitters.get(h);
+    if (!e || e->finishing) return 0;
+    return Spawn(*e, count);
+}
+
+uint32_t Particles::getParticleCount(EmitterHandle h)
+{
+    const Emitter* e = s_emitters.get(h);
+    return e ? e->p.count : 0;
+}
+
+std::size_t Particles::getTotalParticleCount()
+{
+    std::size_t total = 0;
+    s_emitters.forEach([&](Emitter& e) { total += e.p.count; });
+    return total;
+}
+
+std::size_t Particles::getEmitterCount()
+{
+    return s_emitters.size();
+}
+
+void Particles::updateParticles(float dt)
+{
+    if (dt <= 0.0f || s_emitters.empty()) return;
+
+    if (s_pool.threads.empty()) {
+        s_emitters.forEach([&](Emitter& e) {
+            integrateParticles(e.p.arrays(), 0, e.p.count, MotionFor(e.desc, dt), dt);
+        });
+    }
+    else {
+        IntegrateParallel(dt);
+    }
+
+    Vector<EmitterHandle> finished;
+    s_emitters.forEach([&](Emitter& e) {
+        ParticleStore& p = e.p;
+        for (uint32_t i = 0; i < p.count;) {
+            if (p.life[i] <= 0.0f) p.swapRemove(i);
+            else ++i;
+        }
+        if (e.active && e.desc.rate > 0.0f) {
+            e.spawnCarry += e.desc.rate * dt;
+            const uint32_t n = (uint32_t)e.spawnCarry;
+            e.spawnCarry -= (float)n;
+            Spawn(e, n);
+        }
+        if (e.finishing && p.count == 0) finished.push_back(e.self);
+    });
+    for (EmitterHandle h : finished) s_emitters.release(h);
+}
+
+void Particles::setParticleWorkerCount(int workers)
+{
+    workers = std::clamp(workers, 0, 64);
+    if ((int)s_pool.threads.size() == workers) return;
+    StopWorkers();
+    s_pool.threads.reserve((std::size_t)workers);
+    for (int w = 0; w < workers; ++w) s_pool.threads.emplace_back(Worker, (std::size_t)w + 1, s_pool.batch);
+}
+
+int Particles::getParticleWorkerCount()
+{
+    return (int)s_pool.threads.size();
+}
+
+const Vector<Particles::ParticleBatch>& Particles::buildParticleBatches(const Vector2& offset)
+{
+    for (ParticleBatch& b : s_batches) b.quads = 0;
+
+    s_emitters.forEach([&](Emitter& e) {
+        const ParticleStore& p = e.p;
+        if (p.count == 0) return;
+        const EmitterDesc& d = e.desc;
+
+        ParticleBatch* batch = nullptr;
+        for (ParticleBatch& b : s_batches) {
+            if (b.image == d.image) { batch = &b; break; }
+        }
+        if (!batch) {
+            s_batches.push_back({});
+            batch = &s_batches.back();
+            batch->image = d.image;
+        }
+
+        const std::size_t first = batch->quads;
+        batch->quads += p.count;
+        if (batch->vertices.size() < batch->quads * 4) batch->vertices.resize(batch->quads * 4);
+        SDL_Vertex* v = batch->vertices.data() + first * 4;
+
+        const float c0[4] = { d.colorStart.r / 255.0f, d.colorStart.g / 255.0f, d.colorStart.b / 255.0f, d.colorStart.a / 255.0f };
+        const float dc[4] = { d.colorEnd.r / 255.0f - c0[0], d.colorEnd.g / 255.0f - c0[1], d.colorEnd.b / 255.0f - c0[2], d.colorEnd.a / 255.0f - c0[3] };
+        const float u0 = d.uv.x, v0 = d.uv.y, u1 = d.uv.x + d.uv.w, v1 = d.uv.y + d.uv.h;
+
+        for (uint32_t i = 0; i < p.count; ++i, v += 4) {
+            const float t = 1.0f - p.life[i] * p.invLife[i];   // 0 at spawn, 1 at death
+            const SDL_FColor c = { c0[0] + dc[0] * t, c0[1] + dc[1] * t, c0[2] + dc[2] * t, c0[3] + dc[3] * t };
+            const float h = p.size[i] * 0.5f;
+            const float x = p.posX[i] - offset.x, y = p.posY[i] - offset.y;
+            v[0] = { { x - h, y - h }, c, { u0, v0 } };
+            v[1] = { { x + h, y - h }, c, { u1, v0 } };
+            v[2] = { { x + h, y + h }, c, { u1, v1 } };
+            v[3] = { { x - h, y + h }, c, { u0, v1 } };
+        }
+    });
+
+    std::erase_if(s_batches, [](const ParticleBatch& b) { return b.quads == 0; });
+    return s_batches;
+}
+
+void Particles::clearParticles()
+{
+    s_emitters.clear();
+    s_batches.clear();
+}
+
+void Particles::shutdownParticles()
+{
+    StopWorkers();
+    clearParticles();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+// Particle effects (hit sparks, spells, weather).
+// Emitters live in a pool. Each one owns its particles as structure-of-arrays
+// (position, velocity, life, size) sized to maxParticles when it is created,
+// so spawning and dying never allocate: dead particles are swap-removed with
+// the last live one. Colour and size follow start -> end ramps over each
+// particle's life. updateParticles(dt) integrates every emitter with a SIMD
+// kernel, optionally split across worker threads. renderParticles() submits
+// one SDL_RenderGeometry call per texture.
+//
+// Times (life, rate) are in the units of the dt passed to updateParticles.
+namespace Particles {
+
+    struct EmitterDesc {
+        Renderer::ImageHandle image;            // null = untextured quads
+        SDL_FRect uv = { 0.0f, 0.0f, 1.0f, 1.0f };  // normalised source rect in the image
+        uint32_t maxParticles = 1024;
+        float rate = 0.0f;                      // continuous spawns per time unit (0 = bursts only)
+        float lifeMin = 0.5f;
+        float lifeMax = 1.0f;
+        float speedMin = 20.0f;
+        float speedMax = 60.0f;
+        float angleDeg = -90.0f;                // launch direction, 0 = +x, -90 = up on screen
+        float spreadDeg = 360.0f;               // full cone width around angleDeg
+        Vector2 spawnExtent;                    // spawn within +-extent of the emitter position
+        Vector2 gravity;
+        float drag = 0.0f;                      // fraction of velocity lost per time unit
+        float sizeStart = 4.0f;
+        float sizeEnd = 0.0f;
+        Renderer::Color colorStart = { 255, 255, 255, 255 };
+        Renderer::Color colorEnd = { 255, 255, 255, 0 };
+    };
+
+    struct EmitterTag;
+    using EmitterHandle = Handle<EmitterTag>;
+
+    EmitterHandle createEmitter(const EmitterDesc& desc, const Vector2& position);
+    // finish = stop spawning and release the emitter once its last particle dies
+    bool destroyEmitter(EmitterHandle h, bool finish = false);
+    bool setEmitterPosition(EmitterHandle h, const Vector2& position);
+    bool setEmitterActive(EmitterHandle h, bool active);
+    // Spawns up to count particles now (clamped to free capacity); returns how many
+    uint32_t emitBurst(EmitterHandle h, uint32_t count);
+    uint32_t getParticleCount(EmitterHandle h);
+    std::size_t getTotalParticleCount();
+    std::size_t getEmitterCount();
+
+    // Spawn, integrate and compact every emitter
+    void updateParticles(float dt);
+    // 0 = update on the calling thread (default). With workers the integration is
+    // split into chunks shared by the workers and the caller.
+    void setParticleWorkerCount(int workers);
+    int getParticleWorkerCount();
+
+    // Integration kernel over one range of parallel arrays:
+    //   vel = (vel + gravity * dt) * damping
+    //   pos += vel * dt
+    //   life -= dt
+    //   size = sizeEnd + (sizeStart - sizeEnd) * life * invLife
+    struct ParticleArrays {
+        float* posX = nullptr;
+        float* posY = nullptr;
+        float* velX = nullptr;
+        float* velY = nullptr;
+        float* life = nullptr;
+        const float* invLife = nullptr;     // 1 / initial life
+        float* size = nullptr;
+    };
+    struct ParticleMotion {
+        Vector2 gravity;
+        float damping = 1.0f;               // velocity multiplier for this step
+        float sizeStart = 0.0f;
+        float sizeEnd = 0.0f;
+    };
+    void integrateParticles(const ParticleArrays& p, std::size_t begin, std::size_t end, const ParticleMotion& m, float dt);
+    // Scalar reference (always available)
+    void integrateParticlesScalar(const ParticleArrays& p, std::size_t begin, std::size_t end, const ParticleMotion& m, float dt);
+
+    // Quads for one texture, ready for SDL_RenderGeometry with the shared
+    // index pattern from Renderer::getQuadIndices
+    struct ParticleBatch {
+        Renderer::ImageHandle image;
+        Vector<SDL_Vertex> vertices;        // 4 per particle
+        std::size_t quads = 0;
+    };
+    // Rebuilds and returns one batch per distinct image (storage is reused)
+    const Vector<ParticleBatch>& buildParticleBatches(const Vector2& offset = { 0.0f, 0.0f });
+    // Draws every emitter, offset subtracted from positions (implemented with the renderer)
+    void renderParticles(const Vector2& offset = { 0.0f, 0.0f });
+
+    // Destroys all emitters and their particles
+    void clearParticles();
+    // Also stops the worker threads
+    void shutdownParticles();
+}
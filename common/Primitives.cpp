@@ -1,7 +1,68 @@
-﻿#include "common.h"
+﻿#include "Common.h"
 
 namespace {
     constexpr float kPI = 3.14159265358979323846f;
+
+    // cos/sin of 2*pi*k/kTrigSteps. 768 is a multiple of every count on the
+    // autoSegments ladder, so those rims read the table directly.
+    constexpr uint32_t kTrigSteps = 768;
+    constexpr uint32_t kQuarterTurn = kTrigSteps / 4;
+    constexpr uint32_t kSegmentLadder[] = { 6, 8, 12, 16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 768 };
+    // Counts up to this are cached exactly (polygons need their side count); above
+    // it they round up to the ladder, so the cache holds at most a few hundred shapes
+    constexpr uint32_t kMaxExactSegments = 64;
+
+    struct TrigTable {
+        float c[kTrigSteps];
+        float s[kTrigSteps];
+        TrigTable() {
+            for (uint32_t k = 0; k < kTrigSteps; ++k) {
+                const double a = 6.283185307179586476925 * (double)k / (double)kTrigSteps;
+                c[k] = (float)std::cos(a);
+                s[k] = (float)std::sin(a);
+            }
+        }
+    };
+
+    const TrigTable& Trig() {
+        static const TrigTable table;
+        return table;
+    }
+
+    // Unit rim of S points, starting at 0 deg or -90 deg ("top")
+    void buildUnitRim(Uint32 S, bool top, Vector2Stream& out) {
+        if (kTrigSteps % S == 0) {
+            const TrigTable& t = Trig();
+            const uint32_t stride = kTrigSteps / S;
+            const uint32_t start = top ? kTrigSteps - kQuarterTurn : 0;
+            for (Uint32 i = 0; i < S; ++i) {
+                const uint32_t k = (start + i * stride) % kTrigSteps;
+                out.push_back({ t.c[k], t.s[k] });
+            }
+            return;
+        }
+        const double a0 = top ? -0.5 * 3.14159265358979323846 : 0.0;
+        for (Uint32 i = 0; i < S; ++i) {
+            const double a = a0 + 6.283185307179586476925 * (double)i / (double)S;
+            out.push_back({ (float)std::cos(a), (float)std::sin(a) });
+        }
+    }
+
+    inline Uint32 CachedSegments(Uint32 segments) {
+        if (segments <= kMaxExactSegments) return segments;
+        for (uint32_t s : kSegmentLadder) {
+            if (s >= segments) return s;
+        }
+        return kTrigSteps;
+    }
+
+    inline uint32_t ShapeKey(Renderer::UnitShapeKind kind, Uint32 segments) {
+        return (segments << 2) | (uint32_t)kind;
+    }
+
+    // Node-based map: entries never move, so returned references stay valid
+    UMap<uint32_t, Renderer::UnitShape> s_unitShapes;
+    Vector<int> s_quadIndices;
     inline float deg2rad(float d) { return d * (kPI / 180.f); }
     inline Uint32 clampSeg(Uint32 s, Uint32 minS = 3u) { return s < minS ? minS : s; }
     inline Uint32 clampSides(Uint32 n) { return n < 3u ? 3u : n; }
@@ -20,45 +81,93 @@ namespace {
         tri.reserve(rimCount * 3);
         for (int i = 1; i <= rimCount - 1; ++i) { tri.push_back(0); tri.push_back(i); tri.push_back(i + 1); }
     }
-    // Arc rim points inclusive end
+    // Arc rim points inclusive end. Arbitrary spans don't fit the cache: rotate a
+    // unit vector by the step angle instead of calling sin/cos per vertex.
     inline void buildArcPoints(Vector2 c, float r, float a0Deg, float a1Deg, Uint32 segs, Vector<Vector2>& pts) {
         pts.clear();
-        const float a0 = deg2rad(a0Deg), a1 = deg2rad(a1Deg);
-        const float span = a1 - a0; const Uint32 S = clampSeg(segs, 2u);
+        const Uint32 S = clampSeg(segs, 2u);
+        const double a0 = (double)deg2rad(a0Deg);
+        const double step = ((double)deg2rad(a1Deg) - a0) / (double)S;
+        const double cs = std::cos(step), ss = std::sin(step);
+        double x = std::cos(a0), y = std::sin(a0);
         pts.reserve(S + 1);
         for (Uint32 i = 0; i <= S; ++i) {
-            float t = float(i) / float(S), a = a0 + span * t;
-            pts.push_back({ c.x + r * std::cos(a), c.y + r * std::sin(a) });
+            pts.push_back({ c.x + r * (float)x, c.y + r * (float)y });
+            const double nx = x * cs - y * ss;
+            y = y * cs + x * ss;
+            x = nx;
         }
     }
+
+    // Scale + rotate a cached unit shape into the caller's vectors
+    inline void placeShape(Renderer::UnitShapeKind kind, Uint32 S, Vector2 c, Vector2 ax, Vector2 ay,
+        Vector<Vector2>& pts, Vector<int>& idx) {
+        const Renderer::UnitShape& u = Renderer::getUnitShape(kind, S);
+        Renderer::transformUnitShape(u, c, ax, ay, pts);
+        idx.assign(u.indices.begin(), u.indices.end());
+    }
+    inline void placeRotated(Renderer::UnitShapeKind kind, Uint32 S, Vector2 c, float r, float rotDeg,
+        Vector<Vector2>& pts, Vector<int>& idx) {
+        const float a = deg2rad(rotDeg);
+        const float ca = std::cos(a) * r, sa = std::sin(a) * r;
+        placeShape(kind, S, c, { ca, sa }, { -sa, ca }, pts, idx);
+    }
 }
 
 namespace Renderer {
 
-    // ---------- OUTLINES ----------
-    void makeCircle(Vector2 c, float radius, Uint32 segments, Vector<Vector2>& pts, Vector<int>& idx) {
-        const float r = std::max(radius, 0.001f);
-        const uint32_t S = std::max<uint32_t>(3, segments);
+    // ---------- UNIT SHAPE CACHE ----------
+    const UnitShape& getUnitShape(UnitShapeKind kind, Uint32 segments) {
+        const Uint32 S = CachedSegments(clampSeg(segments));
+        auto it = s_unitShapes.find(ShapeKey(kind, S));
+        if (it != s_unitShapes.end()) return it->second;
+
+        UnitShape u;
+        const bool fan = kind == UnitShapeKind::Fan || kind == UnitShapeKind::FanTopClosed;
+        const bool top = kind == UnitShapeKind::RingTop || kind == UnitShapeKind::FanTopClosed;
+        u.points.reserve(S + (fan ? 1 : 0));
+        if (fan) u.points.push_back({ 0.0f, 0.0f });
+        buildUnitRim(S, top, u.points);
+        if (fan) {
+            buildFanIdx((int)S, u.indices);
+            // close last: (0,S,1)
+            if (kind == UnitShapeKind::FanTopClosed) { u.indices.push_back(0); u.indices.push_back((int)S); u.indices.push_back(1); }
+        }
+        else {
+            buildPolylineIdx((int)S, true, u.indices);
+        }
+        return s_unitShapes.emplace(ShapeKey(kind, S), std::move(u)).first->second;
+    }
 
-        pts.clear(); pts.reserve(S);
-        idx.clear(); idx.reserve(S * 2);
+    void transformUnitShape(const UnitShape& shape, Vector2 c, Vector2 ax, Vector2 ay, Vector<Vector2>& pts) {
+        Vector2Batch::transform(shape.points, Vector2Batch::makeAffine(c, ax, ay), pts);
+    }
 
-        // Start at -90° so a vertex points “up”; equal angular spacing
-        const float a0 = -0.5f * M_PI;
-        const float step = M_TAU / (float)S;
+    std::size_t getUnitShapeCacheSize() {
+        return s_unitShapes.size();
+    }
 
-        for (uint32_t i = 0; i < S; ++i) {
-            const float a = a0 + step * (float)i; // ensure (float) cast
-            const float ca = std::cos(a);
-            const float sa = std::sin(a);
-            pts.push_back({ c.x + r * ca, c.y + r * sa });
-        }
+    void clearUnitShapeCache() {
+        s_unitShapes.clear();
+    }
 
-        // Closed ring as line list (i, i+1), last wraps to 0
-        for (int i = 0; i < (int)S; ++i) {
-            const int j = (i + 1) % (int)S;
-            idx.push_back(i); idx.push_back(j);
+    const int* getQuadIndices(std::size_t quads) {
+        std::size_t have = s_quadIndices.size() / 6;
+        if (have < quads) {
+            s_quadIndices.reserve(quads * 6);
+            for (; have < quads; ++have) {
+                const int b = (int)(have * 4);
+                for (int k : { 0, 1, 2, 0, 2, 3 }) s_quadIndices.push_back(b + k);
+            }
         }
+        return s_quadIndices.data();
+    }
+
+    // ---------- OUTLINES ----------
+    void makeCircle(Vector2 c, float radius, Uint32 segments, Vector<Vector2>& pts, Vector<int>& idx) {
+        const float r = std::max(radius, 0.001f);
+        // Starts at -90° so a vertex points “up”; equal angular spacing
+        placeShape(UnitShapeKind::RingTop, std::max<uint32_t>(3, segments), c, { r, 0.0f }, { 0.0f, r }, pts, idx);
     }
 
     void makeArc(Vector2 c, float r, float a0Deg, float a1Deg, Uint32 segs,
@@ -87,25 +196,12 @@ namespace Renderer {
     }
 
     void makeEllipse(Vector2 c, float rx, float ry, Uint32 segs, Vector<Vector2>& pts, Vector<int>& idx) {
-        const Uint32 S = clampSeg(segs);
-        pts.clear(); pts.reserve(S);
-        for (Uint32 i = 0; i < S; ++i) {
-            float a = (2.f * kPI) * (float(i) / float(S));
-            pts.push_back({ c.x + rx * std::cos(a), c.y + ry * std::sin(a) });
-        }
-        buildPolylineIdx((int)pts.size(), true, idx);
+        placeShape(UnitShapeKind::Ring, clampSeg(segs), c, { rx, 0.0f }, { 0.0f, ry }, pts, idx);
     }
 
     // ---------- FILLED ----------
     void makeCircleFilled(Vector2 c, float r, Uint32 segs, Vector<Vector2>& pts, Vector<int>& tri) {
-        const Uint32 S = clampSeg(segs);
-        pts.clear(); pts.reserve(S + 1);
-        pts.push_back(c);
-        for (Uint32 i = 0; i < S; ++i) {
-            float a = (2.f * kPI) * (float(i) / float(S));
-            pts.push_back({ c.x + r * std::cos(a), c.y + r * std::sin(a) });
-        }
-        buildFanIdx((int)S, tri);
+        placeShape(UnitShapeKind::Fan, clampSeg(segs), c, { r, 0.0f }, { 0.0f, r }, pts, tri);
     }
 
     void makeArcFilled(Vector2 c, float r, float a0Deg, float a1Deg, Uint32 segs,
@@ -134,47 +230,20 @@ namespace Renderer {
 
     void makeEllipseFilled(Vector2 c, float rx, float ry, Uint32 segs,
         Vector<Vector2>& pts, Vector<int>& tri) {
-        const Uint32 S = clampSeg(segs);
-        pts.clear(); pts.reserve(S + 1);
-        pts.push_back(c);
-        for (Uint32 i = 0; i < S; ++i) {
-            float a = (2.f * kPI) * (float(i) / float(S));
-            pts.push_back({ c.x + rx * std::cos(a), c.y + ry * std::sin(a) });
-        }
-        buildFanIdx((int)S, tri);
+        placeShape(UnitShapeKind::Fan, clampSeg(segs), c, { rx, 0.0f }, { 0.0f, ry }, pts, tri);
     }
 
     // ---------- REGULAR POLYGON ----------
     void makeRegularPolygon(Vector2 c, float r, Uint32 sides, float rotDeg,
         Vector<Vector2>& pts, Vector<int>& idx) {
-        const Uint32 N = clampSides(sides);
-        pts.clear(); pts.reserve(N);
-        idx.clear(); idx.reserve(N * 2);
-        const float start = deg2rad(rotDeg - 90.f);
-        const float step = 2.f * kPI / float(N);
-        for (Uint32 i = 0; i < N; ++i) {
-            float a = start + step * float(i);
-            pts.push_back({ c.x + r * std::cos(a), c.y + r * std::sin(a) });
-        }
-        buildPolylineIdx((int)N, true, idx);
+        placeRotated(UnitShapeKind::RingTop, clampSides(sides), c, r, rotDeg, pts, idx);
     }
 
     void makeRegularPolygonFilled(Vector2 c, float r, Uint32 sides, float rotDeg,
         Vector<Vector2>& pts, Vector<int>& tri) {
-        const Uint32 N = clampSides(sides);
-        pts.clear(); pts.reserve(N + 1);
-        tri.clear(); tri.reserve(N * 3);
-        pts.push_back(c);
-        const float start = deg2rad(rotDeg - 90.f);
-        const float step = 2.f * kPI / float(N);
-        for (Uint32 i = 0; i < N; ++i) {
-            float a = start + step * float(i);
-            pts.push_back({ c.x + r * std::cos(a), c.y + r * std::sin(a) });
-        }
-        buildFanIdx((int)N, tri);
-        // close last: (0,N,1)
-        tri.push_back(0); tri.push_back((int)N); tri.push_back(1);
+        placeRotated(UnitShapeKind::FanTopClosed, clampSides(sides), c, r, rotDeg, pts, tri);
     }
+
     uint32_t autoSegmentsForCircleWorld(float r, float L, uint32_t minS, uint32_t maxS)
     {
         r = std::max(r, 1.0f);
@@ -183,10 +252,13 @@ namespace Renderer {
         uint32_t s = (uint32_t)std::ceil(circ / L); // ← linear in radius
         if (s < minS) s = minS;
         if (s > maxS) s = maxS;
-        return s;
+        // Round up to the ladder; fall back to the largest step that still fits
+        uint32_t best = 0;
+        for (uint32_t q : kSegmentLadder) {
+            if (q > maxS) break;
+            if (q >= minS) best = q;
+            if (q >= s && q >= minS) return q;
+        }
+        return best ? best : s;
     }
 }
-
-
-
-
@@ -40,6 +40,35 @@ namespace Renderer {
     void makeRegularPolygonFilled(Vector2 center, float radius, Uint32 sides, float rotationDeg,
         Vector<Vector2>& pts, Vector<int>& tri);
 
+    // Segment count for edges of about L world units, rounded up to a fixed ladder
+    // (6, 8, 12, 16, 24 ... 768) so nearby radii share one cached unit shape.
     uint32_t autoSegmentsForCircleWorld(float r, float L, uint32_t minS, uint32_t maxS);
 
+    // Unit-space shapes, generated once per (kind, segment count) from a sin/cos
+    // table. The builders above only scale/rotate/translate them. Main thread only.
+    // Counts of 3..64 are exact; larger ones round up the autoSegments ladder (at
+    // most 768), which keeps the cache to a few hundred shapes whatever callers ask for.
+    enum struct UnitShapeKind : uint8_t {
+        RingTop,        // closed outline, first vertex at -90 deg (circle, polygon)
+        Ring,           // closed outline, first vertex at 0 deg (ellipse)
+        Fan,            // centre + rim from 0 deg as a fan (filled circle/ellipse)
+        FanTopClosed,   // centre + rim from -90 deg, fan closed back to the first rim vertex (filled polygon)
+    };
+
+    struct UnitShape {
+        Vector2Stream points;       // SoA so placing a shape is one batch affine
+        Vector<int> indices;
+    };
+
+    const UnitShape& getUnitShape(UnitShapeKind kind, Uint32 segments);
+    // pts[i] = center + axisX * p.x + axisY * p.y
+    void transformUnitShape(const UnitShape& shape, Vector2 center, Vector2 axisX, Vector2 axisY, Vector<Vector2>& pts);
+    std::size_t getUnitShapeCacheSize();
+    void clearUnitShapeCache();
+
+    // (0,1,2, 0,2,3) for each of at least quads quads, offset by 4 per quad. Shared
+    // by every quad-list SDL_RenderGeometry submit (particles, sprites); the
+    // pointer is valid until a call asks for more quads.
+    const int* getQuadIndices(std::size_t quads);
+
 }
\ No newline at end of file
@@ -1,9 +1,16 @@
 #include "Common.h"
 
 
-static inline float GLYPH_WIDTH() { return 0.60f; }
+static constexpr float GLYPH_WIDTH() { return 0.60f; }
 struct Seg { float x1, y1, x2, y2; };
-using Strokes = std::vector<Seg>;
+
+// Fixed-capacity stroke list; the widest glyph ('B') uses 7 segments
+constexpr int kMaxGlyphSegs = 8;
+struct GlyphStrokes {
+    uint8_t count = 0;
+    Seg segs[kMaxGlyphSegs]{};
+};
+using StrokeTable = std::array<GlyphStrokes, 128>; // indexed by ASCII code
 
 struct TextMetrics {
     float width;   // total horizontal extent
@@ -12,99 +19,172 @@ struct TextMetrics {
     float descent; // below baseline
 };
 
-static inline const std::unordered_map<char, Strokes>& StrokeAlphabet()
+static constexpr StrokeTable BuildStrokeAlphabet()
 {
-    static std::unordered_map<char, Strokes> map;
-    if (!map.empty()) return map;
-
-    const float w = GLYPH_WIDTH();
-    const float x0 = (1.0f - w) * 0.5f;
-    const float xL = x0;
-    const float xR = x0 + w;
-    const float xM = x0 + w * 0.5f;
-    const float top = 0.05f;
-    const float mid = 0.50f;
-    const float bot = 0.95f;
+    StrokeTable map{};
+
+    constexpr float w = GLYPH_WIDTH();
+    constexpr float x0 = (1.0f - w) * 0.5f;
+    constexpr float xL = x0;
+    constexpr float xR = x0 + w;
+    constexpr float xM = x0 + w * 0.5f;
+    constexpr float top = 0.05f;
+    constexpr float mid = 0.50f;
+    constexpr float bot = 0.95f;
 
     auto Hbar = [&](float y) { return Seg{ xL, y, xR, y }; };
+    auto set = [&](char c, std::initializer_list<Seg> segs) {
+        GlyphStrokes& g = map[(unsigned char)c];
+        g.count = 0;
+        for (const Seg& s : segs) g.segs[g.count++] = s;
+    };
 
     // Letters (subset, extend as needed)
-    map['A'] = { {xL, bot, xM, top}, {xR, bot, xM, top}, Hbar(mid) };
-    map['B'] = { {xL, top, xL, bot}, {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid}, {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} };
-    map['C'] = { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, bot, xR, bot} };
-    map['D'] = { {xL, top, xL, bot}, {xL, top, xR, mid}, {xR, mid, xL, bot} };
-    map['E'] = { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, mid, xR, mid}, {xL, bot, xR, bot} };
-    map['F'] = { {xL, top, xL, bot}, {xL, top, xR, top}, {xL, mid, xR * 0.9f, mid} };
-    map['H'] = { {xL, top, xL, bot}, {xR, top, xR, bot}, Hbar(mid) };
-    map['J'] = { {xR, top, xR, bot * 0.8f}, {xR, bot, xL, bot}, {xL, bot, xL, bot * 0.8f} };
-    map['L'] = { {xL, top, xL, bot}, {xL, bot, xR, bot} };
-    map['M'] = { {xL, bot, xL, top}, {xL, top, xM, mid}, {xM, mid, xR, top}, {xR, top, xR, bot} };
-    map['N'] = { {xL, bot, xL, top}, {xL, top, xR, bot}, {xR, bot, xR, top} };
-    map['O'] = { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top} };
-    map['P'] = { {xL, bot, xL, top}, {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid} };
-    map['Q'] = { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top}, {xM, mid, xR, bot} };
-    map['R'] = { {xL, bot, xL, top}, {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid}, {xL, mid, xR, bot} };
-    map['S'] = { {xR, top, xL, top}, {xL, top, xL, mid}, {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} };
-    map['T'] = { {xL, top, xR, top}, {xM, top, xM, bot} };
-    map['U'] = { {xL, top, xL, bot}, {xL, bot, xR, bot}, {xR, bot, xR, top} };
-    map['V'] = { {xL, top, xM, bot}, {xM, bot, xR, top} };
-    map['W'] = { {xL, top, xL, bot}, {xL, bot, xM, top}, {xM, top, xR, bot}, {xR, bot, xR, top} };
-    map['X'] = { {xL, top, xR, bot}, {xR, top, xL, bot} };
-    map['Y'] = { {xL, top, xM, mid}, {xR, top, xM, mid}, {xM, mid, xM, bot} };
-    map['Z'] = { {xL, top, xR, top}, {xR, top, xL, bot}, {xL, bot, xR, bot} };
-    map['G'] = { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, bot, xR, bot}, {xR, bot, xR, mid}, {xR, mid, xM, mid} };
-    map['I'] = { {xM, top, xM, bot}, {xL, top, xR, top}, {xL, bot, xR, bot} };
-    map['K'] = { {xL, top, xL, bot}, {xL, mid, xR, top}, {xL, mid, xR, bot} };
-    map[' '] = {};
+    set('A', { {xL, bot, xM, top}, {xR, bot, xM, top}, Hbar(mid) });
+    set('B', { {xL, top, xL, bot}, {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid}, {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} });
+    set('C', { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, bot, xR, bot} });
+    set('D', { {xL, top, xL, bot}, {xL, top, xR, mid}, {xR, mid, xL, bot} });
+    set('E', { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, mid, xR, mid}, {xL, bot, xR, bot} });
+    set('F', { {xL, top, xL, bot}, {xL, top, xR, top}, {xL, mid, xR * 0.9f, mid} });
+    set('H', { {xL, top, xL, bot}, {xR, top, xR, bot}, Hbar(mid) });
+    set('J', { {xR, top, xR, bot * 0.8f}, {xR, bot, xL, bot}, {xL, bot, xL, bot * 0.8f} });
+    set('L', { {xL, top, xL, bot}, {xL, bot, xR, bot} });
+    set('M', { {xL, bot, xL, top}, {xL, top, xM, mid}, {xM, mid, xR, top}, {xR, top, xR, bot} });
+    set('N', { {xL, bot, xL, top}, {xL, top, xR, bot}, {xR, bot, xR, top} });
+    set('O', { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top} });
+    set('P', { {xL, bot, xL, top}, {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid} });
+    set('Q', { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top}, {xM, mid, xR, bot} });
+    set('R', { {xL, bot, xL, top}, {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid}, {xL, mid, xR, bot} });
+    set('S', { {xR, top, xL, top}, {xL, top, xL, mid}, {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} });
+    set('T', { {xL, top, xR, top}, {xM, top, xM, bot} });
+    set('U', { {xL, top, xL, bot}, {xL, bot, xR, bot}, {xR, bot, xR, top} });
+    set('V', { {xL, top, xM, bot}, {xM, bot, xR, top} });
+    set('W', { {xL, top, xL, bot}, {xL, bot, xM, top}, {xM, top, xR, bot}, {xR, bot, xR, top} });
+    set('X', { {xL, top, xR, bot}, {xR, top, xL, bot} });
+    set('Y', { {xL, top, xM, mid}, {xR, top, xM, mid}, {xM, mid, xM, bot} });
+    set('Z', { {xL, top, xR, top}, {xR, top, xL, bot}, {xL, bot, xR, bot} });
+    set('G', { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, bot, xR, bot}, {xR, bot, xR, mid}, {xR, mid, xM, mid} });
+    set('I', { {xM, top, xM, bot}, {xL, top, xR, top}, {xL, bot, xR, bot} });
+    set('K', { {xL, top, xL, bot}, {xL, mid, xR, top}, {xL, mid, xR, bot} });
+    set(' ', {});
 
     // Digits
-    map['0'] = { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top} };
-    map['1'] = { {xM, top, xM, bot}, {xL, bot, xR, bot} };
-    map['2'] = { {xL, mid * 0.2f, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid}, {xL, mid, xL, bot}, {xL, bot, xR, bot} };
-    map['3'] = { {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL * 0.9f, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} };
-    map['4'] = { {xL, top, xL, mid}, {xL, mid, xR, mid}, {xR, top, xR, bot} };
-    map['5'] = { {xR, top, xL, top}, {xL, top, xL, mid}, {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} };
-    map['6'] = { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, bot, xR, bot}, {xR, bot, xR, mid}, {xR, mid, xL, mid} };
-    map['7'] = { {xL, top, xR, top}, {xR, top, xL, bot} };
-    map['8'] = { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top}, {xL, mid, xR, mid} };
-    map['9'] = { {xR, bot, xR, top}, {xR, top, xL, top}, {xL, top, xL, mid}, {xL, mid, xR, mid} };
+    set('0', { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top} });
+    set('1', { {xM, top, xM, bot}, {xL, bot, xR, bot} });
+    set('2', { {xL, mid * 0.2f, xR, top}, {xR, top, xR, mid}, {xR, mid, xL, mid}, {xL, mid, xL, bot}, {xL, bot, xR, bot} });
+    set('3', { {xL, top, xR, top}, {xR, top, xR, mid}, {xR, mid, xL * 0.9f, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} });
+    set('4', { {xL, top, xL, mid}, {xL, mid, xR, mid}, {xR, top, xR, bot} });
+    set('5', { {xR, top, xL, top}, {xL, top, xL, mid}, {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot} });
+    set('6', { {xR, top, xL, top}, {xL, top, xL, bot}, {xL, bot, xR, bot}, {xR, bot, xR, mid}, {xR, mid, xL, mid} });
+    set('7', { {xL, top, xR, top}, {xR, top, xL, bot} });
+    set('8', { {xL, top, xR, top}, {xR, top, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, top}, {xL, mid, xR, mid} });
+    set('9', { {xR, bot, xR, top}, {xR, top, xL, top}, {xL, top, xL, mid}, {xL, mid, xR, mid} });
 
     // Punctuation
     // Comma: small vertical stroke near bottom-left + small diagonal tail
-    map[','] = { {xM, bot - 0.1f, xM, bot}, {xM, bot, xM - 0.1f, bot + 0.1f} };
+    set(',', { {xM, bot - 0.1f, xM, bot}, {xM, bot, xM - 0.1f, bot + 0.1f} });
     // Period: tiny point at bottom-center
-  
-    map['.'] = { {xM, bot - 0.05f, xM, bot} };
-    map[';'] = { {xM, mid, xM, mid + 0.15f}, {xM, bot - 0.05f, xM, bot} };
-    map['-'] = { {xL, mid, xR, mid} };
-    map['='] = { {xL, mid - 0.1f, xR, mid - 0.1f}, {xL, mid + 0.1f, xR, mid + 0.1f} };
-    map['!'] = { {xM, top, xM, mid}, {xM, bot - 0.05f, xM, bot} };
-    map['@'] = { {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, mid}, {xM, mid, xM, bot * 0.9f} };
-    map['#'] = { {xL, mid - 0.2f, xR, mid - 0.2f}, {xL, mid + 0.2f, xR, mid + 0.2f}, {xM - 0.1f, top, xM - 0.1f, bot}, {xM + 0.1f, top, xM + 0.1f, bot} };
-    map['$'] = { {xM, top, xM, bot}, {xR, top, xL, top}, {xL, mid, xR, mid}, {xR, bot, xL, bot} };
-    map['%'] = { {xL, bot, xR, top}, {xL, top, xL, top + 0.05f}, {xR, bot, xR, bot - 0.05f} };
-    map['^'] = { {xL, mid, xM, top}, {xM, top, xR, mid} };
-    map['&'] = { {xR, top, xL, mid}, {xL, mid, xR, bot}, {xR, bot, xM, mid}, {xM, mid, xL, bot} };
-    map['*'] = { {xM, top, xM, bot}, {xL, mid, xR, mid}, {xL, top, xR, bot}, {xR, top, xL, bot} };
-    map['('] = { {xR, top, xL, mid}, {xL, mid, xR, bot} };
-    map[')'] = { {xL, top, xR, mid}, {xR, mid, xL, bot} };
+    set('.', { {xM, bot - 0.05f, xM, bot} });
+    set(';', { {xM, mid, xM, mid + 0.15f}, {xM, bot - 0.05f, xM, bot} });
+    set('-', { {xL, mid, xR, mid} });
+    set('=', { {xL, mid - 0.1f, xR, mid - 0.1f}, {xL, mid + 0.1f, xR, mid + 0.1f} });
+    set('!', { {xM, top, xM, mid}, {xM, bot - 0.05f, xM, bot} });
+    set('@', { {xL, mid, xR, mid}, {xR, mid, xR, bot}, {xR, bot, xL, bot}, {xL, bot, xL, mid}, {xM, mid, xM, bot * 0.9f} });
+    set('#', { {xL, mid - 0.2f, xR, mid - 0.2f}, {xL, mid + 0.2f, xR, mid + 0.2f}, {xM - 0.1f, top, xM - 0.1f, bot}, {xM + 0.1f, top, xM + 0.1f, bot} });
+    set('$', { {xM, top, xM, bot}, {xR, top, xL, top}, {xL, mid, xR, mid}, {xR, bot, xL, bot} });
+    set('%', { {xL, bot, xR, top}, {xL, top, xL, top + 0.05f}, {xR, bot, xR, bot - 0.05f} });
+    set('^', { {xL, mid, xM, top}, {xM, top, xR, mid} });
+    set('&', { {xR, top, xL, mid}, {xL, mid, xR, bot}, {xR, bot, xM, mid}, {xM, mid, xL, bot} });
+    set('*', { {xM, top, xM, bot}, {xL, mid, xR, mid}, {xL, top, xR, bot}, {xR, top, xL, bot} });
+    set('(', { {xR, top, xL, mid}, {xL, mid, xR, bot} });
+    set(')', { {xL, top, xR, mid}, {xR, mid, xL, bot} });
 
     return map;
 }
 
- void DrawStrokeGlyph(char ch,
-    float ox, float oy, float size,
-    float thickness, Renderer::Color color)
+static constexpr StrokeTable kStrokeAlphabet = BuildStrokeAlphabet();
+
+static inline const GlyphStrokes* FindGlyph(char ch)
 {
-    const auto& dict = StrokeAlphabet();
-    char key = (char)SDL_toupper((unsigned char)ch);
-    auto it = dict.find(key);
-    if (it == dict.end()) return;
-    for (const auto& s : it->second) {
-        Renderer::drawThickLine(ox + s.x1 * size, oy + s.y1 * size,
-            ox + s.x2 * size, oy + s.y2 * size,
-            thickness, color);
+    const unsigned char key = (unsigned char)SDL_toupper((unsigned char)ch);
+    if (key >= kStrokeAlphabet.size()) return nullptr;
+    const GlyphStrokes& g = kStrokeAlphabet[key];
+    return g.count ? &g : nullptr;
+}
+
+// ---------- expanded mesh cache ----------
+// Meshes are built in local space (pen origin at 0,0) and white; drawing only
+// offsets positions and applies the color, then submits one geometry call.
+struct StrokeMeshKey {
+    String text;
+    float size = 0.0f, thickness = 0.0f, spacing = 0.0f;
+    bool operator==(const StrokeMeshKey& o) const {
+        return size == o.size && thickness == o.thickness && spacing == o.spacing && text == o.text;
     }
+};
+
+struct StrokeMeshKeyHash {
+    std::size_t operator()(const StrokeMeshKey& k) const noexcept {
+        std::size_t h = std::hash<String>{}(k.text);
+        auto mix = [&h](float f) { h ^= std::hash<float>{}(f) + 0x9e3779b9 + (h << 6) + (h >> 2); };
+        mix(k.size); mix(k.thickness); mix(k.spacing);
+        return h;
+    }
+};
+
+struct StrokeMesh {
+    Vector<SDL_FPoint> points; // 4 per segment quad
+    Vector<int> indices;       // 6 per segment quad
+};
+
+static constexpr std::size_t kMaxCachedStrokeMeshes = 256;
+static std::unordered_map<StrokeMeshKey, StrokeMesh, StrokeMeshKeyHash> g_strokeMeshes;
+static Vector<SDL_Vertex> g_strokeScratch; // reused per draw
+
+static void AppendThickSegment(StrokeMesh& mesh, float x1, float y1, float x2, float y2, float thickness)
+{
+    // Same quad expansion as Renderer::drawThickLine
+    float dx = x2 - x1;
+    float dy = y2 - y1;
+    const float len = sqrtf(dx * dx + dy * dy);
+    if (len <= 0.0001f) return;
+    dx /= len;
+    dy /= len;
+    const float px = -dy * (thickness * 0.5f);
+    const float py = dx * (thickness * 0.5f);
+
+    const int base = (int)mesh.points.size();
+    mesh.points.push_back({ x1 + px, y1 + py });
+    mesh.points.push_back({ x2 + px, y2 + py });
+    mesh.points.push_back({ x2 - px, y2 - py });
+    mesh.points.push_back({ x1 - px, y1 - py });
+    const int quad[6] = { 0,1,2, 2,3,0 };
+    for (int q : quad) mesh.indices.push_back(base + q);
+}
+
+static const StrokeMesh& GetStrokeMesh(const std::string& text, float size, float thickness, float spacing)
+{
+    StrokeMeshKey key{ text, size, thickness, spacing };
+    auto it = g_strokeMeshes.find(key);
+    if (it != g_strokeMeshes.end()) return it->second;
+
+    // Simple bound: HUD strings are few, so drop everything when the cache fills up
+    if (g_strokeMeshes.size() >= kMaxCachedStrokeMeshes) g_strokeMeshes.clear();
+
+    StrokeMesh mesh;
+    const float advance = size * GLYPH_WIDTH() + spacing;
+    float penX = 0.0f;
+    for (char c : text) {
+        if (const GlyphStrokes* g = FindGlyph(c)) {
+            for (int i = 0; i < g->count; ++i) {
+                const Seg& s = g->segs[i];
+                AppendThickSegment(mesh, penX + s.x1 * size, s.y1 * size,
+                    penX + s.x2 * size, s.y2 * size, thickness);
+            }
+        }
+        penX += advance;
+    }
+    return g_strokeMeshes.emplace(std::move(key), std::move(mesh)).first->second;
 }
 
 void RendererGlyphs::DrawStrokeText(const std::string& text,
@@ -112,12 +192,22 @@ void RendererGlyphs::DrawStrokeText(const std::string& text,
     float thickness, float spacing,
     Renderer::Color color)
 {
-    float advance = size * GLYPH_WIDTH() + spacing;
-    float penX = x;
-    for (char c : text) {
-        DrawStrokeGlyph(c, penX, y, size, thickness, color);
-        penX += advance;
+    const StrokeMesh& mesh = GetStrokeMesh(text, size, thickness, spacing);
+    if (mesh.indices.empty()) return;
+
+    const SDL_FColor c = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+    g_strokeScratch.resize(mesh.points.size());
+    for (std::size_t i = 0; i < mesh.points.size(); ++i) {
+        g_strokeScratch[i] = SDL_Vertex{ { mesh.points[i].x + x, mesh.points[i].y + y }, c, { 0, 0 } };
     }
+    Renderer::drawGeometry(g_strokeScratch, mesh.indices);
+}
+
+void RendererGlyphs::ClearStrokeTextCache()
+{
+    g_strokeMeshes.clear();
+    g_strokeScratch.clear();
+    g_strokeScratch.shrink_to_fit();
 }
 
 static inline TextMetrics MeasureStrokeText(const std::string& text,
@@ -7,6 +7,9 @@ namespace RendererGlyphs {
         float thickness, float spacing,
         Renderer::Color color);
 
+    // Drop all cached stroke-text meshes (they are rebuilt on next draw)
+    void ClearStrokeTextCache();
+
     SDL_FRect MeasureStrokeTextRect(float x, float y,
         const std::string& text,
         float size,
@@ -93,8 +93,9 @@ bool Renderer::initRenderer(int width, int height)
 
 bool Renderer::shutDownRenderer()
 {
-    // Shutdown text subsystem before renderer destruction
+    // Shutdown text subsystem and release textures before renderer destruction
     Text::shutdown();
+    releaseAllImages();
     if (g_RenderState.sdlRenderer) {
         SDL_DestroyRenderer(g_RenderState.sdlRenderer);
         g_RenderState.sdlRenderer = nullptr;
@@ -120,8 +121,9 @@ void Renderer::drawThickLine(float x1, float y1, float x2, float y2, float thick
     return;
 }
 
-void Renderer::drawImage(Vector2 position, Vector2 scale, float rotation, Ref<Image> img, Color tint)
+void Renderer::drawImage(Vector2 position, Vector2 scale, float rotation, ImageHandle handle, Color tint)
 {
+    const Image* img = getImage(handle);
     if (!img || !img->texture) return;
     SDL_FRect destRect;
     destRect.w = img->imageRect.w * scale.x;
@@ -135,8 +137,9 @@ void Renderer::drawImage(Vector2 position, Vector2 scale, float rotation, Ref<Im
     //SDL_RenderCopyExF(g_RenderState.sdlRenderer, img->texture, &img->imageRect, &destRect, rotation, nullptr, SDL_FLIP_NONE);
 }
 
-void Renderer::drawImageFromRect(Vector2 position, Vector2 scale, float rotation, Ref<Image> img, const SDL_FRect& tileRect, Color tint)
+void Renderer::drawImageFromRect(Vector2 position, Vector2 scale, float rotation, ImageHandle handle, const SDL_FRect& tileRect, Color tint)
 {
+    const Image* img = getImage(handle);
     if (!img || !img->texture) return;
     SDL_FRect destRect;
     destRect.w = tileRect.w * scale.x;
@@ -211,6 +214,43 @@ void Renderer::drawPrimitiveList(const Vector<Vector2>& points, const Vector<int
 }
 
 
+void Renderer::drawGeometry(const Vector<SDL_Vertex>& verts, const Vector<int>& indices, SDL_Texture* texture)
+{
+    if (!g_RenderState.sdlRenderer || verts.empty() || indices.empty()) return;
+    SDL_RenderGeometry(g_RenderState.sdlRenderer, texture, verts.data(), (int)verts.size(), indices.data(), (int)indices.size());
+}
+
+void Particles::renderParticles(const Vector2& offset)
+{
+    if (!g_RenderState.sdlRenderer) return;
+    for (const ParticleBatch& b : buildParticleBatches(offset)) {
+        const Renderer::Image* img = Renderer::getImage(b.image);
+        const int* indices = Renderer::getQuadIndices(b.quads);
+        SDL_RenderGeometry(g_RenderState.sdlRenderer, img ? img->texture : nullptr,
+            b.vertices.data(), (int)(b.quads * 4), indices, (int)(b.quads * 6));
+    }
+}
+
+namespace {
+    Vector2 SpriteTextureSize(Renderer::ImageHandle h)
+    {
+        const Renderer::Image* img = Renderer::getImage(h);
+        return img ? Vector2{ (float)img->imageSize.w, (float)img->imageSize.h } : Vector2{ 0.0f, 0.0f };
+    }
+}
+
+void SpriteLayer::renderSprites()
+{
+    if (!g_RenderState.sdlRenderer) return;
+    buildSpriteRuns(&SpriteTextureSize);
+    const SDL_Vertex* vertices = getSpriteVertices().data();
+    for (const SpriteRun& run : getSpriteRuns()) {
+        const Renderer::Image* img = Renderer::getImage(run.image);
+        SDL_RenderGeometry(g_RenderState.sdlRenderer, img ? img->texture : nullptr,
+            vertices + (std::size_t)run.first * 4, (int)(run.count * 4),
+            Renderer::getQuadIndices(run.count), (int)(run.count * 6));
+    }
+}
 
 SDL_Renderer* Renderer::getRenderer()
 {
@@ -39,14 +39,16 @@ namespace  Renderer
 	bool drawFilledRect(float x, float y, float width, float height, Color color);
 	bool drawRect(float x, float y, float width, float height, Color color);
 	void drawThickLine(float x1, float y1, float x2, float y2, float thickness, Color color);
-	void drawImage(Vector2 position, Vector2 scale, float rotation, Ref<Image> img, Color tint = {255,255,255,255});
-	void drawImageFromRect(Vector2 position, Vector2 scale, float rotation, Ref<Image> img, const SDL_FRect& tileRect, Color tint = { 255,255,255,255 });
+	void drawImage(Vector2 position, Vector2 scale, float rotation, ImageHandle img, Color tint = {255,255,255,255});
+	void drawImageFromRect(Vector2 position, Vector2 scale, float rotation, ImageHandle img, const SDL_FRect& tileRect, Color tint = { 255,255,255,255 });
 	void beginRender();
 	void endRender();
 	void setClearColor(Color color);
 	// Set the renderer's draw blend mode (e.g., SDL_BLENDMODE_NONE, _BLEND, _ADD, _MOD, _MUL)
 	void setBlendMode(SDL_BlendMode mode);
 	void drawPrimitiveList(const Vector<Vector2>& points, const Vector<int>& indices, Color color, float thickness = 1.0f);
+	// Submit a prebuilt triangle list (i0,i1,i2, ...) in a single SDL_RenderGeometry call
+	void drawGeometry(const Vector<SDL_Vertex>& verts, const Vector<int>& indices, SDL_Texture* texture = nullptr);
 	SDL_Renderer* getRenderer();
 };
 
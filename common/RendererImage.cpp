@@ -1,4 +1,4 @@
-#include "common.h"
+#include "Common.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -6,26 +6,11 @@
 
 namespace Renderer
 {
-	bool loadImageFromFile(const char* filename, Ref<Renderer::Image>& newImage)
-	{
-        if (!filename || !*filename)
-            return false;
-
-        SDL_Renderer* renderer = Renderer::getRenderer();
-        if (!renderer)
-            return false;
-
-        // Optionally flip vertically if your art expects OpenGL-like origin.
-        // stbi_set_flip_vertically_on_load(1);
-
-        int width = 0, height = 0, channelsInFile = 0;
-        // Force 4 channels (RGBA) so we can use SDL_PIXELFORMAT_RGBA32
-        stbi_uc* pixels = stbi_load(filename, &width, &height, &channelsInFile, STBI_rgb_alpha);
-        if (!pixels) {
-            SDL_Log("stbi_load failed for '%s': %s", filename, stbi_failure_reason());
-            return false;
-        }
+    static HandlePool<Renderer::Image> g_images;
 
+    // Streaming RGBA32 texture with the sprite defaults
+    static SDL_Texture* CreateImageTexture(SDL_Renderer* renderer, int width, int height)
+    {
 #if SDL_BYTEORDER == SDL_LIL_ENDIAN
         SDL_PixelFormat sdlFmt = SDL_PIXELFORMAT_ABGR8888; // bytes: R,G,B,A in memory
 #else
@@ -38,25 +23,24 @@ namespace Renderer
             SDL_TEXTUREACCESS_STREAMING,  // streaming is safer for manual uploads
             width, height
         );
-
-
         if (!tex) {
             SDL_Log("SDL_CreateTexture failed: %s", SDL_GetError());
-            stbi_image_free(pixels);
-            return false;
+            return nullptr;
         }
 
         // Blend/scaling settings are optional but typical for sprites/UI
         SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
         SDL_SetTextureScaleMode(tex, SDL_SCALEMODE_LINEAR);
+        return tex;
+    }
 
-
+    // Copies tightly packed RGBA8 rows into the whole texture
+    static bool UploadPixels(SDL_Texture* tex, const void* pixels, int width, int height)
+    {
         void* dst = nullptr;
         int dstPitch = 0;
         if (SDL_LockTexture(tex, nullptr, &dst, &dstPitch) == false) {
             SDL_Log("SDL_LockTexture failed: %s", SDL_GetError());
-            SDL_DestroyTexture(tex);
-            stbi_image_free(pixels);
             return false;
         }
 
@@ -67,7 +51,7 @@ namespace Renderer
         }
         else {
             // Safe path: copy row-by-row
-            const uint8_t* srcRow = pixels;
+            const uint8_t* srcRow = static_cast<const uint8_t*>(pixels);
             uint8_t* dstRow = static_cast<uint8_t*>(dst);
             for (int y = 0; y < height; ++y) {
                 std::memcpy(dstRow, srcRow, srcPitch);
@@ -77,32 +61,252 @@ namespace Renderer
         }
 
         SDL_UnlockTexture(tex);
+        return true;
+    }
+
+    // Indexed images: CPU indices and palette slot per texture, keyed by handle
+    struct IndexedImage {
+        Palette::IndexedPixels pixels;
+        uint8_t slot = 0;
+        bool dirty = false;
+    };
+    static UMap<uint32_t, IndexedImage> g_indexedImages;
+    static Palette::Lut g_paletteSlots[256];
+    static bool g_paletteSlotSet[256] = {};
+    // Palette each slot's images were quantised against; empty until the first load
+    static Vector<Renderer::Color> g_slotPalettes[256];
+    static Vector<uint32_t> g_expandScratch;
+
+    static bool SamePalette(const Vector<Renderer::Color>& a, const Vector<Renderer::Color>& b)
+    {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (Palette::packRGBA(a[i]) != Palette::packRGBA(b[i])) return false;
+        }
+        return true;
+    }
+
+    static bool ExpandAndUpload(SDL_Texture* tex, const IndexedImage& indexed)
+    {
+        const Palette::IndexedPixels& px = indexed.pixels;
+        g_expandScratch.resize(px.indices.size());
+        Palette::expand(px.indices.data(), px.indices.size(), g_paletteSlots[indexed.slot], g_expandScratch.data());
+        return UploadPixels(tex, g_expandScratch.data(), px.width, px.height);
+    }
+
+	bool loadImageFromFile(const char* filename, ImageHandle& newImage)
+	{
+        if (!filename || !*filename)
+            return false;
+
+        SDL_Renderer* renderer = Renderer::getRenderer();
+        if (!renderer)
+            return false;
+
+        // Optionally flip vertically if your art expects OpenGL-like origin.
+        // stbi_set_flip_vertically_on_load(1);
+
+        int width = 0, height = 0, channelsInFile = 0;
+        // Force 4 channels (RGBA) so we can use SDL_PIXELFORMAT_RGBA32
+        stbi_uc* pixels = stbi_load(filename, &width, &height, &channelsInFile, STBI_rgb_alpha);
+        if (!pixels) {
+            SDL_Log("stbi_load failed for '%s': %s", filename, stbi_failure_reason());
+            return false;
+        }
+
+        SDL_Texture* tex = CreateImageTexture(renderer, width, height);
+        if (!tex || !UploadPixels(tex, pixels, width, height)) {
+            if (tex) SDL_DestroyTexture(tex);
+            stbi_image_free(pixels);
+            return false;
+        }
         // Were done with CPU-side pixels
         stbi_image_free(pixels);
 
         // Build the Image object
-        Ref<Renderer::Image> img = CreateRef<Renderer::Image>();
-        img->texture = tex;
-        img->imageSize = SDL_FRect{ 0, 0, (float)width, (float)height };
-		img->imageRect = SDL_FRect{ 0, 0, (float)width, (float)height };
-        img->format = SDL_PIXELFORMAT_RGBA32;
+        Renderer::Image img;
+        img.texture = tex;
+        img.imageSize = SDL_FRect{ 0, 0, (float)width, (float)height };
+		img.imageRect = SDL_FRect{ 0, 0, (float)width, (float)height };
+        img.format = SDL_PIXELFORMAT_RGBA32;
 
-        newImage = img;
+        newImage = g_images.create(img);
+        if (!newImage) {
+            SDL_Log("Image pool exhausted for '%s'", filename);
+            SDL_DestroyTexture(tex);
+            return false;
+        }
         return true;
 	}
-	bool releaseImage(Ref<Renderer::Image>& img)
+	bool releaseImage(ImageHandle& img)
 	{
-        if (!img)
+        Renderer::Image* image = g_images.get(img);
+        const ImageHandle released = img;
+        img = {};
+        if (!image)
             return false;
 
-        if (img->texture) {
-            SDL_DestroyTexture(img->texture);
-            img->texture = nullptr;
+        if (image->texture) {
+            SDL_DestroyTexture(image->texture);
         }
-        img->imageSize = SDL_FRect{ 0, 0, 0, 0 };
-        img->format = SDL_PIXELFORMAT_UNKNOWN;
-
-        img.reset(); // release Ref (shared_ptr/unique_ptr as you defined)
+        g_images.release(released);
+        g_indexedImages.erase(released.value);
         return true;
 	}
-}
\ No newline at end of file
+	const Image* getImage(ImageHandle img)
+	{
+        return g_images.get(img);
+	}
+	void releaseAllImages()
+	{
+        g_images.forEach([](Renderer::Image& image) {
+            if (image.texture) SDL_DestroyTexture(image.texture);
+        });
+        g_images.clear();
+        g_indexedImages.clear();
+        for (int slot = 0; slot < 256; ++slot) {
+            g_paletteSlotSet[slot] = false;
+            g_slotPalettes[slot].clear();
+        }
+	}
+}
+
+bool Palette::loadIndexedImageFromFile(const char* filename, const ColorPalette& palette, Renderer::ImageHandle& outImage, uint8_t slot)
+{
+    using namespace Renderer;
+    if (!filename || !*filename)
+        return false;
+
+    SDL_Renderer* renderer = Renderer::getRenderer();
+    if (!renderer)
+        return false;
+
+    // Indices are only meaningful against the palette they were quantised with
+    if (!g_slotPalettes[slot].empty() && !SamePalette(g_slotPalettes[slot], palette.colors)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "loadIndexedImageFromFile: '%s' uses a different palette than slot %d was built from", filename, (int)slot);
+        return false;
+    }
+
+    // stb expands indexed PNGs to RGBA; quantising against the same palette
+    // recovers their indices exactly
+    int width = 0, height = 0, channelsInFile = 0;
+    stbi_uc* pixels = stbi_load(filename, &width, &height, &channelsInFile, STBI_rgb_alpha);
+    if (!pixels) {
+        SDL_Log("stbi_load failed for '%s': %s", filename, stbi_failure_reason());
+        return false;
+    }
+    IndexedImage indexed;
+    indexed.slot = slot;
+    const bool quantized = quantize(pixels, width, height, palette, indexed.pixels);
+    stbi_image_free(pixels);
+    if (!quantized)
+        return false;
+
+    if (!g_paletteSlotSet[slot]) {
+        buildLut(palette, g_paletteSlots[slot]);
+        g_paletteSlotSet[slot] = true;
+    }
+
+    SDL_Texture* tex = CreateImageTexture(renderer, width, height);
+    if (!tex || !ExpandAndUpload(tex, indexed)) {
+        if (tex) SDL_DestroyTexture(tex);
+        return false;
+    }
+
+    Renderer::Image img;
+    img.texture = tex;
+    img.imageSize = SDL_FRect{ 0, 0, (float)width, (float)height };
+    img.imageRect = SDL_FRect{ 0, 0, (float)width, (float)height };
+    img.format = SDL_PIXELFORMAT_RGBA32;
+
+    outImage = g_images.create(img);
+    if (!outImage) {
+        SDL_Log("Image pool exhausted for '%s'", filename);
+        SDL_DestroyTexture(tex);
+        return false;
+    }
+    g_indexedImages[outImage.value] = std::move(indexed);
+    if (g_slotPalettes[slot].empty())
+        g_slotPalettes[slot] = palette.colors;
+    return true;
+}
+
+bool Palette::setSlotLut(uint8_t slot, const Lut& lut)
+{
+    using namespace Renderer;
+    g_paletteSlots[slot] = lut;
+    g_paletteSlotSet[slot] = true;
+    for (auto& [handle, indexed] : g_indexedImages) {
+        if (indexed.slot == slot) indexed.dirty = true;
+    }
+    return true;
+}
+
+bool Palette::setImageSlot(Renderer::ImageHandle image, uint8_t slot)
+{
+    using namespace Renderer;
+    auto it = g_indexedImages.find(image.value);
+    if (it == g_indexedImages.end() || !g_images.contains(image))
+        return false;
+    if (it->second.slot == slot)
+        return true;
+    // Same rules as loading into the slot: it needs a table, and one built from the
+    // palette this image's indices refer to
+    if (!g_paletteSlotSet[slot]) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "setImageSlot: slot %d has no table yet", (int)slot);
+        return false;
+    }
+    const Vector<Renderer::Color>& from = g_slotPalettes[it->second.slot];
+    if (g_slotPalettes[slot].empty()) {
+        // A table set with setSlotLut (team colours, night) now serves this palette
+        g_slotPalettes[slot] = from;
+    }
+    else if (!SamePalette(g_slotPalettes[slot], from)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+            "setImageSlot: slot %d was built from a different palette than slot %d", (int)slot, (int)it->second.slot);
+        return false;
+    }
+    it->second.slot = slot;
+    it->second.dirty = true;
+    return true;
+}
+
+int Palette::updateIndexedImages()
+{
+    using namespace Renderer;
+    int uploaded = 0;
+    for (auto& [handle, indexed] : g_indexedImages) {
+        if (!indexed.dirty) continue;
+        ImageHandle h;
+        h.value = handle;
+        const Image* img = g_images.get(h);
+        if (!img || !img->texture) continue;
+        // A failed upload stays dirty and is retried on the next update
+        if (!ExpandAndUpload(img->texture, indexed)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "updateIndexedImages: upload failed: %s", SDL_GetError());
+            continue;
+        }
+        indexed.dirty = false;
+        ++uploaded;
+    }
+    return uploaded;
+}
+
+Palette::MemoryStats Palette::getIndexedMemoryStats()
+{
+    using namespace Renderer;
+    MemoryStats stats;
+    bool slotUsed[256] = {};
+    for (const auto& [handle, indexed] : g_indexedImages) {
+        ++stats.images;
+        const std::size_t pixels = (std::size_t)indexed.pixels.width * indexed.pixels.height;
+        stats.textureBytes += pixels * 4;
+        stats.indexBytes += indexed.pixels.indices.size();
+        if (!slotUsed[indexed.slot]) {
+            slotUsed[indexed.slot] = true;
+            stats.lutBytes += sizeof(Lut);
+        }
+    }
+    return stats;
+}
@@ -9,10 +9,14 @@ namespace Renderer
 		SDL_Texture* texture = nullptr;
 		SDL_PixelFormat format = SDL_PIXELFORMAT_UNKNOWN;
 	};
+	using ImageHandle = Handle<Image>;
 
-
-
-	bool loadImageFromFile(const char* filename, Ref<Renderer::Image>&);
-	bool releaseImage(Ref<Renderer::Image>& img);
+	// Images live in a generational pool owned by the renderer; handles go stale
+	// after releaseImage/releaseAllImages and resolve to nullptr from then on.
+	bool loadImageFromFile(const char* filename, ImageHandle& outImage);
+	bool releaseImage(ImageHandle& img); // destroys the texture and nulls the handle
+	const Image* getImage(ImageHandle img);
+	// Destroy every loaded texture; called before the SDL renderer is torn down.
+	void releaseAllImages();
 
 } // namespace Renderer
\ No newline at end of file
@@ -1,46 +1,188 @@
 #include "Common.h"
 #include "Sound.h"
+#include "SoundMix.h"
 
 #include <SDL3_mixer/SDL_mixer.h>
-#include <mutex>
 #include <atomic>
-#include <memory>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// SFX cache entry. The streamed audio is always kept so eviction never touches the
+// disk; `decoded` holds predecoded PCM while the sound is resident in the cache.
+struct Sound::Sfx {
+    MIX_Audio* stream = nullptr;
+    MIX_Audio* decoded = nullptr;
+    String path;
+    size_t fileBytes = 0;
+    bool cacheable = false;      // within the predecode threshold, or pinned
+    bool pinned = false;
+    bool decodePending = false;  // queued for re-decode after a miss
+    size_t decodedBytes = 0;
+    double decodeMs = 0.0;       // measured cost of the last predecode
+    List<Sound::SfxHandle>::iterator lru; // valid while decoded and not pinned
+
+    MIX_Audio* playable() const { return decoded ? decoded : stream; }
+};
+
+// Positional source. Holds a voice only while in range of the listener.
+struct Sound::Emitter {
+    Sound::EmitterHandle self;
+    Sound::SfxHandle sound;
+    Sound::SfxPlayOptions opts;
+    Sound::SpatialParams params;
+    Vector2 pos;
+    uint64_t startTicks = 0;   // loops resume in phase when they come back into range
+    int voice = -1;
+    uint32_t voiceSerial = 0;  // serial of `voice` when this emitter started it
+    float sentLeft = 1.0f;     // spatial gains last sent to the voice
+    float sentRight = 1.0f;
+
+    bool persistent() const { return opts.loops < 0; }
+};
 
 namespace {
     // Consolidated sound state container to avoid scattered globals
     struct SoundState {
         bool mixerInited = false;
         MIX_Mixer* mixer = nullptr;
-        MIX_Track* musicTrack = nullptr;
-
-        Vector<Ref<Sound::Sfx>> sfx;
-        Vector<Ref<Sound::Music>> music;
-
-        // Tracks to destroy on main thread (queued from mixer thread)
-        Vector<MIX_Track*> trashTracks;
-        std::mutex trashMutex;
-
-        // Category gains (attenuation only). 1.0 = full volume, 0.0 = silent.
-        std::atomic<float> sfxGain{1.0f};    // multiplier for SFX
-        std::atomic<float> musicGain{1.0f};  // multiplier for music
-        float musicBaseGain = 1.0f;          // per-track base for current music
-
-        struct ActiveSfxTrack {
-            MIX_Track* track{};
-            float baseGain{};
-            std::unique_ptr<float> cbUser; // RAII for cooked-callback userdata
-
-            ActiveSfxTrack() = default;
-            ActiveSfxTrack(MIX_Track* t, float b, std::unique_ptr<float> u)
-                : track(t), baseGain(b), cbUser(std::move(u)) {}
-            ActiveSfxTrack(const ActiveSfxTrack&) = delete;
-            ActiveSfxTrack& operator=(const ActiveSfxTrack&) = delete;
-            ActiveSfxTrack(ActiveSfxTrack&&) noexcept = default;
-            ActiveSfxTrack& operator=(ActiveSfxTrack&&) noexcept = default;
+
+        HandlePool<Sound::Sfx> sfx;
+        HandlePool<Sound::Music> music;
+
+        // Decoded-SFX cache: front of the LRU is the most recently played
+        Sound::SfxCachePolicy cachePolicy;
+        Sound::SfxCacheStats cacheStats;
+        List<Sound::SfxHandle> sfxLru;
+        Vector<Sound::SfxHandle> pendingDecode;
+
+        // Positional audio: emitters are updated in one pass per frame in update()
+        HandlePool<Sound::Emitter> emitters;
+        Vector<Sound::EmitterHandle> finishedEmitters; // scratch for the pass
+        Vector2 listener;
+
+        // Main -> mixer commands, drained by the post-mix callback on the mixer thread.
+        // Commands that don't fit wait in commandOverflow (main thread) until update().
+        struct Command {
+            enum class Type : uint8_t { SfxGain, MusicGain, MusicSoftClip, VoiceSpatial, MusicDeckFade };
+            Type type = Type::SfxGain;
+            int index = 0;       // VoiceSpatial: voice index; MusicDeckFade: deck
+            uint32_t serial = 0; // voice/deck serial at request time
+            float value = 0.0f;  // gains; VoiceSpatial: left; MusicDeckFade: envelope target
+            float value2 = 0.0f; // VoiceSpatial: right
+            Sint64 frames = 0;   // fade length
+        };
+        SpscRing<Command, 256> commands;
+        Vector<Command> commandOverflow;
+
+        // Mixer-thread view of the bus state; written only by ApplyCommand.
+        // Category gains are attenuation only: 1.0 = full volume, 0.0 = silent.
+        struct MixerBus {
+            float sfxGain = 1.0f;
+            float musicGain = 1.0f;
+            bool musicSoftClip = false; // fused soft clip on the music bus
+        };
+        MixerBus bus;
+
+        // Two-deck music player: the live deck plays while the other fades out or idles.
+        // Crossfade envelopes run on the mixer thread. The main thread starts a deck by
+        // writing start* and bumping serial while the track is stopped; the cooked
+        // callback picks the new serial up before mixing the first buffer.
+        struct MusicDeck {
+            MIX_Track* track = nullptr;
+            int index = 0;
+            std::atomic<uint32_t> serial{ 0 };
+            std::atomic<float> startGain{ 1.0f };
+            std::atomic<Sint64> startFadeFrames{ 0 };
+
+            // Mixer thread only
+            uint32_t appliedSerial = 0;
+            float baseGain = 1.0f;
+            float env = 0.0f;          // crossfade position, shaped equal-power when applied
+            float envTarget = 0.0f;
+            Sint64 envFrames = 0;      // frames left to reach envTarget
+            float appliedGain = -1.0f; // <0 until first buffer
+            bool stopWhenSilent = false;
+            bool stopping = false;     // set around mixer-issued stops so no handoff happens
+
+            // Gapless handoff: armed by the main thread, consumed by the stopped callback,
+            // which restarts the track on it within the same mix run
+            std::atomic<MIX_Audio*> queued{ nullptr };
+            std::atomic<uint32_t> handoffs{ 0 };
+        };
+        Array<MusicDeck, 2> decks;
+        int liveDeck = 0;
+        uint32_t nextDeckSerial = 0;
+
+        // Playlist entries are opened on this worker one ahead of playback
+        struct MusicPrefetch {
+            std::thread worker;
+            std::mutex mutex;
+            std::condition_variable cv;
+            Vector<std::pair<uint32_t, String>> requests;   // ticket, path (guarded)
+            Vector<std::pair<uint32_t, MIX_Audio*>> ready; // ticket, audio or null (guarded)
+            bool quit = false;                             // guarded
+            uint32_t nextTicket = 0;                       // main thread
+        };
+        MusicPrefetch prefetch;
+
+        // Main thread
+        struct MusicPlaylist {
+            Vector<String> paths;
+            Sound::MusicPlaylistOptions opts;
+            bool active = false;
+            bool started = false;          // an entry is on a deck
+            size_t nextIndex = 0;
+            bool hasNext = false;          // false past the end of a non-looping list
+            uint32_t ticket = 0;           // outstanding prefetch, 0 = none
+            MIX_Audio* nextAudio = nullptr; // prefetched entry, owned until started or handed off
+            bool nextArmed = false;        // nextAudio is queued on decks[armedDeck]
+            int armedDeck = 0;
+            uint32_t handoffsSeen = 0;
+            int failures = 0;
+        };
+        MusicPlaylist playlist;
+
+        // Audio the stopped callback took from a deck but may not have handed to the
+        // track yet; destroyed once that deck's handoff count moves past `handoffs`
+        struct RetiredAudio { MIX_Audio* audio; int deck; uint32_t handoffs; };
+        Vector<RetiredAudio> retiredMusic;
+
+        // Mixer-thread gain state of one SFX voice. spatial* are the positional gains
+        // (1 for non-positional voices); applied* are the gains the previous buffer ended
+        // on, so changes ramp across a buffer.
+        struct SfxGain {
+            uint32_t appliedSerial = 0; // voice serial these gains belong to
+            float baseGain = 1.0f;
+            float spatialLeft = 1.0f;
+            float spatialRight = 1.0f;
+            float appliedLeft = -1.0f;
+            float appliedRight = -1.0f;
+        };
+
+        // Fixed pool of preallocated SFX tracks. Each voice is the cooked/stopped
+        // callbacks' userdata, so they stay stable and playing allocates nothing.
+        // Like the music decks, the main thread starts a voice by writing start* and
+        // then bumping serial; the mixer thread adopts them into `gain` (SyncVoice).
+        struct Voice {
+            MIX_Track* track = nullptr;
+            SfxGain gain;                    // mixer thread only
+            std::atomic<float> startGain{ 1.0f };
+            std::atomic<float> startLeft{ 1.0f };
+            std::atomic<float> startRight{ 1.0f };
+            Sound::SfxHandle sound;
+            int priority = 0;
+            bool active = false;             // main thread view; cleared when the stop is drained
+            std::atomic<uint32_t> serial{0}; // bumped per play; older stop notifications are ignored
+            // Serial of the last play the stopped callback reported. Stops can be reported
+            // from the mixer thread (track ended) and from the main thread (a steal inside
+            // MIX_StopTrack) at once, so each voice has its own slot instead of a shared queue.
+            std::atomic<uint32_t> stoppedSerial{0};
+            int index = 0;
         };
-        Vector<ActiveSfxTrack> activeSfxTracks;
+        Array<Voice, Sound::kMaxSfxVoices> voices;
+        uint32_t nextSerial = 0;
 
-        void* musicCbUser = nullptr; // kept for symmetry, currently unused in callback
     };
 
     inline SoundState& SS() {
@@ -48,35 +190,686 @@ namespace {
         return s;
     }
 
-    // Per-track cooked callbacks to apply gain without using MIX_SetTrackGain
+    // Mixer thread: adopt a voice start the main thread published since the last look.
+    // Spatial commands for an older serial are dropped by the caller, so a late one
+    // can't land on the sound that replaced it.
+    void SyncVoice(SoundState::Voice& v)
+    {
+        const uint32_t serial = v.serial.load(std::memory_order_acquire);
+        if (serial == v.gain.appliedSerial) return;
+        v.gain.appliedSerial = serial;
+        v.gain.baseGain = v.startGain.load(std::memory_order_relaxed);
+        v.gain.spatialLeft = v.startLeft.load(std::memory_order_relaxed);
+        v.gain.spatialRight = v.startRight.load(std::memory_order_relaxed);
+        v.gain.appliedLeft = -1.0f;
+        v.gain.appliedRight = -1.0f;
+    }
+
+    // Per-track cooked callbacks to apply gain without using MIX_SetTrackGain.
+    // `samples` counts floats (not frames). Gain changes ramp linearly over one buffer.
     void SDLCALL SfxCookedCB(void* userdata, MIX_Track* /*track*/, const SDL_AudioSpec* spec, float* pcm, int samples) {
         if (!userdata || !pcm || !spec || samples <= 0) return;
-        const float base = *static_cast<const float*>(userdata);
-        const float cat = SS().sfxGain.load(std::memory_order_relaxed);
-        const float factor = base * cat;
-        if (factor == 1.0f) return;
-        const int total = samples * farmMax(1, spec->channels);
-        for (int i = 0; i < total; ++i) { pcm[i] *= factor; }
+        auto* voice = static_cast<SoundState::Voice*>(userdata);
+        SyncVoice(*voice);
+        SoundState::SfxGain* gain = &voice->gain;
+        const float base = gain->baseGain * SS().bus.sfxGain;
+        const float toLeft = base * gain->spatialLeft;
+        const float toRight = base * gain->spatialRight;
+        const float fromLeft = gain->appliedLeft < 0.0f ? toLeft : gain->appliedLeft;
+        const float fromRight = gain->appliedRight < 0.0f ? toRight : gain->appliedRight;
+        gain->appliedLeft = toLeft;
+        gain->appliedRight = toRight;
+        if (fromLeft == 1.0f && fromRight == 1.0f && toLeft == 1.0f && toRight == 1.0f) return;
+        const int channels = farmMax(1, spec->channels);
+        if (channels == 2) {
+            SoundMix::applyStereoGain(pcm, samples / 2, fromLeft, fromRight, toLeft, toRight);
+            return;
+        }
+        // No pan outside stereo; keep the distance attenuation
+        SoundMix::applyGain(pcm, samples / channels, channels, 0.5f * (fromLeft + fromRight), 0.5f * (toLeft + toRight));
+    }
+
+    // Mixer thread: adopt a start the main thread published since the last buffer
+    void SyncDeck(SoundState::MusicDeck& deck)
+    {
+        const uint32_t serial = deck.serial.load(std::memory_order_acquire);
+        if (serial == deck.appliedSerial) return;
+        deck.appliedSerial = serial;
+        deck.baseGain = deck.startGain.load(std::memory_order_relaxed);
+        deck.envFrames = deck.startFadeFrames.load(std::memory_order_relaxed);
+        deck.env = deck.envFrames > 0 ? 0.0f : 1.0f;
+        deck.envTarget = 1.0f;
+        deck.appliedGain = -1.0f;
+        deck.stopWhenSilent = false;
     }
 
     void SDLCALL MusicCookedCB(void* userdata, MIX_Track* /*track*/, const SDL_AudioSpec* spec, float* pcm, int samples) {
-        (void)userdata; // not used; we read state values instead
-        if (!pcm || !spec || samples <= 0) return;
-        const float cat = SS().musicGain.load(std::memory_order_relaxed);
-        const float factor = SS().musicBaseGain * cat;
-        if (factor == 1.0f) return;
-        const int total = samples * farmMax(1, spec->channels);
-        for (int i = 0; i < total; ++i) { pcm[i] *= factor; }
-    }
-
-    // Auto-destroy tracks when they finish mixing
-    void SDLCALL OnTrackStopped(void* userdata, MIX_Track* track) {
-        (void)userdata;
-        if (!track) return;
-        // Don't destroy from mixer thread; queue for main-thread destruction.
+        if (!userdata || !pcm || !spec || samples <= 0) return;
+        auto* deck = static_cast<SoundState::MusicDeck*>(userdata);
+        auto& bus = SS().bus;
+        SyncDeck(*deck);
+        const int channels = farmMax(1, spec->channels);
+        const int frames = samples / channels;
+
+        // Advance the crossfade envelope across this buffer
+        if (deck->envFrames > 0) {
+            const float t = farmMin(1.0f, (float)frames / (float)deck->envFrames);
+            deck->env += (deck->envTarget - deck->env) * t;
+            deck->envFrames = farmMax((Sint64)0, deck->envFrames - frames);
+        }
+        if (deck->envFrames == 0) deck->env = deck->envTarget;
+
+        const float target = deck->baseGain * bus.musicGain * SoundMix::equalPowerFade(deck->env);
+        const float from = deck->appliedGain < 0.0f ? target : deck->appliedGain;
+        deck->appliedGain = target;
+        if (bus.musicSoftClip) {
+            SoundMix::applyGainSoftClip(pcm, samples / channels, channels, from, target);
+            return;
+        }
+        if (from == 1.0f && target == 1.0f) return;
+        SoundMix::applyGain(pcm, samples / channels, channels, from, target);
+    }
+
+    // Deck ran out of data or was stopped. Under the mixer lock, on the mixer thread or
+    // inside a main-thread MIX_StopTrack (which always disarms the deck first).
+    void SDLCALL OnMusicDeckStopped(void* userdata, MIX_Track* track) {
+        auto* deck = static_cast<SoundState::MusicDeck*>(userdata);
+        if (!deck || deck->stopping) return;
+        MIX_Audio* next = deck->queued.exchange(nullptr, std::memory_order_acq_rel);
+        if (!next) return;
+        // Restarting here continues in the current mix run, so the join is gapless.
+        // Envelope and gain carry over; the track takes its own reference to `next`.
+        if (MIX_SetTrackAudio(track, next)) MIX_PlayTrack(track, 0);
+        deck->handoffs.fetch_add(1, std::memory_order_release);
+    }
+
+    // Voice finished (or was stopped for stealing): hand it back on the main thread
+    void SDLCALL OnVoiceStopped(void* userdata, MIX_Track* /*track*/) {
+        if (!userdata) return;
+        auto* voice = static_cast<SoundState::Voice*>(userdata);
+        voice->stoppedSerial.store(voice->serial.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // Mixer thread
+    void ApplyCommand(SoundState& st, const SoundState::Command& cmd)
+    {
+        using Type = SoundState::Command::Type;
+        switch (cmd.type) {
+        case Type::SfxGain:       st.bus.sfxGain = cmd.value; break;
+        case Type::MusicGain:     st.bus.musicGain = cmd.value; break;
+        case Type::MusicSoftClip: st.bus.musicSoftClip = cmd.value != 0.0f; break;
+        case Type::MusicDeckFade: {
+            auto& deck = st.decks[cmd.index];
+            SyncDeck(deck);
+            if (deck.appliedSerial != cmd.serial) break; // deck restarted since the request
+            deck.envTarget = cmd.value;
+            deck.envFrames = cmd.frames;
+            if (cmd.frames <= 0) deck.env = cmd.value;
+            deck.stopWhenSilent = cmd.value <= 0.0f;
+            break;
+        }
+        case Type::VoiceSpatial: {
+            auto& v = st.voices[cmd.index];
+            SyncVoice(v);
+            if (v.gain.appliedSerial != cmd.serial) break; // voice restarted since the request
+            v.gain.spatialLeft = cmd.value;
+            v.gain.spatialRight = cmd.value2;
+            break;
+        }
+        }
+    }
+
+    // Runs once per mix iteration on the mixer thread; applies queued commands so
+    // they take effect from the next buffer (gain changes still ramp).
+    void SDLCALL CommandPostMixCB(void* /*userdata*/, MIX_Mixer* /*mixer*/, const SDL_AudioSpec* /*spec*/, float* /*pcm*/, int /*samples*/) {
         auto& st = SS();
-        std::scoped_lock<std::mutex> lock(st.trashMutex);
-        st.trashTracks.push_back(track);
+        SoundState::Command cmd;
+        while (st.commands.pop(cmd)) ApplyCommand(st, cmd);
+
+        // Stop decks whose fade-out has finished
+        for (auto& deck : st.decks) {
+            if (!deck.stopWhenSilent || deck.env > 0.0f || deck.envFrames > 0) continue;
+            deck.stopWhenSilent = false;
+            if (!deck.track || !MIX_TrackPlaying(deck.track)) continue;
+            deck.stopping = true;
+            MIX_StopTrack(deck.track, 0);
+            deck.stopping = false;
+        }
+    }
+
+    // Main thread. Keeps order: once anything overflowed, later commands queue behind it.
+    void PushCommand(SoundState& st, const SoundState::Command& cmd)
+    {
+        if (!st.commandOverflow.empty() || !st.commands.push(cmd)) st.commandOverflow.push_back(cmd);
+    }
+
+    void FlushCommandOverflow(SoundState& st)
+    {
+        size_t sent = 0;
+        while (sent < st.commandOverflow.size() && st.commands.push(st.commandOverflow[sent])) ++sent;
+        st.commandOverflow.erase(st.commandOverflow.begin(), st.commandOverflow.begin() + sent);
+    }
+
+    // Pick the voice for a new play: a free one, else one the request may steal.
+    // Returns -1 when every candidate outranks the request.
+    int PickVoice(SoundState& st, Sound::SfxHandle sound, int priority, int maxInstances)
+    {
+        int victim = -1;
+        auto better = [&](int i) {
+            // Lower priority first, then quieter, then older
+            if (victim < 0) return true;
+            const auto& a = st.voices[i];
+            const auto& b = st.voices[victim];
+            if (a.priority != b.priority) return a.priority < b.priority;
+            const float gainA = a.startGain.load(std::memory_order_relaxed);
+            const float gainB = b.startGain.load(std::memory_order_relaxed);
+            if (gainA != gainB) return gainA < gainB;
+            return (int32_t)(a.serial.load(std::memory_order_relaxed) - b.serial.load(std::memory_order_relaxed)) < 0;
+        };
+
+        if (maxInstances > 0) {
+            // At the per-sound cap the new play can only replace an instance of the same sound
+            int count = 0;
+            for (int i = 0; i < Sound::kMaxSfxVoices; ++i) {
+                const auto& v = st.voices[i];
+                if (!v.active || v.sound != sound) continue;
+                ++count;
+                if (v.priority <= priority && better(i)) victim = i;
+            }
+            if (count >= maxInstances) return victim;
+            victim = -1;
+        }
+
+        for (int i = 0; i < Sound::kMaxSfxVoices; ++i) {
+            if (!st.voices[i].active) return i;
+        }
+        for (int i = 0; i < Sound::kMaxSfxVoices; ++i) {
+            if (st.voices[i].priority <= priority && better(i)) victim = i;
+        }
+        return victim;
+    }
+
+    double MsSince(uint64_t start)
+    {
+        return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    }
+
+    // PCM size of the fully decoded audio; 0 when the length is unknown
+    size_t DecodedBytes(MIX_Audio* audio)
+    {
+        SDL_AudioSpec spec{};
+        const Sint64 frames = MIX_GetAudioDuration(audio);
+        if (frames <= 0 || !MIX_GetAudioFormat(audio, &spec)) return 0;
+        return (size_t)frames * (size_t)spec.channels * (size_t)SDL_AUDIO_BYTESIZE(spec.format);
+    }
+
+    // Release the decoded PCM; voices still playing it keep it alive (MIX_Audio is refcounted)
+    void DropDecoded(SoundState& st, Sound::Sfx& e)
+    {
+        if (!e.decoded) return;
+        if (!e.pinned) st.sfxLru.erase(e.lru);
+        MIX_DestroyAudio(e.decoded);
+        e.decoded = nullptr;
+        st.cacheStats.bytesUsed -= e.decodedBytes;
+        st.cacheStats.predecodedCount--;
+        e.decodedBytes = 0;
+    }
+
+    // Evict least recently played unpinned sounds until the cache fits its budget
+    void EnforceBudget(SoundState& st)
+    {
+        while (st.cacheStats.bytesUsed > st.cachePolicy.budgetBytes && !st.sfxLru.empty()) {
+            Sound::Sfx* e = st.sfx.get(st.sfxLru.back());
+            if (!e) { st.sfxLru.pop_back(); continue; }
+            DropDecoded(st, *e);
+            st.cacheStats.evictions++;
+        }
+    }
+
+    bool Decode(SoundState& st, Sound::SfxHandle h, Sound::Sfx& e)
+    {
+        if (e.decoded) return true;
+        // Don't decode what could never stay resident
+        if (!e.pinned && DecodedBytes(e.stream) > st.cachePolicy.budgetBytes) return false;
+
+        const uint64_t start = SDL_GetPerformanceCounter();
+        MIX_Audio* pcm = MIX_LoadAudio(st.mixer, e.path.c_str(), /*predecode*/ true);
+        if (!pcm) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_LoadAudio (predecode) failed for '%s': %s", e.path.c_str(), SDL_GetError());
+            return false;
+        }
+        e.decoded = pcm;
+        e.decodeMs = MsSince(start);
+        e.decodedBytes = DecodedBytes(pcm);
+        st.cacheStats.decodeMsSpent += e.decodeMs;
+        st.cacheStats.bytesUsed += e.decodedBytes;
+        st.cacheStats.predecodedCount++;
+        if (!e.pinned) {
+            st.sfxLru.push_front(h);
+            e.lru = st.sfxLru.begin();
+        }
+        EnforceBudget(st);
+        return e.decoded != nullptr;
+    }
+
+    // Account a play against the cache: hits refresh the LRU, misses queue a re-decode
+    void NoteSfxPlay(SoundState& st, Sound::SfxHandle h, Sound::Sfx& e)
+    {
+        if (e.decoded) {
+            st.cacheStats.hits++;
+            st.cacheStats.decodeMsSaved += e.decodeMs;
+            if (!e.pinned) st.sfxLru.splice(st.sfxLru.begin(), st.sfxLru, e.lru);
+        }
+        else if (e.cacheable) {
+            st.cacheStats.misses++;
+            if (!e.decodePending) {
+                e.decodePending = true;
+                st.pendingDecode.push_back(h);
+            }
+        }
+    }
+
+    // At most one re-decode per frame so a burst of misses doesn't spike a frame
+    void ServicePendingDecodes(SoundState& st)
+    {
+        while (!st.pendingDecode.empty()) {
+            const Sound::SfxHandle h = st.pendingDecode.front();
+            st.pendingDecode.erase(st.pendingDecode.begin());
+            Sound::Sfx* e = st.sfx.get(h);
+            if (!e) continue;
+            e->decodePending = false;
+            if (e->decoded || !e->cacheable) continue;
+            const uint64_t start = SDL_GetPerformanceCounter();
+            Decode(st, h, *e);
+            Game::recordStall("sfx re-decode", (float)MsSince(start));
+            break;
+        }
+    }
+
+    // Start `sfx` on a pooled voice with the given spatial gains. Voices with priority
+    // <= stealPriority may be stolen. Returns the voice index or -1.
+    int StartVoice(SoundState& st, Sound::SfxHandle sfx, const Sound::SfxPlayOptions& opts, int stealPriority,
+                   float spatialLeft, float spatialRight, Sint64 startFrame)
+    {
+        Sound::Sfx* s = st.sfx.get(sfx);
+        if (!st.mixerInited || !st.mixer || !s || !s->playable()) return -1;
+
+        const int index = PickVoice(st, sfx, stealPriority, opts.maxInstances);
+        if (index < 0) return -1; // everything playing outranks this request
+        auto& v = st.voices[index];
+        if (!v.track) return -1;
+
+        // Stealing: stop immediately; the stop notification carries the old serial and is ignored
+        if (v.active) MIX_StopTrack(v.track, 0);
+
+        NoteSfxPlay(st, sfx, *s);
+        if (!MIX_SetTrackAudio(v.track, s->playable())) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_SetTrackAudio failed: %s", SDL_GetError());
+            v.active = false;
+            return -1;
+        }
+
+        // per-track volume (0..128) expressed as base gain [0..1]. Staged, then published
+        // by the serial bump; the mixer thread adopts them before the first buffer.
+        v.startGain.store(static_cast<float>(farmMax(0, farmMin(opts.volume, 128))) / 128.0f, std::memory_order_relaxed);
+        v.startLeft.store(spatialLeft, std::memory_order_relaxed);
+        v.startRight.store(spatialRight, std::memory_order_relaxed);
+        v.sound = sfx;
+        v.priority = opts.priority;
+        v.serial.store(++st.nextSerial, std::memory_order_release);
+        v.active = true;
+
+        bool ok = false;
+        if (opts.loops == 0 && startFrame <= 0) {
+            ok = MIX_PlayTrack(v.track, 0);
+        }
+        else {
+            // loops: 0 = no loop; 1 = loop once; -1 = infinite
+            SDL_PropertiesID props = SDL_CreateProperties();
+            SDL_SetNumberProperty(props, MIX_PROP_PLAY_LOOPS_NUMBER, static_cast<Sint64>(opts.loops));
+            if (startFrame > 0) SDL_SetNumberProperty(props, MIX_PROP_PLAY_START_FRAME_NUMBER, startFrame);
+            ok = MIX_PlayTrack(v.track, props);
+            SDL_DestroyProperties(props);
+        }
+        if (ok) return index;
+
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_PlayTrack failed: %s", SDL_GetError());
+        v.active = false;
+        v.sound = {};
+        return -1;
+    }
+
+    // Stopped here rather than on the mixer thread: the main thread is the only one that
+    // bumps serials, so nothing can restart the voice between the check and the stop
+    void StopVoice(SoundState& st, int index, uint32_t serial, Sint64 frames)
+    {
+        auto& v = st.voices[index];
+        if (v.track && v.active && v.serial.load(std::memory_order_relaxed) == serial) MIX_StopTrack(v.track, frames);
+    }
+
+    // Distance attenuation and pan for one emitter; false when out of audible range
+    bool SpatialGains(const Vector2& listener, const Vector2& pos, const Sound::SpatialParams& p, float& left, float& right)
+    {
+        const float dx = pos.x - listener.x;
+        const float dy = pos.y - listener.y;
+        const float distSq = dx * dx + dy * dy;
+        if (distSq >= p.maxDistance * p.maxDistance) return false;
+        const float g = SoundMix::distanceGain(std::sqrt(distSq), p.minDistance, p.maxDistance);
+        SoundMix::panGains(p.panWidth > 0.0f ? dx / p.panWidth : 0.0f, left, right);
+        left *= g;
+        right *= g;
+        return true;
+    }
+
+    // Start a looping emitter in phase with where it would be had it played all along
+    void StartEmitter(SoundState& st, Sound::Emitter& e, int stealPriority, float left, float right)
+    {
+        Sint64 startFrame = 0;
+        const Sound::Sfx* s = st.sfx.get(e.sound);
+        if (e.persistent() && s) {
+            MIX_Audio* audio = s->playable();
+            const Sint64 length = MIX_GetAudioDuration(audio);
+            if (length > 0) startFrame = MIX_AudioMSToFrames(audio, (Sint64)(SDL_GetTicks() - e.startTicks)) % length;
+        }
+        e.voice = StartVoice(st, e.sound, e.opts, stealPriority, left, right, startFrame);
+        if (e.voice < 0) return;
+        e.voiceSerial = st.voices[e.voice].serial.load(std::memory_order_relaxed);
+        e.sentLeft = left;
+        e.sentRight = right;
+    }
+
+    // One batched pass per frame: refresh every emitter's gains against the listener,
+    // cull voices that left the audible range and revive loops that re-entered it.
+    void UpdateEmitters(SoundState& st)
+    {
+        constexpr float kGainEpsilon = 1.0f / 512.0f; // below this a gain change isn't worth a command
+        st.finishedEmitters.clear();
+        st.emitters.forEach([&](Sound::Emitter& e) {
+            if (e.voice >= 0) {
+                const auto& v = st.voices[e.voice];
+                if (!v.active || v.serial.load(std::memory_order_relaxed) != e.voiceSerial) {
+                    // Finished, stopped or stolen
+                    e.voice = -1;
+                    if (!e.persistent()) { st.finishedEmitters.push_back(e.self); return; }
+                }
+            }
+
+            float left = 0.0f, right = 0.0f;
+            const bool audible = SpatialGains(st.listener, e.pos, e.params, left, right);
+            if (e.voice < 0) {
+                // Only loops come back; a stolen loop waits for a free or lower-priority voice
+                if (audible) StartEmitter(st, e, e.opts.priority - 1, left, right);
+                return;
+            }
+            if (!audible) {
+                // Gain has already ramped to zero at maxDistance, so a hard stop is silent
+                StopVoice(st, e.voice, e.voiceSerial, 0);
+                e.voice = -1;
+                if (!e.persistent()) st.finishedEmitters.push_back(e.self);
+                return;
+            }
+            if (std::fabs(left - e.sentLeft) > kGainEpsilon || std::fabs(right - e.sentRight) > kGainEpsilon) {
+                SoundState::Command cmd;
+                cmd.type = SoundState::Command::Type::VoiceSpatial;
+                cmd.index = e.voice;
+                cmd.serial = e.voiceSerial;
+                cmd.value = left;
+                cmd.value2 = right;
+                PushCommand(st, cmd);
+                e.sentLeft = left;
+                e.sentRight = right;
+            }
+        });
+        for (Sound::EmitterHandle h : st.finishedEmitters) st.emitters.release(h);
+    }
+
+    void DrainStoppedVoices(SoundState& st)
+    {
+        for (auto& v : st.voices) {
+            // A voice restarted since the notification has a newer serial and keeps playing
+            if (v.active && v.stoppedSerial.load(std::memory_order_acquire) == v.serial.load(std::memory_order_relaxed)) {
+                v.active = false;
+                v.sound = {};
+            }
+        }
+    }
+    // ---- Music decks and playlist (main thread) ----
+
+    Sint64 DeckMSToFrames(const SoundState::MusicDeck& deck, int ms)
+    {
+        if (ms <= 0 || !deck.track) return 0;
+        return farmMax((Sint64)0, MIX_TrackMSToFrames(deck.track, static_cast<Sint64>(ms)));
+    }
+
+    // Take back the entry armed for a gapless join. If the stopped callback already
+    // took it, it is (about to be) playing; our reference is retired until the
+    // handoff is published.
+    void DisarmPlaylist(SoundState& st)
+    {
+        auto& pl = st.playlist;
+        if (!pl.nextArmed) return;
+        pl.nextArmed = false;
+        if (st.decks[pl.armedDeck].queued.exchange(nullptr, std::memory_order_acq_rel)) return;
+        st.retiredMusic.push_back({ pl.nextAudio, pl.armedDeck, pl.handoffsSeen });
+        pl.nextAudio = nullptr;
+    }
+
+    void ReleaseRetiredMusic(SoundState& st, bool all)
+    {
+        for (size_t i = 0; i < st.retiredMusic.size();) {
+            const auto& r = st.retiredMusic[i];
+            if (all || st.decks[r.deck].handoffs.load(std::memory_order_acquire) != r.handoffs) {
+                MIX_DestroyAudio(r.audio);
+                st.retiredMusic[i] = st.retiredMusic.back();
+                st.retiredMusic.pop_back();
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    bool StartDeck(SoundState& st, int d, MIX_Audio* audio, int loops, int volume, int fadeInMs)
+    {
+        auto& deck = st.decks[d];
+        if (!deck.track) return false;
+        if (st.playlist.nextArmed && st.playlist.armedDeck == d) DisarmPlaylist(st);
+        // The deck may still be fading out from an earlier switch
+        MIX_StopTrack(deck.track, 0);
+
+        if (!MIX_SetTrackAudio(deck.track, audio)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_SetTrackAudio (music) failed: %s", SDL_GetError());
+            return false;
+        }
+        // Stopped, so the mixer isn't reading these; published by the serial bump
+        deck.startGain.store(static_cast<float>(farmMax(0, farmMin(volume, 128))) / 128.0f, std::memory_order_relaxed);
+        deck.startFadeFrames.store(DeckMSToFrames(deck, fadeInMs), std::memory_order_relaxed);
+        deck.serial.store(++st.nextDeckSerial, std::memory_order_release);
+
+        SDL_PropertiesID opts = SDL_CreateProperties();
+        SDL_SetNumberProperty(opts, MIX_PROP_PLAY_LOOPS_NUMBER, static_cast<Sint64>(loops));
+        const bool ok = MIX_PlayTrack(deck.track, opts);
+        SDL_DestroyProperties(opts);
+        if (!ok) SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_PlayTrack (music) failed: %s", SDL_GetError());
+        return ok;
+    }
+
+    void FadeOutDeck(SoundState& st, int d, int fadeMs)
+    {
+        auto& deck = st.decks[d];
+        if (!deck.track) return;
+        if (st.playlist.nextArmed && st.playlist.armedDeck == d) DisarmPlaylist(st);
+        SoundState::Command cmd;
+        cmd.type = SoundState::Command::Type::MusicDeckFade;
+        cmd.index = d;
+        cmd.serial = deck.serial.load(std::memory_order_relaxed);
+        cmd.value = 0.0f;
+        cmd.frames = DeckMSToFrames(deck, fadeMs);
+        PushCommand(st, cmd);
+    }
+
+    // Start `audio` on the idle deck and crossfade the live one out
+    bool SwitchMusic(SoundState& st, MIX_Audio* audio, int loops, int volume, int fadeInMs, int fadeOutMs)
+    {
+        const int out = st.liveDeck;
+        const int in = 1 - out;
+        if (!StartDeck(st, in, audio, loops, volume, fadeInMs)) return false;
+        FadeOutDeck(st, out, fadeOutMs);
+        st.liveDeck = in;
+        return true;
+    }
+
+    void MusicPrefetchWorker(MIX_Mixer* mixer)
+    {
+        auto& pf = SS().prefetch;
+        for (;;) {
+            std::pair<uint32_t, String> req;
+            {
+                std::unique_lock<std::mutex> lock(pf.mutex);
+                pf.cv.wait(lock, [&] { return pf.quit || !pf.requests.empty(); });
+                if (pf.quit) return;
+                req = std::move(pf.requests.front());
+                pf.requests.erase(pf.requests.begin());
+            }
+            // Opening reads the (compressed) file into memory; decoding still streams
+            MIX_Audio* audio = MIX_LoadAudio(mixer, req.second.c_str(), /*predecode*/ false);
+            if (!audio) SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_LoadAudio failed for '%s': %s", req.second.c_str(), SDL_GetError());
+            std::scoped_lock<std::mutex> lock(pf.mutex);
+            pf.ready.emplace_back(req.first, audio);
+        }
+    }
+
+    void StopMusicPrefetch(SoundState& st)
+    {
+        auto& pf = st.prefetch;
+        {
+            std::scoped_lock<std::mutex> lock(pf.mutex);
+            pf.quit = true;
+        }
+        pf.cv.notify_one();
+        if (pf.worker.joinable()) pf.worker.join();
+        for (auto& [ticket, audio] : pf.ready) {
+            if (audio) MIX_DestroyAudio(audio);
+        }
+        pf.ready.clear();
+        pf.requests.clear();
+        pf.quit = false;
+    }
+
+    void RequestPlaylistEntry(SoundState& st)
+    {
+        auto& pl = st.playlist;
+        auto& pf = st.prefetch;
+        pl.ticket = ++pf.nextTicket;
+        if (pl.ticket == 0) pl.ticket = ++pf.nextTicket;
+        {
+            std::scoped_lock<std::mutex> lock(pf.mutex);
+            pf.requests.emplace_back(pl.ticket, pl.paths[pl.nextIndex]);
+        }
+        pf.cv.notify_one();
+    }
+
+    void AdvancePlaylist(SoundState& st)
+    {
+        auto& pl = st.playlist;
+        if (++pl.nextIndex >= pl.paths.size()) {
+            pl.nextIndex = 0;
+            pl.hasNext = pl.opts.loop;
+        }
+        if (pl.hasNext) RequestPlaylistEntry(st);
+    }
+
+    void StopPlaylist(SoundState& st)
+    {
+        auto& pl = st.playlist;
+        DisarmPlaylist(st);
+        if (pl.nextAudio) MIX_DestroyAudio(pl.nextAudio);
+        pl = SoundState::MusicPlaylist{}; // an outstanding ticket no longer matches and is dropped
+    }
+
+    // Put the prefetched entry on a deck, crossfading from whatever plays
+    void StartPlaylistEntry(SoundState& st, int fadeMs)
+    {
+        auto& pl = st.playlist;
+        const bool loopSingle = pl.paths.size() == 1 && pl.opts.loop;
+        if (SwitchMusic(st, pl.nextAudio, loopSingle ? -1 : 0, pl.opts.volume, fadeMs, fadeMs)) pl.started = true;
+        MIX_DestroyAudio(pl.nextAudio); // the track holds its own reference
+        pl.nextAudio = nullptr;
+        if (loopSingle) pl.hasNext = false;
+        else AdvancePlaylist(st);
+    }
+
+    void CollectPrefetched(SoundState& st)
+    {
+        auto& pl = st.playlist;
+        Vector<std::pair<uint32_t, MIX_Audio*>> ready;
+        {
+            std::scoped_lock<std::mutex> lock(st.prefetch.mutex);
+            ready.swap(st.prefetch.ready);
+        }
+        for (auto& [ticket, audio] : ready) {
+            if (!pl.active || ticket != pl.ticket) {
+                if (audio) MIX_DestroyAudio(audio); // superseded
+                continue;
+            }
+            pl.ticket = 0;
+            if (audio) {
+                pl.nextAudio = audio;
+                pl.failures = 0;
+                continue;
+            }
+            // Skip entries that fail to open; give up once all of them have
+            if (++pl.failures >= (int)pl.paths.size()) { pl.active = false; continue; }
+            AdvancePlaylist(st);
+        }
+    }
+
+    void UpdateMusicPlaylist(SoundState& st)
+    {
+        CollectPrefetched(st);
+        ReleaseRetiredMusic(st, false);
+
+        auto& pl = st.playlist;
+        if (!pl.active) return;
+        auto& live = st.decks[st.liveDeck];
+
+        // The mixer thread joined the armed entry onto the live deck
+        if (pl.nextArmed) {
+            const uint32_t handoffs = st.decks[pl.armedDeck].handoffs.load(std::memory_order_acquire);
+            if (handoffs != pl.handoffsSeen) {
+                pl.nextArmed = false;
+                MIX_DestroyAudio(pl.nextAudio); // the track holds its own reference
+                pl.nextAudio = nullptr;
+                AdvancePlaylist(st);
+            }
+        }
+
+        if (!pl.nextAudio) {
+            if (pl.started && !pl.hasNext && pl.ticket == 0 && !MIX_TrackPlaying(live.track)) pl.active = false; // played out
+            return;
+        }
+        if (!pl.started) {
+            StartPlaylistEntry(st, pl.opts.switchFadeMs);
+            return;
+        }
+
+        if (pl.opts.crossfadeMs > 0) {
+            const Sint64 remaining = MIX_GetTrackRemaining(live.track);
+            const bool ending = remaining >= 0 && remaining <= DeckMSToFrames(live, pl.opts.crossfadeMs);
+            if (ending || !MIX_TrackPlaying(live.track)) StartPlaylistEntry(st, pl.opts.crossfadeMs);
+            return;
+        }
+
+        if (!pl.nextArmed) {
+            pl.armedDeck = st.liveDeck;
+            pl.handoffsSeen = live.handoffs.load(std::memory_order_acquire);
+            pl.nextArmed = true;
+            live.queued.store(pl.nextAudio, std::memory_order_release);
+        }
+        // The deck ran dry before the entry was armed: start it now (with a gap)
+        if (!MIX_TrackPlaying(live.track) && live.queued.exchange(nullptr, std::memory_order_acq_rel)) {
+            pl.nextArmed = false;
+            StartPlaylistEntry(st, 0);
+        }
     }
 }
 
@@ -99,15 +892,40 @@ bool Sound::init()
         return false;
     }
 
-    // Create a dedicated music track we can reuse
-    st.musicTrack = MIX_CreateTrack(st.mixer);
-    if (!st.musicTrack) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_CreateTrack (music) failed: %s", SDL_GetError());
-        MIX_DestroyMixer(st.mixer);
-        st.mixer = nullptr;
-        MIX_Quit();
-        return false;
+    // Two persistent music decks for crossfades and gapless joins
+    for (int i = 0; i < (int)st.decks.size(); ++i) {
+        auto& deck = st.decks[i];
+        deck.index = i;
+        deck.track = MIX_CreateTrack(st.mixer);
+        if (!deck.track) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_CreateTrack (music deck %d) failed: %s", i, SDL_GetError());
+            for (auto& d : st.decks) {
+                if (d.track) { MIX_DestroyTrack(d.track); d.track = nullptr; }
+            }
+            MIX_DestroyMixer(st.mixer);
+            st.mixer = nullptr;
+            MIX_Quit();
+            return false;
+        }
+        MIX_SetTrackCookedCallback(deck.track, MusicCookedCB, &deck);
+        MIX_SetTrackStoppedCallback(deck.track, OnMusicDeckStopped, &deck);
     }
+    st.liveDeck = 0;
+
+    // Preallocate the SFX voice pool; callbacks are bound once per voice
+    for (int i = 0; i < Sound::kMaxSfxVoices; ++i) {
+        auto& v = st.voices[i];
+        v.index = i;
+        v.track = MIX_CreateTrack(st.mixer);
+        if (!v.track) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_CreateTrack (sfx voice %d) failed: %s", i, SDL_GetError());
+            continue;
+        }
+        MIX_SetTrackCookedCallback(v.track, SfxCookedCB, &v);
+        MIX_SetTrackStoppedCallback(v.track, OnVoiceStopped, &v);
+    }
+    MIX_SetPostMixCallback(st.mixer, CommandPostMixCB, nullptr);
+    st.prefetch.worker = std::thread(MusicPrefetchWorker, st.mixer);
 
     st.mixerInited = true;
     return true;
@@ -118,47 +936,57 @@ void Sound::shutdown()
     auto& st = SS();
     if (!st.mixerInited) return;
 
-    // Stop and destroy any remaining SFX tracks; RAII will free cooked userdata
-    for (auto& a : st.activeSfxTracks) {
-        if (a.track) {
-            MIX_StopTrack(a.track, 0);
-            MIX_DestroyTrack(a.track);
-            a.track = nullptr;
+    // No new audio may be opened against the mixer past this point
+    StopMusicPrefetch(st);
+
+    // Stop and destroy the SFX voice pool
+    for (auto& v : st.voices) {
+        if (v.track) {
+            MIX_SetTrackStoppedCallback(v.track, nullptr, nullptr);
+            MIX_StopTrack(v.track, 0);
+            MIX_DestroyTrack(v.track);
+            v.track = nullptr;
         }
+        v.active = false;
+        v.sound = {};
     }
-    st.activeSfxTracks.clear();
+    st.commandOverflow.clear();
 
     // Stop music and close
-    if (st.musicTrack) {
-        // stop immediately
-        MIX_StopTrack(st.musicTrack, 0);
-        MIX_DestroyTrack(st.musicTrack);
-        st.musicTrack = nullptr;
+    StopPlaylist(st);
+    for (auto& deck : st.decks) {
+        if (!deck.track) continue;
+        MIX_SetTrackStoppedCallback(deck.track, nullptr, nullptr);
+        MIX_StopTrack(deck.track, 0);
+        MIX_DestroyTrack(deck.track);
+        deck.track = nullptr;
     }
+    ReleaseRetiredMusic(st, true);
 
-    // Free loaded audio
-    for (auto& s : st.sfx) {
-        if (s && s->handle) {
-            MIX_DestroyAudio(s->handle);
-            s->handle = nullptr;
-        }
-    }
+    // Free loaded audio; outstanding handles become stale
+    st.sfx.forEach([](Sound::Sfx& s) {
+        if (s.decoded) MIX_DestroyAudio(s.decoded);
+        if (s.stream) MIX_DestroyAudio(s.stream);
+    });
     st.sfx.clear();
+    st.emitters.clear();
+    st.sfxLru.clear();
+    st.pendingDecode.clear();
+    st.cacheStats = Sound::SfxCacheStats{};
 
-    for (auto& m : st.music) {
-        if (m && m->handle) {
-            MIX_DestroyAudio(m->handle);
-            m->handle = nullptr;
-        }
-    }
+    st.music.forEach([](Sound::Music& m) {
+        if (m.handle) MIX_DestroyAudio(m.handle);
+    });
     st.music.clear();
 
     if (st.mixer) {
-        // cleanup music callback userdata if any
-        if (st.musicCbUser) { delete static_cast<float*>(st.musicCbUser); st.musicCbUser = nullptr; }
         MIX_DestroyMixer(st.mixer);
         st.mixer = nullptr;
     }
+    // The mixer thread is gone, so the main thread can drain what it never consumed
+    SoundState::Command cmd;
+    while (st.commands.pop(cmd)) {}
+    st.bus = SoundState::MixerBus{};
 
     MIX_Quit();
     st.mixerInited = false;
@@ -168,216 +996,211 @@ void Sound::update()
 {
     auto& st = SS();
     if (!st.mixerInited) return;
-    // Drain and destroy any finished SFX tracks queued by the mixer thread.
-    Vector<MIX_Track*> toDestroy;
-    {
-        std::scoped_lock<std::mutex> lock(st.trashMutex);
-        toDestroy.swap(st.trashTracks);
-    }
-    for (auto* t : toDestroy) {
-        if (t && t != st.musicTrack) {
-            // remove from active SFX list if present
-            for (auto it = st.activeSfxTracks.begin(); it != st.activeSfxTracks.end(); ++it) {
-                if (it->track == t) {
-                    st.activeSfxTracks.erase(it);
-                    break;
-                }
-            }
-            MIX_DestroyTrack(t);
-        }
-    }
+    // Return voices that finished mixing to the pool
+    DrainStoppedVoices(st);
+    UpdateEmitters(st);
+    UpdateMusicPlaylist(st);
+    FlushCommandOverflow(st);
+    ServicePendingDecodes(st);
 }
 
-Sound::Sfx* Sound::loadSfx(const std::string& path)
+Sound::SfxHandle Sound::loadSfx(const std::string& path)
 {
     auto& st = SS();
     if (!st.mixerInited || !st.mixer) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sound::loadSfx called before Sound::init");
-        return nullptr;
+        return {};
     }
 
     MIX_Audio* audio = MIX_LoadAudio(st.mixer, path.c_str(), /*predecode*/ false);
     if (!audio) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_LoadAudio failed for '%s': %s", path.c_str(), SDL_GetError());
-        return nullptr;
+        return {};
     }
 
-    auto sfxRef = CreateRef<Sound::Sfx>();
-    sfxRef->handle = audio;
-    st.sfx.push_back(sfxRef);
-    return sfxRef.get();
+    Sound::Sfx entry;
+    entry.stream = audio;
+    entry.path = path;
+    SDL_PathInfo info{};
+    if (SDL_GetPathInfo(path.c_str(), &info)) entry.fileBytes = (size_t)info.size;
+    entry.cacheable = entry.fileBytes > 0 && entry.fileBytes <= st.cachePolicy.predecodeMaxFileBytes;
+
+    const Sound::SfxHandle h = st.sfx.create(std::move(entry));
+    Sound::Sfx* e = st.sfx.get(h);
+    if (e && e->cacheable) Decode(st, h, *e); // on failure the sound still streams
+    return h;
 }
 
-void Sound::unloadSfx(Sound::Sfx* s)
+void Sound::unloadSfx(Sound::SfxHandle s)
 {
-    if (!s) return;
     auto& st = SS();
-    for (auto it = st.sfx.begin(); it != st.sfx.end(); ++it) {
-        if (it->get() == s) {
-            if ((*it)->handle) {
-                MIX_DestroyAudio((*it)->handle);
-                (*it)->handle = nullptr;
-            }
-            st.sfx.erase(it);
-            break;
-        }
-    }
+    Sound::Sfx* sfx = st.sfx.get(s);
+    if (!sfx) return;
+    DropDecoded(st, *sfx);
+    if (sfx->pinned) st.cacheStats.pinnedCount--;
+    if (sfx->stream) MIX_DestroyAudio(sfx->stream);
+    st.sfx.release(s);
 }
 
-Sound::Music* Sound::loadMusic(const std::string& path)
+void Sound::setSfxCachePolicy(const SfxCachePolicy& policy)
 {
     auto& st = SS();
-    if (!st.mixerInited || !st.mixer) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sound::loadMusic called before Sound::init");
-        return nullptr;
-    }
-
-    MIX_Audio* audio = MIX_LoadAudio(st.mixer, path.c_str(), /*predecode*/ false);
-    if (!audio) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_LoadAudio failed for '%s': %s", path.c_str(), SDL_GetError());
-        return nullptr;
-    }
-
-    auto musicRef = CreateRef<Sound::Music>();
-    musicRef->handle = audio;
-    st.music.push_back(musicRef);
-    return musicRef.get();
+    st.cachePolicy = policy;
+    // Sounds that became cacheable decode on their next play (counted as a miss)
+    st.sfx.forEach([&](Sound::Sfx& e) {
+        if (e.pinned) return;
+        e.cacheable = e.fileBytes > 0 && e.fileBytes <= policy.predecodeMaxFileBytes;
+        if (!e.cacheable) DropDecoded(st, e);
+    });
+    EnforceBudget(st);
 }
 
-void Sound::unloadMusic(Sound::Music* m)
+const Sound::SfxCachePolicy& Sound::getSfxCachePolicy()
 {
-    if (!m) return;
-    auto& st = SS();
-    for (auto it = st.music.begin(); it != st.music.end(); ++it) {
-        if (it->get() == m) {
-            if ((*it)->handle) {
-                MIX_DestroyAudio((*it)->handle);
-                (*it)->handle = nullptr;
-            }
-            st.music.erase(it);
-            break;
-        }
-    }
+    return SS().cachePolicy;
 }
 
-bool Sound::playSfx(Sound::Sfx* s, int loops, int channel, int volume)
+void Sound::pinSfx(Sound::SfxHandle s, bool pinned)
 {
     auto& st = SS();
-    (void)channel; // SDL_mixer 3.x doesn't have channel indices; we autogenerate tracks.
-    // per-track volume (0..128) expressed as base gain [0..1]
-    float baseGain = static_cast<float>(farmMax(0, farmMin(volume, 128))) / 128.0f;
-    if (!st.mixerInited || !st.mixer || !s || !s->handle) return false;
-
-    MIX_Track* track = MIX_CreateTrack(st.mixer);
-    if (!track) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_CreateTrack failed: %s", SDL_GetError());
-        return false;
-    }
+    Sound::Sfx* e = st.sfx.get(s);
+    if (!e || e->pinned == pinned) return;
 
-    if (!MIX_SetTrackAudio(track, s->handle)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_SetTrackAudio failed: %s", SDL_GetError());
-        MIX_DestroyTrack(track);
-        return false;
+    if (pinned) {
+        if (e->decoded) st.sfxLru.erase(e->lru);
+        e->pinned = true;
+        e->cacheable = true;
+        st.cacheStats.pinnedCount++;
+        if (st.mixer) Decode(st, s, *e);
+        EnforceBudget(st);
+        return;
     }
 
-    // Use cooked-callback to scale samples; stash baseGain in RAII pointer
-    auto user = std::make_unique<float>(baseGain);
-    MIX_SetTrackCookedCallback(track, SfxCookedCB, user.get());
+    e->pinned = false;
+    st.cacheStats.pinnedCount--;
+    e->cacheable = e->fileBytes > 0 && e->fileBytes <= st.cachePolicy.predecodeMaxFileBytes;
+    if (e->decoded) {
+        st.sfxLru.push_front(s);
+        e->lru = st.sfxLru.begin();
+        if (!e->cacheable) DropDecoded(st, *e);
+    }
+    EnforceBudget(st);
+}
 
-    // Auto-destroy when finished
-    MIX_SetTrackStoppedCallback(track, OnTrackStopped, nullptr);
+const Sound::SfxCacheStats& Sound::getSfxCacheStats()
+{
+    auto& st = SS();
+    st.cacheStats.budgetBytes = st.cachePolicy.budgetBytes;
+    return st.cacheStats;
+}
 
-    SDL_PropertiesID opts = SDL_CreateProperties();
-    if (loops != 0) {
-        // loops: 0 = no loop; 1 = loop once; -1 = infinite
-        SDL_SetNumberProperty(opts, MIX_PROP_PLAY_LOOPS_NUMBER, static_cast<Sint64>(loops));
+Sound::MusicHandle Sound::loadMusic(const std::string& path)
+{
+    auto& st = SS();
+    if (!st.mixerInited || !st.mixer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Sound::loadMusic called before Sound::init");
+        return {};
     }
 
-    bool ok = MIX_PlayTrack(track, opts);
-    SDL_DestroyProperties(opts);
-    if (!ok) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_PlayTrack failed: %s", SDL_GetError());
-        // If play failed, destroy the track now to avoid a leak
-        MIX_SetTrackStoppedCallback(track, nullptr, nullptr);
-        MIX_DestroyTrack(track);
-        return false;
+    MIX_Audio* audio = MIX_LoadAudio(st.mixer, path.c_str(), /*predecode*/ false);
+    if (!audio) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_LoadAudio failed for '%s': %s", path.c_str(), SDL_GetError());
+        return {};
     }
 
-    // Track this SFX so future setSfxVolume() can adjust it
-    st.activeSfxTracks.emplace_back(track, baseGain, std::move(user));
-
-    return true;
+    return st.music.create(Sound::Music{ audio });
 }
 
-bool Sound::playMusic(Sound::Music* m, int loops, int volume)
+void Sound::unloadMusic(Sound::MusicHandle m)
 {
     auto& st = SS();
-    if (!st.mixerInited || !st.mixer || !st.musicTrack || !m || !m->handle) return false;
+    Sound::Music* music = st.music.get(m);
+    if (!music) return;
+    if (music->handle) MIX_DestroyAudio(music->handle);
+    st.music.release(m);
+}
 
-    if (!MIX_SetTrackAudio(st.musicTrack, m->handle)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_SetTrackAudio (music) failed: %s", SDL_GetError());
-        return false;
-    }
+bool Sound::playSfx(Sound::SfxHandle sfx, int loops, int channel, int volume)
+{
+    (void)channel; // SDL_mixer 3.x doesn't have channel indices; voices come from the pool.
+    SfxPlayOptions opts;
+    opts.loops = loops;
+    opts.volume = volume;
+    return playSfx(sfx, opts);
+}
 
-    // per-track base gain from requested volume; apply via cooked callback
-    st.musicBaseGain = static_cast<float>(farmMax(0, farmMin(volume, 128))) / 128.0f;
-    // free previous userdata if any
-    if (st.musicCbUser) { delete static_cast<float*>(st.musicCbUser); st.musicCbUser = nullptr; }
-    st.musicCbUser = nullptr; // not used by MusicCookedCB
-    MIX_SetTrackCookedCallback(st.musicTrack, MusicCookedCB, st.musicCbUser);
+bool Sound::playSfx(Sound::SfxHandle sfx, const SfxPlayOptions& opts)
+{
+    return StartVoice(SS(), sfx, opts, opts.priority, 1.0f, 1.0f, 0) >= 0;
+}
 
-    SDL_PropertiesID opts = SDL_CreateProperties();
-    SDL_SetNumberProperty(opts, MIX_PROP_PLAY_LOOPS_NUMBER, static_cast<Sint64>(loops));
-    bool ok = MIX_PlayTrack(st.musicTrack, opts);
-    SDL_DestroyProperties(opts);
-    if (!ok) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_PlayTrack (music) failed: %s", SDL_GetError());
-        return false;
-    }
-    return true;
+bool Sound::playMusic(Sound::MusicHandle music, int loops, int volume)
+{
+    return crossfadeMusic(music, 0, loops, volume);
+}
+
+bool Sound::playMusicFadeIn(Sound::MusicHandle music, int loops, int volume, int fadeInMs)
+{
+    return crossfadeMusic(music, fadeInMs, loops, volume);
 }
 
-bool Sound::playMusicFadeIn(Sound::Music* m, int loops, int volume, int fadeInMs)
+bool Sound::crossfadeMusic(Sound::MusicHandle music, int crossfadeMs, int loops, int volume)
 {
     auto& st = SS();
-    if (!st.mixerInited || !st.mixer || !st.musicTrack || !m || !m->handle) return false;
+    const Sound::Music* m = st.music.get(music);
+    if (!st.mixerInited || !st.mixer || !m || !m->handle) return false;
+    StopPlaylist(st);
+    return SwitchMusic(st, m->handle, loops, volume, crossfadeMs, crossfadeMs);
+}
 
-    if (!MIX_SetTrackAudio(st.musicTrack, m->handle)) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_SetTrackAudio (music) failed: %s", SDL_GetError());
-        return false;
-    }
+void Sound::playMusicPlaylist(const Vector<String>& paths, const MusicPlaylistOptions& opts)
+{
+    auto& st = SS();
+    if (!st.mixerInited || !st.mixer) return;
+    StopPlaylist(st);
+    if (paths.empty()) { stopMusic(opts.switchFadeMs); return; }
 
-    // per-track base gain from requested volume; apply via cooked callback
-    st.musicBaseGain = static_cast<float>(farmMax(0, farmMin(volume, 128))) / 128.0f;
-    if (st.musicCbUser) { delete static_cast<float*>(st.musicCbUser); st.musicCbUser = nullptr; }
-    st.musicCbUser = nullptr;
-    MIX_SetTrackCookedCallback(st.musicTrack, MusicCookedCB, st.musicCbUser);
+    auto& pl = st.playlist;
+    pl.paths = paths;
+    pl.opts = opts;
+    pl.active = true;
+    pl.hasNext = true;
+    RequestPlaylistEntry(st); // whatever plays keeps playing until the first entry is open
+}
 
-    SDL_PropertiesID opts = SDL_CreateProperties();
-    SDL_SetNumberProperty(opts, MIX_PROP_PLAY_LOOPS_NUMBER, static_cast<Sint64>(loops));
-    if (fadeInMs > 0) {
-        SDL_SetNumberProperty(opts, MIX_PROP_PLAY_FADE_IN_MILLISECONDS_NUMBER, static_cast<Sint64>(fadeInMs));
-    }
-    bool ok = MIX_PlayTrack(st.musicTrack, opts);
-    SDL_DestroyProperties(opts);
-    if (!ok) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "MIX_PlayTrack (music fade-in) failed: %s", SDL_GetError());
-        return false;
-    }
-    return true;
+bool Sound::isMusicPlaylistActive()
+{
+    return SS().playlist.active;
 }
 
 void Sound::stopMusic(int fadeMs)
 {
     auto& st = SS();
-    if (!st.mixerInited || !st.musicTrack) return;
+    if (!st.mixerInited) return;
+    StopPlaylist(st);
+    for (int d = 0; d < (int)st.decks.size(); ++d) FadeOutDeck(st, d, fadeMs);
+}
 
-    Sint64 frames = 0;
-    if (fadeMs > 0) {
-        frames = MIX_TrackMSToFrames(st.musicTrack, static_cast<Sint64>(fadeMs));
-        if (frames < 0) frames = 0; // fallback
+void Sound::stopSfx(Sound::SfxHandle sfx, int fadeMs)
+{
+    auto& st = SS();
+    if (!st.mixerInited) return;
+    for (auto& v : st.voices) {
+        if (!v.active || !v.track || (sfx && v.sound != sfx)) continue;
+        const Sint64 frames = fadeMs > 0 ? farmMax((Sint64)0, MIX_TrackMSToFrames(v.track, static_cast<Sint64>(fadeMs))) : 0;
+        StopVoice(st, v.index, v.serial.load(std::memory_order_relaxed), frames);
     }
-    MIX_StopTrack(st.musicTrack, frames);
+    // Emitters of this sound would otherwise restart their loops next update()
+    st.finishedEmitters.clear();
+    st.emitters.forEach([&](Sound::Emitter& e) {
+        if (!sfx || e.sound == sfx) st.finishedEmitters.push_back(e.self);
+    });
+    for (Sound::EmitterHandle h : st.finishedEmitters) st.emitters.release(h);
+}
+
+void Sound::stopAllSfx(int fadeMs)
+{
+    stopSfx(Sound::SfxHandle{}, fadeMs);
 }
 
 void Sound::setMasterVolume(int volume)
@@ -394,8 +1217,19 @@ void Sound::setMusicVolume(int volume)
     if (!st.mixerInited) return;
     float g = static_cast<float>(farmMax(0, farmMin(volume, 128))) / 128.0f;
     if (g > 1.0f) g = 1.0f; // attenuation only
-    st.musicGain = g;
-    // No mixer-side gain changes; cooked callback scales samples using musicBaseGain * musicGain
+    // Applied on the mixer thread; each deck's cooked callback ramps to its base gain * musicGain
+    SoundState::Command cmd;
+    cmd.type = SoundState::Command::Type::MusicGain;
+    cmd.value = g;
+    PushCommand(st, cmd);
+}
+
+void Sound::setMusicSoftClip(bool enabled)
+{
+    SoundState::Command cmd;
+    cmd.type = SoundState::Command::Type::MusicSoftClip;
+    cmd.value = enabled ? 1.0f : 0.0f;
+    PushCommand(SS(), cmd);
 }
 
 void Sound::setSfxVolume(int volume)
@@ -404,6 +1238,78 @@ void Sound::setSfxVolume(int volume)
     if (!st.mixerInited) return;
     float g = static_cast<float>(farmMax(0, farmMin(volume, 128))) / 128.0f;
     if (g > 1.0f) g = 1.0f; // attenuation only
-    st.sfxGain = g;
-    // No per-track gain updates needed; cooked callback reads sfxGain atomically at mix time
+    // Applied on the mixer thread; every SFX voice ramps to its base gain * sfxGain
+    SoundState::Command cmd;
+    cmd.type = SoundState::Command::Type::SfxGain;
+    cmd.value = g;
+    PushCommand(st, cmd);
+}
+
+void Sound::setListenerPosition(const Vector2& worldPos)
+{
+    SS().listener = worldPos;
+}
+
+Sound::EmitterHandle Sound::playSfxAt(Sound::SfxHandle sfx, const Vector2& worldPos, const SfxPlayOptions& opts, const SpatialParams& params)
+{
+    auto& st = SS();
+    if (!st.mixerInited || !st.sfx.get(sfx)) return {};
+
+    float left = 0.0f, right = 0.0f;
+    const bool audible = SpatialGains(st.listener, worldPos, params, left, right);
+    if (!audible && opts.loops >= 0) return {}; // culled one-shot: never takes a voice
+
+    Sound::Emitter e;
+    e.sound = sfx;
+    e.opts = opts;
+    e.params = params;
+    e.pos = worldPos;
+    e.startTicks = SDL_GetTicks();
+    const Sound::EmitterHandle h = st.emitters.create(e);
+    Sound::Emitter* ep = st.emitters.get(h);
+    ep->self = h;
+    if (audible) {
+        StartEmitter(st, *ep, opts.priority, left, right);
+        if (ep->voice < 0 && !ep->persistent()) {
+            st.emitters.release(h);
+            return {};
+        }
+    }
+    return h;
+}
+
+Sound::EmitterHandle Sound::playSfxAt(Sound::SfxHandle sfx, const TileVector& tile, const TileVector& tileSize, const SfxPlayOptions& opts, const SpatialParams& params)
+{
+    const Vector2 worldPos{ (float)(tile.x * tileSize.x), (float)(tile.y * tileSize.y) };
+    return playSfxAt(sfx, worldPos, opts, params);
+}
+
+void Sound::setEmitterPosition(Sound::EmitterHandle e, const Vector2& worldPos)
+{
+    if (Sound::Emitter* em = SS().emitters.get(e)) em->pos = worldPos; // applied by the next update()
+}
+
+void Sound::stopEmitter(Sound::EmitterHandle e, int fadeMs)
+{
+    auto& st = SS();
+    Sound::Emitter* em = st.emitters.get(e);
+    if (!em) return;
+    if (em->voice >= 0) {
+        auto& v = st.voices[em->voice];
+        const Sint64 frames = fadeMs > 0 && v.track ? farmMax((Sint64)0, MIX_TrackMSToFrames(v.track, static_cast<Sint64>(fadeMs))) : 0;
+        StopVoice(st, em->voice, em->voiceSerial, frames);
+    }
+    st.emitters.release(e);
+}
+
+bool Sound::isEmitterAlive(Sound::EmitterHandle e)
+{
+    return SS().emitters.contains(e);
+}
+
+int Sound::getAudibleEmitterCount()
+{
+    int count = 0;
+    SS().emitters.forEach([&](const Sound::Emitter& e) { if (e.voice >= 0) ++count; });
+    return count;
 }
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <cstdint>
+#include <cstddef>
 
 // Forward declarations to avoid exposing SDL_mixer headers to all includers (SDL_mixer 3.x)
 struct MIX_Audio;
@@ -11,29 +12,122 @@ struct MIX_Track;
 namespace Sound {
     // Initialize/Shutdown SDL_mixer system
     bool init();
-    // Pump cleanup and any pending audio maintenance. Call once per frame.
+    // Pump cleanup and any pending audio maintenance, including the batched positional
+    // pass over all emitters. Call once per frame after setListenerPosition().
     void update();
     void shutdown();
 
-    // Simple handles
-    struct Sfx { MIX_Audio* handle = nullptr; };
+    // Loaded audio lives in generational pools; callers hold handles, which
+    // go stale (and are ignored) after unload or shutdown.
+    struct Sfx;  // cache entry, private to Sound.cpp
     struct Music { MIX_Audio* handle = nullptr; };
+    using SfxHandle = Handle<Sfx>;
+    using MusicHandle = Handle<Music>;
 
-    // Load/unload
-    Sfx* loadSfx(const std::string& path);
-    void unloadSfx(Sfx* s);
+    // Load/unload. Load returns a null handle on failure.
+    // Short SFX (file size at or below the predecode threshold) are decoded to PCM at
+    // load so playing them costs no decode work; longer ones and music stream.
+    SfxHandle loadSfx(const std::string& path);
+    void unloadSfx(SfxHandle s);
 
-    Music* loadMusic(const std::string& path);
-    void unloadMusic(Music* m);
+    // Decoded SFX are held in an LRU cache bounded by budgetBytes. When over budget the
+    // least recently played unpinned sounds fall back to streaming; playing one again
+    // counts a miss and re-decodes it during a later update().
+    struct SfxCachePolicy {
+        size_t predecodeMaxFileBytes = 256 * 1024;
+        size_t budgetBytes = 16 * 1024 * 1024;
+    };
+    void setSfxCachePolicy(const SfxCachePolicy& policy);
+    const SfxCachePolicy& getSfxCachePolicy();
+
+    // Pinned sounds are decoded regardless of size and never evicted (they still count
+    // towards bytesUsed). Use for latency-critical SFX such as UI clicks and hits.
+    void pinSfx(SfxHandle s, bool pinned = true);
+
+    struct SfxCacheStats {
+        size_t bytesUsed = 0;      // decoded PCM currently resident
+        size_t budgetBytes = 0;
+        int predecodedCount = 0;
+        int pinnedCount = 0;
+        uint64_t hits = 0;         // plays served from decoded PCM
+        uint64_t misses = 0;       // plays of cacheable sounds that had been evicted
+        uint64_t evictions = 0;
+        double decodeMsSpent = 0.0; // time spent predecoding
+        double decodeMsSaved = 0.0; // decode time hits avoided (sum of measured decode cost)
+    };
+    const SfxCacheStats& getSfxCacheStats();
+
+    MusicHandle loadMusic(const std::string& path);
+    void unloadMusic(MusicHandle m);
+
+    // SFX play from a fixed pool of preallocated voices (no per-play allocation)
+    constexpr int kMaxSfxVoices = 32;
+
+    struct SfxPlayOptions {
+        int loops = 0;        // 0 = once, n = repeat n more times, -1 = forever
+        int volume = 128;     // 0-128
+        int priority = 0;     // higher wins when voices must be stolen
+        int maxInstances = 0; // simultaneous voices of this sound; 0 = unlimited
+    };
 
     // Playback
-    // channel: -1 picks first free channel
-    bool playSfx(Sfx* s, int loops = 0, int channel = -1, int volume = 128);
-    bool playMusic(Music* m, int loops = -1, int volume = 96);
-    // Convenience: play music with a fade-in over the specified milliseconds
-    bool playMusicFadeIn(Music* m, int loops = -1, int volume = 96, int fadeInMs = 250);
+    // When the pool (or the sound's instance cap) is full, the lowest-priority voice with
+    // priority <= the request is stolen, preferring the quietest then the oldest.
+    // Returns false if every candidate voice outranks the request.
+    bool playSfx(SfxHandle s, const SfxPlayOptions& opts);
+    // channel is ignored (kept for older callers)
+    bool playSfx(SfxHandle s, int loops = 0, int channel = -1, int volume = 128);
+    // Music plays on two decks: starting a track puts it on the idle deck and fades the
+    // live one out, with the envelopes run on the mixer thread. playMusic cuts over
+    // immediately; playMusicFadeIn and crossfadeMusic overlap the two for fadeMs.
+    bool playMusic(MusicHandle m, int loops = -1, int volume = 96);
+    bool playMusicFadeIn(MusicHandle m, int loops = -1, int volume = 96, int fadeInMs = 250);
+    bool crossfadeMusic(MusicHandle m, int crossfadeMs = 1000, int loops = -1, int volume = 96);
+    // Stops music and any playlist
     void stopMusic(int fadeMs = 0);
 
+    struct MusicPlaylistOptions {
+        bool loop = true;        // wrap to the first entry after the last
+        int volume = 96;         // 0-128
+        int crossfadeMs = 0;     // between entries; 0 = gapless join
+        int switchFadeMs = 1000; // crossfade from the previous music into the first entry
+    };
+    // Streams the files in order. Each entry is opened on a background thread one ahead
+    // of playback, so starting or switching playlists never blocks the main thread; the
+    // previous music keeps playing until the first entry is ready.
+    void playMusicPlaylist(const Vector<String>& paths, const MusicPlaylistOptions& opts = {});
+    bool isMusicPlaylistActive();
+    // Stop every voice playing this sound (or all SFX), optionally fading out.
+    // Each stop only takes the track's lock briefly and only hits the play it was
+    // aimed at, never a sound started on that voice afterwards.
+    void stopSfx(SfxHandle s, int fadeMs = 0);
+    void stopAllSfx(int fadeMs = 0);
+
+    // Positional SFX in world coordinates, heard relative to the listener (the player's
+    // world position). Emitters are virtual: a voice is only taken while the emitter is
+    // within maxDistance, so distant ambient loops cost no voice and no mixing.
+    struct Emitter;
+    using EmitterHandle = Handle<Emitter>;
+
+    // Distances are world units (the world map uses 128-unit tiles)
+    struct SpatialParams {
+        float minDistance = 256.0f;  // full volume inside this radius
+        float maxDistance = 1536.0f; // silent and culled at or beyond this radius
+        float panWidth = 640.0f;     // horizontal offset at which the pan is fully left/right
+    };
+
+    void setListenerPosition(const Vector2& worldPos);
+    // One-shots out of range when played are culled and return a null handle. Looping
+    // emitters persist until stopped and (re)start whenever they come into range.
+    EmitterHandle playSfxAt(SfxHandle s, const Vector2& worldPos, const SfxPlayOptions& opts = {}, const SpatialParams& params = {});
+    // Tile-space convenience: position is tile * tileSize, matching the world map
+    EmitterHandle playSfxAt(SfxHandle s, const TileVector& tile, const TileVector& tileSize, const SfxPlayOptions& opts = {}, const SpatialParams& params = {});
+    void setEmitterPosition(EmitterHandle e, const Vector2& worldPos);
+    void stopEmitter(EmitterHandle e, int fadeMs = 0);
+    bool isEmitterAlive(EmitterHandle e);
+    // Emitters currently holding a voice, for debugging and tests
+    int getAudibleEmitterCount();
+
     // Global volume (0-128 typical)
     void setMasterVolume(int volume);
 
@@ -42,4 +136,7 @@ namespace Sound {
     // - SFX volume applies to currently playing SFX tracks and new ones
     void setMusicVolume(int volume);
     void setSfxVolume(int volume);
+
+    // Soft-clip the music bus after gain so hot masters saturate instead of clipping
+    void setMusicSoftClip(bool enabled);
 }
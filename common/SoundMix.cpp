@@ -0,0 +1,347 @@
+#include "Common.h"
+#include "SoundMix.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define AQ_MIX_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define AQ_MIX_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AQ_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AQ_TARGET_AVX2
+#endif
+
+namespace {
+    using GainFn = void (*)(float*, int, int, float, float);
+    using StereoGainFn = void (*)(float*, int, float, float, float, float);
+
+    // Rational tanh approximation, exact at +-3 where it reaches +-1
+    inline float SoftClip(float x)
+    {
+        x = farmMax(-3.0f, farmMin(x, 3.0f));
+        const float x2 = x * x;
+        return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+    }
+
+    // Gain for sample i is gainFrom + step * (i / channels)
+    template<bool Clip>
+    inline void GainRange(float* pcm, int begin, int total, int channels, float gainFrom, float step)
+    {
+        for (int i = begin; i < total; ++i) {
+            const float g = gainFrom + step * (float)(i / channels);
+            const float y = pcm[i] * g;
+            pcm[i] = Clip ? SoftClip(y) : y;
+        }
+    }
+
+    template<bool Clip>
+    void GainScalar(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+    {
+        if (!pcm || frames <= 0 || channels <= 0) return;
+        const float step = (gainTo - gainFrom) / (float)frames;
+        GainRange<Clip>(pcm, 0, frames * channels, channels, gainFrom, step);
+    }
+
+    inline void StereoRange(float* pcm, int begin, int frames, float leftFrom, float rightFrom, float stepL, float stepR)
+    {
+        for (int f = begin; f < frames; ++f) {
+            pcm[2 * f] *= leftFrom + stepL * (float)f;
+            pcm[2 * f + 1] *= rightFrom + stepR * (float)f;
+        }
+    }
+
+    void StereoScalar(float* pcm, int frames, float leftFrom, float rightFrom, float leftTo, float rightTo)
+    {
+        if (!pcm || frames <= 0) return;
+        StereoRange(pcm, 0, frames, leftFrom, rightFrom, (leftTo - leftFrom) / (float)frames, (rightTo - rightFrom) / (float)frames);
+    }
+
+#ifdef AQ_MIX_X86
+    // Two frames per vector: lanes are L0 R0 L1 R1
+    void StereoSSE2(float* pcm, int frames, float leftFrom, float rightFrom, float leftTo, float rightTo)
+    {
+        if (!pcm || frames <= 0) return;
+        const float stepL = (leftTo - leftFrom) / (float)frames;
+        const float stepR = (rightTo - rightFrom) / (float)frames;
+        const __m128 g0 = _mm_set_ps(rightFrom, leftFrom, rightFrom, leftFrom);
+        const __m128 st = _mm_set_ps(stepR, stepL, stepR, stepL);
+        __m128 frame = _mm_set_ps(1.0f, 1.0f, 0.0f, 0.0f);
+        const __m128 frameInc = _mm_set1_ps(2.0f);
+
+        int f = 0;
+        for (; f + 2 <= frames; f += 2) {
+            const __m128 g = _mm_add_ps(g0, _mm_mul_ps(st, frame));
+            _mm_storeu_ps(pcm + 2 * f, _mm_mul_ps(_mm_loadu_ps(pcm + 2 * f), g));
+            frame = _mm_add_ps(frame, frameInc);
+        }
+        StereoRange(pcm, f, frames, leftFrom, rightFrom, stepL, stepR);
+    }
+
+    inline __m128 SoftClipSSE2(__m128 x)
+    {
+        x = _mm_max_ps(_mm_set1_ps(-3.0f), _mm_min_ps(x, _mm_set1_ps(3.0f)));
+        const __m128 x2 = _mm_mul_ps(x, x);
+        const __m128 num = _mm_mul_ps(x, _mm_add_ps(_mm_set1_ps(27.0f), x2));
+        const __m128 den = _mm_add_ps(_mm_set1_ps(27.0f), _mm_mul_ps(_mm_set1_ps(9.0f), x2));
+        return _mm_div_ps(num, den);
+    }
+
+    template<bool Clip>
+    void GainSSE2(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+    {
+        if (!pcm || frames <= 0 || channels <= 0) return;
+        const int total = frames * channels;
+        const float step = (gainTo - gainFrom) / (float)frames;
+        // Lanes must map to whole frames for the per-lane frame index to stay regular
+        if (4 % channels != 0) { GainRange<Clip>(pcm, 0, total, channels, gainFrom, step); return; }
+
+        __m128 frame = _mm_set_ps((float)(3 / channels), (float)(2 / channels), (float)(1 / channels), 0.0f);
+        const __m128 frameInc = _mm_set1_ps((float)(4 / channels));
+        const __m128 g0 = _mm_set1_ps(gainFrom);
+        const __m128 st = _mm_set1_ps(step);
+
+        int i = 0;
+        for (; i + 4 <= total; i += 4) {
+            const __m128 g = _mm_add_ps(g0, _mm_mul_ps(st, frame));
+            __m128 x = _mm_mul_ps(_mm_loadu_ps(pcm + i), g);
+            if constexpr (Clip) x = SoftClipSSE2(x);
+            _mm_storeu_ps(pcm + i, x);
+            frame = _mm_add_ps(frame, frameInc);
+        }
+        GainRange<Clip>(pcm, i, total, channels, gainFrom, step);
+    }
+
+    AQ_TARGET_AVX2 inline __m256 SoftClipAVX2(__m256 x)
+    {
+        x = _mm256_max_ps(_mm256_set1_ps(-3.0f), _mm256_min_ps(x, _mm256_set1_ps(3.0f)));
+        const __m256 x2 = _mm256_mul_ps(x, x);
+        const __m256 num = _mm256_mul_ps(x, _mm256_add_ps(_mm256_set1_ps(27.0f), x2));
+        const __m256 den = _mm256_add_ps(_mm256_set1_ps(27.0f), _mm256_mul_ps(_mm256_set1_ps(9.0f), x2));
+        return _mm256_div_ps(num, den);
+    }
+
+    template<bool Clip>
+    AQ_TARGET_AVX2 void GainAVX2(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+    {
+        if (!pcm || frames <= 0 || channels <= 0) return;
+        const int total = frames * channels;
+        const float step = (gainTo - gainFrom) / (float)frames;
+        if (8 % channels != 0) { GainRange<Clip>(pcm, 0, total, channels, gainFrom, step); return; }
+
+        alignas(32) float lanes[8];
+        for (int k = 0; k < 8; ++k) lanes[k] = (float)(k / channels);
+        __m256 frame = _mm256_load_ps(lanes);
+        const __m256 frameInc = _mm256_set1_ps((float)(8 / channels));
+        const __m256 g0 = _mm256_set1_ps(gainFrom);
+        const __m256 st = _mm256_set1_ps(step);
+
+        int i = 0;
+        for (; i + 8 <= total; i += 8) {
+            const __m256 g = _mm256_add_ps(g0, _mm256_mul_ps(st, frame));
+            __m256 x = _mm256_mul_ps(_mm256_loadu_ps(pcm + i), g);
+            if constexpr (Clip) x = SoftClipAVX2(x);
+            _mm256_storeu_ps(pcm + i, x);
+            frame = _mm256_add_ps(frame, frameInc);
+        }
+        GainRange<Clip>(pcm, i, total, channels, gainFrom, step);
+    }
+#endif
+
+#ifdef AQ_MIX_NEON
+    void StereoNEON(float* pcm, int frames, float leftFrom, float rightFrom, float leftTo, float rightTo)
+    {
+        if (!pcm || frames <= 0) return;
+        const float stepL = (leftTo - leftFrom) / (float)frames;
+        const float stepR = (rightTo - rightFrom) / (float)frames;
+        const float g0v[4] = { leftFrom, rightFrom, leftFrom, rightFrom };
+        const float stv[4] = { stepL, stepR, stepL, stepR };
+        const float lanes[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+        const float32x4_t g0 = vld1q_f32(g0v);
+        const float32x4_t st = vld1q_f32(stv);
+        float32x4_t frame = vld1q_f32(lanes);
+        const float32x4_t frameInc = vdupq_n_f32(2.0f);
+
+        int f = 0;
+        for (; f + 2 <= frames; f += 2) {
+            const float32x4_t g = vaddq_f32(g0, vmulq_f32(st, frame));
+            vst1q_f32(pcm + 2 * f, vmulq_f32(vld1q_f32(pcm + 2 * f), g));
+            frame = vaddq_f32(frame, frameInc);
+        }
+        StereoRange(pcm, f, frames, leftFrom, rightFrom, stepL, stepR);
+    }
+
+    inline float32x4_t SoftClipNEON(float32x4_t x)
+    {
+        x = vmaxq_f32(vdupq_n_f32(-3.0f), vminq_f32(x, vdupq_n_f32(3.0f)));
+        const float32x4_t x2 = vmulq_f32(x, x);
+        const float32x4_t num = vmulq_f32(x, vaddq_f32(vdupq_n_f32(27.0f), x2));
+        const float32x4_t den = vaddq_f32(vdupq_n_f32(27.0f), vmulq_f32(vdupq_n_f32(9.0f), x2));
+        return vdivq_f32(num, den);
+    }
+
+    template<bool Clip>
+    void GainNEON(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+    {
+        if (!pcm || frames <= 0 || channels <= 0) return;
+        const int total = frames * channels;
+        const float step = (gainTo - gainFrom) / (float)frames;
+        if (4 % channels != 0) { GainRange<Clip>(pcm, 0, total, channels, gainFrom, step); return; }
+
+        const float lanes[4] = { 0.0f, (float)(1 / channels), (float)(2 / channels), (float)(3 / channels) };
+        float32x4_t frame = vld1q_f32(lanes);
+        const float32x4_t frameInc = vdupq_n_f32((float)(4 / channels));
+        const float32x4_t g0 = vdupq_n_f32(gainFrom);
+        const float32x4_t st = vdupq_n_f32(step);
+
+        int i = 0;
+        for (; i + 4 <= total; i += 4) {
+            const float32x4_t g = vaddq_f32(g0, vmulq_f32(st, frame));
+            float32x4_t x = vmulq_f32(vld1q_f32(pcm + i), g);
+            if constexpr (Clip) x = SoftClipNEON(x);
+            vst1q_f32(pcm + i, x);
+            frame = vaddq_f32(frame, frameInc);
+        }
+        GainRange<Clip>(pcm, i, total, channels, gainFrom, step);
+    }
+#endif
+
+    struct Kernels {
+        SoundMix::KernelLevel level = SoundMix::KernelLevel::Scalar;
+        GainFn gain = &GainScalar<false>;
+        GainFn gainClip = &GainScalar<true>;
+        StereoGainFn stereo = &StereoScalar;
+    };
+
+    Kernels SelectKernels(SoundMix::KernelLevel level)
+    {
+        Kernels k;
+        switch (level) {
+#ifdef AQ_MIX_X86
+        case SoundMix::KernelLevel::AVX2:
+            // Stereo stays on SSE2: the per-buffer work is too small for wider vectors to pay off
+            if (SDL_HasAVX2()) { k = { level, &GainAVX2<false>, &GainAVX2<true>, &StereoSSE2 }; break; }
+            [[fallthrough]];
+        case SoundMix::KernelLevel::SSE2:
+            k = { SoundMix::KernelLevel::SSE2, &GainSSE2<false>, &GainSSE2<true>, &StereoSSE2 }; // baseline on x86-64
+            break;
+#endif
+#ifdef AQ_MIX_NEON
+        case SoundMix::KernelLevel::NEON:
+            k = { level, &GainNEON<false>, &GainNEON<true>, &StereoNEON }; // baseline on AArch64
+            break;
+#endif
+        default:
+            break;
+        }
+        return k;
+    }
+
+    // Read on the mixer thread; written at startup or by tests
+    std::atomic<GainFn> g_gain{ nullptr };
+    std::atomic<GainFn> g_gainClip{ nullptr };
+    std::atomic<StereoGainFn> g_stereo{ nullptr };
+    std::atomic<SoundMix::KernelLevel> g_level{ SoundMix::KernelLevel::Scalar };
+
+    inline void EnsureKernels()
+    {
+        if (!g_gain.load(std::memory_order_acquire)) SoundMix::setKernelLevel(SoundMix::detectKernelLevel());
+    }
+}
+
+SoundMix::KernelLevel SoundMix::detectKernelLevel()
+{
+#if defined(AQ_MIX_X86)
+    return SDL_HasAVX2() ? KernelLevel::AVX2 : KernelLevel::SSE2;
+#elif defined(AQ_MIX_NEON)
+    return KernelLevel::NEON;
+#else
+    return KernelLevel::Scalar;
+#endif
+}
+
+SoundMix::KernelLevel SoundMix::getKernelLevel()
+{
+    EnsureKernels();
+    return g_level.load(std::memory_order_relaxed);
+}
+
+void SoundMix::setKernelLevel(KernelLevel level)
+{
+    const Kernels k = SelectKernels(level);
+    g_gainClip.store(k.gainClip, std::memory_order_relaxed);
+    g_stereo.store(k.stereo, std::memory_order_relaxed);
+    g_level.store(k.level, std::memory_order_relaxed);
+    g_gain.store(k.gain, std::memory_order_release);
+}
+
+const char* SoundMix::kernelLevelName(KernelLevel level)
+{
+    switch (level) {
+    case KernelLevel::SSE2: return "SSE2";
+    case KernelLevel::AVX2: return "AVX2";
+    case KernelLevel::NEON: return "NEON";
+    default: return "Scalar";
+    }
+}
+
+void SoundMix::applyGain(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+{
+    EnsureKernels();
+    g_gain.load(std::memory_order_acquire)(pcm, frames, channels, gainFrom, gainTo);
+}
+
+void SoundMix::applyGainSoftClip(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+{
+    EnsureKernels();
+    g_gainClip.load(std::memory_order_acquire)(pcm, frames, channels, gainFrom, gainTo);
+}
+
+void SoundMix::applyStereoGain(float* pcm, int frames, float leftFrom, float rightFrom, float leftTo, float rightTo)
+{
+    EnsureKernels();
+    g_stereo.load(std::memory_order_acquire)(pcm, frames, leftFrom, rightFrom, leftTo, rightTo);
+}
+
+void SoundMix::applyGainScalar(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+{
+    GainScalar<false>(pcm, frames, channels, gainFrom, gainTo);
+}
+
+void SoundMix::applyGainSoftClipScalar(float* pcm, int frames, int channels, float gainFrom, float gainTo)
+{
+    GainScalar<true>(pcm, frames, channels, gainFrom, gainTo);
+}
+
+void SoundMix::applyStereoGainScalar(float* pcm, int frames, float leftFrom, float rightFrom, float leftTo, float rightTo)
+{
+    StereoScalar(pcm, frames, leftFrom, rightFrom, leftTo, rightTo);
+}
+
+float SoundMix::distanceGain(float distance, float minDistance, float maxDistance)
+{
+    if (distance <= minDistance) return 1.0f;
+    if (distance >= maxDistance) return 0.0f;
+    const float t = (maxDistance - distance) / (maxDistance - minDistance);
+    return t * t;
+}
+
+void SoundMix::panGains(float pan, float& left, float& right)
+{
+    constexpr float kSqrt2 = 1.41421356f;
+    const float angle = (farmMax(-1.0f, farmMin(pan, 1.0f)) + 1.0f) * 0.25f * SDL_PI_F;
+    left = farmMin(1.0f, std::cos(angle) * kSqrt2);
+    right = farmMin(1.0f, std::sin(angle) * kSqrt2);
+}
+
+float SoundMix::equalPowerFade(float t)
+{
+    return std::sin(farmMax(0.0f, farmMin(t, 1.0f)) * 0.5f * SDL_PI_F);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// Sample-processing kernels used by the Sound cooked callbacks. Independent of
+// SDL_mixer so they can be unit tested and benchmarked without an audio device.
+namespace SoundMix {
+
+    enum class KernelLevel { Scalar, SSE2, AVX2, NEON };
+
+    // Best level this build and CPU support (detected once).
+    KernelLevel detectKernelLevel();
+    KernelLevel getKernelLevel();
+    // Force a level, e.g. for benchmarks. A level the CPU or build lacks falls back
+    // to the next one down: AVX2 to SSE2 on x86-64; anything else to Scalar.
+    void setKernelLevel(KernelLevel level);
+    const char* kernelLevelName(KernelLevel level);
+
+    // Scale interleaved float samples in place. The gain ramps linearly per frame
+    // from gainFrom (first frame) towards gainTo (reached at the start of the next
+    // buffer), so consecutive buffers join without a step.
+    void applyGain(float* pcm, int frames, int channels, float gainFrom, float gainTo);
+    // applyGain fused with a soft clip that keeps the output within [-1, 1].
+    void applyGainSoftClip(float* pcm, int frames, int channels, float gainFrom, float gainTo);
+
+    // Interleaved stereo with independent left/right ramps (positional voices).
+    void applyStereoGain(float* pcm, int frames, float leftFrom, float rightFrom, float leftTo, float rightTo);
+
+    // Scalar reference implementations (always available)
+    void applyGainScalar(float* pcm, int frames, int channels, float gainFrom, float gainTo);
+    void applyGainSoftClipScalar(float* pcm, int frames, int channels, float gainFrom, float gainTo);
+    void applyStereoGainScalar(float* pcm, int frames, float leftFrom, float rightFrom, float leftTo, float rightTo);
+
+    // Spatial helpers for 2D positional audio
+    // 1 inside minDistance, 0 at or beyond maxDistance, quadratic falloff between.
+    float distanceGain(float distance, float minDistance, float maxDistance);
+    // Clamped sin/cos pan (-1 = left, 1 = right): the sin/cos law scaled by sqrt(2)
+    // and clamped to 1, so a centred sound plays at unity on both sides and the far
+    // side fades out towards a hard pan. Not constant power: L^2 + R^2 is 2 at the
+    // centre and 1 at either end.
+    void panGains(float pan, float& left, float& right);
+    // Equal-power crossfade curve: for t in [0, 1], fade(t)^2 + fade(1 - t)^2 == 1.
+    float equalPowerFade(float t);
+}
@@ -0,0 +1,215 @@
+#include "Common.h"
+
+namespace {
+    using namespace SpriteLayer;
+
+    constexpr uint32_t kDepthLevels = 0xFFFFu;
+    // Sprites a regrouping scan may step over before it gives up; bounds the
+    // overlap tests to O(n * window) for slices with thousands of sprites
+    constexpr std::size_t kRegroupWindow = 64;
+
+    struct LayerState {
+        Vector<Sprite> sprites;         // submission order
+        Vector<uint32_t> keys, keysTmp;
+        Vector<uint32_t> order, orderTmp;
+        Vector<SDL_FRect> quads;        // destination rect per submitted sprite
+        Vector<uint32_t> skipped;
+        Vector<uint8_t> taken;
+        Vector<SpriteRun> runs;
+        Vector<SDL_Vertex> vertices;
+        float quantum = 1.0f;
+    };
+    LayerState s_layer;
+
+    // Stable LSD radix sort of order[] by keys[], one byte per pass. Passes where
+    // every key has the same byte are skipped (e.g. a single texture).
+    void RadixSort(LayerState& st)
+    {
+        const std::size_t n = st.keys.size();
+        st.keysTmp.resize(n);
+        st.orderTmp.resize(n);
+        uint32_t* keys = st.keys.data();
+        uint32_t* order = st.order.data();
+        uint32_t* keysOut = st.keysTmp.data();
+        uint32_t* orderOut = st.orderTmp.data();
+
+        uint32_t counts[4][256] = {};
+        for (std::size_t i = 0; i < n; ++i) {
+            const uint32_t k = keys[i];
+            ++counts[0][k & 0xFF];
+            ++counts[1][(k >> 8) & 0xFF];
+            ++counts[2][(k >> 16) & 0xFF];
+            ++counts[3][k >> 24];
+        }
+
+        for (int pass = 0; pass < 4; ++pass) {
+            uint32_t* c = counts[pass];
+            const int shift = pass * 8;
+            if (c[(keys[0] >> shift) & 0xFF] == n) continue;
+
+            uint32_t sum = 0;
+            for (int b = 0; b < 256; ++b) {
+                const uint32_t t = c[b];
+                c[b] = sum;
+                sum += t;
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                const uint32_t dst = c[(keys[i] >> shift) & 0xFF]++;
+                keysOut[dst] = keys[i];
+                orderOut[dst] = order[i];
+            }
+            std::swap(keys, keysOut);
+            std::swap(order, orderOut);
+        }
+
+        // An odd number of passes leaves the result in the scratch arrays
+        if (order != st.order.data()) {
+            st.keys.swap(st.keysTmp);
+            st.order.swap(st.orderTmp);
+        }
+    }
+
+    bool QuadsOverlap(const SDL_FRect& a, const SDL_FRect& b)
+    {
+        return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+    }
+
+    // Reorders each run of equal keys in order[] so sprites sharing a texture sit
+    // together, moving a sprite ahead of others only when it overlaps none of them.
+    // Any pair whose relative order changes is disjoint, so the picture is the
+    // same as drawing in submission order.
+    void RegroupEqualDepth(LayerState& st)
+    {
+        const std::size_t n = st.order.size();
+        st.orderTmp.resize(n);
+        st.taken.assign(n, 0);
+        std::size_t out = 0;
+        for (std::size_t begin = 0; begin < n;) {
+            std::size_t end = begin + 1;
+            while (end < n && st.keys[end] == st.keys[begin]) ++end;
+
+            for (std::size_t i = begin; i < end; ++i) {
+                if (st.taken[i]) continue;
+                st.orderTmp[out++] = st.order[i];
+                const Renderer::ImageHandle image = st.sprites[st.order[i]].image;
+                st.skipped.clear();
+                for (std::size_t j = i + 1; j < end && st.skipped.size() < kRegroupWindow; ++j) {
+                    if (st.taken[j]) continue;
+                    const uint32_t sj = st.order[j];
+                    bool free = st.sprites[sj].image == image;
+                    for (std::size_t k = 0; free && k < st.skipped.size(); ++k) {
+                        free = !QuadsOverlap(st.quads[sj], st.quads[st.skipped[k]]);
+                    }
+                    if (free) {
+                        st.orderTmp[out++] = sj;
+                        st.taken[j] = 1;
+                    }
+                    else {
+                        st.skipped.push_back(sj);
+                    }
+                }
+            }
+            begin = end;
+        }
+        st.order.swap(st.orderTmp);
+    }
+}
+
+void SpriteLayer::clearSprites()
+{
+    s_layer.sprites.clear();
+}
+
+void SpriteLayer::addSprite(const Sprite& sprite)
+{
+    s_layer.sprites.push_back(sprite);
+}
+
+std::size_t SpriteLayer::getSpriteCount()
+{
+    return s_layer.sprites.size();
+}
+
+void SpriteLayer::setSpriteDepthQuantum(float quantum)
+{
+    s_layer.quantum = std::max(quantum, 1e-4f);
+}
+
+void SpriteLayer::buildSpriteRuns(TextureSizeFn textureSize)
+{
+    LayerState& st = s_layer;
+    st.runs.clear();
+    st.vertices.clear();
+    const std::size_t n = st.sprites.size();
+    st.order.resize(n);
+    st.keys.resize(n);
+    if (n == 0) return;
+
+    float dMin = st.sprites[0].depth, dMax = dMin;
+    for (const Sprite& s : st.sprites) {
+        dMin = std::min(dMin, s.depth);
+        dMax = std::max(dMax, s.depth);
+    }
+    const float step = std::max(st.quantum, (dMax - dMin) / (float)kDepthLevels);
+    const float inv = 1.0f / step;
+
+    st.quads.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Sprite& s = st.sprites[i];
+        const uint32_t q = std::min(kDepthLevels, (uint32_t)((s.depth - dMin) * inv));
+        st.keys[i] = q;
+        st.order[i] = (uint32_t)i;
+        const float w = s.size.x != 0.0f ? s.size.x : s.src.w;
+        const float h = s.size.y != 0.0f ? s.size.y : s.src.h;
+        st.quads[i] = { s.position.x - w * 0.5f, s.position.y - h * 0.5f, w, h };
+    }
+    RadixSort(st);
+    RegroupEqualDepth(st);
+
+    st.vertices.resize(n * 4);
+    SDL_Vertex* v = st.vertices.data();
+    Vector2 invTex{ 1.0f, 1.0f };
+    for (std::size_t k = 0; k < n; ++k, v += 4) {
+        const Sprite& s = st.sprites[st.order[k]];
+        if (st.runs.empty() || st.runs.back().image != s.image) {
+            st.runs.push_back({ s.image, (uint32_t)k, 0 });
+            invTex = { 1.0f, 1.0f };
+            if (textureSize) {
+                const Vector2 ts = textureSize(s.image);
+                if (ts.x > 0.0f && ts.y > 0.0f) invTex = { 1.0f / ts.x, 1.0f / ts.y };
+            }
+        }
+        ++st.runs.back().count;
+
+        const SDL_FRect& q = st.quads[st.order[k]];
+        const float w = q.w, h = q.h;
+        const float x0 = q.x, y0 = q.y;
+        const float u0 = s.src.x * invTex.x, v0 = s.src.y * invTex.y;
+        const float u1 = (s.src.x + s.src.w) * invTex.x, v1 = (s.src.y + s.src.h) * invTex.y;
+        const SDL_FColor c = { s.tint.r / 255.0f, s.tint.g / 255.0f, s.tint.b / 255.0f, s.tint.a / 255.0f };
+        v[0] = { { x0, y0 }, c, { u0, v0 } };
+        v[1] = { { x0 + w, y0 }, c, { u1, v0 } };
+        v[2] = { { x0 + w, y0 + h }, c, { u1, v1 } };
+        v[3] = { { x0, y0 + h }, c, { u0, v1 } };
+    }
+}
+
+const Vector<SpriteLayer::SpriteRun>& SpriteLayer::getSpriteRuns()
+{
+    return s_layer.runs;
+}
+
+const Vector<SDL_Vertex>& SpriteLayer::getSpriteVertices()
+{
+    return s_layer.vertices;
+}
+
+const Vector<uint32_t>& SpriteLayer::getSpriteDrawOrder()
+{
+    return s_layer.order;
+}
+
+void SpriteLayer::shutdownSprites()
+{
+    s_layer = LayerState{};
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// World sprite layer: characters, NPCs, props and effects drawn over the map.
+// Sprites are collected every frame, ordered back to front by depth (usually
+// the sprite's foot Y) and drawn painter's-style.
+//
+// Depth is quantised to 16 bits over the frame's depth range (never finer than
+// setSpriteDepthQuantum) and a stable LSD radix sort orders by it, so sprites at
+// equal quantised depth keep submission order. Within such a slice a sprite is
+// then pulled forward to join an earlier sprite's texture only when its quad
+// overlaps none of the sprites it jumps over, so regrouping never changes what
+// ends up on top. Consecutive sprites on one texture become a run that is drawn
+// with a single SDL_RenderGeometry call.
+namespace SpriteLayer {
+
+    struct Sprite {
+        Renderer::ImageHandle image;
+        SDL_FRect src = { 0.0f, 0.0f, 0.0f, 0.0f };     // source rect in image pixels
+        Vector2 position;                               // destination centre, screen px
+        Vector2 size;                                   // destination size, zero = src size
+        Renderer::Color tint = { 255, 255, 255, 255 };
+        float depth = 0.0f;                             // larger = nearer (drawn later)
+    };
+
+    // Start a new frame's collection (storage is kept)
+    void clearSprites();
+    void addSprite(const Sprite& sprite);
+    std::size_t getSpriteCount();
+
+    // Depths closer than this may share a key (default 1 px). Larger quanta
+    // give longer texture runs where sprites don't overlap.
+    void setSpriteDepthQuantum(float quantum);
+
+    struct SpriteRun {
+        Renderer::ImageHandle image;
+        uint32_t first = 0;     // first sprite in draw order (4 vertices each)
+        uint32_t count = 0;
+    };
+
+    // Texture size in pixels for UVs; null = UVs stay in pixels
+    using TextureSizeFn = Vector2 (*)(Renderer::ImageHandle image);
+
+    // Sort the collected sprites and build their quads and runs
+    void buildSpriteRuns(TextureSizeFn textureSize);
+    const Vector<SpriteRun>& getSpriteRuns();
+    const Vector<SDL_Vertex>& getSpriteVertices();
+    // Submission indices in draw order
+    const Vector<uint32_t>& getSpriteDrawOrder();
+
+    // Build and draw everything collected this frame (implemented with the renderer)
+    void renderSprites();
+    void shutdownSprites();
+}
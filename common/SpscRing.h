@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+
+// Bounded lock-free single-producer/single-consumer ring buffer.
+// push() may only be called from one thread at a time and pop() from one (other)
+// thread at a time; neither ever blocks or allocates. Capacity must be a power of
+// two; one push can be in flight per slot, so all Capacity slots are usable.
+template<typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    // Producer side. Returns false (and drops nothing) when the ring is full.
+    bool push(const T& item)
+    {
+        const std::size_t head = _head.load(std::memory_order_relaxed);
+        const std::size_t tail = _tail.load(std::memory_order_acquire);
+        if (head - tail == Capacity) return false;
+        _items[head & kMask] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when the ring is empty.
+    bool pop(T& out)
+    {
+        const std::size_t tail = _tail.load(std::memory_order_relaxed);
+        const std::size_t head = _head.load(std::memory_order_acquire);
+        if (tail == head) return false;
+        out = _items[tail & kMask];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called concurrently with push/pop
+    std::size_t size() const
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    // Indices grow monotonically and wrap through size_t; head/tail on separate
+    // cache lines so producer and consumer don't false-share.
+    alignas(64) std::atomic<std::size_t> _head{ 0 };
+    alignas(64) std::atomic<std::size_t> _tail{ 0 };
+    alignas(64) T _items[Capacity]{};
+};
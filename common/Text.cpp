@@ -4,7 +4,9 @@
 
 namespace {
     bool g_ttfInited = false;
-    Vector<Ref<Text::Font>> g_fonts;
+    HandlePool<Text::Font> g_fonts;
+    HandlePool<Text::Run> g_runs;
+    TTF_TextEngine* g_textEngine = nullptr; // created on first run, bound to the active renderer
 }
 
 bool Text::init()
@@ -20,13 +22,20 @@ bool Text::init()
 
 void Text::shutdown()
 {
-    // Unload any remaining fonts
-    for (auto& f : g_fonts) {
-        if (f && f->handle) {
-            TTF_CloseFont(f->handle);
-            f->handle = nullptr;
-        }
+    // Runs reference both their font and the text engine; release them first
+    g_runs.forEach([](Text::Run& r) {
+        if (r.handle) TTF_DestroyText(r.handle);
+    });
+    g_runs.clear();
+    if (g_textEngine) {
+        TTF_DestroyRendererTextEngine(g_textEngine);
+        g_textEngine = nullptr;
     }
+
+    // Unload any remaining fonts; outstanding handles become stale
+    g_fonts.forEach([](Text::Font& f) {
+        if (f.handle) TTF_CloseFont(f.handle);
+    });
     g_fonts.clear();
 
     if (g_ttfInited) {
@@ -35,44 +44,78 @@ void Text::shutdown()
     }
 }
 
-Text::Font* Text::loadFont(const std::string& path, int ptSize)
+Text::FontHandle Text::loadFont(const std::string& path, int ptSize)
 {
     if (!g_ttfInited) {
         // Attempt to init on demand if not already
-        if (!Text::init()) return nullptr;
+        if (!Text::init()) return {};
     }
 
     TTF_Font* f = TTF_OpenFont(path.c_str(), static_cast<float>(ptSize));
     if (!f) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TTF_OpenFont failed for '%s': %s", path.c_str(), SDL_GetError());
-        return nullptr;
+        return {};
     }
-    auto fontRef = CreateRef<Text::Font>();
-    fontRef->handle = f;
-    fontRef->size = ptSize;
-    g_fonts.push_back(fontRef);
-    return fontRef.get();
+    return g_fonts.create(Text::Font{ f, ptSize, nullptr });
 }
 
-void Text::unloadFont(Text::Font* font)
+Text::FontBytes Text::loadFontBytes(const std::string& path)
 {
-    if (!font) return;
-    // Find and release from our list; caller's pointer becomes invalid after this
-    for (auto it = g_fonts.begin(); it != g_fonts.end(); ++it) {
-        if (it->get() == font) {
-            if ((*it)->handle) {
-                TTF_CloseFont((*it)->handle);
-                (*it)->handle = nullptr;
-            }
-            g_fonts.erase(it);
-            break;
-        }
+    size_t size = 0;
+    void* data = SDL_LoadFile(path.c_str(), &size);
+    if (!data) return nullptr;
+    const uint8_t* begin = static_cast<const uint8_t*>(data);
+    auto bytes = CreateRef<Vector<uint8_t>>(begin, begin + size);
+    SDL_free(data);
+    return bytes;
+}
+
+TTF_Font* Text::openFontFromMemory(const Text::FontBytes& bytes, int ptSize)
+{
+    if (!bytes || bytes->empty()) return nullptr;
+    SDL_IOStream* io = SDL_IOFromConstMem(bytes->data(), bytes->size());
+    if (!io) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_IOFromConstMem failed: %s", SDL_GetError());
+        return nullptr;
+    }
+    // closeio=true: the stream (not the bytes) is released with the font
+    TTF_Font* f = TTF_OpenFontIO(io, true, static_cast<float>(ptSize));
+    if (!f) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TTF_OpenFontIO failed for size %d: %s", ptSize, SDL_GetError());
     }
+    return f;
+}
+
+Text::FontHandle Text::adoptFont(TTF_Font* font, int ptSize, Text::FontBytes bytes)
+{
+    if (!font) return {};
+    return g_fonts.create(Text::Font{ font, ptSize, std::move(bytes) });
+}
+
+Text::FontHandle Text::loadFontFromMemory(const Text::FontBytes& bytes, int ptSize)
+{
+    if (!g_ttfInited && !Text::init()) return {};
+    return adoptFont(openFontFromMemory(bytes, ptSize), ptSize, bytes);
+}
+
+void Text::unloadFont(Text::FontHandle font)
+{
+    // Stale or null handles are ignored; the caller's handle becomes stale after this
+    Text::Font* f = g_fonts.get(font);
+    if (!f) return;
+    if (f->handle) TTF_CloseFont(f->handle);
+    g_fonts.release(font);
+}
+
+const Text::Font* Text::getFont(Text::FontHandle font)
+{
+    return g_fonts.get(font);
 }
 
-SDL_FRect Text::measure(Text::Font* font, const std::string& text)
+SDL_FRect Text::measure(Text::FontHandle fontHandle, const std::string& text)
 {
     SDL_FRect r{0,0,0,0};
+    const Text::Font* font = g_fonts.get(fontHandle);
     if (!font || !font->handle) return r;
     int w = 0, h = 0;
     if (TTF_GetStringSize(font->handle, text.c_str(), text.size(), &w, &h)) {
@@ -82,8 +125,9 @@ SDL_FRect Text::measure(Text::Font* font, const std::string& text)
     return r;
 }
 
-void Text::draw(Text::Font* font, const std::string& text, float x, float y, SDL_Color color)
+void Text::draw(Text::FontHandle fontHandle, const std::string& text, float x, float y, SDL_Color color)
 {
+    const Text::Font* font = g_fonts.get(fontHandle);
     if (!font || !font->handle || text.empty()) return;
     SDL_Surface* surface = TTF_RenderText_Blended(font->handle, text.c_str(), text.size(), color);
     if (!surface) {
@@ -107,3 +151,60 @@ void Text::draw(Text::Font* font, const std::string& text, float x, float y, SDL
     SDL_DestroyTexture(texture);
     SDL_DestroySurface(surface);
 }
+
+Text::RunHandle Text::createRun(Text::FontHandle fontHandle, const std::string& text)
+{
+    const Text::Font* font = g_fonts.get(fontHandle);
+    if (!font || !font->handle || text.empty()) return {};
+    if (!g_textEngine) {
+        SDL_Renderer* renderer = Renderer::getRenderer();
+        if (!renderer) return {};
+        g_textEngine = TTF_CreateRendererTextEngine(renderer);
+        if (!g_textEngine) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TTF_CreateRendererTextEngine failed: %s", SDL_GetError());
+            return {};
+        }
+    }
+
+    TTF_Text* t = TTF_CreateText(g_textEngine, font->handle, text.c_str(), text.size());
+    if (!t) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "TTF_CreateText failed: %s", SDL_GetError());
+        return {};
+    }
+    return g_runs.create(Text::Run{ t });
+}
+
+void Text::destroyRun(Text::RunHandle runHandle)
+{
+    // Stale or null handles are ignored; the caller's handle becomes stale after this
+    Text::Run* run = g_runs.get(runHandle);
+    if (!run) return;
+    if (run->handle) TTF_DestroyText(run->handle);
+    g_runs.release(runHandle);
+}
+
+void Text::drawRun(Text::RunHandle runHandle, float x, float y, SDL_Color color, float maxWidth)
+{
+    const Text::Run* run = g_runs.get(runHandle);
+    if (!run || !run->handle) return;
+    TTF_SetTextColor(run->handle, color.r, color.g, color.b, color.a);
+    if (maxWidth < 0.0f) {
+        TTF_DrawRendererText(run->handle, x, y);
+        return;
+    }
+    if (maxWidth == 0.0f) return;
+
+    // Clip to the requested prefix, restoring any clip the caller had set
+    SDL_Renderer* renderer = Renderer::getRenderer();
+    const bool hadClip = SDL_RenderClipEnabled(renderer);
+    SDL_Rect prevClip{};
+    if (hadClip) SDL_GetRenderClipRect(renderer, &prevClip);
+
+    int w = 0, h = 0;
+    TTF_GetTextSize(run->handle, &w, &h);
+    SDL_Rect clip{ (int)std::floor(x), (int)std::floor(y), (int)std::ceil(maxWidth), h };
+    if (hadClip && !SDL_GetRectIntersection(&clip, &prevClip, &clip)) return; // fully clipped
+    SDL_SetRenderClipRect(renderer, &clip);
+    TTF_DrawRendererText(run->handle, x, y);
+    SDL_SetRenderClipRect(renderer, hadClip ? &prevClip : nullptr);
+}
@@ -4,6 +4,7 @@
 
 // Forward declaration to avoid forcing all includers to have SDL_ttf headers
 struct TTF_Font;
+struct TTF_Text;
 
 namespace Text {
 
@@ -11,21 +12,56 @@ namespace Text {
     bool init();
     void shutdown();
 
+    // Whole font file held in memory so several point sizes can share one read
+    using FontBytes = Ref<const Vector<uint8_t>>;
+
     struct Font {
         TTF_Font* handle = nullptr;
         int size = 0;
+        FontBytes source; // kept alive while the font streams from it (null for file fonts)
     };
+    using FontHandle = Handle<Font>;
 
     // Load a font at a given point size. Caller owns and must unload via unloadFont.
-    // Returns nullptr on failure.
-    Font* loadFont(const std::string& path, int ptSize);
-    void unloadFont(Font* font);
+    // Returns a null handle on failure. Handles go stale after unloadFont/shutdown.
+    FontHandle loadFont(const std::string& path, int ptSize);
+    void unloadFont(FontHandle font);
+    // Resolve a handle; nullptr when the handle is null or stale.
+    const Font* getFont(FontHandle font);
+
+    // Read a font file into a shared buffer. Returns null on failure. Safe on any thread.
+    FontBytes loadFontBytes(const std::string& path);
+    // Open one size from shared bytes through an SDL IO stream. Safe on any thread;
+    // the result must be handed to adoptFont on the main thread.
+    TTF_Font* openFontFromMemory(const FontBytes& bytes, int ptSize);
+    // Take ownership of a font opened with openFontFromMemory. Main thread only.
+    FontHandle adoptFont(TTF_Font* font, int ptSize, FontBytes bytes);
+    // openFontFromMemory + adoptFont in one step.
+    FontHandle loadFontFromMemory(const FontBytes& bytes, int ptSize);
 
     // Measure text using the given font; returns width/height in pixels.
-    SDL_FRect measure(Font* font, const std::string& text);
+    SDL_FRect measure(FontHandle font, const std::string& text);
 
     // Draw UTF-8 text at top-left pixel position (x,y) with RGBA color.
     // This creates a transient texture per draw. For HUD text this is fine;
     // consider caching if drawing the same strings frequently.
-    void draw(Font* font, const std::string& text, float x, float y, SDL_Color color);
+    void draw(FontHandle font, const std::string& text, float x, float y, SDL_Color color);
+
+    // Pre-shaped text run drawn through SDL_ttf's renderer text engine. Glyphs are
+    // rasterized once into the engine's atlas, so redrawing a run costs no shaping
+    // and no texture creation. Use for strings that persist across frames.
+    struct Run {
+        TTF_Text* handle = nullptr;
+    };
+    using RunHandle = Handle<Run>;
+
+    // Shape a run for the given font. Caller owns and must release via destroyRun.
+    // Returns a null handle on failure.
+    RunHandle createRun(FontHandle font, const std::string& text);
+    void destroyRun(RunHandle run);
+
+    // Draw a run at top-left pixel position (x,y). When maxWidth >= 0, only the
+    // first maxWidth pixels are drawn (clipped), which lets callers reveal a
+    // prefix of the run without reshaping it.
+    void drawRun(RunHandle run, float x, float y, SDL_Color color, float maxWidth = -1.0f);
 }
@@ -11,7 +11,15 @@ int hashFileName(const char* filename) {
 	return static_cast<int>(hash);
 }
 
-static UMap<int, Ref<Renderer::Image>> g_imageBank;
+static UMap<int, Renderer::ImageHandle> g_imageBank;
+static Palette::ColorPalette g_bankPalette;
+static bool g_bankIndexed = false;
+
+void TileMap::setTileBankPalette(const Palette::ColorPalette* palette)
+{
+	g_bankIndexed = palette && !palette->colors.empty();
+	g_bankPalette = g_bankIndexed ? *palette : Palette::ColorPalette{};
+}
 
 bool TileMap::loadFromModelArray(const TileMap::TileModel* models, int count, VectorRef<TileMap::Tile>& tiles)
 {
@@ -43,8 +51,11 @@ bool TileMap::loadImageForTileBank(const char* filename, int& outImageIndex)
 		outImageIndex = hash;
 		return true; // Already loaded
 	}
-	Ref<Renderer::Image> newImage;
-	if (!loadImageFromFile(filename, newImage)) {
+	Renderer::ImageHandle newImage;
+	const bool loaded = g_bankIndexed
+		? Palette::loadIndexedImageFromFile(filename, g_bankPalette, newImage)
+		: loadImageFromFile(filename, newImage);
+	if (!loaded) {
 		return false;
 	}
 	g_imageBank[hash] = newImage;
@@ -79,6 +90,7 @@ void TileMap::releaseImageFromBank(int imageIndex)
 {
 	auto it = g_imageBank.find(imageIndex);
 	if (it != g_imageBank.end()) {
+		Renderer::releaseImage(it->second);
 		g_imageBank.erase(it);
 	}
 
@@ -91,7 +103,7 @@ void TileMap::renderTile(TileTransform& transform, const Ref<Tile>& tile)
 	if (it == g_imageBank.end()) {
 		return; // Image not found
 	}
-	auto& store = it->second;
+	Renderer::ImageHandle store = it->second;
 	if (!store) return;
 	if (tile->tileRects.empty()) return;
 	drawImageFromRect(transform.position, transform.scale, transform.rotation, store, tile->tileRects[tile->activeFrame], tile->tint[tile->activeFrame]);
@@ -105,6 +117,85 @@ void TileMap::renderTiles(Vector<TileTransform>& positions, VectorRef<Tile>& til
 	}
 }
 
+void TileMap::renderTiles(const Vector2Stream& positions, const Vector<int>& tileIndices, VectorRef<Tile>& tiles)
+{
+	TileTransform transform;
+	for (std::size_t i = 0; i < tileIndices.size(); ++i) {
+		transform.position = positions[i];
+		transform.tileIndex = tileIndices[i];
+		renderTile(transform, tiles[transform.tileIndex]);
+	}
+}
+
+namespace {
+	struct TileBatch {
+		int imageIndex = 0;
+		Vector<SDL_Vertex> vertices;
+	};
+	Vector<TileBatch> s_tileBatches;
+
+	TileBatch& BatchFor(int imageIndex)
+	{
+		for (TileBatch& b : s_tileBatches) {
+			if (b.imageIndex == imageIndex) return b;
+		}
+		s_tileBatches.push_back({ imageIndex, {} });
+		return s_tileBatches.back();
+	}
+}
+
+void TileMap::renderTilesLit(const Vector<TileTransform>& positions, VectorRef<Tile>& tiles, const Vector<SDL_FColor>& cornerLight)
+{
+	SDL_Renderer* renderer = Renderer::getRenderer();
+	if (!renderer || cornerLight.size() < positions.size() * 4) return;
+	for (TileBatch& b : s_tileBatches) b.vertices.clear();
+
+	// Tiles never overlap, so they can be regrouped by image freely
+	for (std::size_t i = 0; i < positions.size(); ++i) {
+		const TileTransform& t = positions[i];
+		const Ref<Tile>& tile = tiles[t.tileIndex];
+		if (tile->tileRects.empty()) continue;
+		auto it = g_imageBank.find(tile->imageIndex);
+		if (it == g_imageBank.end()) continue;
+		const Renderer::Image* img = Renderer::getImage(it->second);
+		if (!img || !img->texture || img->imageSize.w <= 0.0f || img->imageSize.h <= 0.0f) continue;
+
+		const SDL_FRect& r = tile->tileRects[tile->activeFrame];
+		const Renderer::Color tint = tile->tint.empty() ? Renderer::Color{ 255, 255, 255, 255 } : tile->tint[tile->activeFrame];
+		const float u0 = r.x / img->imageSize.w, v0 = r.y / img->imageSize.h;
+		const float u1 = (r.x + r.w) / img->imageSize.w, v1 = (r.y + r.h) / img->imageSize.h;
+		const float hw = r.w * t.scale.x * 0.5f, hh = r.h * t.scale.y * 0.5f;
+		Vector2 corner[4] = { { -hw, -hh }, { hw, -hh }, { hw, hh }, { -hw, hh } };
+		if (t.rotation != 0.0f) {
+			const float a = t.rotation * 0.01745329251994329577f;
+			const float c = std::cos(a), s = std::sin(a);
+			for (Vector2& p : corner) p = { p.x * c - p.y * s, p.x * s + p.y * c };
+		}
+		const SDL_FPoint uv[4] = { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } };
+
+		Vector<SDL_Vertex>& out = BatchFor(tile->imageIndex).vertices;
+		const SDL_FColor* light = cornerLight.data() + i * 4;
+		for (int k = 0; k < 4; ++k) {
+			const SDL_FColor color = { light[k].r * tint.r / 255.0f, light[k].g * tint.g / 255.0f,
+				light[k].b * tint.b / 255.0f, light[k].a * tint.a / 255.0f };
+			out.push_back({ { t.position.x + corner[k].x, t.position.y + corner[k].y }, color, uv[k] });
+		}
+	}
+
+	for (const TileBatch& b : s_tileBatches) {
+		if (b.vertices.empty()) continue;
+		auto it = g_imageBank.find(b.imageIndex);
+		const Renderer::Image* img = it != g_imageBank.end() ? Renderer::getImage(it->second) : nullptr;
+		if (!img) continue;
+		// The unlit path leaves the last tile's colour mod on the texture
+		SDL_SetTextureColorMod(img->texture, 255, 255, 255);
+		SDL_SetTextureAlphaMod(img->texture, 255);
+		const std::size_t quads = b.vertices.size() / 4;
+		SDL_RenderGeometry(renderer, img->texture, b.vertices.data(), (int)b.vertices.size(),
+			Renderer::getQuadIndices(quads), (int)(quads * 6));
+	}
+}
+
 void TileMap::updateTileSets(float deltaTime, Vector<TileTransform>& positions, VectorRef<Tile>& tiles)
 {
 	for (auto& transform : positions) {
@@ -118,3 +209,15 @@ void TileMap::updateTileSets(float deltaTime, Vector<TileTransform>& positions,
 	}
 }
 
+void TileMap::updateTileSets(float deltaTime, const Vector<int>& tileIndices, VectorRef<Tile>& tiles)
+{
+	for (int tileIndex : tileIndices) {
+		auto& tile = tiles[tileIndex];
+
+		tile->frameTime += deltaTime;
+		if (tile->frameTime >= tile->frameDuration) {
+			tile->frameTime = 0.0f;
+			tile->activeFrame = (tile->activeFrame + 1) % tile->tileRects.size();
+		}
+	}
+}
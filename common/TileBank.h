@@ -55,11 +55,22 @@ namespace TileMap {
 	 };
     
      bool loadFromModelArray(const TileMap::TileModel* models, int count, VectorRef<TileMap::Tile>& tiles);
+	 // Images loaded after this are quantised to the palette and kept indexed
+	 // (slot 0) so palette swaps can recolour them; null = plain RGBA
+	 void setTileBankPalette(const Palette::ColorPalette* palette);
 	 bool loadImageForTileBank(const char* filename, int& outImageIndex);
 	 bool createTileFromBank(int imageIndex, TileModel&, Ref<Tile>& outTile);
 	 void releaseImageFromBank(int imageIndex);
 	 void renderTile(TileTransform& transform, const Ref<Tile>& tiles);
      void renderTiles(Vector<TileTransform>& positions, VectorRef<Tile>& tiles);
 	 void updateTileSets(float deltaTime, Vector<TileTransform>& positions,VectorRef<Tile>& );
+     // Visible sets kept as SoA positions + tile indices (TileMap); unit scale, no rotation
+     void renderTiles(const Vector2Stream& positions, const Vector<int>& tileIndices, VectorRef<Tile>& tiles);
+     void updateTileSets(float deltaTime, const Vector<int>& tileIndices, VectorRef<Tile>& tiles);
+     // Batched path: one SDL_RenderGeometry per tile image instead of a colour-mod
+     // blit per tile. cornerLight holds 4 colours per transform (TL, TR, BR, BL),
+     // multiplied with the tile tint. The quad is scaled by transform.scale, then
+     // rotated about the tile centre.
+     void renderTilesLit(const Vector<TileTransform>& positions, VectorRef<Tile>& tiles, const Vector<SDL_FColor>& cornerLight);
 
 }
\ No newline at end of file
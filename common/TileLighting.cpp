@@ -0,0 +1,439 @@
+#include "Common.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define AQ_LIGHT_SSE2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define AQ_LIGHT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+    using namespace TileLighting;
+
+    constexpr int kChunkTiles = 16;
+
+    struct Light {
+        LightDesc desc;
+        TileVector tile;
+        int reach = 0;              // whole tiles the flood can step
+        Vector<float> falloff;      // (2 * reach + 1)^2 around the tile, 0 = unlit
+        bool stale = true;          // falloff needs a new flood
+    };
+
+    struct LightingState {
+        int width = 0, height = 0;
+        int chunksX = 0, chunksY = 0;
+        Vector<uint8_t> blocking;
+        Vector<float> lightR, lightG, lightB;   // sum of lights, no ambient
+        Vector<uint8_t> chunkDirty;
+        std::size_t dirtyChunks = 0;
+        HandlePool<Light, LightTag> lights;
+        float hours = 12.0f;
+
+        // Scratch
+        Vector<int> queue;
+        Vector<uint16_t> steps;
+        Vector<float> gather, cells[3], corners[3];
+    };
+    LightingState s_light;
+
+    // Ambient key frames over the day (hour, r, g, b), linearly interpolated
+    struct AmbientKey { float hour, r, g, b; };
+    constexpr AmbientKey kAmbientKeys[] = {
+        { 0.0f,  0.10f, 0.12f, 0.25f },
+        { 5.0f,  0.10f, 0.12f, 0.25f },
+        { 6.5f,  0.75f, 0.55f, 0.50f },
+        { 8.0f,  1.00f, 1.00f, 1.00f },
+        { 17.0f, 1.00f, 1.00f, 1.00f },
+        { 19.0f, 0.85f, 0.55f, 0.45f },
+        { 20.5f, 0.10f, 0.12f, 0.25f },
+        { 24.0f, 0.10f, 0.12f, 0.25f },
+    };
+
+    void MarkDirty(int x0, int y0, int x1, int y1)
+    {
+        LightingState& st = s_light;
+        x0 = std::max(x0, 0);
+        y0 = std::max(y0, 0);
+        x1 = std::min(x1, st.width - 1);
+        y1 = std::min(y1, st.height - 1);
+        if (x0 > x1 || y0 > y1) return;
+        for (int cy = y0 / kChunkTiles; cy <= y1 / kChunkTiles; ++cy) {
+            for (int cx = x0 / kChunkTiles; cx <= x1 / kChunkTiles; ++cx) {
+                uint8_t& d = st.chunkDirty[(std::size_t)cy * st.chunksX + cx];
+                if (!d) {
+                    d = 1;
+                    ++st.dirtyChunks;
+                }
+            }
+        }
+    }
+
+    void MarkAllDirty()
+    {
+        MarkDirty(0, 0, s_light.width - 1, s_light.height - 1);
+    }
+
+    void MarkLightDirty(const Light& l)
+    {
+        MarkDirty(l.tile.x - l.reach, l.tile.y - l.reach, l.tile.x + l.reach, l.tile.y + l.reach);
+    }
+
+    bool InMap(int x, int y)
+    {
+        return x >= 0 && y >= 0 && x < s_light.width && y < s_light.height;
+    }
+
+    bool Covers(const Light& l, int x, int y)
+    {
+        return std::abs(x - l.tile.x) <= l.reach && std::abs(y - l.tile.y) <= l.reach;
+    }
+
+    // Breadth-first flood from the light's tile: strength 1 - steps / (radius + 1)
+    void Flood(Light& l)
+    {
+        LightingState& st = s_light;
+        const int r = l.reach, side = 2 * r + 1;
+        l.falloff.assign((std::size_t)side * side, 0.0f);
+        l.stale = false;
+        if (!InMap(l.tile.x, l.tile.y)) return;
+
+        st.steps.assign((std::size_t)side * side, 0);
+        st.queue.clear();
+        const int source = r * side + r;
+        l.falloff[source] = 1.0f;
+        st.queue.push_back(source);
+        const float perStep = 1.0f / (l.desc.radius + 1.0f);
+        static constexpr int kDx[4] = { 1, -1, 0, 0 };
+        static constexpr int kDy[4] = { 0, 0, 1, -1 };
+
+        for (std::size_t head = 0; head < st.queue.size(); ++head) {
+            const int at = st.queue[head];
+            const int lx = at % side, ly = at / side;
+            const int s = st.steps[at];
+            if (s >= r) continue;
+            // Occluders are lit but do not pass light on (the source always does)
+            if (at != source && st.blocking[(std::size_t)(l.tile.y + ly - r) * st.width + (l.tile.x + lx - r)]) continue;
+            for (int k = 0; k < 4; ++k) {
+                const int nx = lx + kDx[k], ny = ly + kDy[k];
+                if (nx < 0 || ny < 0 || nx >= side || ny >= side) continue;
+                if (!InMap(l.tile.x + nx - r, l.tile.y + ny - r)) continue;
+                const int next = ny * side + nx;
+                if (l.falloff[next] > 0.0f) continue;
+                st.steps[next] = (uint16_t)(s + 1);
+                l.falloff[next] = 1.0f - (float)(s + 1) * perStep;
+                st.queue.push_back(next);
+            }
+        }
+    }
+
+    void RebuildChunk(int cx, int cy)
+    {
+        LightingState& st = s_light;
+        const int x0 = cx * kChunkTiles, y0 = cy * kChunkTiles;
+        const int x1 = std::min(x0 + kChunkTiles, st.width) - 1;
+        const int y1 = std::min(y0 + kChunkTiles, st.height) - 1;
+        for (int y = y0; y <= y1; ++y) {
+            const std::size_t row = (std::size_t)y * st.width;
+            std::fill(st.lightR.begin() + row + x0, st.lightR.begin() + row + x1 + 1, 0.0f);
+            std::fill(st.lightG.begin() + row + x0, st.lightG.begin() + row + x1 + 1, 0.0f);
+            std::fill(st.lightB.begin() + row + x0, st.lightB.begin() + row + x1 + 1, 0.0f);
+        }
+
+        st.lights.forEach([&](Light& l) {
+            const int lx0 = std::max(x0, l.tile.x - l.reach), lx1 = std::min(x1, l.tile.x + l.reach);
+            const int ly0 = std::max(y0, l.tile.y - l.reach), ly1 = std::min(y1, l.tile.y + l.reach);
+            if (lx0 > lx1 || ly0 > ly1) return;
+            if (l.stale) Flood(l);
+
+            const float k = l.desc.intensity / 255.0f;
+            const float cr = l.desc.color.r * k, cg = l.desc.color.g * k, cb = l.desc.color.b * k;
+            const int side = 2 * l.reach + 1;
+            for (int y = ly0; y <= ly1; ++y) {
+                const float* f = l.falloff.data() + (std::size_t)(y - l.tile.y + l.reach) * side + (lx0 - l.tile.x + l.reach);
+                const std::size_t row = (std::size_t)y * st.width;
+                for (int x = lx0; x <= lx1; ++x, ++f) {
+                    if (*f <= 0.0f) continue;
+                    st.lightR[row + x] += *f * cr;
+                    st.lightG[row + x] += *f * cg;
+                    st.lightB[row + x] += *f * cb;
+                }
+            }
+        });
+    }
+}
+
+bool TileLighting::initLighting(const TileVector& mapSize)
+{
+    if (mapSize.x <= 0 || mapSize.y <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "initLighting: invalid map size %dx%d", mapSize.x, mapSize.y);
+        return false;
+    }
+    const float hours = s_light.hours;
+    s_light = LightingState{};
+    LightingState& st = s_light;
+    st.hours = hours;
+    st.width = mapSize.x;
+    st.height = mapSize.y;
+    st.chunksX = (st.width + kChunkTiles - 1) / kChunkTiles;
+    st.chunksY = (st.height + kChunkTiles - 1) / kChunkTiles;
+    const std::size_t cells = (std::size_t)st.width * st.height;
+    st.blocking.assign(cells, 0);
+    st.lightR.assign(cells, 0.0f);
+    st.lightG.assign(cells, 0.0f);
+    st.lightB.assign(cells, 0.0f);
+    st.chunkDirty.assign((std::size_t)st.chunksX * st.chunksY, 0);
+    return true;
+}
+
+void TileLighting::shutdownLighting()
+{
+    s_light = LightingState{};
+}
+
+void TileLighting::setOccluder(const TileVector& tile, bool blocking)
+{
+    LightingState& st = s_light;
+    if (!InMap(tile.x, tile.y)) return;
+    uint8_t& b = st.blocking[(std::size_t)tile.y * st.width + tile.x];
+    if (b == (uint8_t)blocking) return;
+    b = (uint8_t)blocking;
+    st.lights.forEach([&](Light& l) {
+        if (!Covers(l, tile.x, tile.y)) return;
+        l.stale = true;
+        MarkLightDirty(l);
+    });
+}
+
+void TileLighting::setOccludersFromMap(const Vector<int>& mapData, const VectorRef<TileMap::Tile>& tiles)
+{
+    LightingState& st = s_light;
+    const std::size_t cells = std::min(st.blocking.size(), mapData.size());
+    for (std::size_t i = 0; i < cells; ++i) {
+        const int t = mapData[i];
+        st.blocking[i] = (t >= 0 && t < (int)tiles.size() && tiles[t] &&
+            tiles[t]->isPropertySet(TileMap::TileProperties::Blocking)) ? 1 : 0;
+    }
+    st.lights.forEach([](Light& l) { l.stale = true; });
+    MarkAllDirty();
+}
+
+TileLighting::LightHandle TileLighting::addLight(const LightDesc& desc, const TileVector& tile)
+{
+    if (s_light.width == 0 || desc.radius < 0.0f) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "addLight: lighting not initialised or negative radius");
+        return {};
+    }
+    Light l;
+    l.desc = desc;
+    l.tile = tile;
+    l.reach = (int)desc.radius;
+    MarkLightDirty(l);
+    return s_light.lights.create(std::move(l));
+}
+
+bool TileLighting::moveLight(LightHandle h, const TileVector& tile)
+{
+    Light* l = s_light.lights.get(h);
+    if (!l) return false;
+    if (l->tile == tile) return true;
+    MarkLightDirty(*l);
+    l->tile = tile;
+    l->stale = true;
+    MarkLightDirty(*l);
+    return true;
+}
+
+bool TileLighting::setLightDesc(LightHandle h, const LightDesc& desc)
+{
+    Light* l = s_light.lights.get(h);
+    if (!l || desc.radius < 0.0f) return false;
+    MarkLightDirty(*l);
+    l->desc = desc;
+    l->reach = (int)desc.radius;
+    l->stale = true;
+    MarkLightDirty(*l);
+    return true;
+}
+
+bool TileLighting::removeLight(LightHandle h)
+{
+    const Light* l = s_light.lights.get(h);
+    if (!l) return false;
+    MarkLightDirty(*l);
+    return s_light.lights.release(h);
+}
+
+std::size_t TileLighting::getLightCount()
+{
+    return s_light.lights.size();
+}
+
+void TileLighting::setTimeOfDay(float hours)
+{
+    hours = std::fmod(hours, 24.0f);
+    s_light.hours = hours < 0.0f ? hours + 24.0f : hours;
+}
+
+void TileLighting::advanceTimeOfDay(float hours)
+{
+    setTimeOfDay(s_light.hours + hours);
+}
+
+float TileLighting::getTimeOfDay()
+{
+    return s_light.hours;
+}
+
+SDL_FColor TileLighting::getAmbient()
+{
+    const float h = s_light.hours;
+    std::size_t k = 1;
+    while (k + 1 < std::size(kAmbientKeys) && kAmbientKeys[k].hour <= h) ++k;
+    const AmbientKey& a = kAmbientKeys[k - 1];
+    const AmbientKey& b = kAmbientKeys[k];
+    const float t = std::clamp((h - a.hour) / (b.hour - a.hour), 0.0f, 1.0f);
+    return { a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t, a.b + (b.b - a.b) * t, 1.0f };
+}
+
+void TileLighting::updateLighting(const SDL_Rect& region)
+{
+    LightingState& st = s_light;
+    if (st.dirtyChunks == 0 || region.w <= 0 || region.h <= 0) return;
+    const int x0 = std::max(region.x - 1, 0), y0 = std::max(region.y - 1, 0);
+    const int x1 = std::min(region.x + region.w, st.width - 1);
+    const int y1 = std::min(region.y + region.h, st.height - 1);
+    if (x0 > x1 || y0 > y1) return;
+    for (int cy = y0 / kChunkTiles; cy <= y1 / kChunkTiles; ++cy) {
+        for (int cx = x0 / kChunkTiles; cx <= x1 / kChunkTiles; ++cx) {
+            uint8_t& d = st.chunkDirty[(std::size_t)cy * st.chunksX + cx];
+            if (!d) continue;
+            RebuildChunk(cx, cy);
+            d = 0;
+            --st.dirtyChunks;
+        }
+    }
+}
+
+std::size_t TileLighting::getDirtyChunkCount()
+{
+    return s_light.dirtyChunks;
+}
+
+SDL_FColor TileLighting::getTileLight(const TileVector& tile)
+{
+    const SDL_FColor a = getAmbient();
+    if (!InMap(tile.x, tile.y)) return a;
+    const std::size_t i = (std::size_t)tile.y * s_light.width + tile.x;
+    return { std::min(a.r + s_light.lightR[i], 1.0f), std::min(a.g + s_light.lightG[i], 1.0f),
+        std::min(a.b + s_light.lightB[i], 1.0f), 1.0f };
+}
+
+void TileLighting::buildCornerLight(const SDL_Rect& region, Vector<SDL_FColor>& out)
+{
+    LightingState& st = s_light;
+    out.clear();
+    if (region.w <= 0 || region.h <= 0) return;
+    const std::size_t cols = (std::size_t)region.w + 1, rows = (std::size_t)region.h + 1;
+    out.resize(cols * rows);
+    const SDL_FColor a = getAmbient();
+    if (st.width == 0) {
+        std::fill(out.begin(), out.end(), a);
+        return;
+    }
+
+    // Tiles x - 1 .. x + w by y - 1 .. y + h, clamped to the map edge
+    const std::size_t cellCols = cols + 1, cellRows = rows + 1;
+    const int cx0 = region.x - 1;
+    const bool inside = cx0 >= 0 && cx0 + (int)cellCols <= st.width;
+    const Vector<float>* light[3] = { &st.lightR, &st.lightG, &st.lightB };
+    const float ambient[3] = { a.r, a.g, a.b };
+    st.gather.resize(cellCols);
+    for (int c = 0; c < 3; ++c) {
+        st.cells[c].resize(cellCols * cellRows);
+        st.corners[c].resize(cols * rows);
+        for (std::size_t j = 0; j < cellRows; ++j) {
+            const int y = std::clamp(region.y - 1 + (int)j, 0, st.height - 1);
+            const float* src = light[c]->data() + (std::size_t)y * st.width;
+            if (inside) {
+                src += cx0;
+            }
+            else {
+                for (std::size_t i = 0; i < cellCols; ++i) st.gather[i] = src[std::clamp(cx0 + (int)i, 0, st.width - 1)];
+                src = st.gather.data();
+            }
+            blendLightRow(src, ambient[c], st.cells[c].data() + j * cellCols, cellCols);
+        }
+        for (std::size_t j = 0; j < rows; ++j) {
+            const float* above = st.cells[c].data() + j * cellCols;
+            averageCornerRow(above, above + cellCols, st.corners[c].data() + j * cols, cols);
+        }
+    }
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        out[i] = { st.corners[0][i], st.corners[1][i], st.corners[2][i], 1.0f };
+    }
+}
+
+void TileLighting::blendLightRowScalar(const float* light, float ambient, float* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) out[i] = std::min(ambient + light[i], 1.0f);
+}
+
+void TileLighting::averageCornerRowScalar(const float* a, const float* b, float* out, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i) out[i] = (a[i] + a[i + 1] + b[i] + b[i + 1]) * 0.25f;
+}
+
+#if defined(AQ_LIGHT_SSE2)
+void TileLighting::blendLightRow(const float* light, float ambient, float* out, std::size_t n)
+{
+    const __m128 amb = _mm_set1_ps(ambient), one = _mm_set1_ps(1.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm_storeu_ps(out + i, _mm_min_ps(_mm_add_ps(_mm_loadu_ps(light + i), amb), one));
+    blendLightRowScalar(light + i, ambient, out + i, n - i);
+}
+
+void TileLighting::averageCornerRow(const float* a, const float* b, float* out, std::size_t n)
+{
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 top = _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(a + i + 1));
+        const __m128 bottom = _mm_add_ps(_mm_loadu_ps(b + i), _mm_loadu_ps(b + i + 1));
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_add_ps(top, bottom), quarter));
+    }
+    averageCornerRowScalar(a + i, b + i, out + i, n - i);
+}
+#elif defined(AQ_LIGHT_NEON)
+void TileLighting::blendLightRow(const float* light, float ambient, float* out, std::size_t n)
+{
+    const float32x4_t amb = vdupq_n_f32(ambient), one = vdupq_n_f32(1.0f);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) vst1q_f32(out + i, vminq_f32(vaddq_f32(vld1q_f32(light + i), amb), one));
+    blendLightRowScalar(light + i, ambient, out + i, n - i);
+}
+
+void TileLighting::averageCornerRow(const float* a, const float* b, float* out, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t top = vaddq_f32(vld1q_f32(a + i), vld1q_f32(a + i + 1));
+        const float32x4_t bottom = vaddq_f32(vld1q_f32(b + i), vld1q_f32(b + i + 1));
+        vst1q_f32(out + i, vmulq_n_f32(vaddq_f32(top, bottom), 0.25f));
+    }
+    averageCornerRowScalar(a + i, b + i, out + i, n - i);
+}
+#else
+void TileLighting::blendLightRow(const float* light, float ambient, float* out, std::size_t n)
+{
+    blendLightRowScalar(light, ambient, out, n);
+}
+
+void TileLighting::averageCornerRow(const float* a, const float* b, float* out, std::size_t n)
+{
+    averageCornerRowScalar(a, b, out, n);
+}
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+
+// Per-tile light map for the world (torches, spells, day/night).
+// Each light floods outwards breadth-first, one tile per step, losing a share
+// of its strength per step until its radius runs out; Blocking tiles take light
+// but stop it spreading, so light bends round corners but not through walls.
+// Lights are summed into an RGB map the size of the tile map. Moving, adding
+// or removing a light, or changing an occluder, marks the 16x16-tile chunks it
+// touches dirty, and updateLighting only rebuilds dirty chunks inside the
+// region it is given. Ambient light follows the time of day and is added when
+// colours are read, so the day/night cycle never dirties the map.
+namespace TileLighting {
+
+    struct LightDesc {
+        float radius = 6.0f;                        // reach in tiles
+        Renderer::Color color = { 255, 200, 140, 255 };
+        float intensity = 1.0f;
+    };
+
+    struct LightTag;
+    using LightHandle = Handle<LightTag>;
+
+    // Sizes the light map to the tile map; drops all lights and occluders
+    bool initLighting(const TileVector& mapSize);
+    void shutdownLighting();
+
+    void setOccluder(const TileVector& tile, bool blocking);
+    // Occluders from every tile whose model has TileProperties::Blocking
+    void setOccludersFromMap(const Vector<int>& mapData, const VectorRef<TileMap::Tile>& tiles);
+
+    LightHandle addLight(const LightDesc& desc, const TileVector& tile);
+    bool moveLight(LightHandle h, const TileVector& tile);
+    bool setLightDesc(LightHandle h, const LightDesc& desc);
+    bool removeLight(LightHandle h);
+    std::size_t getLightCount();
+
+    // Hours in [0, 24). Ambient runs night -> dawn -> day -> dusk -> night.
+    void setTimeOfDay(float hours);
+    void advanceTimeOfDay(float hours);
+    float getTimeOfDay();
+    SDL_FColor getAmbient();
+
+    // Rebuilds dirty chunks overlapping region (in tiles, plus a one-tile
+    // border for corner sampling). Chunks outside stay dirty until seen.
+    void updateLighting(const SDL_Rect& region);
+    std::size_t getDirtyChunkCount();
+
+    // Ambient + lights, clamped to 1, for one tile
+    SDL_FColor getTileLight(const TileVector& tile);
+    // Light at the tile corners of region: (w + 1) x (h + 1) colours, row-major.
+    // Corner (x, y) averages the four tiles that share it, which gives smooth
+    // vertex colours for the tile quads.
+    void buildCornerLight(const SDL_Rect& region, Vector<SDL_FColor>& out);
+
+    // Blend kernels (SIMD where available):
+    //   blendLightRow:     out[i] = min(ambient + light[i], 1)
+    //   averageCornerRow:  out[i] = (a[i] + a[i + 1] + b[i] + b[i + 1]) / 4
+    //                      (a and b hold n + 1 values)
+    void blendLightRow(const float* light, float ambient, float* out, std::size_t n);
+    void averageCornerRow(const float* a, const float* b, float* out, std::size_t n);
+    // Scalar references (always available)
+    void blendLightRowScalar(const float* light, float ambient, float* out, std::size_t n);
+    void averageCornerRowScalar(const float* a, const float* b, float* out, std::size_t n);
+}
@@ -24,8 +24,9 @@ namespace TileMap {
         uint16_t depth = 0;
         bool isLeaf = true;
 
-        // Render payload for leaves:
-        Vector<TileMap::TileTransform> visibleTiles;
+        // Render payload for leaves: world px positions (SoA) + tile indices
+        Vector2Stream tilePositions;
+        Vector<int> tileIndices;
     };
 
     struct TileMapData {
@@ -40,7 +41,8 @@ namespace TileMap {
         // NEW: Quadtree storage + four roots (one per quadrant)
         Vector<MapSegmentNode> nodes;               // node arena
         UMap<MapSegmentLocation, int> roots;        // root node index per quadrant
-		Vector<TileMap::TileTransform> visibleTiles; // current frames visible tiles
+		Vector2Stream visiblePositions; // current frame's visible tiles
+		Vector<int> visibleIndices;
         // NEW: split tunables
         SegmentSplitConfig splitConfig;
     };
@@ -119,7 +121,7 @@ namespace TileMap {
     // ---------- emit tiles for a leaf rect ----------
     static void emit_tiles_for_rect(const SDL_FRect& r, const TileVector& tileSz, const TileVector& mapSz,
         const VectorRef<TileMap::Tile>& tiles, const Vector<int>& mapData,
-        Vector<TileMap::TileTransform>& out)
+        Vector2Stream& outPos, Vector<int>& outIdx)
     {
         const int mapW = (int)mapSz.x, mapH = (int)mapSz.y;
         if (mapW <= 0 || mapH <= 0 || (int)mapData.size() < mapW * mapH) return;
@@ -134,12 +136,8 @@ namespace TileMap {
                 const int tIdx = mapData[base + tx];
                 if (tIdx < 0 || tIdx >= (int)tiles.size()) continue;
 
-                TileMap::TileTransform tr;
-                tr.position = { tx * tw, ty * th }; // world px
-                tr.scale = { 1.0f, 1.0f };
-                tr.rotation = 0.0f;
-                tr.tileIndex = tIdx;
-                out.push_back(tr);
+                outPos.push_back({ tx * tw, ty * th }); // world px
+                outIdx.push_back(tIdx);
             }
         }
     }
@@ -158,14 +156,16 @@ namespace TileMap {
         const int mapW = (int)m.mapSize.x, mapH = (int)m.mapSize.y;
 
         if (!intersects(node.rect, m.viewPort)) {
-            node.visibleTiles.clear(); // outside view; keep leaf but empty
+            node.tilePositions.clear(); // outside view; keep leaf but empty
+            node.tileIndices.clear();
             return;
         }
 
         if (!should_split(node.rect, m.viewPort, m.tileSize, mapW, mapH, m.splitConfig, node.depth)) {
             node.isLeaf = true;
-            node.visibleTiles.clear();
-            emit_tiles_for_rect(node.rect, m.tileSize, m.mapSize, m.tiles, m.mapData, node.visibleTiles);
+            node.tilePositions.clear();
+            node.tileIndices.clear();
+            emit_tiles_for_rect(node.rect, m.tileSize, m.mapSize, m.tiles, m.mapData, node.tilePositions, node.tileIndices);
             return;
         }
 
@@ -182,7 +182,8 @@ namespace TileMap {
         }
 
         node.isLeaf = false;
-        node.visibleTiles.clear(); // payload lives in leaves
+        node.tilePositions.clear(); // payload lives in leaves
+        node.tileIndices.clear();
     }
 
     static inline void updateViewportFromPlayer(TileMapData& m, const Vector2& playerPos)
@@ -248,7 +249,7 @@ namespace TileMap {
 
     static void gatherFromNodeRecursive(const TileMapData& m,
         int nodeIdx,
-        Vector<TileTransform>& out)
+        Vector2Stream& outPos, Vector<int>& outIdx)
     {
         if (nodeIdx < 0 || nodeIdx >= (int)m.nodes.size()) return;
         const MapSegmentNode& node = m.nodes[nodeIdx];
@@ -258,8 +259,9 @@ namespace TileMap {
 
         // 2) Leaf: append payload
         if (node.isLeaf) {
-            if (!node.visibleTiles.empty()) {
-                out.insert(out.end(), node.visibleTiles.begin(), node.visibleTiles.end());
+            if (!node.tileIndices.empty()) {
+                outPos.append(node.tilePositions);
+                outIdx.insert(outIdx.end(), node.tileIndices.begin(), node.tileIndices.end());
             }
             return;
         }
@@ -268,7 +270,7 @@ namespace TileMap {
         for (int i = 0; i < 4; ++i) {
             const int ci = node.child[i];
             if (ci == -1) continue;
-            gatherFromNodeRecursive(m, ci, out);
+            gatherFromNodeRecursive(m, ci, outPos, outIdx);
         }
     }
 
@@ -276,34 +278,32 @@ namespace TileMap {
 
 // Collect all segment tiles (world-space) into a flat vector.
     static inline void gatherVisibleTilesWorld(const Ref<TileMapData>& mref,
-        Vector<TileMap::TileTransform>& out)
+        Vector2Stream& outPos, Vector<int>& outIdx)
     {
-        out.clear();
+        outPos.clear();
+        outIdx.clear();
         if (!mref) return;
         const TileMapData& m = *mref;
 
-        out.reserve(4096);
+        outPos.reserve(4096);
+        outIdx.reserve(4096);
 
         auto it = m.roots.find(MapSegmentLocation::TopLeft);
-        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, out);
+        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, outPos, outIdx);
         it = m.roots.find(MapSegmentLocation::TopRight);
-        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, out);
+        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, outPos, outIdx);
         it = m.roots.find(MapSegmentLocation::BottomLeft);
-        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, out);
+        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, outPos, outIdx);
         it = m.roots.find(MapSegmentLocation::BottomRight);
-        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, out);
+        if (it != m.roots.end()) gatherFromNodeRecursive(m, it->second, outPos, outIdx);
     }
 
     // Convert world-space positions to screen-space (relative to current viewport)
-    static inline void toScreenSpace(const Ref<TileMapData>& mref,
-        Vector<TileMap::TileTransform>& list)
+    static inline void toScreenSpace(const Ref<TileMapData>& mref, Vector2Stream& positions)
     {
         if (!mref) return;
         const SDL_FRect& vp = mref->viewPort;
-        for (auto& t : list) {
-            t.position.x -= vp.x;
-            t.position.y -= vp.y;
-        }
+        Vector2Batch::translate(positions, { -vp.x, -vp.y });
     }
 
     // Centers viewport on player; viewport w/h are the constraint; clamps to map.
@@ -427,13 +427,14 @@ bool TileMap::updateMap(float deltaTime, Vector2& viewPosition, int& mapId)
     Ref<TileMapData> tileMap = it->second;
     if (!tileMap) return false;
 
-	tileMap->visibleTiles.clear();
+	tileMap->visiblePositions.clear();
+	tileMap->visibleIndices.clear();
 
 	centerViewportOnPlayer(tileMap, viewPosition);
 	createMapSegments(tileMap);
 
-    gatherVisibleTilesWorld(tileMap, tileMap->visibleTiles);
-	updateTileSets(deltaTime, tileMap->visibleTiles, tileMap->tiles);
+    gatherVisibleTilesWorld(tileMap, tileMap->visiblePositions, tileMap->visibleIndices);
+	updateTileSets(deltaTime, tileMap->visibleIndices, tileMap->tiles);
 
     return true;
 }
@@ -446,10 +447,10 @@ void TileMap::renderMap(int mapId)
     Ref<TileMapData> tileMap = it->second;
     if (!tileMap) return;
 
-    toScreenSpace(tileMap, tileMap->visibleTiles);
+    toScreenSpace(tileMap, tileMap->visiblePositions);
 
     // 3) Draw in one batch using your renderer
-    renderTiles(tileMap->visibleTiles, tileMap->tiles);
+    renderTiles(tileMap->visiblePositions, tileMap->visibleIndices, tileMap->tiles);
 
 }
 
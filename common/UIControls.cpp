@@ -5,8 +5,8 @@ namespace UI {
 
 #ifdef AVATARQUEST_ENABLE_AUDIO
 #include "Sound.h"
-static Sound::Sfx* AQ_GetUiBeep() {
-    static Sound::Sfx* s_beep = nullptr;
+static Sound::SfxHandle AQ_GetUiBeep() {
+    static Sound::SfxHandle s_beep;
     if (!s_beep) {
         s_beep = Sound::loadSfx("assets/wav/menu-beep.wav");
         if (!s_beep) s_beep = Sound::loadSfx("asssets/wav/menu-beep.wav");
@@ -14,7 +14,7 @@ static Sound::Sfx* AQ_GetUiBeep() {
     return s_beep;
 }
 static inline void AQ_PlayBeep(int vol = 96) {
-    if (auto* s = AQ_GetUiBeep()) { Sound::playSfx(s, 0, -1, vol); }
+    if (auto s = AQ_GetUiBeep()) { Sound::playSfx(s, 0, -1, vol); }
 }
 #endif
 
@@ -438,12 +438,13 @@ void UIImage::render() const {
     }
 
     // From here down, we require a regular image
-    if (!_img || !_img->texture) return;
+    const Renderer::Image* img = Renderer::getImage(_img);
+    if (!img || !img->texture) return;
 
     if (_useTiles && _tileW > 0 && _tileH > 0) {
         // Draw a specific tile from the atlas
-        const float atlasW = _img->imageRect.w;
-        const float atlasH = _img->imageRect.h;
+        const float atlasW = img->imageRect.w;
+        const float atlasH = img->imageRect.h;
         if (atlasW <= 0.0f || atlasH <= 0.0f || _w <= 0.0f || _h <= 0.0f) return;
         const int cols = (int)std::max(1.0f, std::floor(atlasW / (float)_tileW));
         const int rows = (int)std::max(1.0f, std::floor(atlasH / (float)_tileH));
@@ -451,8 +452,8 @@ void UIImage::render() const {
         int idx = std::max(0, _tileIndex % (cols * rows));
         int tx = idx % cols;
         int ty = idx / cols;
-        SDL_FRect tileRect{ _img->imageRect.x + tx * (float)_tileW,
-                            _img->imageRect.y + ty * (float)_tileH,
+        SDL_FRect tileRect{ img->imageRect.x + tx * (float)_tileW,
+                            img->imageRect.y + ty * (float)_tileH,
                             (float)_tileW,
                             (float)_tileH };
         float sx = 1.0f, sy = 1.0f;
@@ -471,7 +472,7 @@ void UIImage::render() const {
     }
 
     // Default: draw full image region
-    const SDL_FRect src = _img->imageRect;
+    const SDL_FRect src = img->imageRect;
     if (src.w <= 0.0f || src.h <= 0.0f || _w <= 0.0f || _h <= 0.0f) return;
     float sx = 1.0f, sy = 1.0f;
     switch (_mode) {
@@ -493,13 +494,13 @@ void UIImage::render() const {
 namespace UI {
 
 int UIAnimatedTextBox::totalWords() const {
-    int n = 0;
-    for (const auto& t : _tokens) if (!t.newline) ++n;
-    return n;
+    return _wordCount;
 }
 
 void UIAnimatedTextBox::tokenize() {
+    releaseLayout();
     _tokens.clear();
+    _wordCount = 0;
     String cur;
     for (size_t i = 0; i < _text.size(); ++i) {
         char c = _text[i];
@@ -514,6 +515,65 @@ void UIAnimatedTextBox::tokenize() {
         }
     }
     if (!cur.empty()) { _tokens.push_back(Token{cur, false}); }
+
+    // Measure every word once; wrapping only sums these widths afterwards
+    _spaceW = 0.0f;
+    _lineH = 0.0f;
+    if (_font) {
+        _spaceW = Text::measure(_font, " ").w;
+        _lineH = Text::measure(_font, "Mg").h;
+    }
+    for (auto& t : _tokens) {
+        if (t.newline) continue;
+        ++_wordCount;
+        if (_font) t.width = Text::measure(_font, t.word).w;
+    }
+}
+
+void UIAnimatedTextBox::releaseLayout() const {
+    for (auto& ln : _lines) {
+        if (ln.run) { Text::destroyRun(ln.run); ln.run = {}; }
+    }
+    _lines.clear();
+    _wordLine.clear();
+    _layoutW = -1.0f;
+}
+
+void UIAnimatedTextBox::layout(float availW) const {
+    releaseLayout();
+    _layoutW = availW;
+    _wordLine.reserve(_wordCount);
+
+    // Greedy wrap over precomputed widths, respecting explicit newlines
+    String current;
+    Line line;
+    float penX = 0.0f;
+    int wordIndex = 0;
+    auto flush = [&]() {
+        line.run = current.empty() ? Text::RunHandle{} : Text::createRun(_font, current);
+        _lines.push_back(std::move(line));
+        line = Line{};
+        line.firstWord = wordIndex;
+        current.clear();
+        penX = 0.0f;
+    };
+    for (const auto& t : _tokens) {
+        if (t.newline) { flush(); continue; }
+        if (!current.empty()) {
+            if (penX + _spaceW + t.width <= availW) {
+                current.push_back(' ');
+                penX += _spaceW;
+            } else {
+                flush();
+            }
+        }
+        current += t.word;
+        penX += t.width;
+        line.wordRight.push_back(penX);
+        _wordLine.push_back((int)_lines.size());
+        ++wordIndex;
+    }
+    if (!current.empty()) flush();
 }
 
 void UIAnimatedTextBox::update(float delta) {
@@ -541,42 +601,30 @@ void UIAnimatedTextBox::render() const {
     if (!_font || _tokens.empty()) return;
 
     const float availW = std::max(0.0f, _w - 2.0f * _padX);
+    if (availW != _layoutW) layout(availW);
+    if (_visibleWords <= 0 || _wordLine.empty()) return;
+
     const float startX = _x + _padX;
     const float startY = _y + _padY;
-    const float lineH = Text::measure(_font, "Mg").h;
 
-    // Build wrapped lines from the first _visibleWords words, respecting explicit newlines
-    Vector<String> lines; lines.reserve(8);
-    String current;
-    int wordsShown = 0;
-    for (const auto& t : _tokens) {
-        if (t.newline) {
-            if (!current.empty()) { lines.push_back(current); current.clear(); }
-            else { lines.push_back(""); }
-            continue;
-        }
-        if (wordsShown >= _visibleWords) break;
-        const String& w = t.word;
-        if (current.empty()) {
-            // Start of a new line
-            current = w;
-        } else {
-            String candidate = current + " " + w;
-            SDL_FRect m = Text::measure(_font, candidate.c_str());
-            if (m.w <= availW) current = std::move(candidate);
-            else { lines.push_back(current); current = w; }
-        }
-        ++wordsShown;
-    }
-    if (!current.empty()) lines.push_back(current);
+    // The last revealed word picks the last line to draw; earlier lines are
+    // drawn whole and that line is clipped just past the revealed word.
+    const int lastWord = std::min(_visibleWords, (int)_wordLine.size()) - 1;
+    const int lastLine = _wordLine[lastWord];
 
-    // Draw lines
     float y = startY;
-    for (const auto& ln : lines) {
-        if (!ln.empty()) {
-            Text::draw(_font, ln.c_str(), startX, y, _textColor);
+    for (int i = 0; i <= lastLine; ++i) {
+        const Line& ln = _lines[i];
+        if (ln.run) {
+            if (i < lastLine) {
+                Text::drawRun(ln.run, startX, y, _textColor);
+            } else {
+                // Clip halfway into the following gap so glyph overhang isn't cut
+                const float right = ln.wordRight[lastWord - ln.firstWord] + _spaceW * 0.5f;
+                Text::drawRun(ln.run, startX, y, _textColor, right);
+            }
         }
-        y += lineH + _lineGap;
+        y += _lineH + _lineGap;
         if (y > _y + _h - _padY) break; // stop if overflowing the box vertically
     }
 }
@@ -30,12 +30,12 @@ protected:
 class UILabel : public UIControl {
 public:
     UILabel() = default;
-    UILabel(Text::Font* font, String text, SDL_Color color = SDL_Color{255,255,255,255})
+    UILabel(Text::FontHandle font, String text, SDL_Color color = SDL_Color{255,255,255,255})
         : _font(font), _text(std::move(text)), _color(color) {}
 
     void setText(String text) { _text = std::move(text); }
     void setColor(SDL_Color color) { _color = color; }
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
 
     void render() const override {
         if (!_font || _text.empty()) return;
@@ -47,7 +47,7 @@ public:
         return Text::measure(_font, _text.c_str());
     }
 private:
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     String _text;
     SDL_Color _color{255,255,255,255};
 };
@@ -55,7 +55,7 @@ private:
 // Simple window/panel with background and border, optional title
 class UIWindow : public UIControl {
 public:
-    void setTitle(Text::Font* font, String title) { _titleFont = font; _title = std::move(title); }
+    void setTitle(Text::FontHandle font, String title) { _titleFont = font; _title = std::move(title); }
     void setColors(Renderer::Color bg, Renderer::Color border) { _bg = bg; _border = border; }
     void setPadding(float px, float py) { _padX = px; _padY = py; }
 
@@ -71,7 +71,7 @@ public:
     void render() const override;
 
 private:
-    Text::Font* _titleFont = nullptr;
+    Text::FontHandle _titleFont;
     String _title;
     Renderer::Color _bg{20,20,20,200};
     Renderer::Color _border{200,200,200,255};
@@ -81,7 +81,7 @@ private:
 // Basic single-line text input
 class UITextInput : public UIControl {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
     void setText(String t) { _text = std::move(t); _caret = (int)_text.size(); }
     const String& text() const { return _text; }
     void setPlaceholder(String p) { _placeholder = std::move(p); }
@@ -103,7 +103,7 @@ private:
     }
     static char keyToChar(int keyCode);
 
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     String _text;
     String _placeholder;
     int _maxChars = 128;
@@ -121,7 +121,7 @@ private:
 // Clickable button control
 class UIButton : public UIControl {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
     void setText(String t) { _text = std::move(t); }
     void setOnClick(std::function<void()> cb) { _onClick = std::move(cb); }
     void setColors(Renderer::Color normal, Renderer::Color hover, Renderer::Color pressed, Renderer::Color border, SDL_Color text) {
@@ -141,7 +141,7 @@ private:
     static bool pointInRect(float px, float py, const SDL_FRect& r) {
         return px >= r.x && py >= r.y && px <= r.x + r.w && py <= r.y + r.h;
     }
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     String _text;
     std::function<void()> _onClick;
     bool _hovered = false;
@@ -158,7 +158,7 @@ private:
 // Checkbox control with label
 class UICheckbox : public UIControl {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
     void setText(String t) { _text = std::move(t); }
     void setChecked(bool c) { _checked = c; }
     bool checked() const { return _checked; }
@@ -178,7 +178,7 @@ private:
     }
     void toggle();
 
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     String _text;
     std::function<void(bool)> _onChanged;
     bool _checked = false;
@@ -243,7 +243,12 @@ private:
 // Animated text box that reveals one word at a time with word wrapping
 class UIAnimatedTextBox : public UIControl {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    UIAnimatedTextBox() = default;
+    ~UIAnimatedTextBox() override { releaseLayout(); }
+    UIAnimatedTextBox(const UIAnimatedTextBox&) = delete;
+    UIAnimatedTextBox& operator=(const UIAnimatedTextBox&) = delete;
+
+    void setFont(Text::FontHandle font) { if (_font != font) { _font = font; tokenize(); } }
     void setText(String t) { _text = std::move(t); tokenize(); reset(); }
     void setWordInterval(float seconds) { _wordInterval = seconds > 0.0f ? seconds : 0.01f; }
     void setStartDelay(float seconds) { _startDelay = seconds > 0.0f ? seconds : 0.0f; _delayLeft = _startDelay; }
@@ -259,12 +264,28 @@ public:
     void render() const override;
 
 private:
-    struct Token { String word; bool newline = false; };
+    struct Token { String word; bool newline = false; float width = 0.0f; };
+    // One wrapped line, shaped once into a glyph run. wordRight[i] is the pixel
+    // offset just past the i-th word of the line, used to clip partial reveals.
+    struct Line {
+        Text::RunHandle run;
+        int firstWord = 0;
+        Vector<float> wordRight;
+    };
     void tokenize();
+    void layout(float availW) const;
+    void releaseLayout() const;
 
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     String _text;
     Vector<Token> _tokens;
+    int _wordCount = 0;
+    float _spaceW = 0.0f;  // measured once per font
+    float _lineH = 0.0f;
+    // Layout cache, rebuilt only when the text, font or available width changes
+    mutable Vector<Line> _lines;
+    mutable Vector<int> _wordLine; // word index -> line index
+    mutable float _layoutW = -1.0f;
     int _visibleWords = 0; // words currently revealed
     float _wordInterval = 0.2f; // seconds between words
     float _startDelay = 0.0f;    // delay before starting reveal
@@ -282,7 +303,7 @@ class UIImage : public UIControl {
 public:
     enum class ScaleMode { None, Fit, Stretch };
 
-    void setImage(Ref<Renderer::Image> img) { _img = std::move(img); }
+    void setImage(Renderer::ImageHandle img) { _img = img; }
     bool loadFromFile(const char* path) { return Renderer::loadImageFromFile(path, _img); }
     void setScaleMode(ScaleMode m) { _mode = m; }
     void setTint(Renderer::Color c) { _tint = c; }
@@ -299,7 +320,7 @@ public:
     void render() const override;
 
 private:
-    Ref<Renderer::Image> _img;
+    Renderer::ImageHandle _img;
     ScaleMode _mode = ScaleMode::Fit;
     Renderer::Color _tint{255,255,255,255};
     float _rotation = 0.0f; // degrees
@@ -316,7 +337,7 @@ private:
 // Scrollable list box with single selection
 class UIListBox : public UIControl {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
     void setItems(Vector<String> items) { _items = std::move(items); _selected = _items.empty() ? -1 : 0; clampScroll(); }
     int selectedIndex() const { return _selected; }
     const String* selectedItem() const { return (_selected >= 0 && _selected < (int)_items.size()) ? &_items[_selected] : nullptr; }
@@ -333,7 +354,7 @@ private:
     int visibleRows() const;
     int rowAt(float mx, float my) const;
 
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     Vector<String> _items;
     int _selected = -1;
     int _scroll = 0; // index of first visible item
@@ -350,7 +371,7 @@ private:
 // Simple combo box (pulldown) for selecting one item from a small list
 class UIComboBox : public UIControl {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
     void setItems(Vector<String> items) { _items = std::move(items); if (_selected < 0 || _selected >= (int)_items.size()) _selected = _items.empty() ? -1 : 0; }
     void setSelectedIndex(int idx) { if (idx >= 0 && idx < (int)_items.size()) _selected = idx; }
     int selectedIndex() const { return _selected; }
@@ -369,7 +390,7 @@ public:
 
 private:
     static bool pointInRect(float px, float py, const SDL_FRect& r) { return px >= r.x && py >= r.y && px <= r.x + r.w && py <= r.y + r.h; }
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     Vector<String> _items;
     int _selected = -1;
     bool _open = false;
@@ -387,7 +408,7 @@ private:
 // Segmented control: multiple side-by-side segments, single selection (toggle-like)
 class UISegmentedControl : public UIControl {
 public:
-    void setFont(Text::Font* font) { _font = font; }
+    void setFont(Text::FontHandle font) { _font = font; }
     void setItems(Vector<String> items) { _items = std::move(items); if (_selected < 0 || _selected >= (int)_items.size()) _selected = _items.empty() ? -1 : 0; }
     void setSelectedIndex(int idx) { if (idx >= 0 && idx < (int)_items.size()) { _selected = idx; if (_onChanged) _onChanged(_selected); } }
     int selectedIndex() const { return _selected; }
@@ -404,7 +425,7 @@ private:
     static bool pointInRect(float px, float py, const SDL_FRect& r) { return px >= r.x && py >= r.y && px <= r.x + r.w && py <= r.y + r.h; }
     int segmentAt(float mx, float my) const;
 
-    Text::Font* _font = nullptr;
+    Text::FontHandle _font;
     Vector<String> _items;
     int _selected = -1;
     int _hover = -1;
@@ -0,0 +1,535 @@
+#include "Common.h"
+#include "Vector2Stream.h"
+
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define AQ_VEC_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define AQ_VEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AQ_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define AQ_TARGET_AVX2
+#endif
+
+// affineToPoints stores interleaved x/y pairs straight into Vector2 arrays
+static_assert(sizeof(Vector2) == 2 * sizeof(float), "Vector2 must be two packed floats");
+
+namespace {
+    using Vector2Batch::Affine2;
+
+    using TranslateFn = void (*)(float*, float*, std::size_t, const Vector2&);
+    using AffineFn = void (*)(const float*, const float*, float*, float*, std::size_t, const Affine2&);
+    using AffinePointsFn = void (*)(const float*, const float*, std::size_t, const Affine2&, Vector2*);
+    using BoundsFn = bool (*)(const float*, const float*, std::size_t, Vector2&, Vector2&);
+    using CullFn = std::size_t(*)(const float*, const float*, std::size_t, const Vector2&, float, uint32_t*);
+
+    // Tails of the vector loops share these
+    inline void TranslateRange(float* x, float* y, std::size_t i, std::size_t n, float dx, float dy)
+    {
+        for (; i < n; ++i) { x[i] += dx; y[i] += dy; }
+    }
+
+    inline void AffineRange(const float* sx, const float* sy, float* dx, float* dy, std::size_t i, std::size_t n, const Affine2& a)
+    {
+        for (; i < n; ++i) {
+            const float px = sx[i], py = sy[i];
+            dx[i] = a.m[0] * px + a.m[2] * py + a.tx;
+            dy[i] = a.m[1] * px + a.m[3] * py + a.ty;
+        }
+    }
+
+    inline void AffinePointsRange(const float* sx, const float* sy, std::size_t i, std::size_t n, const Affine2& a, Vector2* out)
+    {
+        for (; i < n; ++i) {
+            const float px = sx[i], py = sy[i];
+            out[i] = { a.m[0] * px + a.m[2] * py + a.tx, a.m[1] * px + a.m[3] * py + a.ty };
+        }
+    }
+
+    inline void BoundsRange(const float* x, const float* y, std::size_t i, std::size_t n, float& x0, float& y0, float& x1, float& y1)
+    {
+        for (; i < n; ++i) {
+            x0 = std::min(x0, x[i]); x1 = std::max(x1, x[i]);
+            y0 = std::min(y0, y[i]); y1 = std::max(y1, y[i]);
+        }
+    }
+
+    inline std::size_t CullRange(const float* x, const float* y, std::size_t i, std::size_t n, float cx, float cy, float r2, uint32_t* outIdx, std::size_t count)
+    {
+        for (; i < n; ++i) {
+            const float dx = x[i] - cx, dy = y[i] - cy;
+            if (dx * dx + dy * dy <= r2) outIdx[count++] = (uint32_t)i;
+        }
+        return count;
+    }
+
+    // One bit per lane that passed the test
+    inline std::size_t EmitMask(unsigned mask, std::size_t base, uint32_t* outIdx, std::size_t count)
+    {
+        while (mask) {
+            outIdx[count++] = (uint32_t)(base + (std::size_t)std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+        return count;
+    }
+
+    void TranslateScalar(float* x, float* y, std::size_t n, const Vector2& d)
+    {
+        if (!x || !y) return;
+        TranslateRange(x, y, 0, n, d.x, d.y);
+    }
+
+    void AffineScalar(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a)
+    {
+        if (!sx || !sy || !dx || !dy) return;
+        AffineRange(sx, sy, dx, dy, 0, n, a);
+    }
+
+    void AffinePointsScalar(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out)
+    {
+        if (!sx || !sy || !out) return;
+        AffinePointsRange(sx, sy, 0, n, a, out);
+    }
+
+    bool BoundsScalar(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax)
+    {
+        if (!x || !y || n == 0) return false;
+        float x0 = x[0], y0 = y[0], x1 = x[0], y1 = y[0];
+        BoundsRange(x, y, 1, n, x0, y0, x1, y1);
+        outMin = { x0, y0 };
+        outMax = { x1, y1 };
+        return true;
+    }
+
+    std::size_t CullScalar(const float* x, const float* y, std::size_t n, const Vector2& c, float r2, uint32_t* outIdx)
+    {
+        if (!x || !y || !outIdx) return 0;
+        return CullRange(x, y, 0, n, c.x, c.y, r2, outIdx, 0);
+    }
+
+#ifdef AQ_VEC_X86
+    inline float HMinSSE(__m128 v)
+    {
+        v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(v);
+    }
+
+    inline float HMaxSSE(__m128 v)
+    {
+        v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+        v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(v);
+    }
+
+    void TranslateSSE2(float* x, float* y, std::size_t n, const Vector2& d)
+    {
+        if (!x || !y) return;
+        const __m128 dx = _mm_set1_ps(d.x), dy = _mm_set1_ps(d.y);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), dx));
+            _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), dy));
+        }
+        TranslateRange(x, y, i, n, d.x, d.y);
+    }
+
+    struct AffineSSE {
+        __m128 m0, m1, m2, m3, tx, ty;
+        explicit AffineSSE(const Affine2& a)
+            : m0(_mm_set1_ps(a.m[0])), m1(_mm_set1_ps(a.m[1])), m2(_mm_set1_ps(a.m[2])), m3(_mm_set1_ps(a.m[3])),
+              tx(_mm_set1_ps(a.tx)), ty(_mm_set1_ps(a.ty)) {}
+        __m128 x(__m128 px, __m128 py) const { return _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, px), _mm_mul_ps(m2, py)), tx); }
+        __m128 y(__m128 px, __m128 py) const { return _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, px), _mm_mul_ps(m3, py)), ty); }
+    };
+
+    void AffineSSE2(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a)
+    {
+        if (!sx || !sy || !dx || !dy) return;
+        const AffineSSE k(a);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128 px = _mm_loadu_ps(sx + i), py = _mm_loadu_ps(sy + i);
+            _mm_storeu_ps(dx + i, k.x(px, py));
+            _mm_storeu_ps(dy + i, k.y(px, py));
+        }
+        AffineRange(sx, sy, dx, dy, i, n, a);
+    }
+
+    void AffinePointsSSE2(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out)
+    {
+        if (!sx || !sy || !out) return;
+        const AffineSSE k(a);
+        float* dst = &out[0].x;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128 px = _mm_loadu_ps(sx + i), py = _mm_loadu_ps(sy + i);
+            const __m128 ox = k.x(px, py), oy = k.y(px, py);
+            _mm_storeu_ps(dst + 2 * i, _mm_unpacklo_ps(ox, oy));
+            _mm_storeu_ps(dst + 2 * i + 4, _mm_unpackhi_ps(ox, oy));
+        }
+        AffinePointsRange(sx, sy, i, n, a, out);
+    }
+
+    bool BoundsSSE2(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax)
+    {
+        if (!x || !y || n == 0) return false;
+        if (n < 4) return BoundsScalar(x, y, n, outMin, outMax);
+        __m128 x0 = _mm_loadu_ps(x), x1 = x0;
+        __m128 y0 = _mm_loadu_ps(y), y1 = y0;
+        std::size_t i = 4;
+        for (; i + 4 <= n; i += 4) {
+            const __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i);
+            x0 = _mm_min_ps(x0, px); x1 = _mm_max_ps(x1, px);
+            y0 = _mm_min_ps(y0, py); y1 = _mm_max_ps(y1, py);
+        }
+        float fx0 = HMinSSE(x0), fy0 = HMinSSE(y0), fx1 = HMaxSSE(x1), fy1 = HMaxSSE(y1);
+        BoundsRange(x, y, i, n, fx0, fy0, fx1, fy1);
+        outMin = { fx0, fy0 };
+        outMax = { fx1, fy1 };
+        return true;
+    }
+
+    std::size_t CullSSE2(const float* x, const float* y, std::size_t n, const Vector2& c, float r2, uint32_t* outIdx)
+    {
+        if (!x || !y || !outIdx) return 0;
+        const __m128 cx = _mm_set1_ps(c.x), cy = _mm_set1_ps(c.y), rr = _mm_set1_ps(r2);
+        std::size_t count = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+            const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), cy);
+            const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+            count = EmitMask((unsigned)_mm_movemask_ps(_mm_cmple_ps(d2, rr)), i, outIdx, count);
+        }
+        return CullRange(x, y, i, n, c.x, c.y, r2, outIdx, count);
+    }
+
+    AQ_TARGET_AVX2 void TranslateAVX2(float* x, float* y, std::size_t n, const Vector2& d)
+    {
+        if (!x || !y) return;
+        const __m256 dx = _mm256_set1_ps(d.x), dy = _mm256_set1_ps(d.y);
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), dx));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), dy));
+        }
+        TranslateRange(x, y, i, n, d.x, d.y);
+    }
+
+    // Both outputs of one 8-point step
+    AQ_TARGET_AVX2 inline void AffineStepAVX2(const Affine2& a, __m256 px, __m256 py, __m256& ox, __m256& oy)
+    {
+        ox = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a.m[0]), px), _mm256_mul_ps(_mm256_set1_ps(a.m[2]), py)), _mm256_set1_ps(a.tx));
+        oy = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a.m[1]), px), _mm256_mul_ps(_mm256_set1_ps(a.m[3]), py)), _mm256_set1_ps(a.ty));
+    }
+
+    AQ_TARGET_AVX2 void AffineAVX2(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a)
+    {
+        if (!sx || !sy || !dx || !dy) return;
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 ox, oy;
+            AffineStepAVX2(a, _mm256_loadu_ps(sx + i), _mm256_loadu_ps(sy + i), ox, oy);
+            _mm256_storeu_ps(dx + i, ox);
+            _mm256_storeu_ps(dy + i, oy);
+        }
+        AffineRange(sx, sy, dx, dy, i, n, a);
+    }
+
+    AQ_TARGET_AVX2 void AffinePointsAVX2(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out)
+    {
+        if (!sx || !sy || !out) return;
+        float* dst = &out[0].x;
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256 ox, oy;
+            AffineStepAVX2(a, _mm256_loadu_ps(sx + i), _mm256_loadu_ps(sy + i), ox, oy);
+            // unpack works per 128-bit lane: lo = p0 p1 | p4 p5, hi = p2 p3 | p6 p7
+            const __m256 lo = _mm256_unpacklo_ps(ox, oy), hi = _mm256_unpackhi_ps(ox, oy);
+            _mm256_storeu_ps(dst + 2 * i, _mm256_permute2f128_ps(lo, hi, 0x20));
+            _mm256_storeu_ps(dst + 2 * i + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+        }
+        AffinePointsRange(sx, sy, i, n, a, out);
+    }
+
+    AQ_TARGET_AVX2 bool BoundsAVX2(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax)
+    {
+        if (!x || !y || n == 0) return false;
+        if (n < 8) return BoundsSSE2(x, y, n, outMin, outMax);
+        __m256 x0 = _mm256_loadu_ps(x), x1 = x0;
+        __m256 y0 = _mm256_loadu_ps(y), y1 = y0;
+        std::size_t i = 8;
+        for (; i + 8 <= n; i += 8) {
+            const __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i);
+            x0 = _mm256_min_ps(x0, px); x1 = _mm256_max_ps(x1, px);
+            y0 = _mm256_min_ps(y0, py); y1 = _mm256_max_ps(y1, py);
+        }
+        float fx0 = HMinSSE(_mm_min_ps(_mm256_castps256_ps128(x0), _mm256_extractf128_ps(x0, 1)));
+        float fy0 = HMinSSE(_mm_min_ps(_mm256_castps256_ps128(y0), _mm256_extractf128_ps(y0, 1)));
+        float fx1 = HMaxSSE(_mm_max_ps(_mm256_castps256_ps128(x1), _mm256_extractf128_ps(x1, 1)));
+        float fy1 = HMaxSSE(_mm_max_ps(_mm256_castps256_ps128(y1), _mm256_extractf128_ps(y1, 1)));
+        BoundsRange(x, y, i, n, fx0, fy0, fx1, fy1);
+        outMin = { fx0, fy0 };
+        outMax = { fx1, fy1 };
+        return true;
+    }
+
+    AQ_TARGET_AVX2 std::size_t CullAVX2(const float* x, const float* y, std::size_t n, const Vector2& c, float r2, uint32_t* outIdx)
+    {
+        if (!x || !y || !outIdx) return 0;
+        const __m256 cx = _mm256_set1_ps(c.x), cy = _mm256_set1_ps(c.y), rr = _mm256_set1_ps(r2);
+        std::size_t count = 0, i = 0;
+        for (; i + 8 <= n; i += 8) {
+            const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), cx);
+            const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), cy);
+            const __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+            count = EmitMask((unsigned)_mm256_movemask_ps(_mm256_cmp_ps(d2, rr, _CMP_LE_OQ)), i, outIdx, count);
+        }
+        return CullRange(x, y, i, n, c.x, c.y, r2, outIdx, count);
+    }
+#endif
+
+#ifdef AQ_VEC_NEON
+    void TranslateNEON(float* x, float* y, std::size_t n, const Vector2& d)
+    {
+        if (!x || !y) return;
+        const float32x4_t dx = vdupq_n_f32(d.x), dy = vdupq_n_f32(d.y);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            vst1q_f32(x + i, vaddq_f32(vld1q_f32(x + i), dx));
+            vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), dy));
+        }
+        TranslateRange(x, y, i, n, d.x, d.y);
+    }
+
+    inline float32x4x2_t AffineStepNEON(const Affine2& a, float32x4_t px, float32x4_t py)
+    {
+        float32x4x2_t o;
+        o.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(px, a.m[0]), vmulq_n_f32(py, a.m[2])), vdupq_n_f32(a.tx));
+        o.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(px, a.m[1]), vmulq_n_f32(py, a.m[3])), vdupq_n_f32(a.ty));
+        return o;
+    }
+
+    void AffineNEON(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a)
+    {
+        if (!sx || !sy || !dx || !dy) return;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const float32x4x2_t o = AffineStepNEON(a, vld1q_f32(sx + i), vld1q_f32(sy + i));
+            vst1q_f32(dx + i, o.val[0]);
+            vst1q_f32(dy + i, o.val[1]);
+        }
+        AffineRange(sx, sy, dx, dy, i, n, a);
+    }
+
+    void AffinePointsNEON(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out)
+    {
+        if (!sx || !sy || !out) return;
+        float* dst = &out[0].x;
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            vst2q_f32(dst + 2 * i, AffineStepNEON(a, vld1q_f32(sx + i), vld1q_f32(sy + i))); // interleaving store
+        }
+        AffinePointsRange(sx, sy, i, n, a, out);
+    }
+
+    bool BoundsNEON(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax)
+    {
+        if (!x || !y || n == 0) return false;
+        if (n < 4) return BoundsScalar(x, y, n, outMin, outMax);
+        float32x4_t x0 = vld1q_f32(x), x1 = x0;
+        float32x4_t y0 = vld1q_f32(y), y1 = y0;
+        std::size_t i = 4;
+        for (; i + 4 <= n; i += 4) {
+            const float32x4_t px = vld1q_f32(x + i), py = vld1q_f32(y + i);
+            x0 = vminq_f32(x0, px); x1 = vmaxq_f32(x1, px);
+            y0 = vminq_f32(y0, py); y1 = vmaxq_f32(y1, py);
+        }
+        float fx0 = vminvq_f32(x0), fy0 = vminvq_f32(y0), fx1 = vmaxvq_f32(x1), fy1 = vmaxvq_f32(y1);
+        BoundsRange(x, y, i, n, fx0, fy0, fx1, fy1);
+        outMin = { fx0, fy0 };
+        outMax = { fx1, fy1 };
+        return true;
+    }
+
+    std::size_t CullNEON(const float* x, const float* y, std::size_t n, const Vector2& c, float r2, uint32_t* outIdx)
+    {
+        if (!x || !y || !outIdx) return 0;
+        const float32x4_t cx = vdupq_n_f32(c.x), cy = vdupq_n_f32(c.y), rr = vdupq_n_f32(r2);
+        const uint32_t laneBitsV[4] = { 1, 2, 4, 8 };
+        const uint32x4_t laneBits = vld1q_u32(laneBitsV);
+        std::size_t count = 0, i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const float32x4_t dx = vsubq_f32(vld1q_f32(x + i), cx);
+            const float32x4_t dy = vsubq_f32(vld1q_f32(y + i), cy);
+            const float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+            count = EmitMask(vaddvq_u32(vandq_u32(vcleq_f32(d2, rr), laneBits)), i, outIdx, count);
+        }
+        return CullRange(x, y, i, n, c.x, c.y, r2, outIdx, count);
+    }
+#endif
+
+    struct Kernels {
+        Vector2Batch::KernelLevel level = Vector2Batch::KernelLevel::Scalar;
+        TranslateFn translate = &TranslateScalar;
+        AffineFn affine = &AffineScalar;
+        AffinePointsFn affinePoints = &AffinePointsScalar;
+        BoundsFn bounds = &BoundsScalar;
+        CullFn cull = &CullScalar;
+    };
+
+    const Kernels kScalarKernels{};
+#ifdef AQ_VEC_X86
+    const Kernels kSSE2Kernels{ Vector2Batch::KernelLevel::SSE2, &TranslateSSE2, &AffineSSE2, &AffinePointsSSE2, &BoundsSSE2, &CullSSE2 };
+    const Kernels kAVX2Kernels{ Vector2Batch::KernelLevel::AVX2, &TranslateAVX2, &AffineAVX2, &AffinePointsAVX2, &BoundsAVX2, &CullAVX2 };
+#endif
+#ifdef AQ_VEC_NEON
+    const Kernels kNEONKernels{ Vector2Batch::KernelLevel::NEON, &TranslateNEON, &AffineNEON, &AffinePointsNEON, &BoundsNEON, &CullNEON };
+#endif
+
+    const Kernels* SelectKernels(Vector2Batch::KernelLevel level)
+    {
+        switch (level) {
+#ifdef AQ_VEC_X86
+        case Vector2Batch::KernelLevel::AVX2:
+            if (SDL_HasAVX2()) return &kAVX2Kernels;
+            [[fallthrough]];
+        case Vector2Batch::KernelLevel::SSE2:
+            return &kSSE2Kernels; // baseline on x86-64
+#endif
+#ifdef AQ_VEC_NEON
+        case Vector2Batch::KernelLevel::NEON:
+            return &kNEONKernels; // baseline on AArch64
+#endif
+        default:
+            return &kScalarKernels;
+        }
+    }
+
+    // Swapped as one table so a caller never mixes levels
+    std::atomic<const Kernels*> g_kernels{ nullptr };
+
+    inline const Kernels& K()
+    {
+        const Kernels* k = g_kernels.load(std::memory_order_acquire);
+        if (!k) {
+            Vector2Batch::setKernelLevel(Vector2Batch::detectKernelLevel());
+            k = g_kernels.load(std::memory_order_acquire);
+        }
+        return *k;
+    }
+}
+
+Vector2Batch::KernelLevel Vector2Batch::detectKernelLevel()
+{
+#if defined(AQ_VEC_X86)
+    return SDL_HasAVX2() ? KernelLevel::AVX2 : KernelLevel::SSE2;
+#elif defined(AQ_VEC_NEON)
+    return KernelLevel::NEON;
+#else
+    return KernelLevel::Scalar;
+#endif
+}
+
+Vector2Batch::KernelLevel Vector2Batch::getKernelLevel()
+{
+    return K().level;
+}
+
+void Vector2Batch::setKernelLevel(KernelLevel level)
+{
+    g_kernels.store(SelectKernels(level), std::memory_order_release);
+}
+
+const char* Vector2Batch::kernelLevelName(KernelLevel level)
+{
+    switch (level) {
+    case KernelLevel::SSE2: return "SSE2";
+    case KernelLevel::AVX2: return "AVX2";
+    case KernelLevel::NEON: return "NEON";
+    default: return "Scalar";
+    }
+}
+
+Vector2Batch::Affine2 Vector2Batch::makeAffine(const Vector2& origin, const Vector2& axisX, const Vector2& axisY)
+{
+    Affine2 a;
+    a.m[0] = axisX.x; a.m[1] = axisX.y;
+    a.m[2] = axisY.x; a.m[3] = axisY.y;
+    a.tx = origin.x;
+    a.ty = origin.y;
+    return a;
+}
+
+Vector2Batch::Affine2 Vector2Batch::makeScaleAround(const Vector2& pivot, const Vector2& factor)
+{
+    // pivot + (p - pivot) * factor
+    return makeAffine({ pivot.x - pivot.x * factor.x, pivot.y - pivot.y * factor.y }, { factor.x, 0.0f }, { 0.0f, factor.y });
+}
+
+Vector2Batch::Affine2 Vector2Batch::makeRotationAround(const Vector2& pivot, float degrees)
+{
+    const float r = degrees * 0.01745329251994329577f;
+    const float c = std::cos(r), s = std::sin(r);
+    // pivot + R * (p - pivot)
+    return makeAffine({ pivot.x - (c * pivot.x - s * pivot.y), pivot.y - (s * pivot.x + c * pivot.y) }, { c, s }, { -s, c });
+}
+
+void Vector2Batch::translate(float* x, float* y, std::size_t n, const Vector2& d)
+{
+    K().translate(x, y, n, d);
+}
+
+void Vector2Batch::affine(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a)
+{
+    K().affine(sx, sy, dx, dy, n, a);
+}
+
+void Vector2Batch::affineToPoints(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out)
+{
+    K().affinePoints(sx, sy, n, a, out);
+}
+
+bool Vector2Batch::bounds(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax)
+{
+    return K().bounds(x, y, n, outMin, outMax);
+}
+
+std::size_t Vector2Batch::cullDistanceSq(const float* x, const float* y, std::size_t n, const Vector2& center, float radiusSq, uint32_t* outIdx)
+{
+    return K().cull(x, y, n, center, radiusSq, outIdx);
+}
+
+void Vector2Batch::translateScalar(float* x, float* y, std::size_t n, const Vector2& d)
+{
+    TranslateScalar(x, y, n, d);
+}
+
+void Vector2Batch::affineScalar(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a)
+{
+    AffineScalar(sx, sy, dx, dy, n, a);
+}
+
+void Vector2Batch::affineToPointsScalar(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out)
+{
+    AffinePointsScalar(sx, sy, n, a, out);
+}
+
+bool Vector2Batch::boundsScalar(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax)
+{
+    return BoundsScalar(x, y, n, outMin, outMax);
+}
+
+std::size_t Vector2Batch::cullDistanceSqScalar(const float* x, const float* y, std::size_t n, const Vector2& center, float radiusSq, uint32_t* outIdx)
+{
+    return CullScalar(x, y, n, center, radiusSq, outIdx);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+// Structure-of-arrays Vector2 storage. Batch transforms over it run four or
+// eight points per instruction instead of one Vector2 at a time.
+struct Vector2Stream {
+    Vector<float> x;
+    Vector<float> y;
+
+    std::size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+    void clear() { x.clear(); y.clear(); }
+    void reserve(std::size_t n) { x.reserve(n); y.reserve(n); }
+    void resize(std::size_t n) { x.resize(n); y.resize(n); }
+    void push_back(const Vector2& v) { x.push_back(v.x); y.push_back(v.y); }
+    void append(const Vector2Stream& o)
+    {
+        x.insert(x.end(), o.x.begin(), o.x.end());
+        y.insert(y.end(), o.y.begin(), o.y.end());
+    }
+    Vector2 operator[](std::size_t i) const { return { x[i], y[i] }; }
+    void set(std::size_t i, const Vector2& v) { x[i] = v.x; y[i] = v.y; }
+
+    // AoS <-> SoA
+    void assign(const Vector2* pts, std::size_t n)
+    {
+        resize(n);
+        for (std::size_t i = 0; i < n; ++i) { x[i] = pts[i].x; y[i] = pts[i].y; }
+    }
+    void store(Vector<Vector2>& out) const
+    {
+        out.resize(size());
+        for (std::size_t i = 0; i < out.size(); ++i) out[i] = { x[i], y[i] };
+    }
+};
+
+// Kernels over Vector2Stream (or any pair of x/y float arrays). The best level
+// is picked on first use and all five kernels switch together; the *Scalar
+// functions are the reference the SIMD paths are tested against.
+namespace Vector2Batch {
+
+    enum class KernelLevel { Scalar, SSE2, AVX2, NEON };
+
+    KernelLevel detectKernelLevel();
+    KernelLevel getKernelLevel();
+    // Force a level for tests and benchmarks; getKernelLevel() reports the one
+    // actually used. AVX2 on a CPU without it runs SSE2, and a level this
+    // architecture has no kernels for (NEON on x86-64, SSE2 on AArch64) runs Scalar.
+    void setKernelLevel(KernelLevel level);
+    const char* kernelLevelName(KernelLevel level);
+
+    // x' = m[0] * x + m[2] * y + tx
+    // y' = m[1] * x + m[3] * y + ty
+    // i.e. the columns (m[0], m[1]) and (m[2], m[3]) are the images of the unit axes.
+    struct Affine2 {
+        float m[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+        float tx = 0.0f;
+        float ty = 0.0f;
+    };
+
+    Affine2 makeAffine(const Vector2& origin, const Vector2& axisX, const Vector2& axisY);
+    Affine2 makeScaleAround(const Vector2& pivot, const Vector2& factor);
+    Affine2 makeRotationAround(const Vector2& pivot, float degrees);
+
+    // Raw kernels. Source and destination may be the same arrays.
+    void translate(float* x, float* y, std::size_t n, const Vector2& d);
+    void affine(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a);
+    // affine() writing interleaved points, for APIs that take Vector2 arrays
+    void affineToPoints(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out);
+    // false (and min/max untouched) when n is 0
+    bool bounds(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax);
+    // Writes the indices of points with |p - center|^2 <= radiusSq, in order.
+    // outIdx must hold n entries; returns how many were written.
+    std::size_t cullDistanceSq(const float* x, const float* y, std::size_t n, const Vector2& center, float radiusSq, uint32_t* outIdx);
+
+    // Scalar reference implementations (always available)
+    void translateScalar(float* x, float* y, std::size_t n, const Vector2& d);
+    void affineScalar(const float* sx, const float* sy, float* dx, float* dy, std::size_t n, const Affine2& a);
+    void affineToPointsScalar(const float* sx, const float* sy, std::size_t n, const Affine2& a, Vector2* out);
+    bool boundsScalar(const float* x, const float* y, std::size_t n, Vector2& outMin, Vector2& outMax);
+    std::size_t cullDistanceSqScalar(const float* x, const float* y, std::size_t n, const Vector2& center, float radiusSq, uint32_t* outIdx);
+
+    // Stream helpers
+    inline void translate(Vector2Stream& s, const Vector2& d)
+    {
+        translate(s.x.data(), s.y.data(), s.size(), d);
+    }
+    inline void transform(Vector2Stream& s, const Affine2& a)
+    {
+        affine(s.x.data(), s.y.data(), s.x.data(), s.y.data(), s.size(), a);
+    }
+    inline void transform(const Vector2Stream& src, const Affine2& a, Vector<Vector2>& out)
+    {
+        out.resize(src.size());
+        affineToPoints(src.x.data(), src.y.data(), src.size(), a, out.data());
+    }
+    inline void scale(Vector2Stream& s, const Vector2& factor, const Vector2& pivot = { 0.0f, 0.0f })
+    {
+        transform(s, makeScaleAround(pivot, factor));
+    }
+    inline void rotateAround(Vector2Stream& s, const Vector2& pivot, float degrees)
+    {
+        transform(s, makeRotationAround(pivot, degrees));
+    }
+    inline bool bounds(const Vector2Stream& s, Vector2& outMin, Vector2& outMax)
+    {
+        return bounds(s.x.data(), s.y.data(), s.size(), outMin, outMax);
+    }
+    inline std::size_t cullDistanceSq(const Vector2Stream& s, const Vector2& center, float radiusSq, Vector<uint32_t>& outIdx)
+    {
+        outIdx.resize(s.size());
+        outIdx.resize(cullDistanceSq(s.x.data(), s.y.data(), s.size(), center, radiusSq, outIdx.data()));
+        return outIdx.size();
+    }
+}
@@ -6,18 +6,21 @@
 namespace AvatarQuest {
 namespace Fonts {
 
-// Initialize font cache (optional; lazy loads by default)
+// Start preloading on a background thread. Sizes come from assets/fonts/preload.txt
+// (one point size per line, '#' comments) or the wrapper sizes below when absent.
+// The font file is read once and every size is opened from the shared bytes.
 void init();
 
-// Get a cached font at the requested point size. Loads once on first use.
-// Returns nullptr on failure.
-Text::Font* get(int pointSize);
+// Get a cached font at the requested point size. Adopts preloaded fonts, otherwise
+// loads once on first use and records the stall in Game::getFrameStats().
+// Returns a null handle on failure.
+Text::FontHandle get(int pointSize);
 
 // Convenience wrappers for common sizes
-inline Text::Font* title() { return get(31); }
-inline Text::Font* ui()    { return get(27); }
+inline Text::FontHandle title() { return get(31); }
+inline Text::FontHandle ui()    { return get(27); }
 // 2x UI for menus
-inline Text::Font* menu()  { return get(54); }
+inline Text::FontHandle menu()  { return get(54); }
 
 // Release all cached fonts; call on shutdown.
 void shutdown();
@@ -0,0 +1,239 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+#include <cmath>
+
+using namespace Renderer;
+
+namespace {
+    // The per-corner math RenderAnimationBank used before frames were baked
+    Vector2 RotateAround(const Vector2& p, const Vector2& pivot, float deg)
+    {
+        const float r = deg * 0.01745329251994329577f;
+        const float s = std::sin(r), c = std::cos(r);
+        const float x = p.x - pivot.x, y = p.y - pivot.y;
+        return { pivot.x + x * c - y * s, pivot.y + x * s + y * c };
+    }
+
+    Vector2 ScaleAround(const Vector2& p, const Vector2& pivot, const Vector2& s)
+    {
+        return { pivot.x + (p.x - pivot.x) * s.x, pivot.y + (p.y - pivot.y) * s.y };
+    }
+
+    struct OldXform {
+        Vector2 tPos, tScl, worldPos, worldScale;
+        float tRot = 0.0f, worldRot = 0.0f;
+
+        Vector2 corner(const Vector2& p, const Vector2& center) const
+        {
+            Vector2 v = RotateAround(ScaleAround(p, center, tScl), center, tRot);
+            const Vector2 s{ v.x * worldScale.x * tScl.x, v.y * worldScale.y * tScl.y };
+            const Vector2 r = RotateAround(s, { 0, 0 }, worldRot + tRot);
+            return { r.x + worldPos.x + tPos.x, r.y + worldPos.y + tPos.y };
+        }
+
+        AnimMeshXform mesh() const { return makeAnimMeshXform(tPos, tScl, tRot, worldPos, worldScale, worldRot); }
+    };
+
+    // Quad corners of drawThickLine(s, e)
+    void ThickLine(const Vector2& s, const Vector2& e, float thickness, Vector2 out[4])
+    {
+        float dx = e.x - s.x, dy = e.y - s.y;
+        const float len = std::sqrt(dx * dx + dy * dy);
+        dx /= len; dy /= len;
+        const float px = -dy * (thickness * 0.5f), py = dx * (thickness * 0.5f);
+        out[0] = { s.x + px, s.y + py };
+        out[1] = { e.x + px, e.y + py };
+        out[2] = { e.x - px, e.y - py };
+        out[3] = { s.x - px, s.y - py };
+    }
+
+    AnimPrimitive Prim(AnimPrimitiveType type, Vector2 pos, Vector2 size, Vector2 center, float thickness)
+    {
+        AnimPrimitive p;
+        p.type = type;
+        p.aabb = AABB(pos, size);
+        p.center = center;
+        p.thickness = thickness;
+        p.color = Color{ 255, 128, 0, 255 };
+        return p;
+    }
+
+    void RequireNear(const SDL_FPoint& a, const Vector2& b)
+    {
+        REQUIRE(a.x == Catch::Approx(b.x).margin(1e-3));
+        REQUIRE(a.y == Catch::Approx(b.y).margin(1e-3));
+    }
+}
+
+TEST_CASE("AnimMesh: baked lines match the per-corner path", "[anim_mesh]")
+{
+    const AnimPrimitive line = Prim(AnimPrimitiveType::Line, { 2, 3 }, { 10, -4 }, { 5, 1 }, 3.0f);
+    AnimFrameMesh mesh;
+    bakeAnimFrameMesh(&line, 1, mesh);
+    REQUIRE(mesh.shapedCount() == 4);
+    REQUIRE(mesh.rigidCount() == 0);
+    REQUIRE(mesh.indices.size() == 6);
+    REQUIRE(mesh.vertices[0].color.g == Catch::Approx(128.0f / 255.0f));
+
+    OldXform x;
+    x.tPos = { 4, -2 };
+    x.tScl = { 1.5f, 1.5f };
+    x.tRot = 30.0f;
+    x.worldPos = { 100, 50 };
+    x.worldScale = { 2, 2 };
+    x.worldRot = -15.0f;
+
+    Vector2 expect[4];
+    ThickLine(x.corner({ 2, 3 }, line.center), x.corner({ 12, -1 }, line.center), 3.0f, expect);
+
+    Vector<SDL_Vertex> out = mesh.vertices;
+    transformAnimFrameMesh(mesh, x.mesh(), out.data());
+    for (int k = 0; k < 4; ++k) RequireNear(out[k].position, expect[k]);
+}
+
+TEST_CASE("AnimMesh: lines keep their width under flips and non-uniform scale", "[anim_mesh]")
+{
+    // 45 degree line: a mirror maps it onto its own perpendicular
+    const AnimPrimitive line = Prim(AnimPrimitiveType::Line, { 0, 0 }, { 6, 6 }, { 1, 2 }, 4.0f);
+    AnimFrameMesh mesh;
+    bakeAnimFrameMesh(&line, 1, mesh);
+
+    struct Case { Vector2 tScl, worldScale; float tRot, worldRot; };
+    const Case cases[] = {
+        { { 1, 1 }, { -1, 1 }, 0.0f, 0.0f },      // horizontal flip
+        { { 1, 1 }, { 1, -1 }, 20.0f, 10.0f },    // vertical flip, rotated
+        { { 3, 0.5f }, { 1, 1 }, 0.0f, 0.0f },    // squash
+        { { 1, -2 }, { 2.5f, 1 }, 35.0f, -50.0f },
+    };
+    for (const Case& c : cases) {
+        OldXform x;
+        x.tPos = { 1, 1 };
+        x.tScl = c.tScl;
+        x.tRot = c.tRot;
+        x.worldPos = { 50, 60 };
+        x.worldScale = c.worldScale;
+        x.worldRot = c.worldRot;
+
+        Vector2 expect[4];
+        ThickLine(x.corner({ 0, 0 }, line.center), x.corner({ 6, 6 }, line.center), 4.0f, expect);
+        Vector<SDL_Vertex> out = mesh.vertices, scalar = mesh.vertices;
+        transformAnimFrameMesh(mesh, x.mesh(), out.data());
+        transformAnimFrameMeshScalar(mesh, x.mesh(), scalar.data());
+        for (int k = 0; k < 4; ++k) {
+            RequireNear(out[k].position, expect[k]);
+            RequireNear(scalar[k].position, expect[k]);
+        }
+        // Still 4px across on screen
+        const float w = std::hypot(out[0].position.x - out[3].position.x, out[0].position.y - out[3].position.y);
+        REQUIRE(w == Catch::Approx(4.0f).margin(1e-3));
+    }
+
+    // A scale that collapses the segment leaves it with no width rather than NaNs
+    OldXform flat;
+    flat.tScl = { 1, 1 };
+    flat.worldScale = { 0, 0 };
+    Vector<SDL_Vertex> out = mesh.vertices;
+    transformAnimFrameMesh(mesh, flat.mesh(), out.data());
+    for (int k = 0; k < 4; ++k) {
+        REQUIRE(out[k].position.x == 0.0f);
+        REQUIRE(out[k].position.y == 0.0f);
+    }
+}
+
+TEST_CASE("AnimMesh: rect outlines and filled rects", "[anim_mesh]")
+{
+    const AnimPrimitive prims[2] = {
+        Prim(AnimPrimitiveType::RectFilled, { -1, -1 }, { 2, 3 }, { 0, 0 }, 1.0f),
+        Prim(AnimPrimitiveType::Rect, { 0, 0 }, { 8, 6 }, { 4, 3 }, 0.0f),
+    };
+    AnimFrameMesh mesh;
+    bakeAnimFrameMesh(prims, 2, mesh);
+    REQUIRE(mesh.primCount == 2);
+    REQUIRE(mesh.shapedCount() == 16);
+    REQUIRE(mesh.rigidCount() == 4);
+    REQUIRE(mesh.vertices.size() == 20);
+    REQUIRE(mesh.indices.size() == 30);
+    // Draw order is kept: the filled rect's triangles come first and use the rigid range
+    REQUIRE(mesh.indices[0] == 16);
+    REQUIRE(mesh.indices[6] == 0);
+
+    OldXform x;
+    x.tScl = { 1, 1 };
+    x.tRot = 90.0f;
+    x.worldPos = { 10, 20 };
+    x.worldScale = { 1, 1 };
+
+    Vector<SDL_Vertex> out = mesh.vertices;
+    transformAnimFrameMesh(mesh, x.mesh(), out.data());
+
+    // Filled rects are only translated, as drawFilledRect was
+    RequireNear(out[16].position, { 9, 19 });
+    RequireNear(out[18].position, { 11, 22 });
+
+    // Outline edge b->c with the 1px default thickness
+    Vector2 expect[4];
+    ThickLine(x.corner({ 8, 0 }, { 4, 3 }), x.corner({ 8, 6 }, { 4, 3 }), 1.0f, expect);
+    for (int k = 0; k < 4; ++k) RequireNear(out[4 + k].position, expect[k]);
+}
+
+TEST_CASE("AnimMesh: SIMD transform matches scalar", "[anim_mesh]")
+{
+    Vector<AnimPrimitive> prims;
+    for (int i = 0; i < 13; ++i) {
+        prims.push_back(Prim((AnimPrimitiveType)(i % 3), { (float)i, (float)(i * 2) }, { 5.0f + i, 3.0f - i }, { (float)i * 0.5f, 1.0f }, 1.0f + (float)(i % 4)));
+    }
+    AnimFrameMesh mesh;
+    bakeAnimFrameMesh(prims.data(), prims.size(), mesh);
+
+    const AnimMeshXform x = makeAnimMeshXform({ 3, 4 }, { 1.25f, 0.75f }, 12.0f, { 320, 200 }, { 2.0f, -1.0f }, 33.0f);
+    Vector<SDL_Vertex> simd = mesh.vertices, scalar = mesh.vertices;
+    transformAnimFrameMesh(mesh, x, simd.data());
+    transformAnimFrameMeshScalar(mesh, x, scalar.data());
+    for (std::size_t i = 0; i < simd.size(); ++i) {
+        REQUIRE(simd[i].position.x == Catch::Approx(scalar[i].position.x).margin(1e-3));
+        REQUIRE(simd[i].position.y == Catch::Approx(scalar[i].position.y).margin(1e-3));
+    }
+}
+
+TEST_CASE("AnimMesh: frame transform throughput", "[.][benchmark]")
+{
+    Vector<AnimPrimitive> prims;
+    for (int i = 0; i < 64; ++i) {
+        prims.push_back(Prim((AnimPrimitiveType)(i % 2), { (float)i, 0.0f }, { 6.0f, 4.0f }, { 3.0f, 2.0f }, 2.0f));
+    }
+    AnimFrameMesh mesh;
+    bakeAnimFrameMesh(prims.data(), prims.size(), mesh);
+    Vector<SDL_Vertex> out = mesh.vertices;
+
+    OldXform x;
+    x.tPos = { 1, 2 };
+    x.tScl = { 1.1f, 1.1f };
+    x.tRot = 10.0f;
+    x.worldPos = { 300, 200 };
+    x.worldScale = { 2, 2 };
+    x.worldRot = 5.0f;
+
+    BENCHMARK("per-corner path, 64 prims") {
+        float acc = 0.0f;
+        for (const AnimPrimitive& p : prims) {
+            const Vector2 P = p.aabb.getPosition(), S = p.aabb.getSize();
+            const Vector2 c[4] = { P, { P.x + S.x, P.y }, { P.x + S.x, P.y + S.y }, { P.x, P.y + S.y } };
+            const int edges = p.type == AnimPrimitiveType::Line ? 1 : 4;
+            for (int e = 0; e < edges; ++e) {
+                Vector2 q[4];
+                ThickLine(x.corner(c[e], p.center), x.corner(c[(e + 1) % 4], p.center), p.thickness, q);
+                acc += q[0].x + q[2].y;
+            }
+        }
+        return acc;
+    };
+
+    BENCHMARK("baked mesh transform, 64 prims") {
+        out.assign(mesh.vertices.begin(), mesh.vertices.end());
+        transformAnimFrameMesh(mesh, x.mesh(), out.data());
+        return out[0].position.x;
+    };
+}
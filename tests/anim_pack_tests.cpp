@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+#include <cstdio>
+
+using namespace Renderer;
+
+namespace {
+    AnimationBankRef MakeBank(int index, int frames, int primsPerFrame)
+    {
+        AnimationBankRef bank = CreateRef<AnimationBank>();
+        bank->name = "bank_" + std::to_string(index);
+        bank->flags = AnimBankFlags::Repeat;
+        bank->currentFrame = (Uint32)(frames - 1);
+        bank->currentTime = 0.25f;
+        for (int f = 0; f < frames; ++f) {
+            AnimationFrameRef frame = CreateRef<AnimationFrame>();
+            frame->name = (f % 2) ? "walk" : "idle"; // shared names land in the string table once
+            frame->duration = 0.1f * (float)(f + 1);
+            frame->positionStart = { (float)f, 2.0f };
+            frame->positionEnd = { 3.0f, (float)index };
+            frame->rotationStartEnd = { 0.0f, 90.0f };
+            frame->scaleStart = { 1.0f, 1.0f };
+            frame->scaleEnd = { 2.0f, 0.5f };
+            frame->flags = AnimFrameFlags::Move | AnimFrameFlags::Rotate;
+            for (int p = 0; p < primsPerFrame; ++p) {
+                AnimPrimitiveRef prim = CreateRef<AnimPrimitive>();
+                prim->type = (AnimPrimitiveType)(p % 3);
+                prim->aabb = AABB({ (float)p, (float)f }, { 4.0f, 8.0f });
+                prim->center = { (float)p + 2.0f, (float)f + 4.0f };
+                prim->color = Color{ (uint8_t)p, (uint8_t)f, (uint8_t)index, 200 };
+                prim->thickness = 1.5f;
+                prim->layer = p - 1;
+                frame->primitives.push_back(prim);
+            }
+            bank->frames.push_back(frame);
+        }
+        return bank;
+    }
+
+    bool SameBank(const AnimationBank& a, const AnimationBank& b)
+    {
+        if (a.name != b.name || a.flags != b.flags || a.currentFrame != b.currentFrame
+            || a.currentTime != b.currentTime || a.frames.size() != b.frames.size()) return false;
+        for (size_t f = 0; f < a.frames.size(); ++f) {
+            const AnimationFrame& fa = *a.frames[f];
+            const AnimationFrame& fb = *b.frames[f];
+            if (fa.name != fb.name || fa.duration != fb.duration || fa.flags != fb.flags
+                || fa.positionStart != fb.positionStart || fa.positionEnd != fb.positionEnd
+                || fa.rotationStartEnd != fb.rotationStartEnd || fa.scaleStart != fb.scaleStart
+                || fa.scaleEnd != fb.scaleEnd || fa.primitives.size() != fb.primitives.size()) return false;
+            for (size_t p = 0; p < fa.primitives.size(); ++p) {
+                const AnimPrimitive& pa = *fa.primitives[p];
+                const AnimPrimitive& pb = *fb.primitives[p];
+                if (pa.type != pb.type || pa.aabb.position != pb.aabb.position || pa.aabb.size != pb.aabb.size
+                    || pa.center != pb.center || pa.color.r != pb.color.r || pa.color.a != pb.color.a
+                    || pa.thickness != pb.thickness || pa.layer != pb.layer) return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("AnimPack: banks round trip through a pack", "[animpack]") {
+    Vector<AnimationBankRef> banks;
+    for (int i = 0; i < 5; ++i) banks.push_back(MakeBank(i, 1 + i, 3 + i));
+    banks.push_back(CreateRef<AnimationBank>()); // empty bank
+
+    Util::BinStream w;
+    Util::WriteAnimPack(w, banks);
+    REQUIRE(w.size() % 4 == 0);
+
+    Util::BinView r{ std::span<const Util::Byte>(w.buffer()) };
+    Vector<AnimationBankRef> loaded;
+    REQUIRE(Util::ReadAnimPack(r, loaded));
+    REQUIRE(r.eof());
+    REQUIRE(loaded.size() == banks.size());
+    for (size_t i = 0; i < banks.size(); ++i) {
+        INFO("bank " << i);
+        REQUIRE(SameBank(*banks[i], *loaded[i]));
+    }
+
+    // A bank's frames are one array and its primitives another
+    const AnimationBank& b = *loaded[4];
+    REQUIRE(b.frames[1].get() == b.frames[0].get() + 1);
+    const AnimationFrame& last = *b.frames.back();
+    REQUIRE(last.primitives.back().get() == last.primitives.front().get() + (last.primitives.size() - 1));
+    REQUIRE(loaded[4].use_count() == 1);
+
+    // Copies of the frames keep their storage alive once the bank is gone
+    VectorRef<AnimationFrame> frames = b.frames;
+    const AnimationBank copy = b;
+    loaded.clear();
+    REQUIRE(frames.size() == 5);
+    REQUIRE(frames.back()->primitives.size() == 7);
+    REQUIRE(SameBank(*banks[4], copy));
+    frames.clear();
+    REQUIRE(copy.frames.back()->primitives.back()->layer == banks[4]->frames.back()->primitives.back()->layer);
+}
+
+TEST_CASE("AnimPack: malformed packs are rejected without output", "[animpack]") {
+    Util::BinStream w;
+    Util::WriteAnimPack(w, { MakeBank(1, 3, 4), MakeBank(2, 2, 2) });
+    const Vector<Util::Byte> good = w.buffer();
+
+    for (size_t cut : { (size_t)0, (size_t)16, (size_t)40, good.size() - 1 }) {
+        Util::BinView r{ std::span<const Util::Byte>(good.data(), cut) };
+        Vector<AnimationBankRef> out;
+        REQUIRE_FALSE(Util::ReadAnimPack(r, out));
+        REQUIRE(out.empty());
+        REQUIRE(r.tell() == 0);
+    }
+
+    // Bank frame range past the end of the frame table
+    Vector<Util::Byte> bad = good;
+    Util::AnimPackBank rec{};
+    std::memcpy(&rec, bad.data() + sizeof(Util::AnimPackHeader), sizeof(rec));
+    rec.frameCount = 1000;
+    std::memcpy(bad.data() + sizeof(Util::AnimPackHeader), &rec, sizeof(rec));
+    Util::BinView r{ std::span<const Util::Byte>(bad) };
+    Vector<AnimationBankRef> out;
+    REQUIRE_FALSE(Util::ReadAnimPack(r, out));
+    REQUIRE(out.empty());
+}
+
+TEST_CASE("AnimPack: mapped file and misaligned views", "[animpack]") {
+    Vector<AnimationBankRef> banks;
+    for (int i = 0; i < 3; ++i) banks.push_back(MakeBank(i, 4, 5));
+    Util::BinStream w;
+    Util::WriteAnimPack(w, banks);
+
+    const char* path = "aq_anim_pack_test.aqp";
+    REQUIRE(w.saveFile(path));
+    Vector<AnimationBankRef> loaded;
+    REQUIRE(Util::LoadAnimPack(path, loaded));
+    std::remove(path);
+    REQUIRE(loaded.size() == 3);
+    REQUIRE(SameBank(*banks[2], *loaded[2]));
+
+    // One byte in front makes the records misaligned; the reader copies instead
+    Vector<Util::Byte> shifted(1, 0);
+    shifted.insert(shifted.end(), w.buffer().begin(), w.buffer().end());
+    Util::BinView r{ std::span<const Util::Byte>(shifted) };
+    REQUIRE(r.skip(1));
+    Vector<AnimationBankRef> copied;
+    REQUIRE(Util::ReadAnimPack(r, copied));
+    REQUIRE(SameBank(*banks[1], *copied[1]));
+}
+
+TEST_CASE("AnimPack: load 300 banks", "[.][benchmark][animpack]") {
+    constexpr int kBanks = 300;
+    Vector<AnimationBankRef> banks;
+    for (int i = 0; i < kBanks; ++i) banks.push_back(MakeBank(i, 8, 12));
+
+    Util::BinStream pack;
+    Util::WriteAnimPack(pack, banks);
+    WARN("pack: " << kBanks << " banks, " << pack.size() << " bytes");
+
+    BENCHMARK("ReadAnimPack (frame and primitive arrays per bank)") {
+        Util::BinView r{ std::span<const Util::Byte>(pack.buffer()) };
+        Vector<AnimationBankRef> out;
+        out.reserve(kBanks);
+        Util::ReadAnimPack(r, out);
+        return out.size();
+    };
+    BENCHMARK("WriteAnimPack") {
+        Util::BinStream w;
+        Util::WriteAnimPack(w, banks);
+        return w.size();
+    };
+}
@@ -0,0 +1,191 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+using namespace Renderer;
+
+namespace {
+    AnimClipId MakeClip(const String& name, bool repeat, float duration)
+    {
+        AnimationBank bank;
+        bank.name = name;
+        bank.flags = repeat ? AnimBankFlags::Repeat : AnimBankFlags::None;
+        AnimationFrameRef frame = CreateRef<AnimationFrame>();
+        frame->duration = duration;
+        bank.frames.push_back(frame);
+        return registerAnimationClip(createAnimationClip(bank));
+    }
+
+    // idle <-> walk on speed, attack on a trigger from any state, back to idle at clip end
+    AnimGraphId MakeGraph()
+    {
+        AnimGraphDesc d;
+        d.name = "hero";
+        d.params = { { "speed", AnimParamType::Float, 0.0f }, { "attack", AnimParamType::Trigger, 0.0f } };
+        d.states = {
+            { "idle", MakeClip("idle", true, 1.0f) },
+            { "walk", MakeClip("walk", true, 0.5f), 2.0f },
+            { "attack", MakeClip("attack", false, 0.6f) },
+        };
+        d.transitions = {
+            { "idle", "walk", 0.2f, false, { { "speed", AnimCondOp::Greater, 0.1f } } },
+            { "walk", "idle", 0.2f, false, { { "speed", AnimCondOp::Less, 0.1f } } },
+            { "attack", "idle", 0.1f, true, {} },
+            { "", "attack", 0.0f, false, { { "attack", AnimCondOp::Triggered } } },
+        };
+        return createAnimGraph(d);
+    }
+
+    void Step(float dt)
+    {
+        updateAnimationControllers(dt);
+        updateAnimations(dt);
+    }
+}
+
+TEST_CASE("AnimationController: graphs resolve names and reject bad descriptions", "[anim_controller]")
+{
+    shutdownAnimationControllers();
+    shutdownAnimations();
+    const AnimGraphId g = MakeGraph();
+    REQUIRE(g != kInvalidAnimGraph);
+    REQUIRE(findAnimGraphState(g, "walk") == 1);
+    REQUIRE(findAnimGraphParam(g, "attack") == 1);
+    REQUIRE(findAnimGraphParam(g, "jump") == -1);
+
+    AnimGraphDesc bad;
+    bad.name = "bad";
+    bad.states = { { "idle", findAnimationClip("idle") } };
+    bad.transitions = { { "idle", "run", 0.1f, false, {} } };
+    REQUIRE(createAnimGraph(bad) == kInvalidAnimGraph);
+    bad.transitions = { { "idle", "idle", 0.1f, false, { { "nope", AnimCondOp::IsTrue } } } };
+    REQUIRE(createAnimGraph(bad) == kInvalidAnimGraph);
+    bad.states = { { "idle", kInvalidAnimClip } };
+    bad.transitions.clear();
+    REQUIRE(createAnimGraph(bad) == kInvalidAnimGraph);
+}
+
+TEST_CASE("AnimationController: parameter transitions cross-fade between playheads", "[anim_controller]")
+{
+    shutdownAnimationControllers();
+    shutdownAnimations();
+    const AnimGraphId g = MakeGraph();
+    const int speed = findAnimGraphParam(g, "speed");
+    AnimControllerHandle h = createAnimationController(g);
+    REQUIRE(h);
+    REQUIRE(getAnimState(h) == 0);
+    REQUIRE(getPlayheadCount() == 1);
+
+    Step(0.1f);
+    REQUIRE(getAnimState(h) == 0);
+
+    REQUIRE(setAnimFloat(h, speed, 1.0f));
+    Step(0.1f);
+    REQUIRE(getAnimState(h) == 1);
+    AnimControllerPose pose;
+    REQUIRE(getAnimControllerPose(h, pose));
+    REQUIRE(pose.previous);
+    REQUIRE(pose.blend == 0.0f);
+    REQUIRE(getPlayheadCount() == 2);
+
+    PlayheadState st;
+    REQUIRE(getPlayhead(pose.current, st));
+    REQUIRE(st.clip == findAnimationClip("walk"));
+    REQUIRE(st.speed == 2.0f);
+
+    Step(0.1f);
+    REQUIRE(getAnimControllerPose(h, pose));
+    REQUIRE(pose.blend > 0.4f);
+    REQUIRE(pose.blend < 0.6f);
+
+    Step(0.15f);
+    REQUIRE(getAnimControllerPose(h, pose));
+    REQUIRE_FALSE(pose.previous);
+    REQUIRE(pose.blend == 1.0f);
+    REQUIRE(getPlayheadCount() == 1);
+}
+
+TEST_CASE("AnimationController: triggers fire once and clip end returns to idle", "[anim_controller]")
+{
+    shutdownAnimationControllers();
+    shutdownAnimations();
+    const AnimGraphId g = MakeGraph();
+    const int attack = findAnimGraphParam(g, "attack");
+    AnimControllerHandle h = createAnimationController(g);
+    REQUIRE_FALSE(setAnimBool(h, 99, true));
+    REQUIRE_FALSE(setAnimTrigger(h, findAnimGraphParam(g, "speed")));
+
+    REQUIRE(setAnimTrigger(h, attack));
+    REQUIRE(getAnimParam(h, attack) == 1.0f);
+    Step(0.1f);
+    REQUIRE(getAnimState(h) == 2);
+    REQUIRE(getAnimParam(h, attack) == 0.0f);
+
+    // Zero fade is a cut: one playhead, switched in place
+    AnimControllerPose pose;
+    REQUIRE(getAnimControllerPose(h, pose));
+    REQUIRE_FALSE(pose.previous);
+
+    Step(0.3f);
+    REQUIRE(getAnimState(h) == 2);
+    Step(0.35f);
+    REQUIRE(getAnimState(h) == 0);
+
+    // Any-state transitions never restart the current state, and a trigger
+    // nobody consumes is gone after one update
+    REQUIRE(setAnimTrigger(h, attack));
+    updateAnimationControllers(0.0f);
+    REQUIRE(getAnimState(h) == 2);
+    REQUIRE(setAnimTrigger(h, attack));
+    updateAnimationControllers(0.0f);
+    REQUIRE(getAnimParam(h, attack) == 0.0f);
+    REQUIRE(playAnimState(h, 0));
+    Step(0.1f);
+    REQUIRE(getAnimState(h) == 0);
+}
+
+TEST_CASE("AnimationController: pooled controllers release their playheads", "[anim_controller]")
+{
+    shutdownAnimationControllers();
+    shutdownAnimations();
+    const AnimGraphId g = MakeGraph();
+    AnimControllerHandle a = createAnimationController(g);
+    AnimControllerHandle b = createAnimationController(g);
+    REQUIRE(getAnimationControllerCount() == 2);
+    REQUIRE(playAnimState(b, 1, 0.5f));
+    REQUIRE(getPlayheadCount() == 3);
+
+    REQUIRE(destroyAnimationController(b));
+    REQUIRE_FALSE(destroyAnimationController(b));
+    REQUIRE(getAnimState(b) == -1);
+    REQUIRE(getPlayheadCount() == 1);
+
+    clearAnimationControllers();
+    REQUIRE(getAnimationControllerCount() == 0);
+    REQUIRE(getPlayheadCount() == 0);
+    REQUIRE(getAnimState(a) == -1);
+}
+
+TEST_CASE("AnimationController: batch update throughput", "[.][benchmark]")
+{
+    shutdownAnimationControllers();
+    shutdownAnimations();
+    const AnimGraphId g = MakeGraph();
+    const int speed = findAnimGraphParam(g, "speed");
+    const int attack = findAnimGraphParam(g, "attack");
+    Vector<AnimControllerHandle> actors;
+    for (int i = 0; i < 5000; ++i) actors.push_back(createAnimationController(g));
+
+    int frame = 0;
+    BENCHMARK("5k controllers, params changing every frame") {
+        ++frame;
+        for (std::size_t i = 0; i < actors.size(); ++i) {
+            setAnimFloat(actors[i], speed, ((i + frame) % 64) < 32 ? 1.0f : 0.0f);
+            if (((i + frame) % 97) == 0) setAnimTrigger(actors[i], attack);
+        }
+        Step(1.0f / 60.0f);
+        return getPlayheadCount();
+    };
+    shutdownAnimationControllers();
+    shutdownAnimations();
+}
@@ -0,0 +1,175 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+using namespace Renderer;
+
+namespace {
+    AnimationBankRef MakeBank(const String& name, bool repeat, int frames, float duration)
+    {
+        AnimationBankRef bank = CreateRef<AnimationBank>();
+        bank->name = name;
+        bank->flags = repeat ? AnimBankFlags::Repeat : AnimBankFlags::None;
+        for (int f = 0; f < frames; ++f) {
+            AnimationFrameRef frame = CreateRef<AnimationFrame>();
+            frame->duration = duration;
+            frame->flags = AnimFrameFlags::Move;
+            frame->positionEnd = { (float)f, 1.0f };
+            for (int p = 0; p <= f; ++p) {
+                AnimPrimitiveRef prim = CreateRef<AnimPrimitive>();
+                prim->type = AnimPrimitiveType::Rect;
+                prim->layer = f * 10 + p;
+                frame->primitives.push_back(prim);
+            }
+            bank->frames.push_back(frame);
+        }
+        return bank;
+    }
+
+    int CountEvents(AnimEventType type, PlayheadHandle h = PlayheadHandle{})
+    {
+        int n = 0;
+        for (const AnimEvent& e : getAnimationEvents()) {
+            if (e.type == type && (!h || e.playhead == h)) ++n;
+        }
+        return n;
+    }
+}
+
+TEST_CASE("AnimationRuntime: clips flatten frames into one primitive array", "[anim_runtime]")
+{
+    shutdownAnimations();
+    AnimClipRef clip = createAnimationClip(*MakeBank("walk", true, 3, 0.5f));
+    REQUIRE(clip->frames.size() == 3);
+    REQUIRE(clip->primitives.size() == 6);
+    REQUIRE(clip->loop);
+    REQUIRE(clip->duration == 1.5f);
+    REQUIRE(clip->frames[2].firstPrim == 3);
+    REQUIRE(clip->frames[2].primCount == 3);
+    REQUIRE(clip->primitives[clip->frames[2].firstPrim].layer == 20);
+
+    const AnimClipId id = registerAnimationClip(clip);
+    REQUIRE(findAnimationClip("walk") == id);
+    REQUIRE(getAnimationClip(id) == clip.get());
+    REQUIRE(findAnimationClip("run") == kInvalidAnimClip);
+}
+
+TEST_CASE("AnimationRuntime: looping playheads wrap and report events", "[anim_runtime]")
+{
+    shutdownAnimations();
+    const AnimClipId id = registerAnimationClip(createAnimationClip(*MakeBank("idle", true, 2, 1.0f)));
+    PlayheadHandle a = createPlayhead(id);
+    PlayheadHandle b = createPlayhead(id, 2.0f);
+    REQUIRE(getPlayheadCount() == 2);
+
+    updateAnimations(0.5f);
+    REQUIRE(CountEvents(AnimEventType::Started) == 2);
+    PlayheadState st;
+    REQUIRE(getPlayhead(a, st));
+    REQUIRE(st.frame == 0);
+    REQUIRE(st.time == 0.5f);
+    REQUIRE(getPlayhead(b, st));
+    REQUIRE(st.frame == 1);
+    REQUIRE(st.time == 0.0f);
+
+    updateAnimations(0.75f);
+    REQUIRE(getAnimationEvents().empty() == false);
+    REQUIRE(CountEvents(AnimEventType::Started) == 0);
+    REQUIRE(CountEvents(AnimEventType::Looped, b) == 1);
+    REQUIRE(getPlayhead(b, st));
+    REQUIRE(st.frame == 0);
+    REQUIRE(st.time == 0.5f);
+
+    // A long hitch skips whole cycles but only reports one loop
+    updateAnimations(100.25f);
+    REQUIRE(CountEvents(AnimEventType::Looped, a) == 1);
+    REQUIRE(getPlayhead(a, st));
+    REQUIRE(HasPlayheadFlag(st.flags, PlayheadFlags::Playing));
+}
+
+TEST_CASE("AnimationRuntime: one-shot playheads clamp on the last frame", "[anim_runtime]")
+{
+    shutdownAnimations();
+    const AnimClipId id = registerAnimationClip(createAnimationClip(*MakeBank("attack", false, 3, 0.25f)));
+    PlayheadHandle h = createPlayhead(id);
+
+    updateAnimations(1.0f);
+    REQUIRE(CountEvents(AnimEventType::Started, h) == 1);
+    REQUIRE(CountEvents(AnimEventType::Ended, h) == 1);
+    PlayheadState st;
+    REQUIRE(getPlayhead(h, st));
+    REQUIRE(st.frame == 2);
+    REQUIRE(st.time == 0.25f);
+    REQUIRE(HasPlayheadFlag(st.flags, PlayheadFlags::Finished));
+    REQUIRE_FALSE(setPlayheadPlaying(h, true));
+
+    updateAnimations(1.0f);
+    REQUIRE(getAnimationEvents().empty());
+
+    REQUIRE(restartPlayhead(h));
+    updateAnimations(0.1f);
+    REQUIRE(CountEvents(AnimEventType::Started, h) == 1);
+    REQUIRE(getPlayhead(h, st));
+    REQUIRE(st.frame == 0);
+}
+
+TEST_CASE("AnimationRuntime: handles survive swap-remove and go stale on destroy", "[anim_runtime]")
+{
+    shutdownAnimations();
+    const AnimClipId slow = registerAnimationClip(createAnimationClip(*MakeBank("slow", true, 1, 10.0f)));
+    const AnimClipId fast = registerAnimationClip(createAnimationClip(*MakeBank("fast", false, 1, 1.0f)));
+
+    PlayheadHandle a = createPlayhead(slow);
+    PlayheadHandle b = createPlayhead(slow);
+    PlayheadHandle c = createPlayhead(fast);
+    REQUIRE(setPlayheadSpeed(c, 0.5f));
+
+    REQUIRE(destroyPlayhead(a));
+    REQUIRE_FALSE(destroyPlayhead(a));
+    PlayheadState st;
+    REQUIRE_FALSE(getPlayhead(a, st));
+    REQUIRE(getPlayheadCount() == 2);
+
+    // c moved into a's dense row; its state came along
+    REQUIRE(getPlayhead(c, st));
+    REQUIRE(st.clip == fast);
+    REQUIRE(st.speed == 0.5f);
+
+    PlayheadHandle d = createPlayhead(fast);
+    REQUIRE(d.index() == a.index());
+    REQUIRE_FALSE(d == a);
+
+    REQUIRE(setPlayheadPlaying(b, false));
+    REQUIRE(setPlayheadClip(c, slow));
+    updateAnimations(2.0f);
+    REQUIRE(getPlayhead(b, st));
+    REQUIRE(st.time == 0.0f);
+    REQUIRE(getPlayhead(c, st));
+    REQUIRE(st.time == 1.0f);
+    REQUIRE(CountEvents(AnimEventType::Ended, d) == 1);
+
+    clearPlayheads();
+    REQUIRE(getPlayheadCount() == 0);
+    REQUIRE_FALSE(getPlayhead(b, st));
+    REQUIRE(getAnimationClip(slow) != nullptr);
+}
+
+TEST_CASE("AnimationRuntime: update throughput", "[.][benchmark]")
+{
+    shutdownAnimations();
+    Vector<AnimClipId> clips;
+    for (int i = 0; i < 16; ++i) {
+        clips.push_back(registerAnimationClip(createAnimationClip(
+            *MakeBank("clip_" + std::to_string(i), (i % 4) != 0, 4 + (i % 5), 0.1f + 0.01f * (float)i))));
+    }
+    for (int i = 0; i < 10000; ++i) {
+        PlayheadHandle h = createPlayhead(clips[i % clips.size()], 0.5f + 0.0001f * (float)i);
+        if ((i % 4) == 0) setPlayheadLooping(h, true);
+    }
+
+    BENCHMARK("updateAnimations 10k playheads") {
+        updateAnimations(1.0f / 60.0f);
+        return getAnimationEvents().size();
+    };
+    shutdownAnimations();
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Common.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+TEST_CASE("Cow: snapshots are unaffected by later edits", "[cow]") {
+    Cow<Vector<int>> grid(Vector<int>{ 1, 2, 3 });
+    REQUIRE_FALSE(grid.isShared());
+
+    grid.edit()[0] = 10; // unshared: edits in place
+    const Vector<int>* before = &grid.get();
+    grid.edit()[1] = 20;
+    REQUIRE(&grid.get() == before);
+
+    Ref<const Vector<int>> snap = grid.share();
+    REQUIRE(grid.isShared());
+    REQUIRE(snap.get() == &grid.get()); // sharing copies nothing
+
+    grid.edit()[2] = 30; // shared: clones first
+    REQUIRE(snap->at(2) == 3);
+    REQUIRE(grid->at(2) == 30);
+    REQUIRE(grid->at(0) == 10);
+    REQUIRE_FALSE(grid.isShared());
+}
+
+TEST_CASE("AsyncSave: writes atomically and reports progress on update", "[asyncsave]") {
+    const String path = "aq_async_save_test.bin";
+    std::remove(path.c_str());
+    {
+        Util::BinStream old;
+        old.writeU32(1);
+        REQUIRE(old.saveFile(path.c_str()));
+    }
+
+    Ref<const Vector<int>> snapshot = std::make_shared<const Vector<int>>(200000, 7);
+    Vector<float> progress;
+    int completions = 0;
+    bool result = false;
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::thread::id serializeThread;
+
+    const AsyncSave::JobId job = AsyncSave::submit(path,
+        [snapshot, &serializeThread](Util::BinStream& out, const std::function<void(float)>& report) {
+            serializeThread = std::this_thread::get_id();
+            out.writeU32((std::uint32_t)snapshot->size());
+            out.writeArray<int>(*snapshot);
+            report(1.0f);
+            return true;
+        },
+        [&](AsyncSave::JobId, float f) { REQUIRE(std::this_thread::get_id() == mainThread); progress.push_back(f); },
+        [&](AsyncSave::JobId id, bool ok) { REQUIRE(id != 0); ++completions; result = ok; });
+    REQUIRE(job != 0);
+    REQUIRE(AsyncSave::isBusy());
+    REQUIRE(completions == 0); // nothing is delivered outside update()/flush()
+
+    AsyncSave::flush();
+    REQUIRE(completions == 1);
+    REQUIRE(result);
+    REQUIRE_FALSE(AsyncSave::isBusy());
+    REQUIRE(serializeThread != mainThread);
+    REQUIRE_FALSE(progress.empty());
+    REQUIRE(progress.back() == 1.0f);
+    for (size_t i = 1; i < progress.size(); ++i) REQUIRE(progress[i] >= progress[i - 1]);
+    REQUIRE_FALSE(std::filesystem::exists(path + ".tmp"));
+
+    Util::BinStream in;
+    REQUIRE(in.loadFile(path.c_str()));
+    std::uint32_t count = 0;
+    REQUIRE(in.readU32(count));
+    REQUIRE(count == 200000);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("AsyncSave: failed serialisation keeps the previous file", "[asyncsave]") {
+    const String path = "aq_async_save_fail.bin";
+    Util::BinStream old;
+    old.writeU32(0xABCD);
+    REQUIRE(old.saveFile(path.c_str()));
+
+    bool result = true;
+    AsyncSave::submit(path,
+        [](Util::BinStream& out, const std::function<void(float)>&) { out.writeU32(1); return false; },
+        {}, [&](AsyncSave::JobId, bool ok) { result = ok; });
+    // A detached job still runs but calls nothing back
+    bool detachedCalled = false;
+    const AsyncSave::JobId detached = AsyncSave::submit(path + ".other",
+        [](Util::BinStream& out, const std::function<void(float)>&) { out.writeU32(2); return true; },
+        {}, [&](AsyncSave::JobId, bool) { detachedCalled = true; });
+    AsyncSave::detach(detached);
+    AsyncSave::flush();
+    REQUIRE_FALSE(result);
+    REQUIRE_FALSE(detachedCalled);
+    REQUIRE(std::filesystem::exists(path + ".other"));
+
+    Util::BinStream in;
+    REQUIRE(in.loadFile(path.c_str()));
+    std::uint32_t v = 0;
+    REQUIRE(in.readU32(v));
+    REQUIRE(v == 0xABCD);
+    std::remove(path.c_str());
+    std::remove((path + ".other").c_str());
+    AsyncSave::shutdown();
+}
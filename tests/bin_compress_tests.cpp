@@ -0,0 +1,210 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+#include <chrono>
+
+namespace {
+    // Deterministic terrain-like tile grid: large same-cell regions from coarse
+    // value noise with a sprinkle of single-tile detail, like the world maps.
+    Vector<std::int32_t> MakeTerrain(int w, int h)
+    {
+        Vector<std::int32_t> tiles((size_t)w * h);
+        std::uint32_t seed = 0x9E3779B9u;
+        auto next = [&seed]() { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; return seed; };
+        constexpr int kCell = 16;
+        const int cw = w / kCell + 2, ch = h / kCell + 2;
+        Vector<float> coarse((size_t)cw * ch);
+        for (float& v : coarse) v = (float)(next() & 0xFFFF) / 65535.0f;
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                const int cx = x / kCell, cy = y / kCell;
+                const float fx = (float)(x % kCell) / kCell, fy = (float)(y % kCell) / kCell;
+                const float a = coarse[(size_t)cy * cw + cx], b = coarse[(size_t)cy * cw + cx + 1];
+                const float c = coarse[(size_t)(cy + 1) * cw + cx], d = coarse[(size_t)(cy + 1) * cw + cx + 1];
+                const float n = (a * (1 - fx) + b * fx) * (1 - fy) + (c * (1 - fx) + d * fx) * fy;
+                std::int32_t tile = n < 0.35f ? 0 : n < 0.45f ? 1 : n < 0.7f ? 2 : 3; // water, sand, grass, forest
+                if ((next() & 63) == 0) tile = 4; // scattered rocks
+                tiles[(size_t)y * w + x] = tile;
+            }
+        }
+        return tiles;
+    }
+
+    std::span<const Util::Byte> AsBytes(const Vector<std::int32_t>& v)
+    {
+        return { reinterpret_cast<const Util::Byte*>(v.data()), v.size() * sizeof(std::int32_t) };
+    }
+}
+
+TEST_CASE("Compress: LZ round trip", "[binaryio][compress]") {
+    Vector<Util::Byte> text;
+    for (int i = 0; i < 4000; ++i) {
+        const char* word = (i % 7 == 0) ? "avatar " : (i % 3 == 0) ? "quest " : "britannia ";
+        text.insert(text.end(), word, word + std::strlen(word));
+    }
+    for (size_t size : { (size_t)0, (size_t)1, (size_t)12, (size_t)100, text.size() }) {
+        const std::span<const Util::Byte> in(text.data(), size);
+        Vector<Util::Byte> packed;
+        Util::Compress::lzCompress(in, packed);
+        Vector<Util::Byte> out(size);
+        REQUIRE(Util::Compress::lzDecompress(packed, out));
+        REQUIRE(std::equal(out.begin(), out.end(), in.begin()));
+    }
+
+    Vector<Util::Byte> packed;
+    Util::Compress::lzCompress(text, packed);
+    REQUIRE(packed.size() < text.size() / 4);
+
+    // Incompressible input grows only by the literal-run overhead
+    Vector<Util::Byte> noise(5000);
+    std::uint32_t s = 1;
+    for (auto& b : noise) { s = s * 1664525u + 1013904223u; b = (Util::Byte)(s >> 24); }
+    packed.clear();
+    Util::Compress::lzCompress(noise, packed);
+    REQUIRE(packed.size() <= noise.size() + noise.size() / 255 + 16);
+    Vector<Util::Byte> out(noise.size());
+    REQUIRE(Util::Compress::lzDecompress(packed, out));
+    REQUIRE(out == noise);
+}
+
+TEST_CASE("Compress: element RLE round trip", "[binaryio][compress]") {
+    Vector<std::int32_t> cells;
+    for (int i = 0; i < 300; ++i) cells.push_back(7);     // run longer than one control byte
+    for (int i = 0; i < 200; ++i) cells.push_back(i);     // literals longer than one control byte
+    cells.push_back(-1);
+    cells.push_back(-1);
+    const auto in = AsBytes(cells);
+
+    Vector<Util::Byte> rle;
+    Util::Compress::rleEncode(in, sizeof(std::int32_t), rle);
+    Vector<Util::Byte> out;
+    REQUIRE(Util::Compress::rleDecode(rle, sizeof(std::int32_t), in.size(), out));
+    REQUIRE(std::equal(out.begin(), out.end(), in.begin(), in.end()));
+
+    // Declared size must match exactly
+    out.clear();
+    REQUIRE_FALSE(Util::Compress::rleDecode(rle, sizeof(std::int32_t), in.size() + 4, out));
+}
+
+TEST_CASE("Compress: sections round trip and fall back to stored", "[binaryio][compress]") {
+    const Vector<std::int32_t> tiles = MakeTerrain(64, 64);
+    Vector<Util::Byte> noise(256);
+    for (size_t i = 0; i < noise.size(); ++i) noise[i] = (Util::Byte)(i * 151 + 17);
+
+    Util::BinStream w;
+    Util::Compress::writeSection(w, AsBytes(tiles), Util::Codec::RleLZ, sizeof(std::int32_t));
+    Util::Compress::writeSection(w, AsBytes(tiles), Util::Codec::LZ, 1);
+    Util::Compress::writeSection(w, noise, Util::Codec::LZ, 1);
+    w.writeU32(0xC0FFEEu);
+    REQUIRE(w.size() < AsBytes(tiles).size());
+
+    Util::BinView r(std::span<const Util::Byte>(w.buffer()));
+    Vector<Util::Byte> out;
+    for (int i = 0; i < 2; ++i) {
+        REQUIRE(Util::Compress::readSection(r, out));
+        REQUIRE(std::equal(out.begin(), out.end(), AsBytes(tiles).begin(), AsBytes(tiles).end()));
+    }
+    const size_t storedAt = r.tell();
+    REQUIRE(Util::Compress::readSection(r, out));
+    REQUIRE(out == noise);
+    REQUIRE(w.buffer()[storedAt + 4] == (Util::Byte)Util::Codec::None);
+    std::uint32_t tail = 0;
+    REQUIRE(r.readU32(tail));
+    REQUIRE(tail == 0xC0FFEEu);
+}
+
+TEST_CASE("Compress: corrupt sections are rejected", "[binaryio][compress]") {
+    const Vector<std::int32_t> tiles = MakeTerrain(32, 32);
+    Util::BinStream w;
+    Util::Compress::writeSection(w, AsBytes(tiles), Util::Codec::RleLZ, sizeof(std::int32_t));
+    const Vector<Util::Byte> good = w.buffer();
+
+    Vector<Util::Byte> out;
+    {   // truncated payload; cursor is left where it was
+        Util::BinView r(std::span<const Util::Byte>(good.data(), good.size() - 3));
+        REQUIRE_FALSE(Util::Compress::readSection(r, out));
+        REQUIRE(r.tell() == 0);
+    }
+    {   // wrong raw size
+        Vector<Util::Byte> bad = good;
+        bad[8] ^= 0x40;
+        Util::BinView r{ std::span<const Util::Byte>(bad) };
+        REQUIRE_FALSE(Util::Compress::readSection(r, out));
+        REQUIRE(out.empty());
+    }
+    {   // garbage payload must fail or decode without overrunning
+        Vector<Util::Byte> bad = good;
+        for (size_t i = Util::Compress::kSectionHeaderSize; i < bad.size(); i += 5) bad[i] = 0xFF;
+        Util::BinView r{ std::span<const Util::Byte>(bad) };
+        if (Util::Compress::readSection(r, out)) REQUIRE(out.size() == AsBytes(tiles).size());
+    }
+    {   // sizes the payload can't expand to fail before anything is allocated
+        for (size_t field : { size_t(12), size_t(8) }) {
+            Vector<Util::Byte> bad = good;
+            bad[field] = bad[field + 1] = bad[field + 2] = bad[field + 3] = 0xF0;
+            Util::BinView r{ std::span<const Util::Byte>(bad) };
+            REQUIRE_FALSE(Util::Compress::readSection(r, out));
+            REQUIRE(r.tell() == 0);
+        }
+        Util::BinStream lz;
+        Util::Compress::writeSection(lz, AsBytes(tiles), Util::Codec::LZ, 1);
+        Vector<Util::Byte> bad = lz.buffer();
+        const std::uint32_t huge = 0xFFFFFFF0u;
+        std::memcpy(&bad[8], &huge, 4);
+        std::memcpy(&bad[12], &huge, 4);
+        Util::BinView r{ std::span<const Util::Byte>(bad) };
+        REQUIRE_FALSE(Util::Compress::readSection(r, out));
+    }
+    {   // bad magic
+        Vector<Util::Byte> bad = good;
+        bad[0] = 0;
+        Util::BinView r{ std::span<const Util::Byte>(bad) };
+        REQUIRE_FALSE(Util::Compress::readSection(r, out));
+    }
+}
+
+TEST_CASE("Compress: sections over the size limit are not written", "[binaryio][compress]") {
+    // Anything readSection would refuse must fail at save time, not at load time
+    const Vector<Util::Byte> huge(Util::Compress::kMaxSectionSize + 1);
+    Util::BinStream w;
+    REQUIRE_FALSE(Util::Compress::writeSection(w, huge, Util::Codec::None, 1));
+    REQUIRE_FALSE(Util::Compress::writeSection(w, huge, Util::Codec::RleLZ, 1));
+    REQUIRE(w.size() == 0);
+
+    const std::span<const Util::Byte> atLimit(huge.data(), Util::Compress::kMaxSectionSize);
+    REQUIRE(Util::Compress::writeSection(w, atLimit, Util::Codec::None, 1));
+    Vector<Util::Byte> out;
+    Util::BinView r{ std::span<const Util::Byte>(w.buffer()) };
+    REQUIRE(Util::Compress::readSection(r, out));
+    REQUIRE(out.size() == Util::Compress::kMaxSectionSize);
+}
+
+TEST_CASE("Compress: 512x512 terrain grid", "[.][benchmark][binaryio][compress]") {
+    const Vector<std::int32_t> tiles = MakeTerrain(512, 512);
+    const auto raw = AsBytes(tiles);
+
+    for (Util::Codec codec : { Util::Codec::None, Util::Codec::LZ, Util::Codec::RleLZ }) {
+        Util::BinStream w;
+        Util::Compress::writeSection(w, raw, codec, sizeof(std::int32_t));
+        Vector<Util::Byte> out;
+        Util::BinView r(std::span<const Util::Byte>(w.buffer()));
+        REQUIRE(Util::Compress::readSection(r, out));
+        REQUIRE(std::equal(out.begin(), out.end(), raw.begin(), raw.end()));
+
+        const char* name = codec == Util::Codec::None ? "none" : codec == Util::Codec::LZ ? "lz" : "rle+lz";
+        WARN(name << ": " << raw.size() << " -> " << w.size() << " bytes (ratio "
+            << (double)raw.size() / (double)w.size() << ")");
+
+        BENCHMARK(std::string(name) + " compress") {
+            Util::BinStream s;
+            Util::Compress::writeSection(s, raw, codec, sizeof(std::int32_t));
+            return s.size();
+        };
+        BENCHMARK(std::string(name) + " decompress") {
+            Util::BinView v(std::span<const Util::Byte>(w.buffer()));
+            Util::Compress::readSection(v, out);
+            return out.size();
+        };
+    }
+}
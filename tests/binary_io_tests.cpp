@@ -0,0 +1,202 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+#include <cstdio>
+
+namespace {
+    Util::BinStream MakeSample()
+    {
+        Util::BinStream w;
+        w.writeU32(0x41565131u);
+        w.writeI16(-7);
+        w.writeF32(1.5f);
+        w.writeStr("avatar");
+        for (std::int32_t i = 0; i < 5; ++i) w.writeI32(i * 10);
+        return w;
+    }
+}
+
+TEST_CASE("BinView: reads what BinStream wrote", "[binaryio]") {
+    const Util::BinStream w = MakeSample();
+    Util::BinView v(std::span<const Util::Byte>(w.buffer()));
+
+    std::uint32_t magic = 0; std::int16_t s = 0; float f = 0.0f;
+    REQUIRE(v.readU32(magic));
+    REQUIRE(magic == 0x41565131u);
+    REQUIRE(v.readI16(s));
+    REQUIRE(s == -7);
+    REQUIRE(v.readF32(f));
+    REQUIRE(f == 1.5f);
+
+    std::string_view name;
+    REQUIRE(v.readStrView(name));
+    REQUIRE(name == "avatar");
+    REQUIRE(name.data() == reinterpret_cast<const char*>(w.buffer().data() + 14)); // no copy
+
+    std::span<const std::int32_t> arr;
+    REQUIRE(v.readSpan(5, arr));
+    REQUIRE(arr.size() == 5);
+    REQUIRE(arr[4] == 40);
+    REQUIRE(v.eof());
+}
+
+TEST_CASE("BinView: bounds and alignment failures leave the cursor", "[binaryio]") {
+    const Util::BinStream w = MakeSample();
+    Util::BinView v(std::span<const Util::Byte>(w.buffer()));
+
+    std::span<const std::int32_t> arr;
+    REQUIRE(v.seek(1));
+    REQUIRE_FALSE(v.readSpan(1, arr)); // misaligned
+    REQUIRE(v.tell() == 1);
+    REQUIRE(v.seek(w.size() - 4));
+    REQUIRE_FALSE(v.readSpan(2, arr)); // past the end
+    REQUIRE(v.tell() == w.size() - 4);
+
+    // A string length running past the end fails without moving
+    Util::BinStream bad;
+    bad.writeU32(100);
+    bad.writeU8('x');
+    Util::BinView bv(std::span<const Util::Byte>(bad.buffer()));
+    std::string_view sv;
+    REQUIRE_FALSE(bv.readStrView(sv));
+    REQUIRE(bv.tell() == 0);
+    REQUIRE_FALSE(bv.seek(bad.size() + 1));
+}
+
+TEST_CASE("BinView: mapped file outlives the view that opened it", "[binaryio]") {
+    const char* path = "binview_test.bin";
+    REQUIRE(MakeSample().saveFile(path));
+
+    Util::BinView section;
+    {
+        Util::BinView file;
+        REQUIRE(file.mapFile(path));
+        REQUIRE(file.size() == MakeSample().size());
+        REQUIRE(file.skip(4 + 2 + 4));
+        REQUIRE(file.readView(4 + 6, section));
+        REQUIRE(section.owner() == file.owner());
+    }
+    std::string name;
+    REQUIRE(section.readStr(name));
+    REQUIRE(name == "avatar");
+    REQUIRE(section.eof());
+
+    Util::BinView missing;
+    REQUIRE_FALSE(missing.mapFile("does_not_exist.bin"));
+    section = {};
+    std::remove(path);
+}
+
+TEST_CASE("BinStream: varints round-trip at the edges", "[binaryio]") {
+    Util::BinStream w;
+    const std::uint64_t u64s[] = { 0, 1, 127, 128, 16383, 16384, 0xFFFFFFFFull, ~0ull };
+    const std::int64_t i64s[] = { 0, -1, 1, -64, 64, INT64_MIN, INT64_MAX };
+    for (auto v : u64s) w.writeVarU64(v);
+    for (auto v : i64s) w.writeVarI64(v);
+    w.writeVarU32(0xFFFFFFFFu);
+    w.writeVarI32(INT32_MIN);
+
+    Util::BinView v(std::span<const Util::Byte>(w.buffer()));
+    for (auto expected : u64s) { std::uint64_t x = 0; REQUIRE(v.readVarU64(x)); REQUIRE(x == expected); }
+    for (auto expected : i64s) { std::int64_t x = 0; REQUIRE(v.readVarI64(x)); REQUIRE(x == expected); }
+    std::uint32_t u = 0; std::int32_t i = 0;
+    REQUIRE(v.readVarU32(u));
+    REQUIRE(u == 0xFFFFFFFFu);
+    REQUIRE(v.readVarI32(i));
+    REQUIRE(i == INT32_MIN);
+    REQUIRE(v.eof());
+
+    // Encoded sizes: 7 bits per byte, zigzag keeps small negatives short
+    Util::BinStream sz;
+    sz.writeVarU32(127);
+    REQUIRE(sz.size() == 1);
+    sz.writeVarU32(128);
+    REQUIRE(sz.size() == 3);
+    sz.writeVarI32(-1);
+    REQUIRE(sz.size() == 4);
+}
+
+TEST_CASE("BinStream: malformed varints are rejected without moving", "[binaryio]") {
+    Util::BinStream w;
+    w.writeVarU64(1ull << 40); // too wide for 32 bits
+    std::uint32_t u = 0;
+    REQUIRE_FALSE(w.readVarU32(u));
+    REQUIRE(w.tell() == 0);
+
+    Util::BinStream trunc;
+    trunc.writeU8(0x80); // continuation bit with nothing after it
+    std::uint64_t x = 0;
+    REQUIRE_FALSE(trunc.readVarU64(x));
+    REQUIRE(trunc.tell() == 0);
+}
+
+TEST_CASE("BinStream: bulk arrays and delta coding", "[binaryio]") {
+    Vector<std::int32_t> cells(1000);
+    for (size_t i = 0; i < cells.size(); ++i) cells[i] = (std::int32_t)(i * 37 % 11) - 5;
+    Vector<std::uint32_t> ids(1000);
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = 100000u + (std::uint32_t)i * 3;
+    const Vector<std::int16_t> wobble = { 5, 3, -2, -2, 400, -32768, 32767 };
+
+    Util::BinStream w;
+    w.writeArray<std::int32_t>(cells);
+    const size_t before = w.size();
+    w.writeDelta<std::uint32_t>(ids);
+    REQUIRE(w.size() - before < ids.size() + 4); // ~1 byte per sorted id
+    w.writeDelta<std::int16_t>(wobble);
+
+    Vector<std::int32_t> cellsIn(cells.size());
+    Vector<std::uint32_t> idsIn(ids.size());
+    Vector<std::int16_t> wobbleIn(wobble.size());
+    REQUIRE(w.readArray<std::int32_t>(cellsIn));
+    REQUIRE(w.readDelta<std::uint32_t>(idsIn));
+    REQUIRE(w.readDelta<std::int16_t>(wobbleIn));
+    REQUIRE(cellsIn == cells);
+    REQUIRE(idsIn == ids);
+    REQUIRE(wobbleIn == wobble);
+    REQUIRE(w.eof());
+
+    // Same data through a view
+    Util::BinView v(std::span<const Util::Byte>(w.buffer()));
+    std::fill(idsIn.begin(), idsIn.end(), 0u);
+    REQUIRE(v.skip(cells.size() * sizeof(std::int32_t)));
+    REQUIRE(v.readDelta<std::uint32_t>(idsIn));
+    REQUIRE(idsIn == ids);
+
+    Vector<std::int32_t> tooMany(cells.size() * 2);
+    w.rewind();
+    REQUIRE_FALSE(w.readArray<std::int32_t>(tooMany));
+    REQUIRE(w.tell() == 0);
+
+    // A delta run cut short fails with the cursor back where it started
+    Util::BinStream cut;
+    cut.writeDelta<std::uint32_t>(ids);
+    REQUIRE(cut.truncate(cut.size() - 1));
+    REQUIRE_FALSE(cut.readDelta<std::uint32_t>(idsIn));
+    REQUIRE(cut.tell() == 0);
+    Util::BinView cutView(std::span<const Util::Byte>(cut.buffer()));
+    REQUIRE_FALSE(cutView.readDelta<std::uint32_t>(idsIn));
+    REQUIRE(cutView.tell() == 0);
+}
+
+TEST_CASE("BinStream: 1M cell write, scalar vs bulk", "[.][benchmark][binaryio]") {
+    Vector<std::int32_t> cells(1 << 20);
+    for (size_t i = 0; i < cells.size(); ++i) cells[i] = (std::int32_t)(i & 0xFF);
+
+    BENCHMARK("writeI32 per cell") {
+        Util::BinStream w;
+        for (std::int32_t c : cells) w.writeI32(c);
+        return w.size();
+    };
+    BENCHMARK("writeArray") {
+        Util::BinStream w;
+        w.writeArray<std::int32_t>(cells);
+        return w.size();
+    };
+    BENCHMARK("writeVarI32 per cell") {
+        Util::BinStream w;
+        w.reserve(cells.size() * 2);
+        for (std::int32_t c : cells) w.writeVarI32(c);
+        return w.size();
+    };
+}
@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include "AvatarQuestRP.h"
+#include "AvatarQuestGameWeapon.h"
+#include "AvatarQuestGameArmor.h"
+#include "AvatarQuestCharacterIO.h"
+
+using namespace AvatarQuest;
+
+namespace {
+    CharacterSheet MakeSheet()
+    {
+        CharacterSheet cs{};
+        cs.name = "Iolo";
+        cs.isMale = true;
+        cs.portraitIndex = 7;
+        setAttribute(cs.attributes, AttributeType::Strength, 14);
+        setAttribute(cs.attributes, AttributeType::Wisdom, -2);
+        setLevel(cs, 5);
+        setHP(cs, 123456);
+        setSkillRating(cs, SkillType::Bows, 0.75f);
+        setSkillRating(cs, SkillType::Crafting, 0.125f);
+        createPurse(1234567890123LL, 42, 0, 0, cs.wallet);
+        cs.wallet.tileID = 99;
+
+        Ref<AvatarQuestWeapon> bow = std::make_shared<AvatarQuestWeapon>();
+        bow->weaponName = "Magic Bow";
+        bow->description = "A bow of some renown";
+        bow->secondarySkillType = SkillType::Bows;
+        bow->governingAttribute = AttributeType::Dexterity;
+        bow->damageTypes.push_back({ 3, DamageType::Damage_Piercing, { 2.0f, 9.5f } });
+        bow->attackSpeed = 1.25f;
+        bow->attackReach = 6;
+        bow->attributeBonuses.push_back({ AttributeType::Dexterity, 3 });
+        equipPrimaryWeapon(cs, bow);
+        equipSecondaryWeapon(cs, bow); // same object in two slots
+
+        Ref<AvatarQuestArmor> boots = std::make_shared<AvatarQuestArmor>();
+        boots->armorName = "Boots";
+        boots->slot = ArmorSlot::Feet;
+        boots->armorType = ArmorType::Leather;
+        boots->armorClass = 4;
+        boots->resistances.push_back({ -1, DamageType::Damage_Ice, { 1.0f, 2.0f } });
+        boots->attributeBonuses.push_back({ AttributeType::HPMax, -5 });
+        equipArmor(cs, boots);
+        return cs;
+    }
+}
+
+TEST_CASE("CharacterIO: sheet round trips", "[character][save]") {
+    const CharacterSheet src = MakeSheet();
+    Util::BinStream w;
+    writeCharacterSheet(w, src);
+
+    Util::BinView r{ std::span<const Util::Byte>(w.buffer()) };
+    CharacterSheet cs{};
+    REQUIRE(readCharacterSheet(r, cs));
+    REQUIRE(r.eof());
+
+    REQUIRE(cs.name == "Iolo");
+    REQUIRE(cs.isMale);
+    REQUIRE(cs.portraitIndex == 7);
+    REQUIRE(cs.attributes.values == src.attributes.values);
+    REQUIRE(cs.skillRatings == src.skillRatings);
+    REQUIRE(cs.wallet.amounts == src.wallet.amounts);
+    REQUIRE(cs.wallet.tileID == 99);
+
+    REQUIRE(cs.equipment.primaryWeapon);
+    REQUIRE(cs.equipment.primaryWeapon == cs.equipment.secondaryWeapon);
+    const AvatarQuestWeapon& bow = *cs.equipment.primaryWeapon;
+    REQUIRE(bow.weaponName == "Magic Bow");
+    REQUIRE(bow.description == "A bow of some renown");
+    REQUIRE(bow.secondarySkillType == SkillType::Bows);
+    REQUIRE(bow.governingAttribute == AttributeType::Dexterity);
+    REQUIRE(bow.damageTypes.size() == 1);
+    REQUIRE(bow.damageTypes[0].damageType == DamageType::Damage_Piercing);
+    REQUIRE(bow.damageTypes[0].damageRange.y == 9.5f);
+    REQUIRE(bow.attackSpeed == 1.25f);
+    REQUIRE(bow.attackReach == 6);
+    REQUIRE(bow.attributeBonuses.size() == 1);
+    REQUIRE(bow.attributeBonuses[0].amount == 3);
+
+    REQUIRE_FALSE(cs.equipment.head);
+    REQUIRE(cs.equipment.feet);
+    REQUIRE(cs.equipment.feet->armorName == "Boots");
+    REQUIRE(cs.equipment.feet->slot == ArmorSlot::Feet);
+    REQUIRE(cs.equipment.feet->armorClass == 4);
+    REQUIRE(cs.equipment.feet->resistances[0].damageType == DamageType::Damage_Ice);
+    REQUIRE(cs.equipment.feet->attributeBonuses[0].amount == -5);
+    REQUIRE(getEffectiveAttribute(cs, AttributeType::Dexterity) == getEffectiveAttribute(src, AttributeType::Dexterity));
+}
+
+TEST_CASE("CharacterIO: unknown sections are skipped", "[character][save]") {
+    const CharacterSheet src = MakeSheet();
+    Util::BinStream w;
+    writeCharacterSheet(w, src);
+
+    // Append a section from a "newer" build and bump the little-endian count at offset 6
+    Vector<Util::Byte> bytes = w.buffer();
+    bytes[6] += 1;
+    Util::BinStream out(std::move(bytes));
+    out.writeU16(0x7F01);
+    out.writeU32(3);
+    out.writeU8(1); out.writeU8(2); out.writeU8(3);
+
+    Util::BinView r{ std::span<const Util::Byte>(out.buffer()) };
+    CharacterSheet cs{};
+    REQUIRE(readCharacterSheet(r, cs));
+    REQUIRE(cs.name == "Iolo");
+    REQUIRE(r.eof());
+}
+
+TEST_CASE("CharacterIO: truncated or corrupt data leaves the sheet untouched", "[character][save]") {
+    Util::BinStream w;
+    writeCharacterSheet(w, MakeSheet());
+    const Vector<Util::Byte>& good = w.buffer();
+
+    for (size_t cut : { (size_t)0, (size_t)5, (size_t)20, good.size() / 2, good.size() - 1 }) {
+        Util::BinView r{ std::span<const Util::Byte>(good.data(), cut) };
+        CharacterSheet cs{};
+        cs.name = "unchanged";
+        REQUIRE_FALSE(readCharacterSheet(r, cs));
+        REQUIRE(cs.name == "unchanged");
+    }
+
+    Vector<Util::Byte> bad = good;
+    bad[0] ^= 0xFF;
+    Util::BinView r{ std::span<const Util::Byte>(bad) };
+    CharacterSheet cs{};
+    REQUIRE_FALSE(readCharacterSheet(r, cs));
+
+    // Sheet versions this build doesn't know (little-endian u16 at offset 4)
+    for (Util::Byte version : { (Util::Byte)0, (Util::Byte)(CharacterIO::kVersion + 1) }) {
+        Vector<Util::Byte> future = good;
+        future[4] = version;
+        future[5] = 0;
+        Util::BinView v{ std::span<const Util::Byte>(future) };
+        cs.name = "unchanged";
+        REQUIRE_FALSE(readCharacterSheet(v, cs));
+        REQUIRE(cs.name == "unchanged");
+    }
+}
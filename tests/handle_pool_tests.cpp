@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Common.h"
+
+namespace {
+    struct Dummy { int value = 0; };
+}
+
+TEST_CASE("Handle pool: create and resolve", "[handlepool]") {
+    HandlePool<Dummy> pool;
+    auto a = pool.create(Dummy{ 1 });
+    auto b = pool.create(Dummy{ 2 });
+
+    REQUIRE(a);
+    REQUIRE(b);
+    REQUIRE(a != b);
+    REQUIRE(pool.size() == 2);
+    REQUIRE(pool.get(a)->value == 1);
+    REQUIRE(pool.get(b)->value == 2);
+
+    // A default handle never resolves
+    REQUIRE_FALSE(Handle<Dummy>{});
+    REQUIRE(pool.get(Handle<Dummy>{}) == nullptr);
+}
+
+TEST_CASE("Handle pool: released handles go stale", "[handlepool]") {
+    HandlePool<Dummy> pool;
+    auto a = pool.create(Dummy{ 1 });
+    REQUIRE(pool.release(a));
+    REQUIRE(pool.get(a) == nullptr);
+    REQUIRE_FALSE(pool.contains(a));
+    REQUIRE_FALSE(pool.release(a)); // double release is rejected
+
+    // The slot is recycled with a new generation; the old handle stays stale
+    auto b = pool.create(Dummy{ 2 });
+    REQUIRE(b.index() == a.index());
+    REQUIRE(b.generation() != a.generation());
+    REQUIRE(pool.get(a) == nullptr);
+    REQUIRE(pool.get(b)->value == 2);
+}
+
+TEST_CASE("Handle pool: swap-remove keeps other handles valid", "[handlepool]") {
+    HandlePool<Dummy> pool;
+    Vector<Handle<Dummy>> handles;
+    for (int i = 0; i < 8; ++i) handles.push_back(pool.create(Dummy{ i }));
+
+    REQUIRE(pool.release(handles[0]));
+    REQUIRE(pool.release(handles[5]));
+    REQUIRE(pool.size() == 6);
+
+    for (int i = 0; i < 8; ++i) {
+        if (i == 0 || i == 5) {
+            REQUIRE(pool.get(handles[i]) == nullptr);
+        } else {
+            REQUIRE(pool.get(handles[i]) != nullptr);
+            REQUIRE(pool.get(handles[i])->value == i);
+        }
+    }
+
+    int sum = 0;
+    pool.forEach([&](Dummy& d) { sum += d.value; });
+    REQUIRE(sum == 1 + 2 + 3 + 4 + 6 + 7);
+}
+
+TEST_CASE("Handle pool: clear invalidates everything", "[handlepool]") {
+    HandlePool<Dummy> pool;
+    auto a = pool.create(Dummy{ 1 });
+    auto b = pool.create(Dummy{ 2 });
+    pool.clear();
+    REQUIRE(pool.empty());
+    REQUIRE(pool.get(a) == nullptr);
+    REQUIRE(pool.get(b) == nullptr);
+
+    auto c = pool.create(Dummy{ 3 });
+    REQUIRE(pool.get(c)->value == 3);
+    REQUIRE(pool.get(a) == nullptr);
+}
@@ -0,0 +1,261 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstring>
+#include "Common.h"
+
+using namespace Palette;
+
+namespace {
+    // Same layout as Art/UltimaIV_CGAComposite.gpl (tab before the label)
+    const char kGpl[] =
+        "GIMP Palette\n"
+        "Name: Test\r\n"
+        "Columns: 4\n"
+        "#\n"
+        "  0   0   0\tUntitled\n"
+        " 34  32  52\tUntitled\n"
+        "223 113  38\tUntitled\n"
+        "255 255 255\tUntitled\n"
+        "\n"
+        " 99 155 255\n";
+
+    ColorPalette TestPalette()
+    {
+        ColorPalette p;
+        REQUIRE(parseGpl(kGpl, std::strlen(kGpl), p));
+        return p;
+    }
+
+    // RendererImage.cpp creates its textures on getRenderer(); a software renderer
+    // over a small surface stands in for the game window
+    SDL_Renderer* s_renderer = nullptr;
+
+    struct TestRenderer {
+        SDL_Surface* surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+        TestRenderer()
+        {
+            REQUIRE(surface);
+            s_renderer = SDL_CreateSoftwareRenderer(surface);
+            REQUIRE(s_renderer);
+        }
+        ~TestRenderer()
+        {
+            Renderer::releaseAllImages();
+            SDL_DestroyRenderer(s_renderer);
+            s_renderer = nullptr;
+            SDL_DestroySurface(surface);
+        }
+    };
+
+    // RGBA image whose opaque pixels cycle through the palette
+    Vector<uint8_t> PaletteArt(const ColorPalette& p, int w, int h)
+    {
+        Vector<uint8_t> rgba((std::size_t)w * h * 4);
+        for (int i = 0; i < w * h; ++i) {
+            const Renderer::Color& c = p.colors[(std::size_t)(i * 7 + i / w) % p.colors.size()];
+            const bool hole = i % 11 == 0;
+            rgba[i * 4 + 0] = c.r;
+            rgba[i * 4 + 1] = c.g;
+            rgba[i * 4 + 2] = c.b;
+            rgba[i * 4 + 3] = hole ? 0 : 255;
+        }
+        return rgba;
+    }
+}
+
+SDL_Renderer* Renderer::getRenderer()
+{
+    return s_renderer;
+}
+
+TEST_CASE("Palette: GIMP palette parsing", "[palette]")
+{
+    const ColorPalette p = TestPalette();
+    REQUIRE(p.name == "Test");
+    REQUIRE(p.colors.size() == 5);
+    REQUIRE(p.colors[1].r == 34);
+    REQUIRE(p.colors[1].b == 52);
+    REQUIRE(p.colors[4].g == 155);
+    REQUIRE(p.colors[4].a == 255);
+
+    ColorPalette bad;
+    const char noHeader[] = "0 0 0\n";
+    REQUIRE_FALSE(parseGpl(noHeader, std::strlen(noHeader), bad));
+    const char outOfRange[] = "GIMP Palette\n300 0 0\n";
+    REQUIRE_FALSE(parseGpl(outOfRange, std::strlen(outOfRange), bad));
+    const char shortLine[] = "GIMP Palette\n10 20\n";
+    REQUIRE_FALSE(parseGpl(shortLine, std::strlen(shortLine), bad));
+    const char empty[] = "GIMP Palette\n# nothing\n";
+    REQUIRE_FALSE(parseGpl(empty, std::strlen(empty), bad));
+}
+
+TEST_CASE("Palette: quantise, expand and round trip", "[palette]")
+{
+    const ColorPalette p = TestPalette();
+    const Vector<uint8_t> art = PaletteArt(p, 13, 5);
+    IndexedPixels ip;
+    REQUIRE(quantize(art.data(), 13, 5, p, ip));
+    REQUIRE(ip.indices.size() == 65);
+    REQUIRE(ip.indices[0] == kTransparentIndex);
+
+    Lut lut;
+    buildLut(p, lut);
+    REQUIRE(lut.entries[5] == packRGBA({ 0, 0, 0, 0 }));
+    REQUIRE(lut.entries[kTransparentIndex] == packRGBA({ 0, 0, 0, 0 }));
+    Vector<uint32_t> expanded(ip.indices.size());
+    expand(ip.indices.data(), ip.indices.size(), lut, expanded.data());
+
+    // Palette art is lossless; holes come back fully transparent
+    bool same = true;
+    for (std::size_t i = 0; i < ip.indices.size(); ++i) {
+        uint8_t px[4];
+        std::memcpy(px, &expanded[i], 4);
+        if (art[i * 4 + 3] == 0) same = same && px[3] == 0;
+        else same = same && std::memcmp(px, &art[i * 4], 4) == 0;
+    }
+    REQUIRE(same);
+
+    // Off-palette colours go to the nearest entry
+    const uint8_t near[8] = { 230, 110, 40, 255, 20, 20, 30, 200 };
+    REQUIRE(quantize(near, 2, 1, p, ip));
+    REQUIRE(ip.indices[0] == 2);
+    REQUIRE(ip.indices[1] == 1);
+    REQUIRE_FALSE(quantize(near, 2, 1, ColorPalette{}, ip));
+}
+
+TEST_CASE("Palette: swaps are table edits", "[palette]")
+{
+    const ColorPalette p = TestPalette();
+    Lut base;
+    buildLut(p, base);
+
+    // Team colours: swap entries 2 and 4
+    uint8_t remap[256];
+    for (int i = 0; i < 256; ++i) remap[i] = (uint8_t)i;
+    std::swap(remap[2], remap[4]);
+    Lut team;
+    remapLut(base, remap, team);
+    REQUIRE(team.entries[2] == base.entries[4]);
+    REQUIRE(team.entries[4] == base.entries[2]);
+    REQUIRE(team.entries[1] == base.entries[1]);
+    remapLut(team, remap, team);
+    REQUIRE(team.entries[2] == base.entries[2]);
+
+    // Night: darken and cool, alpha untouched
+    Lut night;
+    tintLut(base, { 128, 128, 255, 255 }, night);
+    const Renderer::Color white = unpackRGBA(night.entries[3]);
+    REQUIRE(white.r == 128);
+    REQUIRE(white.b == 255);
+    REQUIRE(white.a == 255);
+    REQUIRE(unpackRGBA(night.entries[kTransparentIndex]).a == 0);
+}
+
+TEST_CASE("Palette: Box1 tile set memory, indexed against plain RGBA", "[palette]")
+{
+    TestRenderer renderer;
+    ColorPalette cga;
+    REQUIRE(loadGpl(AQ_ART_DIR "/UltimaIV_CGAComposite.gpl", cga));
+
+    constexpr int kTiles = 6;
+    Renderer::ImageHandle images[kTiles];
+    std::size_t pixels = 0;
+    for (int t = 0; t < kTiles; ++t) {
+        const String path = String(AQ_ART_DIR "/Box1_") + std::to_string(t + 1) + ".png";
+        REQUIRE(loadIndexedImageFromFile(path.c_str(), cga, images[t]));
+        const Renderer::Image* img = Renderer::getImage(images[t]);
+        REQUIRE(img);
+        pixels += (std::size_t)img->imageSize.w * (std::size_t)img->imageSize.h;
+    }
+    REQUIRE(pixels == 6 * 64 * 64);
+
+    const MemoryStats stats = getIndexedMemoryStats();
+    REQUIRE(stats.images == kTiles);
+    REQUIRE(stats.textureBytes == pixels * 4);
+    REQUIRE(stats.indexBytes == pixels);
+    REQUIRE(stats.lutBytes == sizeof(Lut));
+    REQUIRE(stats.totalBytes() == 123904);
+
+    // One palette: the resident texture plus its indices cost more than plain RGBA
+    const std::size_t plain = pixels * 4;
+    REQUIRE(stats.totalBytes() > plain);
+    // Day, night and poison: one re-expanded texture and three tables beat three
+    // RGBA copies of the art
+    REQUIRE(stats.totalBytes() + 2 * sizeof(Lut) < plain * 3);
+}
+
+TEST_CASE("Palette: slots keep the palette they were built from", "[palette]")
+{
+    TestRenderer renderer;
+    ColorPalette cga;
+    REQUIRE(loadGpl(AQ_ART_DIR "/UltimaIV_CGAComposite.gpl", cga));
+    const ColorPalette other = TestPalette();
+
+    Renderer::ImageHandle a, b, c;
+    REQUIRE(loadIndexedImageFromFile(AQ_ART_DIR "/Box1_1.png", cga, a, 0));
+    // Same palette, same slot: fine. A different palette would expand through the
+    // CGA table, so it is refused; it can still have a slot of its own.
+    REQUIRE(loadIndexedImageFromFile(AQ_ART_DIR "/Box1_2.png", cga, b, 0));
+    REQUIRE_FALSE(loadIndexedImageFromFile(AQ_ART_DIR "/Box1_3.png", other, c, 0));
+    REQUIRE(loadIndexedImageFromFile(AQ_ART_DIR "/Box1_3.png", other, c, 1));
+    REQUIRE(getIndexedMemoryStats().images == 3);
+
+    // Uploaded textures are clean until their slot's table changes
+    REQUIRE(updateIndexedImages() == 0);
+    Lut night;
+    buildLut(cga, night);
+    tintLut(night, { 128, 128, 255, 255 }, night);
+    REQUIRE(setSlotLut(0, night));
+    REQUIRE(updateIndexedImages() == 2);
+    REQUIRE(updateIndexedImages() == 0);
+}
+
+TEST_CASE("Palette: moving an image needs a matching slot table", "[palette]")
+{
+    TestRenderer renderer;
+    ColorPalette cga;
+    REQUIRE(loadGpl(AQ_ART_DIR "/UltimaIV_CGAComposite.gpl", cga));
+    const ColorPalette other = TestPalette();
+
+    Renderer::ImageHandle tile, foreign;
+    REQUIRE(loadIndexedImageFromFile(AQ_ART_DIR "/Box1_1.png", cga, tile, 0));
+    REQUIRE(loadIndexedImageFromFile(AQ_ART_DIR "/Box1_2.png", other, foreign, 1));
+    REQUIRE(updateIndexedImages() == 0);
+
+    // No table yet: the image would expand through zeroes and vanish
+    REQUIRE_FALSE(setImageSlot(tile, 2));
+    // Built from another palette: the indices would pick the wrong colours
+    REQUIRE_FALSE(setImageSlot(tile, 1));
+    REQUIRE(updateIndexedImages() == 0);
+
+    // A table set from the image's own palette takes it
+    Lut night;
+    buildLut(cga, night);
+    tintLut(night, { 128, 128, 255, 255 }, night);
+    REQUIRE(setSlotLut(2, night));
+    REQUIRE(setImageSlot(tile, 2));
+    REQUIRE(updateIndexedImages() == 1);
+    // ...and from then on belongs to that palette
+    REQUIRE_FALSE(setImageSlot(foreign, 2));
+    REQUIRE_FALSE(loadIndexedImageFromFile(AQ_ART_DIR "/Box1_3.png", other, foreign, 2));
+}
+
+TEST_CASE("Palette: quantise and re-expand a 256x256 sheet", "[.][benchmark][palette]")
+{
+    const ColorPalette p = TestPalette();
+    const Vector<uint8_t> art = PaletteArt(p, 256, 256);
+    IndexedPixels ip;
+    Lut lut;
+    buildLut(p, lut);
+    Vector<uint32_t> out(256 * 256);
+
+    BENCHMARK("quantise 256x256 RGBA to the palette") {
+        quantize(art.data(), 256, 256, p, ip);
+        return ip.indices[1];
+    };
+
+    BENCHMARK("expand 256x256 indices through the LUT") {
+        expand(ip.indices.data(), ip.indices.size(), lut, out.data());
+        return out[1];
+    };
+}
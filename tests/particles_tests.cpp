@@ -0,0 +1,206 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+using namespace Particles;
+
+namespace {
+    // Fixed-life particles that only fall, so positions are predictable
+    EmitterDesc FallingDesc(uint32_t maxParticles, float life)
+    {
+        EmitterDesc d;
+        d.maxParticles = maxParticles;
+        d.lifeMin = d.lifeMax = life;
+        d.speedMin = d.speedMax = 0.0f;
+        d.gravity = { 0.0f, 10.0f };
+        d.sizeStart = 4.0f;
+        d.sizeEnd = 0.0f;
+        return d;
+    }
+}
+
+TEST_CASE("Particles: SIMD integration matches scalar", "[particles]")
+{
+    constexpr std::size_t n = 37;
+    Vector<float> a[7], b[7];
+    for (int k = 0; k < 7; ++k) {
+        a[k].resize(n);
+        for (std::size_t i = 0; i < n; ++i) a[k][i] = std::sin((float)(i * 7 + k)) * 10.0f + (k == 4 ? 12.0f : 0.0f);
+        b[k] = a[k];
+    }
+    for (std::size_t i = 0; i < n; ++i) a[5][i] = b[5][i] = 0.05f;
+    auto arrays = [](Vector<float>* v) {
+        return ParticleArrays{ v[0].data(), v[1].data(), v[2].data(), v[3].data(), v[4].data(), v[5].data(), v[6].data() };
+    };
+    ParticleMotion m;
+    m.gravity = { 3.0f, -9.0f };
+    m.damping = 0.97f;
+    m.sizeStart = 8.0f;
+    m.sizeEnd = 2.0f;
+
+    // Odd range so both the vector body and the tail run
+    integrateParticles(arrays(a), 3, 34, m, 0.25f);
+    integrateParticlesScalar(arrays(b), 3, 34, m, 0.25f);
+    for (int k = 0; k < 7; ++k) {
+        for (std::size_t i = 0; i < n; ++i) REQUIRE(a[k][i] == Catch::Approx(b[k][i]).margin(1e-4));
+    }
+    REQUIRE(a[4][0] == b[4][0]);
+}
+
+TEST_CASE("Particles: bursts, expiry and swap-remove", "[particles]")
+{
+    shutdownParticles();
+    EmitterDesc d = FallingDesc(8, 1.0f);
+    d.lifeMin = 0.5f;
+    d.lifeMax = 1.5f;
+    const EmitterHandle h = createEmitter(d, { 100, 100 });
+    REQUIRE(h);
+    REQUIRE(emitBurst(h, 5) == 5);
+    REQUIRE(emitBurst(h, 5) == 3);  // clamped to capacity
+    REQUIRE(getParticleCount(h) == 8);
+
+    updateParticles(0.4f);
+    REQUIRE(getParticleCount(h) == 8);
+    updateParticles(0.7f);
+    const uint32_t alive = getParticleCount(h);
+    REQUIRE(alive < 8);
+    updateParticles(0.5f);
+    REQUIRE(getParticleCount(h) == 0);
+    REQUIRE(getTotalParticleCount() == 0);
+
+    // Continuous emission carries the fractional remainder
+    EmitterDesc rated = FallingDesc(64, 10.0f);
+    rated.rate = 2.5f;
+    const EmitterHandle r = createEmitter(rated, { 0, 0 });
+    updateParticles(1.0f);
+    REQUIRE(getParticleCount(r) == 2);
+    updateParticles(1.0f);
+    REQUIRE(getParticleCount(r) == 5);
+    REQUIRE(setEmitterActive(r, false));
+    updateParticles(1.0f);
+    REQUIRE(getParticleCount(r) == 5);
+    shutdownParticles();
+}
+
+TEST_CASE("Particles: finished emitters release themselves", "[particles]")
+{
+    shutdownParticles();
+    const EmitterHandle h = createEmitter(FallingDesc(16, 1.0f), { 0, 0 });
+    REQUIRE(emitBurst(h, 16) == 16);
+    REQUIRE(destroyEmitter(h, true));
+    REQUIRE(emitBurst(h, 1) == 0);
+    REQUIRE_FALSE(setEmitterActive(h, true));
+    updateParticles(0.5f);
+    REQUIRE(getEmitterCount() == 1);
+    updateParticles(0.6f);
+    REQUIRE(getEmitterCount() == 0);
+    REQUIRE_FALSE(destroyEmitter(h));
+
+    const EmitterHandle now = createEmitter(FallingDesc(4, 1.0f), { 0, 0 });
+    REQUIRE(destroyEmitter(now));
+    REQUIRE(getParticleCount(now) == 0);
+    REQUIRE_FALSE(createEmitter(FallingDesc(0, 1.0f), { 0, 0 }));
+}
+
+TEST_CASE("Particles: batches group emitters by image", "[particles]")
+{
+    shutdownParticles();
+    EmitterDesc d = FallingDesc(4, 2.0f);
+    d.colorStart = { 255, 0, 0, 255 };
+    d.colorEnd = { 0, 0, 255, 0 };
+    d.uv = { 0.5f, 0.0f, 0.5f, 0.25f };
+    const EmitterHandle a = createEmitter(d, { 10, 20 });
+    const EmitterHandle b = createEmitter(d, { 50, 60 });
+    emitBurst(a, 1);
+    emitBurst(b, 2);
+    updateParticles(1.0f);
+
+    const Vector<ParticleBatch>& batches = buildParticleBatches({ 10, 0 });
+    REQUIRE(batches.size() == 1);
+    REQUIRE(batches[0].quads == 3);
+    REQUIRE(batches[0].vertices.size() >= 12);
+
+    // Half-way through life: size 2, colour half-way, y fell g * dt * dt
+    const SDL_Vertex& v = batches[0].vertices[0];
+    REQUIRE(v.position.x == Catch::Approx(-1.0f));
+    REQUIRE(v.position.y == Catch::Approx(29.0f));
+    REQUIRE(batches[0].vertices[2].position.x == Catch::Approx(1.0f));
+    REQUIRE(v.color.r == Catch::Approx(0.5f));
+    REQUIRE(v.color.b == Catch::Approx(0.5f));
+    REQUIRE(v.tex_coord.x == Catch::Approx(0.5f));
+    REQUIRE(batches[0].vertices[2].tex_coord.y == Catch::Approx(0.25f));
+
+    const int* idx = Renderer::getQuadIndices(3);
+    REQUIRE(idx[6] == 4);
+    REQUIRE(idx[11] == 7);
+    REQUIRE(idx[17] == 11);
+
+    destroyEmitter(a);
+    destroyEmitter(b);
+    REQUIRE(buildParticleBatches().empty());
+    shutdownParticles();
+}
+
+TEST_CASE("Particles: parallel update matches the serial result", "[particles]")
+{
+    shutdownParticles();
+    setParticleWorkerCount(3);
+    REQUIRE(getParticleWorkerCount() == 3);
+    const EmitterHandle a = createEmitter(FallingDesc(20000, 10.0f), { 0, 0 });
+    const EmitterHandle b = createEmitter(FallingDesc(9000, 10.0f), { 5, 5 });
+    REQUIRE(emitBurst(a, 20000) == 20000);
+    REQUIRE(emitBurst(b, 9000) == 9000);
+    for (int i = 0; i < 4; ++i) updateParticles(0.5f);
+    REQUIRE(getTotalParticleCount() == 29000);
+
+    // v = 5, 10, 15, 20 over the steps: y = 0.5 * (5 + 10 + 15 + 20)
+    const Vector<ParticleBatch>& batches = buildParticleBatches();
+    REQUIRE(batches.size() == 1);
+    bool allMoved = true;
+    for (std::size_t q = 0; q < batches[0].quads; ++q) {
+        const SDL_Vertex& v = batches[0].vertices[q * 4];
+        const float centreY = v.position.y + 1.6f;    // size 3.2 at 80% life
+        const float expect = q < 20000 ? 25.0f : 30.0f;
+        allMoved = allMoved && std::fabs(centreY - expect) < 1e-3f;
+    }
+    REQUIRE(allMoved);
+
+    setParticleWorkerCount(0);
+    REQUIRE(getParticleWorkerCount() == 0);
+    shutdownParticles();
+}
+
+TEST_CASE("Particles: 100k particle update and batching", "[.][benchmark][particles]")
+{
+    shutdownParticles();
+    EmitterDesc d;
+    d.maxParticles = 25000;
+    d.rate = 25000.0f / 2.0f;   // steady state at 25k per emitter
+    d.lifeMin = d.lifeMax = 2.0f;
+    d.gravity = { 0.0f, 40.0f };
+    d.drag = 0.1f;
+    d.spawnExtent = { 8.0f, 8.0f };
+    for (int i = 0; i < 4; ++i) {
+        const EmitterHandle h = createEmitter(d, { 100.0f * (float)i, 50.0f });
+        emitBurst(h, d.maxParticles);
+    }
+    constexpr float kDt = 1.0f / 60.0f;
+
+    BENCHMARK("serial update, 100k particles") {
+        updateParticles(kDt);
+        return getTotalParticleCount();
+    };
+
+    setParticleWorkerCount(3);
+    BENCHMARK("parallel update (3 workers + caller), 100k particles") {
+        updateParticles(kDt);
+        return getTotalParticleCount();
+    };
+    setParticleWorkerCount(0);
+
+    BENCHMARK("vertex batch build, 100k particles") {
+        return buildParticleBatches()[0].quads;
+    };
+    shutdownParticles();
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+#include <cmath>
+
+using namespace Renderer;
+
+namespace {
+    void RequireNear(const Vector<Vector2>& pts, std::size_t i, float x, float y)
+    {
+        REQUIRE(pts[i].x == Catch::Approx(x).margin(1e-3));
+        REQUIRE(pts[i].y == Catch::Approx(y).margin(1e-3));
+    }
+}
+
+TEST_CASE("Primitives: cached builders match direct trig", "[primitives]")
+{
+    clearUnitShapeCache();
+    Vector<Vector2> pts;
+    Vector<int> idx;
+
+    makeCircle({ 10, 20 }, 5.0f, 24, pts, idx);
+    REQUIRE(pts.size() == 24);
+    REQUIRE(idx.size() == 48);
+    REQUIRE(idx[47] == 0);
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+        const float a = -0.5f * 3.14159265f + 6.2831853f * (float)i / 24.0f;
+        RequireNear(pts, i, 10 + 5 * std::cos(a), 20 + 5 * std::sin(a));
+    }
+
+    makeEllipseFilled({ 0, 0 }, 4.0f, 2.0f, 10, pts, idx);
+    REQUIRE(pts.size() == 11);
+    RequireNear(pts, 0, 0, 0);
+    RequireNear(pts, 1, 4, 0);
+    RequireNear(pts, 4, 4 * std::cos(6.2831853f * 0.3f), 2 * std::sin(6.2831853f * 0.3f));
+    REQUIRE(idx.size() == 27);
+
+    makeRegularPolygonFilled({ 1, 1 }, 2.0f, 4, 45.0f, pts, idx);
+    REQUIRE(pts.size() == 5);
+    RequireNear(pts, 1, 1 + 2 * std::cos(-0.25f * 3.14159265f), 1 + 2 * std::sin(-0.25f * 3.14159265f));
+    REQUIRE(idx.size() == 12);
+    REQUIRE(idx[9] == 0);
+    REQUIRE(idx[10] == 4);
+    REQUIRE(idx[11] == 1);
+
+    makeArc({ 0, 0 }, 3.0f, 0.0f, 90.0f, 48, pts, idx);
+    REQUIRE(pts.size() == 49);
+    RequireNear(pts, 0, 3, 0);
+    RequireNear(pts, 24, 3 * std::cos(0.25f * 3.14159265f), 3 * std::sin(0.25f * 3.14159265f));
+    RequireNear(pts, 48, 0, 3);
+}
+
+TEST_CASE("Primitives: unit shapes are shared per kind and segment count", "[primitives]")
+{
+    clearUnitShapeCache();
+    Vector<Vector2> pts;
+    Vector<int> idx;
+    makeCircle({ 0, 0 }, 1.0f, 32, pts, idx);
+    makeCircle({ 5, 5 }, 9.0f, 32, pts, idx);
+    makeRegularPolygon({ 0, 0 }, 2.0f, 32, 10.0f, pts, idx);
+    REQUIRE(getUnitShapeCacheSize() == 1);
+
+    makeCircleFilled({ 0, 0 }, 1.0f, 32, pts, idx);
+    makeEllipseFilled({ 0, 0 }, 1.0f, 3.0f, 32, pts, idx);
+    REQUIRE(getUnitShapeCacheSize() == 2);
+
+    const UnitShape& a = getUnitShape(UnitShapeKind::Ring, 16);
+    const UnitShape& b = getUnitShape(UnitShapeKind::Ring, 16);
+    REQUIRE(&a == &b);
+    REQUIRE(getUnitShapeCacheSize() == 3);
+    // Off-table counts are still exact
+    const UnitShape& odd = getUnitShape(UnitShapeKind::Ring, 7);
+    REQUIRE(odd.points[3].x == Catch::Approx(std::cos(6.2831853f * 3.0f / 7.0f)).margin(1e-5));
+
+    // Large counts round up the ladder, so the cache stays bounded
+    REQUIRE(getUnitShape(UnitShapeKind::Ring, 100).points.size() == 128);
+    REQUIRE(getUnitShape(UnitShapeKind::Fan, 5000).points.size() == 769);
+    clearUnitShapeCache();
+    for (Uint32 n = 3; n < 4000; ++n) getUnitShape(UnitShapeKind::RingTop, n);
+    REQUIRE(getUnitShapeCacheSize() == 62 + 6);
+    makeRegularPolygon({ 0, 0 }, 1.0f, 65, 0.0f, pts, idx);
+    REQUIRE(pts.size() == 96);
+}
+
+TEST_CASE("Primitives: autoSegmentsForCircleWorld snaps to the ladder", "[primitives]")
+{
+    REQUIRE(autoSegmentsForCircleWorld(10.0f, 4.0f, 8, 256) == 16);      // ceil(15.7)
+    REQUIRE(autoSegmentsForCircleWorld(11.0f, 4.0f, 8, 256) == 24);      // ceil(17.3)
+    REQUIRE(autoSegmentsForCircleWorld(1.0f, 4.0f, 8, 256) == 8);
+    REQUIRE(autoSegmentsForCircleWorld(1000.0f, 1.0f, 8, 256) == 256);
+    REQUIRE(autoSegmentsForCircleWorld(1000.0f, 1.0f, 8, 200) == 192);   // clamp stays on the ladder
+    REQUIRE(autoSegmentsForCircleWorld(10.0f, 4.0f, 17, 20) == 17);      // no ladder step fits
+
+    clearUnitShapeCache();
+    Vector<Vector2> pts;
+    Vector<int> idx;
+    // 32 radii needing 13..26 segments share the 16, 24 and 32 shapes
+    for (float r = 8.0f; r < 16.0f; r += 0.25f) {
+        makeCircle({ 0, 0 }, r, autoSegmentsForCircleWorld(r, 4.0f, 8, 256), pts, idx);
+    }
+    REQUIRE(getUnitShapeCacheSize() == 3);
+}
+
+TEST_CASE("Primitives: builder throughput", "[.][benchmark]")
+{
+    Vector<Vector2> pts;
+    Vector<int> idx;
+
+    BENCHMARK("per-vertex sin/cos, 64-segment circle") {
+        pts.clear(); idx.clear();
+        for (uint32_t i = 0; i < 64; ++i) {
+            const float a = -0.5f * 3.14159265f + 6.2831853f * (float)i / 64.0f;
+            pts.push_back({ 100 + 30 * std::cos(a), 50 + 30 * std::sin(a) });
+            idx.push_back((int)i); idx.push_back((int)((i + 1) % 64));
+        }
+        return pts.size();
+    };
+
+    BENCHMARK("cached makeCircle, 64 segments") {
+        makeCircle({ 100, 50 }, 30.0f, 64, pts, idx);
+        return pts.size();
+    };
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+#include "SoundMix.h"
+
+namespace {
+    constexpr int kFrames = 1024;
+    constexpr int kChannels = 2;
+
+    Vector<float> MakeBuffer(int frames, int channels)
+    {
+        Vector<float> buf((size_t)frames * channels);
+        for (size_t i = 0; i < buf.size(); ++i) {
+            buf[i] = std::sin((float)i * 0.031f) * 1.5f; // exceeds full scale to exercise the clip
+        }
+        return buf;
+    }
+
+    bool NearlyEqual(const Vector<float>& a, const Vector<float>& b, float eps = 1e-5f)
+    {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (std::fabs(a[i] - b[i]) > eps) return false;
+        }
+        return true;
+    }
+
+    // Restores the detected kernel level when a test forces another one
+    struct KernelLevelScope {
+        ~KernelLevelScope() { SoundMix::setKernelLevel(SoundMix::detectKernelLevel()); }
+    };
+}
+
+TEST_CASE("SoundMix: dispatched kernels match scalar reference", "[sound][mix]") {
+    KernelLevelScope restore;
+    SoundMix::setKernelLevel(SoundMix::detectKernelLevel());
+    INFO("kernel level: " << SoundMix::kernelLevelName(SoundMix::getKernelLevel()));
+
+    for (int channels : { 1, 2, 3, 4, 6 }) {
+        for (int frames : { 1, 7, 333, kFrames }) {
+            const Vector<float> src = MakeBuffer(frames, channels);
+
+            Vector<float> ref = src, simd = src;
+            SoundMix::applyGainScalar(ref.data(), frames, channels, 0.25f, 0.9f);
+            SoundMix::applyGain(simd.data(), frames, channels, 0.25f, 0.9f);
+            REQUIRE(NearlyEqual(ref, simd));
+
+            ref = src; simd = src;
+            SoundMix::applyGainSoftClipScalar(ref.data(), frames, channels, 1.0f, 0.5f);
+            SoundMix::applyGainSoftClip(simd.data(), frames, channels, 1.0f, 0.5f);
+            REQUIRE(NearlyEqual(ref, simd));
+        }
+    }
+}
+
+TEST_CASE("SoundMix: gain ramps per frame without a step", "[sound][mix]") {
+    Vector<float> buf((size_t)4 * kChannels, 1.0f);
+    SoundMix::applyGain(buf.data(), 4, kChannels, 0.0f, 1.0f);
+    // Both channels of a frame share the gain; the ramp stops one step short of the target
+    REQUIRE(buf[0] == 0.0f);
+    REQUIRE(buf[1] == 0.0f);
+    REQUIRE(buf[2] == 0.25f);
+    REQUIRE(buf[3] == 0.25f);
+    REQUIRE(buf[6] == 0.75f);
+    REQUIRE(buf[7] == 0.75f);
+}
+
+TEST_CASE("SoundMix: soft clip bounds output and is odd", "[sound][mix]") {
+    Vector<float> buf = { -10.0f, -3.0f, -0.01f, 0.0f, 0.01f, 3.0f, 10.0f, 0.5f };
+    SoundMix::applyGainSoftClipScalar(buf.data(), (int)buf.size(), 1, 1.0f, 1.0f);
+    for (float v : buf) {
+        REQUIRE(v >= -1.0f);
+        REQUIRE(v <= 1.0f);
+    }
+    REQUIRE(buf[0] == -1.0f);
+    REQUIRE(buf[6] == 1.0f);
+    REQUIRE(buf[2] == -buf[4]);
+    REQUIRE(std::fabs(buf[4] - 0.01f) < 1e-4f); // near-linear for quiet input
+}
+
+TEST_CASE("SoundMix: stereo gain kernel matches scalar reference", "[sound][mix]") {
+    KernelLevelScope restore;
+    SoundMix::setKernelLevel(SoundMix::detectKernelLevel());
+    for (int frames : { 1, 2, 3, 255, kFrames }) {
+        const Vector<float> src = MakeBuffer(frames, 2);
+        Vector<float> ref = src, simd = src;
+        SoundMix::applyStereoGainScalar(ref.data(), frames, 1.0f, 0.2f, 0.3f, 0.8f);
+        SoundMix::applyStereoGain(simd.data(), frames, 1.0f, 0.2f, 0.3f, 0.8f);
+        REQUIRE(NearlyEqual(ref, simd));
+    }
+
+    Vector<float> buf(4, 1.0f);
+    SoundMix::applyStereoGainScalar(buf.data(), 2, 1.0f, 0.0f, 0.0f, 1.0f);
+    REQUIRE(buf[0] == 1.0f);  // L, frame 0
+    REQUIRE(buf[1] == 0.0f);  // R, frame 0
+    REQUIRE(buf[2] == 0.5f);
+    REQUIRE(buf[3] == 0.5f);
+}
+
+TEST_CASE("SoundMix: distance attenuation and pan", "[sound][mix]") {
+    REQUIRE(SoundMix::distanceGain(0.0f, 100.0f, 500.0f) == 1.0f);
+    REQUIRE(SoundMix::distanceGain(100.0f, 100.0f, 500.0f) == 1.0f);
+    REQUIRE(SoundMix::distanceGain(500.0f, 100.0f, 500.0f) == 0.0f);
+    REQUIRE(SoundMix::distanceGain(9000.0f, 100.0f, 500.0f) == 0.0f);
+    const float near = SoundMix::distanceGain(200.0f, 100.0f, 500.0f);
+    const float far = SoundMix::distanceGain(400.0f, 100.0f, 500.0f);
+    REQUIRE(near > far);
+    REQUIRE(far > 0.0f);
+
+    float l = 0.0f, r = 0.0f;
+    SoundMix::panGains(0.0f, l, r);
+    REQUIRE(std::fabs(l - 1.0f) < 1e-5f);
+    REQUIRE(std::fabs(r - 1.0f) < 1e-5f);
+    SoundMix::panGains(-1.0f, l, r);
+    REQUIRE(l == 1.0f);
+    REQUIRE(std::fabs(r) < 1e-5f);
+    SoundMix::panGains(5.0f, l, r); // clamped to hard right
+    REQUIRE(std::fabs(l) < 1e-5f);
+    REQUIRE(r == 1.0f);
+    SoundMix::panGains(0.5f, l, r);
+    REQUIRE(l < r);
+    REQUIRE(r <= 1.0f);
+}
+
+TEST_CASE("SoundMix: equal-power crossfade keeps constant power", "[sound][mix]") {
+    REQUIRE(SoundMix::equalPowerFade(0.0f) == 0.0f);
+    REQUIRE(std::fabs(SoundMix::equalPowerFade(1.0f) - 1.0f) < 1e-6f);
+    REQUIRE(SoundMix::equalPowerFade(-1.0f) == 0.0f);
+    for (float t = 0.0f; t <= 1.0f; t += 0.125f) {
+        const float in = SoundMix::equalPowerFade(t);
+        const float out = SoundMix::equalPowerFade(1.0f - t);
+        REQUIRE(std::fabs(in * in + out * out - 1.0f) < 1e-5f);
+    }
+}
+
+TEST_CASE("SoundMix: gain kernels on 1024-frame stereo buffers", "[.][benchmark][sound][mix]") {
+    KernelLevelScope restore;
+    const Vector<float> src = MakeBuffer(kFrames, kChannels);
+    Vector<float> buf = src;
+
+    BENCHMARK("scalar gain ramp") {
+        buf = src;
+        SoundMix::applyGainScalar(buf.data(), kFrames, kChannels, 0.3f, 0.7f);
+        return buf[0];
+    };
+    BENCHMARK("scalar gain ramp + soft clip") {
+        buf = src;
+        SoundMix::applyGainSoftClipScalar(buf.data(), kFrames, kChannels, 0.3f, 0.7f);
+        return buf[0];
+    };
+
+    for (SoundMix::KernelLevel level : { SoundMix::KernelLevel::SSE2, SoundMix::KernelLevel::AVX2, SoundMix::KernelLevel::NEON }) {
+        SoundMix::setKernelLevel(level);
+        if (SoundMix::getKernelLevel() != level) continue; // not available on this CPU/build
+        const std::string name = SoundMix::kernelLevelName(level);
+        BENCHMARK(name + " gain ramp") {
+            buf = src;
+            SoundMix::applyGain(buf.data(), kFrames, kChannels, 0.3f, 0.7f);
+            return buf[0];
+        };
+        BENCHMARK(name + " gain ramp + soft clip") {
+            buf = src;
+            SoundMix::applyGainSoftClip(buf.data(), kFrames, kChannels, 0.3f, 0.7f);
+            return buf[0];
+        };
+    }
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <algorithm>
+#include "Common.h"
+
+using namespace SpriteLayer;
+
+namespace {
+    Renderer::ImageHandle Img(uint32_t index)
+    {
+        return Renderer::ImageHandle::make(index, 1);
+    }
+
+    Sprite MakeSprite(uint32_t image, float depth, float x = 0.0f)
+    {
+        Sprite s;
+        s.image = Img(image);
+        s.src = { 16.0f, 0.0f, 16.0f, 32.0f };
+        s.position = { x, depth };
+        s.depth = depth;
+        return s;
+    }
+
+    Vector2 Size64(Renderer::ImageHandle) { return { 64.0f, 64.0f }; }
+}
+
+TEST_CASE("SpriteLayer: sprites draw back to front and keep submission order", "[sprites]")
+{
+    shutdownSprites();
+    addSprite(MakeSprite(1, 30.0f));
+    addSprite(MakeSprite(1, 10.0f));
+    addSprite(MakeSprite(1, 20.0f, 1.0f));
+    addSprite(MakeSprite(1, 20.0f, 2.0f));
+    addSprite(MakeSprite(1, 5000.0f));
+    buildSpriteRuns(nullptr);
+
+    const Vector<uint32_t>& order = getSpriteDrawOrder();
+    REQUIRE(order == Vector<uint32_t>{ 1, 2, 3, 0, 4 });
+    REQUIRE(getSpriteRuns().size() == 1);
+    REQUIRE(getSpriteRuns()[0].count == 5);
+
+    // Negative depths and a single sprite
+    clearSprites();
+    addSprite(MakeSprite(1, -4.0f));
+    buildSpriteRuns(nullptr);
+    REQUIRE(getSpriteDrawOrder().size() == 1);
+    clearSprites();
+    buildSpriteRuns(nullptr);
+    REQUIRE(getSpriteRuns().empty());
+    shutdownSprites();
+}
+
+TEST_CASE("SpriteLayer: equal depths group by texture into runs", "[sprites]")
+{
+    shutdownSprites();
+    // Two rows of separate sprites; each row alternates textures, which may regroup
+    for (int i = 0; i < 6; ++i) addSprite(MakeSprite(i % 2 ? 2 : 1, 100.0f, i * 20.0f));
+    for (int i = 0; i < 6; ++i) addSprite(MakeSprite(i % 2 ? 2 : 1, 50.0f, i * 20.0f));
+    buildSpriteRuns(nullptr);
+
+    const Vector<SpriteRun>& runs = getSpriteRuns();
+    REQUIRE(runs.size() == 4);
+    REQUIRE(runs[0].image == Img(1));
+    REQUIRE(runs[1].image == Img(2));
+    REQUIRE(runs[2].image == Img(1));
+    REQUIRE(runs[3].first == 9);
+    REQUIRE(runs[3].count == 3);
+    // Within a texture, submission order is kept
+    REQUIRE(getSpriteDrawOrder()[0] == 6);
+    REQUIRE(getSpriteDrawOrder()[1] == 8);
+
+    // A coarser quantum merges nearby rows
+    clearSprites();
+    addSprite(MakeSprite(1, 10.0f));
+    addSprite(MakeSprite(2, 10.5f, 40.0f));
+    addSprite(MakeSprite(1, 11.0f, 80.0f));
+    buildSpriteRuns(nullptr);
+    REQUIRE(getSpriteRuns().size() == 3);
+    setSpriteDepthQuantum(4.0f);
+    buildSpriteRuns(nullptr);
+    REQUIRE(getSpriteRuns().size() == 2);
+    REQUIRE(getSpriteRuns()[0].count == 2);
+    shutdownSprites();
+}
+
+TEST_CASE("SpriteLayer: overlapping sprites at equal depth keep submission order", "[sprites]")
+{
+    shutdownSprites();
+    // The image handle no longer decides who is on top: texture 2 was submitted
+    // first, so it stays underneath the texture 1 sprite it overlaps
+    addSprite(MakeSprite(2, 10.0f, 0.0f));
+    addSprite(MakeSprite(1, 10.0f, 4.0f));
+    addSprite(MakeSprite(2, 10.0f, 8.0f));
+    buildSpriteRuns(nullptr);
+    REQUIRE(getSpriteDrawOrder() == Vector<uint32_t>{ 0, 1, 2 });
+    REQUIRE(getSpriteRuns().size() == 3);
+
+    // A sprite clear of the ones it skips still joins the earlier run
+    clearSprites();
+    addSprite(MakeSprite(2, 10.0f, 0.0f));
+    addSprite(MakeSprite(1, 10.0f, 4.0f));
+    addSprite(MakeSprite(2, 10.0f, 100.0f));
+    addSprite(MakeSprite(1, 10.0f, 104.0f));
+    buildSpriteRuns(nullptr);
+    REQUIRE(getSpriteDrawOrder() == Vector<uint32_t>{ 0, 2, 1, 3 });
+    REQUIRE(getSpriteRuns().size() == 2);
+
+    // Edge contact is not overlap
+    clearSprites();
+    addSprite(MakeSprite(1, 10.0f, 0.0f));
+    addSprite(MakeSprite(2, 10.0f, 16.0f));
+    addSprite(MakeSprite(1, 10.0f, 32.0f));
+    buildSpriteRuns(nullptr);
+    REQUIRE(getSpriteDrawOrder() == Vector<uint32_t>{ 0, 2, 1 });
+    shutdownSprites();
+}
+
+TEST_CASE("SpriteLayer: quads use the sprite rect, tint and texture UVs", "[sprites]")
+{
+    shutdownSprites();
+    Sprite s = MakeSprite(3, 0.0f);
+    s.position = { 100.0f, 50.0f };
+    s.tint = { 255, 0, 0, 128 };
+    addSprite(s);
+    s.size = { 8.0f, 8.0f };
+    s.depth = 1.0f;
+    addSprite(s);
+    buildSpriteRuns(&Size64);
+
+    const Vector<SDL_Vertex>& v = getSpriteVertices();
+    REQUIRE(v.size() == 8);
+    REQUIRE(v[0].position.x == Catch::Approx(92.0f));
+    REQUIRE(v[0].position.y == Catch::Approx(34.0f));
+    REQUIRE(v[2].position.x == Catch::Approx(108.0f));
+    REQUIRE(v[2].position.y == Catch::Approx(66.0f));
+    REQUIRE(v[0].tex_coord.x == Catch::Approx(0.25f));
+    REQUIRE(v[2].tex_coord.x == Catch::Approx(0.5f));
+    REQUIRE(v[2].tex_coord.y == Catch::Approx(0.5f));
+    REQUIRE(v[0].color.a == Catch::Approx(128.0f / 255.0f));
+    REQUIRE(v[4].position.x == Catch::Approx(96.0f));
+    REQUIRE(v[6].position.y == Catch::Approx(54.0f));
+    shutdownSprites();
+}
+
+TEST_CASE("SpriteLayer: 50k sprite sort and build", "[.][benchmark][sprites]")
+{
+    shutdownSprites();
+    constexpr int kSprites = 50000;
+    uint32_t seed = 1234567u;
+    auto next = [&seed]() { seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5; return seed; };
+    Vector<Sprite> sprites;
+    for (int i = 0; i < kSprites; ++i) {
+        const float y = (float)(next() % 4096);
+        Sprite s = MakeSprite(1 + next() % 8, y, (float)(next() % 4096));
+        sprites.push_back(s);
+        addSprite(s);
+    }
+
+    BENCHMARK("radix sort + quad build, 50k sprites") {
+        buildSpriteRuns(&Size64);
+        return getSpriteRuns().size();
+    };
+
+    // Reference: comparison sort on (depth, image) without building quads or
+    // checking overlap
+    Vector<uint32_t> order(kSprites);
+    BENCHMARK("std::stable_sort by depth/image, 50k sprites") {
+        for (int i = 0; i < kSprites; ++i) order[i] = (uint32_t)i;
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+            const Sprite& sa = sprites[a];
+            const Sprite& sb = sprites[b];
+            if (sa.depth != sb.depth) return sa.depth < sb.depth;
+            return sa.image.index() < sb.image.index();
+        });
+        return order[0];
+    };
+    shutdownSprites();
+}
@@ -0,0 +1,51 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Common.h"
+
+#include <thread>
+
+TEST_CASE("SPSC ring: push/pop order and bounds", "[spsc]") {
+    SpscRing<int, 4> ring;
+    REQUIRE(ring.empty());
+
+    REQUIRE(ring.push(1));
+    REQUIRE(ring.push(2));
+    REQUIRE(ring.push(3));
+    REQUIRE(ring.push(4));
+    REQUIRE_FALSE(ring.push(5)); // full: all capacity slots are usable
+    REQUIRE(ring.size() == 4);
+
+    int v = 0;
+    REQUIRE(ring.pop(v));
+    REQUIRE(v == 1);
+    REQUIRE(ring.push(5)); // wraps around
+    for (int expected : { 2, 3, 4, 5 }) {
+        REQUIRE(ring.pop(v));
+        REQUIRE(v == expected);
+    }
+    REQUIRE_FALSE(ring.pop(v));
+    REQUIRE(ring.empty());
+}
+
+TEST_CASE("SPSC ring: producer and consumer threads", "[spsc]") {
+    constexpr int kCount = 200000;
+    SpscRing<int, 64> ring;
+
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            while (!ring.push(i)) std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    bool inOrder = true;
+    while (expected < kCount) {
+        int v = 0;
+        if (!ring.pop(v)) { std::this_thread::yield(); continue; }
+        if (v != expected) inOrder = false;
+        ++expected;
+    }
+    producer.join();
+
+    REQUIRE(inOrder);
+    REQUIRE(ring.empty());
+}
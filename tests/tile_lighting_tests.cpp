@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+using namespace TileLighting;
+
+namespace {
+    LightDesc White(float radius)
+    {
+        LightDesc d;
+        d.radius = radius;
+        d.color = { 255, 255, 255, 255 };
+        return d;
+    }
+
+    // Night ambient red is 0.10; lights add on top
+    float Red(int x, int y)
+    {
+        return getTileLight({ x, y }).r;
+    }
+
+    const SDL_Rect kAll = { 0, 0, 64, 64 };
+}
+
+TEST_CASE("TileLighting: flood falloff and occlusion", "[lighting]")
+{
+    REQUIRE(initLighting({ 20, 20 }));
+    setTimeOfDay(0.0f);
+    const LightHandle h = addLight(White(4.0f), { 5, 5 });
+    REQUIRE(h);
+    updateLighting(kAll);
+
+    // Strength 1 - steps / (radius + 1)
+    REQUIRE(Red(5, 5) == Catch::Approx(1.0f));
+    REQUIRE(Red(7, 5) == Catch::Approx(0.1f + 0.6f));
+    REQUIRE(Red(6, 6) == Catch::Approx(0.1f + 0.6f));
+    REQUIRE(Red(9, 5) == Catch::Approx(0.1f + 0.2f));
+    REQUIRE(Red(10, 5) == Catch::Approx(0.1f));
+
+    // A wall is lit but throws a shadow; light bends round it the long way
+    setOccluder({ 6, 5 }, true);
+    updateLighting(kAll);
+    REQUIRE(Red(6, 5) == Catch::Approx(0.1f + 0.8f));
+    REQUIRE(Red(7, 5) == Catch::Approx(0.1f + 0.2f));
+    REQUIRE(Red(8, 5) == Catch::Approx(0.1f));
+
+    // Fully walled off
+    for (int y = 0; y < 20; ++y) setOccluder({ 6, y }, true);
+    updateLighting(kAll);
+    REQUIRE(Red(7, 5) == Catch::Approx(0.1f));
+    REQUIRE(Red(4, 5) == Catch::Approx(0.1f + 0.8f));
+
+    // Occluders from tile models
+    TileMap::Tile wall;
+    wall.properties = TileMap::TileProperties::Blocking;
+    VectorRef<TileMap::Tile> tiles{ CreateRef<TileMap::Tile>(), CreateRef<TileMap::Tile>(wall) };
+    Vector<int> mapData(400, 0);
+    mapData[5 * 20 + 6] = 1;
+    setOccludersFromMap(mapData, tiles);
+    updateLighting(kAll);
+    REQUIRE(Red(7, 5) == Catch::Approx(0.1f + 0.2f));
+
+    REQUIRE(removeLight(h));
+    REQUIRE_FALSE(removeLight(h));
+    updateLighting(kAll);
+    REQUIRE(Red(5, 5) == Catch::Approx(0.1f));
+    shutdownLighting();
+}
+
+TEST_CASE("TileLighting: only dirty chunks in view are rebuilt", "[lighting]")
+{
+    REQUIRE(initLighting({ 64, 64 }));
+    setTimeOfDay(0.0f);
+    REQUIRE(getDirtyChunkCount() == 0);
+    const LightHandle h = addLight(White(4.0f), { 8, 8 });
+    REQUIRE(getDirtyChunkCount() == 1);
+
+    // Out of view: stays dirty
+    updateLighting({ 40, 40, 8, 8 });
+    REQUIRE(getDirtyChunkCount() == 1);
+    updateLighting({ 0, 0, 10, 10 });
+    REQUIRE(getDirtyChunkCount() == 0);
+    REQUIRE(Red(8, 8) == Catch::Approx(1.0f));
+
+    // Moving dirties the old and the new footprint
+    REQUIRE(moveLight(h, { 20, 8 }));
+    REQUIRE(getDirtyChunkCount() == 2);
+    REQUIRE(moveLight(h, { 20, 8 }));
+    REQUIRE(getDirtyChunkCount() == 2);
+    updateLighting(kAll);
+    REQUIRE(Red(8, 8) == Catch::Approx(0.1f));
+    REQUIRE(Red(20, 8) == Catch::Approx(1.0f));
+
+    // Occluders only dirty lights that cover them
+    setOccluder({ 50, 50 }, true);
+    REQUIRE(getDirtyChunkCount() == 0);
+    setOccluder({ 21, 8 }, true);
+    REQUIRE(getDirtyChunkCount() == 1);
+    setOccluder({ 21, 8 }, true);
+    updateLighting(kAll);
+    REQUIRE(getDirtyChunkCount() == 0);
+
+    // Ambient changes never dirty the map
+    setTimeOfDay(12.0f);
+    REQUIRE(getDirtyChunkCount() == 0);
+    REQUIRE(Red(40, 40) == Catch::Approx(1.0f));
+    shutdownLighting();
+    REQUIRE_FALSE(addLight(White(2.0f), { 0, 0 }));
+}
+
+TEST_CASE("TileLighting: ambient follows the time of day", "[lighting]")
+{
+    setTimeOfDay(12.0f);
+    REQUIRE(getAmbient().r == Catch::Approx(1.0f));
+    setTimeOfDay(2.0f);
+    REQUIRE(getAmbient().b == Catch::Approx(0.25f));
+    setTimeOfDay(7.25f);
+    REQUIRE(getAmbient().r == Catch::Approx(0.875f));
+    advanceTimeOfDay(20.0f);
+    REQUIRE(getTimeOfDay() == Catch::Approx(3.25f));
+    setTimeOfDay(-1.0f);
+    REQUIRE(getTimeOfDay() == Catch::Approx(23.0f));
+    REQUIRE(getAmbient().g == Catch::Approx(0.12f));
+}
+
+TEST_CASE("TileLighting: corner light and SIMD blend kernels", "[lighting]")
+{
+    constexpr std::size_t n = 37;
+    Vector<float> a(n + 1), b(n + 1), out(n + 1), ref(n + 1);
+    for (std::size_t i = 0; i <= n; ++i) {
+        a[i] = std::fabs(std::sin((float)i)) * 0.9f;
+        b[i] = std::fabs(std::cos((float)i * 3.0f));
+    }
+    blendLightRow(a.data(), 0.3f, out.data(), n);
+    blendLightRowScalar(a.data(), 0.3f, ref.data(), n);
+    for (std::size_t i = 0; i < n; ++i) REQUIRE(out[i] == ref[i]);
+    REQUIRE(ref[1] == Catch::Approx(std::min(1.0f, 0.3f + a[1])));
+    averageCornerRow(a.data(), b.data(), out.data(), n);
+    averageCornerRowScalar(a.data(), b.data(), ref.data(), n);
+    for (std::size_t i = 0; i < n; ++i) REQUIRE(out[i] == Catch::Approx(ref[i]));
+
+    REQUIRE(initLighting({ 10, 10 }));
+    setTimeOfDay(0.0f);
+    addLight(White(0.0f), { 1, 1 });
+    updateLighting(kAll);
+
+    Vector<SDL_FColor> corners;
+    buildCornerLight({ 0, 0, 3, 2 }, corners);
+    REQUIRE(corners.size() == 12);
+    // Corner (1, 1) averages tiles (0..1, 0..1); the map edge repeats
+    REQUIRE(corners[0].r == Catch::Approx(0.1f));
+    REQUIRE(corners[5].r == Catch::Approx((0.1f * 3.0f + 1.0f) * 0.25f));
+    REQUIRE(corners[10].r == Catch::Approx((0.1f * 3.0f + 1.0f) * 0.25f));
+    REQUIRE(corners[3].r == Catch::Approx(0.1f));
+    REQUIRE(corners[5].a == 1.0f);
+
+    // Interior region reads the map directly
+    buildCornerLight({ 1, 1, 4, 4 }, corners);
+    REQUIRE(corners.size() == 25);
+    REQUIRE(corners[0].r == Catch::Approx((0.1f * 3.0f + 1.0f) * 0.25f));
+    REQUIRE(corners[12].r == Catch::Approx(0.1f));
+    shutdownLighting();
+}
+
+TEST_CASE("TileLighting: rebuild and blend on a 256x256 map", "[.][benchmark][lighting]")
+{
+    REQUIRE(initLighting({ 256, 256 }));
+    setTimeOfDay(21.0f);
+    Vector<LightHandle> lights;
+    for (int i = 0; i < 64; ++i) lights.push_back(addLight(White(8.0f), { (i % 8) * 32 + 8, (i / 8) * 32 + 8 }));
+    for (int y = 0; y < 256; y += 5) {
+        for (int x = 0; x < 256; x += 7) setOccluder({ x, y }, true);
+    }
+    const SDL_Rect view = { 100, 100, 40, 24 };
+    const SDL_Rect map = { 0, 0, 256, 256 };
+    Vector<SDL_FColor> corners;
+    int step = 0;
+
+    BENCHMARK("move 64 lights, rebuild the whole map") {
+        ++step;
+        for (std::size_t i = 0; i < lights.size(); ++i) {
+            moveLight(lights[i], { (int)(i % 8) * 32 + 8 + (step & 1), (int)(i / 8) * 32 + 8 });
+        }
+        updateLighting(map);
+        return getDirtyChunkCount();
+    };
+
+    BENCHMARK("move 1 light in view, rebuild its chunks") {
+        ++step;
+        moveLight(lights[27], { 3 * 32 + 8 + (step & 1), 3 * 32 + 8 });
+        updateLighting(view);
+        return getDirtyChunkCount();
+    };
+
+    BENCHMARK("corner light for a 40x24 view") {
+        buildCornerLight(view, corners);
+        return corners.size();
+    };
+    shutdownLighting();
+}
@@ -0,0 +1,194 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "Common.h"
+
+using namespace Vector2Batch;
+
+namespace {
+    Vector2Stream MakeStream(std::size_t n)
+    {
+        Vector2Stream s;
+        for (std::size_t i = 0; i < n; ++i) {
+            s.push_back({ std::sin((float)i * 0.37f) * 100.0f, std::cos((float)i * 0.21f) * 60.0f + (float)i });
+        }
+        return s;
+    }
+
+    void RequireNear(const Vector2& a, const Vector2& b)
+    {
+        REQUIRE(a.x == Catch::Approx(b.x).margin(1e-3));
+        REQUIRE(a.y == Catch::Approx(b.y).margin(1e-3));
+    }
+
+    // Restores the detected kernel level when a test forces another one
+    struct KernelLevelScope {
+        ~KernelLevelScope() { setKernelLevel(detectKernelLevel()); }
+    };
+}
+
+TEST_CASE("Vector2Stream: affine builders match the point formulas", "[vector2_stream]")
+{
+    Vector2Stream s;
+    s.push_back({ 3, 1 });
+    s.push_back({ -2, 5 });
+
+    Vector2Stream r = s;
+    rotateAround(r, { 1, 1 }, 90.0f);
+    RequireNear(r[0], { 1, 3 });
+    RequireNear(r[1], { -3, -2 });
+
+    Vector2Stream k = s;
+    scale(k, { 2, 0.5f }, { 1, 1 });
+    RequireNear(k[0], { 5, 1 });
+    RequireNear(k[1], { -5, 3 });
+
+    Vector<Vector2> pts;
+    transform(s, makeAffine({ 10, 20 }, { 0, 2 }, { -1, 0 }), pts);
+    REQUIRE(pts.size() == 2);
+    RequireNear(pts[0], { 9, 26 });
+    RequireNear(pts[1], { 5, 16 });
+
+    translate(s, { 0.5f, -1 });
+    RequireNear(s[1], { -1.5f, 4 });
+
+    Vector<Vector2> aos;
+    s.store(aos);
+    Vector2Stream back;
+    back.assign(aos.data(), aos.size());
+    REQUIRE(back.x == s.x);
+    REQUIRE(back.y == s.y);
+}
+
+TEST_CASE("Vector2Stream: bounds and distance culling", "[vector2_stream]")
+{
+    Vector2Stream s;
+    Vector2 mn, mx;
+    REQUIRE_FALSE(bounds(s, mn, mx));
+
+    for (int i = 0; i < 11; ++i) s.push_back({ (float)i, (float)(i % 3) - 1.0f });
+    REQUIRE(bounds(s, mn, mx));
+    RequireNear(mn, { 0, -1 });
+    RequireNear(mx, { 10, 1 });
+
+    // Indices come back in order, the radius is inclusive
+    Vector<uint32_t> idx;
+    REQUIRE(cullDistanceSq(s, { 5, 0 }, 4.0f, idx) == 4);
+    REQUIRE(idx == Vector<uint32_t>{ 4, 5, 6, 7 });
+    REQUIRE(cullDistanceSq(s, { 100, 0 }, 1.0f, idx) == 0);
+    REQUIRE(idx.empty());
+}
+
+TEST_CASE("Vector2Stream: dispatched kernels match scalar reference", "[vector2_stream]")
+{
+    KernelLevelScope restore;
+    const Affine2 a = makeAffine({ 12, -7 }, { 0.8f, 0.6f }, { -1.2f, 0.9f });
+
+    for (KernelLevel level : { KernelLevel::SSE2, KernelLevel::AVX2, KernelLevel::NEON }) {
+        setKernelLevel(level);
+        if (getKernelLevel() != level) continue; // not available on this CPU/build
+        INFO("kernel level: " << kernelLevelName(level));
+
+        for (std::size_t n : { 1, 3, 4, 7, 8, 9, 17, 64, 333 }) {
+            const Vector2Stream src = MakeStream(n);
+
+            Vector2Stream ref = src, simd = src;
+            translateScalar(ref.x.data(), ref.y.data(), n, { 3, -4 });
+            translate(simd.x.data(), simd.y.data(), n, { 3, -4 });
+            REQUIRE(ref.x == simd.x);
+            REQUIRE(ref.y == simd.y);
+
+            affineScalar(src.x.data(), src.y.data(), ref.x.data(), ref.y.data(), n, a);
+            affine(src.x.data(), src.y.data(), simd.x.data(), simd.y.data(), n, a);
+            Vector<Vector2> pts(n);
+            affineToPoints(src.x.data(), src.y.data(), n, a, pts.data());
+            for (std::size_t i = 0; i < n; ++i) {
+                RequireNear(simd[i], ref[i]);
+                RequireNear(pts[i], ref[i]);
+            }
+
+            Vector2 rmn, rmx, smn, smx;
+            REQUIRE(boundsScalar(src.x.data(), src.y.data(), n, rmn, rmx));
+            REQUIRE(bounds(src.x.data(), src.y.data(), n, smn, smx));
+            REQUIRE(rmn == smn);
+            REQUIRE(rmx == smx);
+
+            Vector<uint32_t> ri(n), si(n);
+            ri.resize(cullDistanceSqScalar(src.x.data(), src.y.data(), n, { 10, 20 }, 2500.0f, ri.data()));
+            si.resize(cullDistanceSq(src.x.data(), src.y.data(), n, { 10, 20 }, 2500.0f, si.data()));
+            REQUIRE(ri == si);
+        }
+    }
+}
+
+TEST_CASE("Vector2Stream: batch kernels against the scalar loops", "[.][benchmark][vector2_stream]")
+{
+    KernelLevelScope restore;
+    constexpr std::size_t kPoints = 4096;
+    const Vector2Stream src = MakeStream(kPoints);
+    Vector2Stream buf = src;
+    Vector<Vector2> aos;
+    src.store(aos);
+    Vector<Vector2> pts(kPoints);
+    Vector<uint32_t> idx(kPoints);
+    const Affine2 a = makeRotationAround({ 50, 50 }, 30.0f);
+
+    // What TileMap's toScreenSpace did per visible tile
+    Vector<TileMap::TileTransform> tiles(kPoints);
+    for (std::size_t i = 0; i < kPoints; ++i) tiles[i].position = aos[i];
+    BENCHMARK("AoS tile transforms, per-tile viewport subtract") {
+        for (auto& t : tiles) {
+            t.position.x -= 0.25f;
+            t.position.y -= 0.5f;
+        }
+        return tiles[0].position.x;
+    };
+
+    // What transformUnitShape did per vertex
+    BENCHMARK("AoS affine into Vector2 array") {
+        for (std::size_t i = 0; i < kPoints; ++i) {
+            const Vector2& p = aos[i];
+            pts[i] = { a.m[0] * p.x + a.m[2] * p.y + a.tx, a.m[1] * p.x + a.m[3] * p.y + a.ty };
+        }
+        return pts[0].x;
+    };
+
+    BENCHMARK("scalar translate") {
+        translateScalar(buf.x.data(), buf.y.data(), kPoints, { -0.25f, -0.5f });
+        return buf.x[0];
+    };
+    BENCHMARK("scalar affineToPoints") {
+        affineToPointsScalar(src.x.data(), src.y.data(), kPoints, a, pts.data());
+        return pts[0].x;
+    };
+    BENCHMARK("scalar bounds") {
+        Vector2 mn, mx;
+        boundsScalar(src.x.data(), src.y.data(), kPoints, mn, mx);
+        return mn.x + mx.y;
+    };
+    BENCHMARK("scalar cullDistanceSq") {
+        return cullDistanceSqScalar(src.x.data(), src.y.data(), kPoints, { 0, 40 }, 2500.0f, idx.data());
+    };
+
+    for (KernelLevel level : { KernelLevel::SSE2, KernelLevel::AVX2, KernelLevel::NEON }) {
+        setKernelLevel(level);
+        if (getKernelLevel() != level) continue; // not available on this CPU/build
+        const std::string name = kernelLevelName(level);
+        BENCHMARK(name + " translate") {
+            translate(buf.x.data(), buf.y.data(), kPoints, { -0.25f, -0.5f });
+            return buf.x[0];
+        };
+        BENCHMARK(name + " affineToPoints") {
+            affineToPoints(src.x.data(), src.y.data(), kPoints, a, pts.data());
+            return pts[0].x;
+        };
+        BENCHMARK(name + " bounds") {
+            Vector2 mn, mx;
+            bounds(src.x.data(), src.y.data(), kPoints, mn, mx);
+            return mn.x + mx.y;
+        };
+        BENCHMARK(name + " cullDistanceSq") {
+            return cullDistanceSq(src.x.data(), src.y.data(), kPoints, { 0, 40 }, 2500.0f, idx.data());
+        };
+    }
+}